@@ -26,6 +26,17 @@
 #endif
 
 
+//-----------------------------------------------------------------------------------------------
+// What a sound is charged against the sound cache's budget: its decoded PCM size, which FMOD_DEFAULT keeps in memory
+//
+static size_t GetSoundMemoryBytes(FMOD::Sound* sound)
+{
+	unsigned int lengthBytes = 0;
+	sound->getLength(&lengthBytes, FMOD_TIMEUNIT_PCMBYTES);
+	return lengthBytes;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 // Initialization code based on example from "FMOD Studio Programmers API for Windows"
 //
@@ -56,12 +67,29 @@ void AudioSystem::Startup()
 
 	result = m_fmodSystem->init( 512, FMOD_INIT_3D_RIGHTHANDED, nullptr );
 	ValidateResult( result );
+
+	m_soundCache = new ResourceCache<SoundID>( m_audioConfig.m_soundCacheConfig, [this]( SoundID soundID )
+	{
+		m_registeredSounds[ soundID ]->release();
+		m_registeredSounds[ soundID ] = nullptr;
+	} );
+
+	m_assetPipeline = new AssetPipeline( m_audioConfig.m_assetPipelineConfig );
+	m_assetPipeline->Startup();
 }
 
 
 //------------------------------------------------------------------------------------------------
 void AudioSystem::Shutdown()
 {
+	// Async loads hold FMOD sounds until they are finalized, so finish them before FMOD goes away
+	m_assetPipeline->Shutdown();
+	delete m_assetPipeline;
+	m_assetPipeline = nullptr;
+	delete m_soundCache;
+	m_soundCache = nullptr;
+	m_registeredSounds.clear();
+
 	FMOD_RESULT result = m_fmodSystem->release();
 	ValidateResult( result );
 
@@ -73,6 +101,7 @@ void AudioSystem::Shutdown()
 void AudioSystem::BeginFrame()
 {
 	m_fmodSystem->update();
+	m_assetPipeline->BeginFrame();
 }
 
 
@@ -85,41 +114,107 @@ void AudioSystem::EndFrame()
 //-----------------------------------------------------------------------------------------------
 SoundID AudioSystem::CreateOrGetSound(const std::string& soundFilePath, int dimension)
 {
-	std::map< std::string, SoundID >::iterator found = m_registeredSoundIDs.find(soundFilePath);
-	if (found != m_registeredSoundIDs.end())
+	if (m_soundCache->IsLoading(soundFilePath))
+	{
+		FinishPendingSoundLoads();
+	}
+
+	SoundID foundSoundID = MISSING_SOUND_ID;
+	if (m_soundCache->Find(soundFilePath, foundSoundID))
 	{
-		return found->second;
+		m_soundCache->Pin(foundSoundID); // the caller keeps the raw ID
+		return foundSoundID;
+	}
+
+	// failed async loads leave the cache, so the file is simply tried again here
+	FMOD::Sound* newSound = nullptr;
+	if (dimension == 2)
+	{
+		m_fmodSystem->createSound(soundFilePath.c_str(), FMOD_DEFAULT, nullptr, &newSound);
 	}
 	else
 	{
-		FMOD::Sound* newSound = nullptr;
-		if (dimension == 2)
+		m_fmodSystem->createSound(soundFilePath.c_str(), FMOD_3D, nullptr, &newSound);
+	}
+
+	if (newSound)
+	{
+		SoundID newSoundID = RegisterSound(newSound);
+		SoundHandle newSoundHandle = m_soundCache->Add(soundFilePath, newSoundID, GetSoundMemoryBytes(newSound));
+		m_soundCache->Pin(newSoundID);
+		return newSoundID;
+	}
+
+	return MISSING_SOUND_ID;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// FMOD Core's API is thread-safe, so the file is read and decoded by createSound on a worker;
+// only registering the new sound happens on the main thread.
+SoundHandle AudioSystem::CreateOrGetSoundAsync(const std::string& soundFilePath, int dimension)
+{
+	SoundHandle soundHandle = m_soundCache->Acquire(soundFilePath);
+	if (soundHandle.IsValid())
+	{
+		return soundHandle;
+	}
+	soundHandle = m_soundCache->AddLoading(soundFilePath, MISSING_SOUND_ID);
+
+	struct PendingSoundLoad
+	{
+		std::string		m_filePath;
+		FMOD::Sound*	m_sound = nullptr;
+		SoundHandle		m_handle; // keeps the entry loading until finalized, even if every caller drops theirs
+	};
+	PendingSoundLoad* pendingLoad = new PendingSoundLoad();
+	pendingLoad->m_filePath = soundFilePath;
+	pendingLoad->m_handle = soundHandle;
+	FMOD_MODE mode = dimension == 2 ? FMOD_DEFAULT : FMOD_3D;
+	m_assetPipeline->QueueLoad(
+		[this, pendingLoad, mode]()
+		{
+			m_fmodSystem->createSound(pendingLoad->m_filePath.c_str(), mode, nullptr, &pendingLoad->m_sound);
+		},
+		[this, pendingLoad]()
 		{
-			m_fmodSystem->createSound(soundFilePath.c_str(), FMOD_DEFAULT, nullptr, &newSound);
-			if (newSound)
+			if (pendingLoad->m_sound)
 			{
-				SoundID newSoundID = m_registeredSounds.size();
-				m_registeredSoundIDs[soundFilePath] = newSoundID;
-				m_registeredSounds.push_back(newSound);
-				return newSoundID;
+				m_soundCache->FinishLoad(pendingLoad->m_handle, RegisterSound(pendingLoad->m_sound), GetSoundMemoryBytes(pendingLoad->m_sound));
 			}
-		}
-		else
-		{
-			m_fmodSystem->createSound(soundFilePath.c_str(), FMOD_3D, nullptr, &newSound);
-			if (newSound)
+			else
 			{
-				SoundID newSoundID = m_registeredSounds.size();
-				m_registeredSoundIDs[soundFilePath] = newSoundID;
-				m_registeredSounds.push_back(newSound);
-				return newSoundID;
+				m_soundCache->FinishLoad(pendingLoad->m_handle, MISSING_SOUND_ID, 0, true);
 			}
-		}
-	}
+			delete pendingLoad;
+		});
+	return soundHandle;
+}
 
-	return MISSING_SOUND_ID;
+
+//-----------------------------------------------------------------------------------------------
+void AudioSystem::FinishPendingSoundLoads()
+{
+	m_assetPipeline->FinishAllLoads();
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void AudioSystem::ReleaseSound(SoundID soundID)
+{
+	m_soundCache->Unpin(soundID);
 }
 
+
+//-----------------------------------------------------------------------------------------------
+SoundID AudioSystem::RegisterSound(FMOD::Sound* sound)
+{
+	SoundID newSoundID = m_registeredSounds.size();
+	m_registeredSounds.push_back(sound);
+	return newSoundID;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 SoundPlaybackID AudioSystem::StartSound( SoundID soundID, bool isLooped, float volume, float balance, float speed, bool isPaused )
 {
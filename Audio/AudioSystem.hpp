@@ -1,5 +1,7 @@
 #pragma once
 #include "Engine/Math/Vec3.hpp"
+#include "Engine/Core/AssetPipeline.hpp"
+#include "Engine/Core/ResourceCache.hpp"
 
 //-----------------------------------------------------------------------------------------------
 #include "ThirdParty/fmod/fmod.hpp"
@@ -12,6 +14,7 @@
 typedef size_t SoundID;
 typedef size_t SoundPlaybackID;
 constexpr size_t MISSING_SOUND_ID = (size_t)(-1); // for bad SoundIDs and SoundPlaybackIDs
+typedef ResourceHandle<SoundID> SoundHandle;
 
 
 //-----------------------------------------------------------------------------------------------
@@ -19,7 +22,8 @@ class AudioSystem;
 
 struct AudioConfig
 {
-
+	AssetPipelineConfig m_assetPipelineConfig;
+	ResourceCacheConfig m_soundCacheConfig; // charged the decoded PCM size of each sound
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -37,6 +41,10 @@ public:
 	virtual void				EndFrame();
 
 	virtual SoundID				CreateOrGetSound( const std::string& soundFilePath, int dimension = 2);
+	SoundHandle					CreateOrGetSoundAsync( const std::string& soundFilePath, int dimension = 2 ); // decoded on g_theJobSystem; MISSING_SOUND_ID until ready
+	void						FinishPendingSoundLoads();
+	void						ReleaseSound( SoundID soundID );	// undoes one CreateOrGetSound; once all are undone the sound may be evicted and its ID then plays nothing
+	ResourceCache<SoundID>&		GetSoundCache() { return *m_soundCache; }
 	virtual SoundPlaybackID		StartSound( SoundID soundID, bool isLooped=false, float volume=1.f, float balance=0.0f, float speed=1.0f, bool isPaused=false );
 	virtual void				StopSound( SoundPlaybackID soundPlaybackID );
 	virtual void				SetSoundPlaybackVolume( SoundPlaybackID soundPlaybackID, float volume );	// volume is in [0,1]
@@ -51,10 +59,14 @@ public:
 
 	virtual void				ValidateResult( FMOD_RESULT result );
 
+protected:
+	SoundID						RegisterSound( FMOD::Sound* sound );
+
 protected:
 	FMOD::System*						m_fmodSystem;
-	std::map< std::string, SoundID >	m_registeredSoundIDs;
-	std::vector< FMOD::Sound* >			m_registeredSounds;
+	ResourceCache<SoundID>*				m_soundCache = nullptr;	// SoundIDs by file path
+	std::vector< FMOD::Sound* >			m_registeredSounds;		// indexed by SoundID; null once evicted
+	AssetPipeline*						m_assetPipeline = nullptr;
 
 private:
 	AudioConfig m_audioConfig;
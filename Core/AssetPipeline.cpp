@@ -0,0 +1,104 @@
+#include "Engine/Core/AssetPipeline.hpp"
+#include "Engine/Core/Time.hpp"
+
+AssetPipeline::AssetPipeline(AssetPipelineConfig const& config)
+	: m_config(config)
+{
+}
+
+AssetPipeline::~AssetPipeline()
+{
+	Shutdown();
+}
+
+void AssetPipeline::Startup()
+{
+}
+
+void AssetPipeline::Shutdown()
+{
+	FinishAllLoads();
+	if (g_theJobSystem != nullptr)
+	{
+		g_theJobSystem->WaitForCounter(m_decodeCounter); //The last decode job may still be returning
+	}
+}
+
+void AssetPipeline::BeginFrame()
+{
+	FinalizeLoads(m_config.m_finalizeBudgetSeconds);
+}
+
+void AssetPipeline::EndFrame()
+{
+}
+
+void AssetPipeline::QueueLoad(AssetStageFunction decode, AssetStageFunction finalize)
+{
+	AssetLoad* load = new AssetLoad();
+	load->m_decode = std::move(decode);
+	load->m_finalize = std::move(finalize);
+	m_numPendingLoads++;
+
+	if (g_theJobSystem != nullptr)
+	{
+		g_theJobSystem->KickJob([this, load]() { DecodeLoad(load); }, &m_decodeCounter);
+	}
+	else
+	{
+		DecodeLoad(load);
+	}
+}
+
+int AssetPipeline::FinalizeLoads(double budgetSeconds)
+{
+	double endTime = GetCurrentTimeSeconds() + budgetSeconds;
+	int numFinalized = 0;
+	for (;;)
+	{
+		AssetLoad* load = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_decodedLoadsMutex);
+			if (m_decodedLoads.empty())
+			{
+				break;
+			}
+			load = m_decodedLoads.front();
+			m_decodedLoads.pop_front();
+		}
+
+		load->m_finalize();
+		delete load;
+		m_numPendingLoads--;
+		numFinalized++;
+		if (GetCurrentTimeSeconds() >= endTime)
+		{
+			break;
+		}
+	}
+	return numFinalized;
+}
+
+void AssetPipeline::FinishAllLoads()
+{
+	while (m_numPendingLoads > 0)
+	{
+		if (FinalizeLoads(1.0) == 0)
+		{
+			//Everything left is still decoding; help with it rather than sleeping
+			if (g_theJobSystem == nullptr || !g_theJobSystem->RunOneJob())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+}
+
+void AssetPipeline::DecodeLoad(AssetLoad* load)
+{
+	load->m_decode();
+	load->m_decode.Clear();
+
+	std::lock_guard<std::mutex> lock(m_decodedLoadsMutex);
+	m_decodedLoads.push_back(load);
+}
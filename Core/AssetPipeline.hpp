@@ -0,0 +1,98 @@
+#pragma once
+#include "Engine/Core/InlineFunction.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+enum class AssetLoadState
+{
+	LOADING,
+	READY,
+	FAILED
+};
+
+//Shared by every handle to one asset. Owned by the system that loads the asset and kept until that system shuts down.
+//m_asset is written on the main thread before m_state becomes READY.
+template<typename AssetType>
+struct AssetLoadStatus
+{
+	std::atomic<AssetLoadState>	m_state = AssetLoadState::LOADING;
+	AssetType					m_asset = AssetType();
+	AssetType					m_placeholder = AssetType(); //What Get returns until the asset is ready, and if it fails
+};
+
+//Returned the moment an asset is requested. Copyable and cheap; for use on the main thread. An empty handle reports FAILED.
+template<typename AssetType>
+class AssetHandle
+{
+public:
+	AssetHandle() = default;
+	explicit AssetHandle(AssetLoadStatus<AssetType>* status) : m_status(status) {}
+
+	AssetLoadState	GetState() const { return m_status ? m_status->m_state.load(std::memory_order_acquire) : AssetLoadState::FAILED; }
+	bool			IsValid() const { return m_status != nullptr; }
+	bool			IsLoading() const { return GetState() == AssetLoadState::LOADING; }
+	bool			IsReady() const { return GetState() == AssetLoadState::READY; }
+	bool			HasFailed() const { return GetState() == AssetLoadState::FAILED; }
+
+	AssetType		Get() const; //The asset once ready, otherwise the placeholder
+
+protected:
+	AssetLoadStatus<AssetType>* m_status = nullptr;
+};
+
+typedef InlineFunction<void()> AssetStageFunction;
+
+struct AssetPipelineConfig
+{
+	double m_finalizeBudgetSeconds = 0.002; //BeginFrame finalizes until this much time has passed, and always at least one load
+};
+
+//Two-stage asset loading. The decode stage (file reads, image decoding, shader compiles) runs on g_theJobSystem, or
+//inline at QueueLoad if there is none. The finalize stage creates the backend objects on the main thread, a time-budgeted
+//batch per BeginFrame, so a burst of requests spreads over several frames instead of stalling one. A level load can queue
+//everything and then call FinishAllLoads, so decodes overlap each other and the main thread's finalizing.
+class AssetPipeline
+{
+public:
+	AssetPipeline(AssetPipelineConfig const& config);
+	~AssetPipeline();
+	void Startup();
+	void Shutdown(); //Finishes every queued load
+	void BeginFrame();
+	void EndFrame();
+
+	//Both stages are called exactly once, in order, and finalize always on the main thread. Captured state must stay valid until then.
+	void	QueueLoad(AssetStageFunction decode, AssetStageFunction finalize);
+	int		FinalizeLoads(double budgetSeconds); //Returns how many loads were finalized
+	void	FinishAllLoads(); //Blocks, helping with decodes, until every queued load is finalized
+	int		GetNumPendingLoads() const { return m_numPendingLoads; }
+
+protected:
+	struct AssetLoad
+	{
+		AssetStageFunction m_decode;
+		AssetStageFunction m_finalize;
+	};
+
+	void	DecodeLoad(AssetLoad* load);
+
+protected:
+	AssetPipelineConfig m_config;
+	JobCounter m_decodeCounter; //Decode jobs still running on g_theJobSystem
+	std::mutex m_decodedLoadsMutex;
+	std::deque<AssetLoad*> m_decodedLoads;
+	int m_numPendingLoads = 0; //Queued but not yet finalized; main thread only
+};
+
+template<typename AssetType>
+AssetType AssetHandle<AssetType>::Get() const
+{
+	if (m_status == nullptr)
+	{
+		return AssetType();
+	}
+	return m_status->m_state.load(std::memory_order_acquire) == AssetLoadState::READY ? m_status->m_asset : m_status->m_placeholder;
+}
@@ -0,0 +1,275 @@
+#include "Engine/Core/AsyncFileLoader.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include <algorithm>
+#include <iterator>
+
+AsyncFileLoader::AsyncFileLoader(AsyncFileLoaderConfig const& config)
+	: m_config(config)
+{
+}
+
+AsyncFileLoader::~AsyncFileLoader()
+{
+	Shutdown();
+}
+
+void AsyncFileLoader::Startup()
+{
+	int numWorkers = m_config.m_numWorkerThreads;
+	if (numWorkers < 0)
+	{
+		numWorkers = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+	}
+	numWorkers = std::max(numWorkers, 1);
+
+	std::lock_guard<std::mutex> lock(m_requestMutex);
+	m_isRunning = true;
+	for (int workerIndex = 0; workerIndex < numWorkers; workerIndex++)
+	{
+		m_workers.emplace_back(&AsyncFileLoader::WorkerMain, this);
+	}
+}
+
+void AsyncFileLoader::Shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_requestMutex);
+		m_isRunning = false;
+	}
+	m_requestAvailable.notify_all();
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+	m_workers.clear();
+
+	for (std::deque<FileLoadRequest>& queue : m_queuedRequests)
+	{
+		for (FileLoadRequest& request : queue)
+		{
+			FailRequest(request);
+		}
+		m_numOutstandingLoads -= static_cast<int>(queue.size());
+		queue.clear();
+	}
+	m_completedLoads.clear();
+}
+
+void AsyncFileLoader::BeginFrame()
+{
+	if (m_config.m_deliverCompletedLoadsInBeginFrame)
+	{
+		DeliverCompletedLoads();
+	}
+}
+
+void AsyncFileLoader::EndFrame()
+{
+}
+
+int AsyncFileLoader::LoadFileAsync(std::string const& filePath, FileLoadCallback callback, FileLoadPriority priority)
+{
+	FileLoadRequest request;
+	request.m_filePath = filePath;
+	request.m_callback = std::move(callback);
+
+	int requestID;
+	{
+		std::lock_guard<std::mutex> lock(m_requestMutex);
+		requestID = QueueRequest(std::move(request), priority);
+	}
+	m_requestAvailable.notify_one();
+	return requestID;
+}
+
+std::future<FileLoadResult> AsyncFileLoader::LoadFileAsync(std::string const& filePath, FileLoadPriority priority, int* out_requestID)
+{
+	FileLoadRequest request;
+	request.m_filePath = filePath;
+	request.m_hasPromise = true;
+	std::future<FileLoadResult> future = request.m_promise.get_future();
+
+	int requestID;
+	{
+		std::lock_guard<std::mutex> lock(m_requestMutex);
+		requestID = QueueRequest(std::move(request), priority);
+	}
+	m_requestAvailable.notify_one();
+
+	if (out_requestID)
+	{
+		*out_requestID = requestID;
+	}
+	return future;
+}
+
+void AsyncFileLoader::LoadFilesAsync(Strings const& filePaths, FileLoadCallback const& callback, FileLoadPriority priority)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_requestMutex);
+		for (std::string const& filePath : filePaths)
+		{
+			FileLoadRequest request;
+			request.m_filePath = filePath;
+			request.m_callback = callback;
+			QueueRequest(std::move(request), priority);
+		}
+	}
+	m_requestAvailable.notify_all();
+}
+
+bool AsyncFileLoader::CancelRequest(int requestID)
+{
+	FileLoadRequest cancelledRequest;
+	{
+		std::lock_guard<std::mutex> lock(m_requestMutex);
+		std::deque<FileLoadRequest>* foundQueue = nullptr;
+		std::deque<FileLoadRequest>::iterator found;
+		for (std::deque<FileLoadRequest>& queue : m_queuedRequests)
+		{
+			found = std::find_if(queue.begin(), queue.end(), [requestID](FileLoadRequest const& request) { return request.m_requestID == requestID; });
+			if (found != queue.end())
+			{
+				foundQueue = &queue;
+				break;
+			}
+		}
+		if (foundQueue == nullptr)
+		{
+			return false;
+		}
+		cancelledRequest = std::move(*found);
+		foundQueue->erase(found);
+	}
+
+	FailRequest(cancelledRequest);
+	if (--m_numOutstandingLoads == 0)
+	{
+		std::lock_guard<std::mutex> lock(m_requestMutex);
+		m_allLoadsFinished.notify_all();
+	}
+	return true;
+}
+
+void AsyncFileLoader::DeliverCompletedLoads()
+{
+	//Swap the list out so callbacks can queue more loads, and workers can keep finishing them, while these run
+	m_deliveryScratch.clear();
+	{
+		std::lock_guard<std::mutex> lock(m_completionMutex);
+		m_deliveryScratch.swap(m_completedLoads);
+	}
+	for (CompletedFileLoad& completedLoad : m_deliveryScratch)
+	{
+		completedLoad.m_callback(completedLoad.m_result);
+	}
+	m_deliveryScratch.clear();
+}
+
+void AsyncFileLoader::WaitForAllLoads()
+{
+	{
+		std::unique_lock<std::mutex> lock(m_requestMutex);
+		m_allLoadsFinished.wait(lock, [this]() { return m_numOutstandingLoads.load(std::memory_order_acquire) == 0 || !m_isRunning; });
+	}
+	DeliverCompletedLoads();
+}
+
+int AsyncFileLoader::QueueRequest(FileLoadRequest&& request, FileLoadPriority priority)
+{
+	request.m_requestID = m_nextRequestID++;
+	int requestID = request.m_requestID;
+	if (!m_isRunning)
+	{
+		FailRequest(request);
+		return requestID;
+	}
+
+	m_numOutstandingLoads++;
+	m_queuedRequests[static_cast<int>(priority)].push_back(std::move(request));
+	return requestID;
+}
+
+void AsyncFileLoader::WorkerMain()
+{
+	std::vector<FileLoadRequest> batch;
+	std::vector<CompletedFileLoad> completedBatch;
+	int maxRequestsPerBatch = std::max(m_config.m_maxRequestsPerBatch, 1);
+
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_requestMutex);
+			m_requestAvailable.wait(lock, [this]()
+			{
+				return !m_isRunning || std::any_of(std::begin(m_queuedRequests), std::end(m_queuedRequests), [](std::deque<FileLoadRequest> const& queue) { return !queue.empty(); });
+			});
+			if (!m_isRunning)
+			{
+				return;
+			}
+
+			//Take one batch, highest priority first, so the lock is held once per batch rather than once per file. A batch is at most
+			//this worker's share of the queue, so a small burst spreads over the pool and later requests do not wait behind long batches.
+			int numQueued = 0;
+			for (std::deque<FileLoadRequest> const& queue : m_queuedRequests)
+			{
+				numQueued += static_cast<int>(queue.size());
+			}
+			int numWorkers = std::max(static_cast<int>(m_workers.size()), 1);
+			int batchSize = std::min(maxRequestsPerBatch, (numQueued + numWorkers - 1) / numWorkers);
+			for (std::deque<FileLoadRequest>& queue : m_queuedRequests)
+			{
+				while (!queue.empty() && static_cast<int>(batch.size()) < batchSize)
+				{
+					batch.push_back(std::move(queue.front()));
+					queue.pop_front();
+				}
+			}
+			if (numQueued > batchSize)
+			{
+				m_requestAvailable.notify_one();
+			}
+		}
+
+		for (FileLoadRequest& request : batch)
+		{
+			FileLoadResult result;
+			result.m_filePath = std::move(request.m_filePath);
+			result.m_succeeded = TryFileReadToBuffer(result.m_bytes, result.m_filePath) >= 0;
+			if (request.m_hasPromise)
+			{
+				request.m_promise.set_value(std::move(result));
+			}
+			else
+			{
+				completedBatch.push_back(CompletedFileLoad{ std::move(request.m_callback), std::move(result) });
+			}
+		}
+
+		if (!completedBatch.empty())
+		{
+			std::lock_guard<std::mutex> lock(m_completionMutex);
+			std::move(completedBatch.begin(), completedBatch.end(), std::back_inserter(m_completedLoads));
+		}
+
+		int numFinished = static_cast<int>(batch.size());
+		batch.clear();
+		completedBatch.clear();
+		if (m_numOutstandingLoads.fetch_sub(numFinished, std::memory_order_acq_rel) == numFinished)
+		{
+			std::lock_guard<std::mutex> lock(m_requestMutex);
+			m_allLoadsFinished.notify_all();
+		}
+	}
+}
+
+void AsyncFileLoader::FailRequest(FileLoadRequest& request)
+{
+	if (request.m_hasPromise)
+	{
+		FileLoadResult result;
+		result.m_filePath = request.m_filePath;
+		request.m_promise.set_value(std::move(result));
+	}
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include "Engine/Core/InlineFunction.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class AsyncFileLoader;
+
+extern AsyncFileLoader* g_theAsyncFileLoader;
+
+//Queued requests are served highest priority first, in request order within a priority
+enum class FileLoadPriority
+{
+	HIGH,
+	NORMAL,
+	LOW,
+	COUNT
+};
+
+struct FileLoadResult
+{
+	std::string				m_filePath;
+	std::vector<uint8_t>	m_bytes;
+	bool					m_succeeded = false; //False if the file was missing or unreadable, or the loader shut down first
+};
+
+typedef InlineFunction<void(FileLoadResult&)> FileLoadCallback; //May move the bytes out of the result
+
+struct AsyncFileLoaderConfig
+{
+	int m_numWorkerThreads = -1; //-1 uses one per hardware thread beyond the main thread, and at least one
+	int m_maxRequestsPerBatch = 8; //Most queued requests a worker takes per lock; it never takes more than its share of the queue
+	bool m_deliverCompletedLoadsInBeginFrame = true;
+};
+
+struct FileLoadRequest
+{
+	int								m_requestID = -1;
+	std::string						m_filePath;
+	FileLoadCallback				m_callback;
+	std::promise<FileLoadResult>	m_promise;
+	bool							m_hasPromise = false;
+};
+
+struct CompletedFileLoad
+{
+	FileLoadCallback	m_callback;
+	FileLoadResult		m_result;
+};
+
+//Reads whole files on a pool of worker threads so many small reads overlap instead of stalling the main thread one after
+//another. Each request either returns a future, fulfilled on the worker as soon as the read finishes, or takes a callback,
+//which runs on the main thread in the next DeliverCompletedLoads (BeginFrame by default) so it may touch any engine system.
+//Requesting is thread safe; delivery, waiting and cancelling are main thread only. Typical level load:
+//
+//	for (std::string const& path : tilePaths)
+//	{
+//		g_theAsyncFileLoader->LoadFileAsync(path, [this](FileLoadResult& result) { ParseTileFile(result); });
+//	}
+//	g_theAsyncFileLoader->WaitForAllLoads(); //Or let the callbacks trickle in over the next frames
+class AsyncFileLoader
+{
+public:
+	AsyncFileLoader(AsyncFileLoaderConfig const& config);
+	~AsyncFileLoader();
+	void Startup();
+	void Shutdown(); //Pending requests fail: futures get an unsuccessful result and callbacks are dropped
+	void BeginFrame();
+	void EndFrame();
+
+	//Each returns a request ID for CancelRequest
+	int							LoadFileAsync(std::string const& filePath, FileLoadCallback callback, FileLoadPriority priority = FileLoadPriority::NORMAL);
+	std::future<FileLoadResult>	LoadFileAsync(std::string const& filePath, FileLoadPriority priority = FileLoadPriority::NORMAL, int* out_requestID = nullptr);
+	void						LoadFilesAsync(Strings const& filePaths, FileLoadCallback const& callback, FileLoadPriority priority = FileLoadPriority::NORMAL); //One lock and wake-up for the batch
+
+	bool	CancelRequest(int requestID); //Only succeeds while the request is still queued; a cancelled future gets an unsuccessful result
+	void	DeliverCompletedLoads(); //Runs the callbacks of every load finished so far
+	void	WaitForAllLoads(); //Blocks until nothing is queued or reading, then delivers
+	int		GetNumOutstandingLoads() const { return m_numOutstandingLoads.load(std::memory_order_acquire); }
+
+protected:
+	int		QueueRequest(FileLoadRequest&& request, FileLoadPriority priority); //Caller holds m_requestMutex
+	void	WorkerMain();
+	void	FailRequest(FileLoadRequest& request);
+
+protected:
+	AsyncFileLoaderConfig m_config;
+	std::vector<std::thread> m_workers;
+
+	std::mutex m_requestMutex;
+	std::condition_variable m_requestAvailable;
+	std::condition_variable m_allLoadsFinished;
+	std::deque<FileLoadRequest> m_queuedRequests[static_cast<int>(FileLoadPriority::COUNT)];
+	int m_nextRequestID = 0;
+	bool m_isRunning = false; //Requests made while stopped fail at once
+	std::atomic<int> m_numOutstandingLoads = 0; //Queued plus being read
+
+	std::mutex m_completionMutex;
+	std::vector<CompletedFileLoad> m_completedLoads;
+	std::vector<CompletedFileLoad> m_deliveryScratch;
+};
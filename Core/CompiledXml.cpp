@@ -0,0 +1,610 @@
+#include "Engine/Core/CompiledXml.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include <cstring>
+#include <filesystem>
+
+constexpr uint32_t COMPILED_XML_MAGIC = 0x434C4D58; //"XMLC"
+constexpr uint32_t COMPILED_XML_VERSION = 1; //Bump whenever the record layout or the pre-conversion rules change
+
+struct CompiledXmlHeader
+{
+	uint32_t m_magic = COMPILED_XML_MAGIC;
+	uint32_t m_version = COMPILED_XML_VERSION;
+	uint64_t m_sourceHash = 0;
+	uint32_t m_blobSize = 0;
+	int32_t m_numElements = 0;
+	int32_t m_numAttributes = 0;
+	uint32_t m_stringPoolSize = 0;
+};
+
+static_assert(sizeof(CompiledXmlHeader) % 8 == 0, "Element records must stay aligned after the header");
+static_assert(sizeof(CompiledXmlElement) % 4 == 0 && sizeof(CompiledXmlAttribute) % 4 == 0, "Records must stay 4-byte aligned");
+
+//64-bit FNV-1a over the source bytes, seeded with the format version so a version bump also misses
+static uint64_t HashSourceBytes(uint8_t const* bytes, size_t numBytes)
+{
+	uint64_t hash = 14695981039346656037ull ^ COMPILED_XML_VERSION;
+	for (size_t byteIndex = 0; byteIndex < numBytes; byteIndex++)
+	{
+		hash ^= bytes[byteIndex];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+//Builds the records with absolute indices (-1 for none), which Finalize turns into self-relative byte offsets
+struct CompiledXmlBuilder
+{
+	int AddString(char const* text)
+	{
+		int stringOffset = static_cast<int>(m_strings.size());
+		m_strings.append(text);
+		m_strings.push_back('\0');
+		return stringOffset;
+	}
+
+	int AddElement(XmlElement const& element)
+	{
+		int elementIndex = static_cast<int>(m_elements.size());
+		m_elements.emplace_back();
+		m_elements[elementIndex].m_nameOffset = AddString(element.Name());
+		m_elements[elementIndex].m_textOffset = element.GetText() ? AddString(element.GetText()) : -1;
+		m_elements[elementIndex].m_attributesOffset = static_cast<int>(m_attributes.size());
+		m_elements[elementIndex].m_firstChildOffset = -1;
+		m_elements[elementIndex].m_nextSiblingOffset = -1;
+
+		for (XmlAttribute const* attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+		{
+			AddAttribute(*attribute);
+			m_elements[elementIndex].m_numAttributes++;
+		}
+
+		int previousChildIndex = -1;
+		for (XmlElement const* child = element.FirstChildElement(); child; child = child->NextSiblingElement())
+		{
+			int childIndex = AddElement(*child);
+			if (previousChildIndex < 0)
+			{
+				m_elements[elementIndex].m_firstChildOffset = childIndex;
+			}
+			else
+			{
+				m_elements[previousChildIndex].m_nextSiblingOffset = childIndex;
+			}
+			previousChildIndex = childIndex;
+		}
+		return elementIndex;
+	}
+
+	void AddAttribute(XmlAttribute const& attribute)
+	{
+		CompiledXmlAttribute compiled;
+		std::string_view value(attribute.Value());
+		compiled.m_nameOffset = AddString(attribute.Name());
+		compiled.m_valueOffset = AddString(attribute.Value());
+		compiled.m_valueLength = static_cast<int32_t>(value.size());
+		compiled.m_componentDelimiter = value.find('~') != std::string_view::npos ? '~' : ',';
+		compiled.m_boolValue = attribute.BoolValue() ? 1 : 0;
+
+		std::string_view components[CompiledXmlAttribute::MAX_COMPONENTS];
+		compiled.m_numComponents = SplitStringViewOnDelimiter(value, compiled.m_componentDelimiter, components, CompiledXmlAttribute::MAX_COMPONENTS);
+		for (int componentIndex = 0; componentIndex < compiled.m_numComponents && componentIndex < CompiledXmlAttribute::MAX_COMPONENTS; componentIndex++)
+		{
+			compiled.m_floatComponents[componentIndex] = ParseFloat(components[componentIndex]);
+			compiled.m_intComponents[componentIndex] = ParseInt(components[componentIndex]);
+		}
+		m_attributes.push_back(compiled);
+	}
+
+	void Finalize(std::vector<uint8_t>& out_blob, uint64_t sourceHash)
+	{
+		int elementsStart = static_cast<int>(sizeof(CompiledXmlHeader));
+		int attributesStart = elementsStart + static_cast<int>(m_elements.size() * sizeof(CompiledXmlElement));
+		int stringsStart = attributesStart + static_cast<int>(m_attributes.size() * sizeof(CompiledXmlAttribute));
+
+		for (int elementIndex = 0; elementIndex < static_cast<int>(m_elements.size()); elementIndex++)
+		{
+			CompiledXmlElement& element = m_elements[elementIndex];
+			int elementPosition = elementsStart + elementIndex * static_cast<int>(sizeof(CompiledXmlElement));
+			element.m_nameOffset = stringsStart + element.m_nameOffset - elementPosition;
+			element.m_textOffset = element.m_textOffset >= 0 ? stringsStart + element.m_textOffset - elementPosition : 0;
+			element.m_attributesOffset = element.m_numAttributes > 0 ? attributesStart + element.m_attributesOffset * static_cast<int>(sizeof(CompiledXmlAttribute)) - elementPosition : 0;
+			element.m_firstChildOffset = element.m_firstChildOffset >= 0 ? (element.m_firstChildOffset - elementIndex) * static_cast<int>(sizeof(CompiledXmlElement)) : 0;
+			element.m_nextSiblingOffset = element.m_nextSiblingOffset >= 0 ? (element.m_nextSiblingOffset - elementIndex) * static_cast<int>(sizeof(CompiledXmlElement)) : 0;
+		}
+		for (int attributeIndex = 0; attributeIndex < static_cast<int>(m_attributes.size()); attributeIndex++)
+		{
+			CompiledXmlAttribute& attribute = m_attributes[attributeIndex];
+			int attributePosition = attributesStart + attributeIndex * static_cast<int>(sizeof(CompiledXmlAttribute));
+			attribute.m_nameOffset = stringsStart + attribute.m_nameOffset - attributePosition;
+			attribute.m_valueOffset = stringsStart + attribute.m_valueOffset - attributePosition;
+		}
+
+		CompiledXmlHeader header;
+		header.m_sourceHash = sourceHash;
+		header.m_blobSize = static_cast<uint32_t>(stringsStart + m_strings.size());
+		header.m_numElements = static_cast<int32_t>(m_elements.size());
+		header.m_numAttributes = static_cast<int32_t>(m_attributes.size());
+		header.m_stringPoolSize = static_cast<uint32_t>(m_strings.size());
+
+		out_blob.resize(header.m_blobSize);
+		memcpy(out_blob.data(), &header, sizeof(header));
+		memcpy(out_blob.data() + elementsStart, m_elements.data(), m_elements.size() * sizeof(CompiledXmlElement));
+		memcpy(out_blob.data() + attributesStart, m_attributes.data(), m_attributes.size() * sizeof(CompiledXmlAttribute));
+		memcpy(out_blob.data() + stringsStart, m_strings.data(), m_strings.size());
+	}
+
+	std::vector<CompiledXmlElement> m_elements;
+	std::vector<CompiledXmlAttribute> m_attributes;
+	std::string m_strings;
+};
+
+char const* CompiledXmlAttribute::Name() const
+{
+	return reinterpret_cast<char const*>(this) + m_nameOffset;
+}
+
+std::string_view CompiledXmlAttribute::Value() const
+{
+	return std::string_view(reinterpret_cast<char const*>(this) + m_valueOffset, static_cast<size_t>(m_valueLength));
+}
+
+void CompiledXmlAttribute::ReadValue(int& out_value) const
+{
+	out_value = m_intComponents[0];
+}
+
+void CompiledXmlAttribute::ReadValue(char& out_value) const
+{
+	out_value = static_cast<char>(m_intComponents[0]);
+}
+
+void CompiledXmlAttribute::ReadValue(bool& out_value) const
+{
+	out_value = m_boolValue != 0;
+}
+
+void CompiledXmlAttribute::ReadValue(float& out_value) const
+{
+	out_value = m_floatComponents[0];
+}
+
+void CompiledXmlAttribute::ReadValue(Rgba8& out_value) const
+{
+	if (m_componentDelimiter == ',' && (m_numComponents == 3 || m_numComponents == 4))
+	{
+		out_value.r = static_cast<unsigned char>(m_intComponents[0]);
+		out_value.g = static_cast<unsigned char>(m_intComponents[1]);
+		out_value.b = static_cast<unsigned char>(m_intComponents[2]);
+		out_value.a = m_numComponents == 4 ? static_cast<unsigned char>(m_intComponents[3]) : 255;
+	}
+	else
+	{
+		out_value.SetFromText(Value());
+	}
+}
+
+void CompiledXmlAttribute::ReadValue(Vec2& out_value) const
+{
+	if (m_componentDelimiter == ',' && m_numComponents == 2)
+	{
+		out_value = Vec2(m_floatComponents[0], m_floatComponents[1]);
+	}
+	else
+	{
+		out_value.SetFromText(Value());
+	}
+}
+
+void CompiledXmlAttribute::ReadValue(Vec3& out_value) const
+{
+	if (m_componentDelimiter == ',' && m_numComponents == 3)
+	{
+		out_value = Vec3(m_floatComponents[0], m_floatComponents[1], m_floatComponents[2]);
+	}
+	else
+	{
+		out_value.SetFromText(Value());
+	}
+}
+
+void CompiledXmlAttribute::ReadValue(EulerAngles& out_value) const
+{
+	if (m_componentDelimiter == ',' && m_numComponents == 3)
+	{
+		out_value = EulerAngles(m_floatComponents[0], m_floatComponents[1], m_floatComponents[2]);
+	}
+	else
+	{
+		out_value.SetFromText(Value());
+	}
+}
+
+void CompiledXmlAttribute::ReadValue(FloatRange& out_value) const
+{
+	if (m_componentDelimiter == '~' && m_numComponents == 2)
+	{
+		out_value = FloatRange(m_floatComponents[0], m_floatComponents[1]);
+	}
+	else
+	{
+		out_value.SetFromText(Value());
+	}
+}
+
+void CompiledXmlAttribute::ReadValue(IntVec2& out_value) const
+{
+	if (m_componentDelimiter == ',' && m_numComponents == 2)
+	{
+		out_value = IntVec2(m_intComponents[0], m_intComponents[1]);
+	}
+	else
+	{
+		out_value.SetFromText(Value());
+	}
+}
+
+void CompiledXmlAttribute::ReadValue(std::string& out_value) const
+{
+	out_value.assign(Value());
+}
+
+void CompiledXmlAttribute::ReadValue(Strings& out_value) const
+{
+	out_value = SplitStringOnDelimiter(Value(), ',');
+}
+
+char const* CompiledXmlElement::Name() const
+{
+	return reinterpret_cast<char const*>(this) + m_nameOffset;
+}
+
+char const* CompiledXmlElement::GetText() const
+{
+	return m_textOffset != 0 ? reinterpret_cast<char const*>(this) + m_textOffset : nullptr;
+}
+
+CompiledXmlAttribute const* CompiledXmlElement::GetAttribute(int attributeIndex) const
+{
+	if (attributeIndex < 0 || attributeIndex >= m_numAttributes)
+	{
+		return nullptr;
+	}
+	CompiledXmlAttribute const* attributes = reinterpret_cast<CompiledXmlAttribute const*>(reinterpret_cast<char const*>(this) + m_attributesOffset);
+	return &attributes[attributeIndex];
+}
+
+CompiledXmlAttribute const* CompiledXmlElement::FindAttribute(char const* attributeName) const
+{
+	if (m_numAttributes == 0)
+	{
+		return nullptr;
+	}
+	CompiledXmlAttribute const* attributes = reinterpret_cast<CompiledXmlAttribute const*>(reinterpret_cast<char const*>(this) + m_attributesOffset);
+	for (int attributeIndex = 0; attributeIndex < m_numAttributes; attributeIndex++)
+	{
+		if (strcmp(attributes[attributeIndex].Name(), attributeName) == 0)
+		{
+			return &attributes[attributeIndex];
+		}
+	}
+	return nullptr;
+}
+
+CompiledXmlElement const* CompiledXmlElement::FirstChildElement(char const* elementName) const
+{
+	if (m_firstChildOffset == 0)
+	{
+		return nullptr;
+	}
+	CompiledXmlElement const* child = reinterpret_cast<CompiledXmlElement const*>(reinterpret_cast<char const*>(this) + m_firstChildOffset);
+	if (elementName == nullptr || strcmp(child->Name(), elementName) == 0)
+	{
+		return child;
+	}
+	return child->NextSiblingElement(elementName);
+}
+
+CompiledXmlElement const* CompiledXmlElement::NextSiblingElement(char const* elementName) const
+{
+	CompiledXmlElement const* sibling = this;
+	while (sibling->m_nextSiblingOffset != 0)
+	{
+		sibling = reinterpret_cast<CompiledXmlElement const*>(reinterpret_cast<char const*>(sibling) + sibling->m_nextSiblingOffset);
+		if (elementName == nullptr || strcmp(sibling->Name(), elementName) == 0)
+		{
+			return sibling;
+		}
+	}
+	return nullptr;
+}
+
+bool CompiledXmlDocument::LoadFile(std::string const& xmlFilePath, char const* cacheFolderPath)
+{
+	Clear();
+	MappedFile source(xmlFilePath);
+	if (!source.IsOpen())
+	{
+		return false;
+	}
+	uint64_t sourceHash = HashSourceBytes(source.GetData(), source.GetSize());
+
+	std::string cacheFilePath;
+	if (cacheFolderPath != nullptr)
+	{
+		cacheFilePath = GetCacheFilePath(xmlFilePath, cacheFolderPath);
+		if (m_cacheFile.Open(cacheFilePath))
+		{
+			if (AdoptCacheBlob(sourceHash))
+			{
+				m_wasLoadedFromCache = true;
+				return true;
+			}
+		}
+	}
+
+	if (!CompileFromText(reinterpret_cast<char const*>(source.GetData()), source.GetSize(), sourceHash))
+	{
+		return false;
+	}
+
+	if (cacheFolderPath != nullptr)
+	{
+		std::error_code ignoredError;
+		std::filesystem::create_directories(cacheFolderPath, ignoredError);
+		if (FileWriteFromBuffer(m_blob, cacheFilePath) != static_cast<int>(m_blob.size()))
+		{
+			DebuggerPrintf("Could not write XML cache file %s\n", cacheFilePath.c_str());
+		}
+	}
+	return true;
+}
+
+bool CompiledXmlDocument::Parse(char const* xmlText, size_t xmlTextLength)
+{
+	Clear();
+	return CompileFromText(xmlText, xmlTextLength, HashSourceBytes(reinterpret_cast<uint8_t const*>(xmlText), xmlTextLength));
+}
+
+void CompiledXmlDocument::Clear()
+{
+	m_cacheFile.Close();
+	m_blob.clear();
+	m_blobData = nullptr;
+	m_blobSize = 0;
+	m_wasLoadedFromCache = false;
+}
+
+CompiledXmlElement const* CompiledXmlDocument::RootElement() const
+{
+	if (m_blobSize == 0 || reinterpret_cast<CompiledXmlHeader const*>(m_blobData)->m_numElements == 0)
+	{
+		return nullptr;
+	}
+	return reinterpret_cast<CompiledXmlElement const*>(m_blobData + sizeof(CompiledXmlHeader));
+}
+
+std::string CompiledXmlDocument::GetCacheFilePath(std::string const& xmlFilePath, char const* cacheFolderPath)
+{
+	size_t lastSlash = xmlFilePath.find_last_of("/\\");
+	std::string fileName = lastSlash == std::string::npos ? xmlFilePath : xmlFilePath.substr(lastSlash + 1);
+	uint64_t pathHash = HashSourceBytes(reinterpret_cast<uint8_t const*>(xmlFilePath.data()), xmlFilePath.size());
+	return Stringf("%s/%s.%016llx.xmlc", cacheFolderPath, fileName.c_str(), static_cast<unsigned long long>(pathHash));
+}
+
+bool CompiledXmlDocument::CompileFromText(char const* xmlText, size_t xmlTextLength, uint64_t sourceHash)
+{
+	XmlDocument document;
+	if (document.Parse(xmlText, xmlTextLength) != tinyxml2::XML_SUCCESS)
+	{
+		return false;
+	}
+
+	CompiledXmlBuilder builder;
+	int previousIndex = -1;
+	for (XmlElement const* element = document.FirstChildElement(); element; element = element->NextSiblingElement())
+	{
+		int elementIndex = builder.AddElement(*element);
+		if (previousIndex >= 0)
+		{
+			builder.m_elements[previousIndex].m_nextSiblingOffset = elementIndex;
+		}
+		previousIndex = elementIndex;
+	}
+	builder.Finalize(m_blob, sourceHash);
+	m_blobData = m_blob.data();
+	m_blobSize = m_blob.size();
+	return true;
+}
+
+//Checks everything that can be checked without walking the records; a mismatch just means recompiling. The records are
+//used straight from m_cacheFile's view, so a valid cache is never copied.
+bool CompiledXmlDocument::AdoptCacheBlob(uint64_t sourceHash)
+{
+	CompiledXmlHeader header;
+	uint8_t const* cacheData = m_cacheFile.GetData();
+	size_t cacheSize = m_cacheFile.GetSize();
+	if (cacheSize < sizeof(header))
+	{
+		m_cacheFile.Close();
+		return false;
+	}
+	memcpy(&header, cacheData, sizeof(header));
+
+	size_t expectedSize = sizeof(header) + static_cast<size_t>(header.m_numElements) * sizeof(CompiledXmlElement)
+		+ static_cast<size_t>(header.m_numAttributes) * sizeof(CompiledXmlAttribute) + header.m_stringPoolSize;
+	bool isValid = header.m_magic == COMPILED_XML_MAGIC && header.m_version == COMPILED_XML_VERSION && header.m_sourceHash == sourceHash
+		&& header.m_numElements >= 0 && header.m_numAttributes >= 0 && header.m_blobSize == cacheSize && expectedSize == cacheSize
+		&& (header.m_stringPoolSize == 0 || cacheData[cacheSize - 1] == '\0');
+	if (!isValid)
+	{
+		m_cacheFile.Close(); //Releases the file so the recompiled cache can overwrite it
+		return false;
+	}
+	m_blobData = cacheData;
+	m_blobSize = cacheSize;
+	return true;
+}
+
+int ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, int defaultValue)
+{
+	CompiledXmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	int var;
+	attribute->ReadValue(var);
+	return var;
+}
+
+char ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, char defaultValue)
+{
+	CompiledXmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	char var;
+	attribute->ReadValue(var);
+	return var;
+}
+
+bool ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, bool defaultValue)
+{
+	CompiledXmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	bool var;
+	attribute->ReadValue(var);
+	return var;
+}
+
+float ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, float defaultValue)
+{
+	CompiledXmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	float var;
+	attribute->ReadValue(var);
+	return var;
+}
+
+Rgba8 ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, Rgba8 const& defaultValue)
+{
+	CompiledXmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	Rgba8 var;
+	attribute->ReadValue(var);
+	return var;
+}
+
+Vec2 ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, Vec2 const& defaultValue)
+{
+	CompiledXmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	Vec2 var;
+	attribute->ReadValue(var);
+	return var;
+}
+
+Vec3 ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, Vec3 const& defaultValue)
+{
+	CompiledXmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	Vec3 var;
+	attribute->ReadValue(var);
+	return var;
+}
+
+EulerAngles ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, EulerAngles const& defaultValue)
+{
+	CompiledXmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	EulerAngles var;
+	attribute->ReadValue(var);
+	return var;
+}
+
+FloatRange ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, FloatRange const& defaultValue)
+{
+	CompiledXmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	FloatRange var;
+	attribute->ReadValue(var);
+	return var;
+}
+
+IntVec2 ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, IntVec2 const& defaultValue)
+{
+	CompiledXmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	IntVec2 var;
+	attribute->ReadValue(var);
+	return var;
+}
+
+std::string ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, std::string const& defaultValue)
+{
+	CompiledXmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	std::string var;
+	attribute->ReadValue(var);
+	return var;
+}
+
+std::string ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, char const* defaultValue)
+{
+	CompiledXmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	std::string var;
+	attribute->ReadValue(var);
+	return var;
+}
+
+Strings ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, Strings const& defaultValue)
+{
+	CompiledXmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	Strings var;
+	attribute->ReadValue(var);
+	return var;
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//Read-only XML tree flattened into one contiguous blob: elements in document order, then attributes, then a pool of
+//null-terminated strings. Every offset is relative to the record holding it, so records are used in place straight from
+//the loaded bytes and navigation mirrors TinyXML2 (RootElement, FirstChildElement, NextSiblingElement, FindAttribute).
+//Offsets of 0 mean "none", since nothing refers to itself.
+
+//Attribute values are pre-split on '~' if they contain one, otherwise on ',', and the first four components are stored
+//already converted, so ReadValue and the typed ParseXmlAttribute overloads below do no string parsing for the usual single values,
+//vectors, colors and ranges. Anything else falls back to the same text parsing as the XmlElement overloads.
+struct CompiledXmlAttribute
+{
+public:
+	char const*			Name() const;
+	std::string_view	Value() const;
+
+	int					GetNumComponents() const { return m_numComponents; }
+	char				GetComponentDelimiter() const { return m_componentDelimiter; }
+	float				GetFloatComponent(int componentIndex) const { return m_floatComponents[componentIndex]; }
+	int					GetIntComponent(int componentIndex) const { return m_intComponents[componentIndex]; }
+	bool				GetBoolValue() const { return m_boolValue != 0; }
+
+	//Same results as the matching ParseXmlAttribute overload on an XmlElement
+	void				ReadValue(int& out_value) const;
+	void				ReadValue(char& out_value) const;
+	void				ReadValue(bool& out_value) const;
+	void				ReadValue(float& out_value) const;
+	void				ReadValue(Rgba8& out_value) const;
+	void				ReadValue(Vec2& out_value) const;
+	void				ReadValue(Vec3& out_value) const;
+	void				ReadValue(EulerAngles& out_value) const;
+	void				ReadValue(FloatRange& out_value) const;
+	void				ReadValue(IntVec2& out_value) const;
+	void				ReadValue(std::string& out_value) const;
+	void				ReadValue(Strings& out_value) const;
+
+public:
+	static constexpr int MAX_COMPONENTS = 4;
+
+	int32_t			m_nameOffset = 0;
+	int32_t			m_valueOffset = 0;
+	int32_t			m_valueLength = 0;
+	float			m_floatComponents[MAX_COMPONENTS] = {};
+	int32_t			m_intComponents[MAX_COMPONENTS] = {};
+	int32_t			m_numComponents = 0; //Full count, which may exceed MAX_COMPONENTS
+	char			m_componentDelimiter = ',';
+	unsigned char	m_boolValue = 0; //As XMLAttribute::BoolValue would return it
+	unsigned char	m_padding[2] = {};
+};
+
+struct CompiledXmlElement
+{
+public:
+	char const*					Name() const;
+	char const*					GetText() const; //nullptr if the element has no text
+	int							GetNumAttributes() const { return m_numAttributes; }
+	CompiledXmlAttribute const*	GetAttribute(int attributeIndex) const;
+	CompiledXmlAttribute const*	FindAttribute(char const* attributeName) const;
+	CompiledXmlElement const*	FirstChildElement(char const* elementName = nullptr) const;
+	CompiledXmlElement const*	NextSiblingElement(char const* elementName = nullptr) const;
+
+public:
+	int32_t m_nameOffset = 0;
+	int32_t m_textOffset = 0;
+	int32_t m_attributesOffset = 0;
+	int32_t m_numAttributes = 0;
+	int32_t m_firstChildOffset = 0;
+	int32_t m_nextSiblingOffset = 0;
+};
+
+//Loads an XML file through a binary cache. The cache file is named after the source path and stores a hash of the source
+//bytes; when the hash still matches, the cache file is mapped and used in place and the XML is never parsed. Otherwise the
+//XML is parsed once with TinyXML2, compiled, and the cache rewritten, so edits to the source invalidate it automatically.
+class CompiledXmlDocument
+{
+public:
+	CompiledXmlDocument() = default;
+	~CompiledXmlDocument() = default;
+
+	//Returns false if the XML file is missing or malformed. Pass a null cacheFolderPath to compile without caching.
+	bool						LoadFile(std::string const& xmlFilePath, char const* cacheFolderPath = "Data/Cache");
+	bool						Parse(char const* xmlText, size_t xmlTextLength);
+	void						Clear();
+
+	CompiledXmlElement const*	RootElement() const;
+	bool						WasLoadedFromCache() const { return m_wasLoadedFromCache; }
+	size_t						GetBlobSize() const { return m_blobSize; }
+
+	static std::string			GetCacheFilePath(std::string const& xmlFilePath, char const* cacheFolderPath);
+
+protected:
+	bool						CompileFromText(char const* xmlText, size_t xmlTextLength, uint64_t sourceHash);
+	bool						AdoptCacheBlob(uint64_t sourceHash);
+
+protected:
+	MappedFile m_cacheFile; //Holds the blob when it came from the cache
+	std::vector<uint8_t> m_blob; //Holds the blob when it was compiled here
+	uint8_t const* m_blobData = nullptr;
+	size_t m_blobSize = 0;
+	bool m_wasLoadedFromCache = false;
+};
+
+int			ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, int defaultValue);
+char		ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, char defaultValue);
+bool		ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, bool defaultValue);
+float		ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, float defaultValue);
+Rgba8		ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, Rgba8 const& defaultValue);
+Vec2		ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, Vec2 const& defaultValue);
+Vec3		ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, Vec3 const& defaultValue);
+EulerAngles ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, EulerAngles const& defaultValue);
+FloatRange	ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, FloatRange const& defaultValue);
+IntVec2		ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, IntVec2 const& defaultValue);
+std::string	ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, std::string const& defaultValue);
+std::string ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, char const* defaultValue);
+Strings		ParseXmlAttribute(CompiledXmlElement const& element, char const* attributename, Strings const& defaultValue);
@@ -3,10 +3,13 @@
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/VertexUtils.hpp"
+#include "Engine/Math/MeshCache.hpp"
 #include "Engine/Core/Timer.hpp"
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/Texture.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
 #include "Game/App.hpp"
 #include "Game/Game.hpp"
 #include <vector>
@@ -15,6 +18,14 @@ extern Clock* g_theSystemClock;
 extern EventSystem* g_theEventSystem;
 extern App* g_theApp;
 
+//One GPU copy of a cached unit shape, shared by every debug object of that shape and placed by the object's transform
+struct DebugSharedMesh
+{
+	VertexBuffer* m_vertexBuffer = nullptr;
+	IndexBuffer* m_indexBuffer = nullptr;
+	unsigned int m_numIndexes = 0;
+};
+
 struct DebugWorldObject
 {
 	Texture* m_texture;
@@ -34,6 +45,7 @@ struct DebugWorldObject
 	bool m_isText = false;
 	bool m_isWireFrame = false;
 	std::vector<Vertex_PCU> m_vertexes;
+	DebugSharedMesh const* m_sharedMesh = nullptr; //Drawn instead of m_vertexes when set
 };
 
 struct DebugScreenObject
@@ -77,6 +89,27 @@ static DebugRenderConfig s_config;
 static bool s_visible = true;
 static BitmapFont* s_debugRenderFont;
 static Camera s_billboardTargetCam;
+static MeshCache s_meshCache;
+static DebugSharedMesh s_sharedMeshes[(int)MeshShape::COUNT];
+
+static DebugSharedMesh const* GetOrCreateSharedMesh(MeshShape shape)
+{
+	DebugSharedMesh& shared = s_sharedMeshes[(int)shape];
+	if (shared.m_vertexBuffer == nullptr)
+	{
+		MeshCacheKey key;
+		key.m_shape = shape;
+		//Copied to the GPU straight away, so later cache evictions cannot touch it
+		CachedMesh const& mesh = s_meshCache.GetOrCreateMesh(key);
+		unsigned int numVertexes = static_cast<unsigned int>(mesh.m_vertexes.size());
+		shared.m_numIndexes = static_cast<unsigned int>(mesh.m_indexes.size());
+		shared.m_vertexBuffer = s_config.m_renderer->CreateVertexBuffer(numVertexes, sizeof(Vertex_PCU));
+		s_config.m_renderer->CopyCPUToGPU(mesh.m_vertexes.data(), numVertexes, shared.m_vertexBuffer);
+		shared.m_indexBuffer = s_config.m_renderer->CreateIndexBuffer(shared.m_numIndexes);
+		s_config.m_renderer->CopyCPUToGPU(mesh.m_indexes.data(), shared.m_numIndexes, shared.m_indexBuffer);
+	}
+	return &shared;
+}
 
 void DebugRenderSystemStartup(const DebugRenderConfig& config)
 {
@@ -96,6 +129,13 @@ void DebugRenderSystemShutdown()
 	s_debugClock = nullptr;
 
 	DebugRenderClear();
+	for (int shapeIndex = 0; shapeIndex < (int)MeshShape::COUNT; shapeIndex++)
+	{
+		delete s_sharedMeshes[shapeIndex].m_vertexBuffer;
+		delete s_sharedMeshes[shapeIndex].m_indexBuffer;
+		s_sharedMeshes[shapeIndex] = DebugSharedMesh();
+	}
+	s_meshCache.Clear();
 
 	UnsubscribeEventCallbackFunction("debug_clear", Command_DebugRenderClear);
 	UnsubscribeEventCallbackFunction("debug_toggle", Command_DebugRenderToggle);
@@ -214,6 +254,18 @@ void DebugRenderBeginFrame()
 	}
 }
 
+static void DrawDebugWorldObject(DebugWorldObject const* object)
+{
+	if (object->m_sharedMesh != nullptr)
+	{
+		s_config.m_renderer->DrawIndexBuffer(object->m_sharedMesh->m_vertexBuffer, object->m_sharedMesh->m_indexBuffer, object->m_sharedMesh->m_numIndexes);
+	}
+	else
+	{
+		s_config.m_renderer->DrawVertexArray(object->m_vertexes);
+	}
+}
+
 void DebugRenderWorld(const Camera& camera)
 {
 	s_config.m_renderer->BeginCamera(camera);
@@ -243,6 +295,12 @@ void DebugRenderWorld(const Camera& camera)
 					s_config.m_renderer->SetBlendMode(BlendMode::ALPHA);
 					s_config.m_renderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_BACK);
 					s_config.m_renderer->SetDepthMode(DepthMode::READ_ONLY_ALWAYS);
+					if (s_debugWorldObjects[entIndex]->m_sharedMesh != nullptr)
+					{
+						Rgba8 xRayColor = s_debugWorldObjects[entIndex]->m_color;
+						xRayColor.a = DenormalizeByte(NormalizeByte(xRayColor.a) * 0.5f);
+						s_config.m_renderer->SetModelConstants(s_debugWorldObjects[entIndex]->m_transform, xRayColor);
+					}
 					for (int i = 0; i < s_debugWorldObjects[entIndex]->m_vertexes.size(); i++)
 					{
 						unsigned char a = DenormalizeByte(NormalizeByte(s_debugWorldObjects[entIndex]->m_vertexes[i].m_color.a) * 0.5f);
@@ -267,12 +325,13 @@ void DebugRenderWorld(const Camera& camera)
 				}
 				s_config.m_renderer->BindShader(nullptr);
 				s_config.m_renderer->SetStatesIfChanged();
-				s_config.m_renderer->DrawVertexArray(s_debugWorldObjects[entIndex]->m_vertexes);
+				DrawDebugWorldObject(s_debugWorldObjects[entIndex]);
 
 				if (s_debugWorldObjects[entIndex]->m_debugRenderMode == DebugRenderMode::X_RAY)
 				{
 					s_config.m_renderer->SetBlendMode(BlendMode::OPAQUE);
 					s_config.m_renderer->SetDepthMode(DepthMode::READ_WRITE_LESS_EQUAL);
+					s_config.m_renderer->SetModelConstants(s_debugWorldObjects[entIndex]->m_transform, s_debugWorldObjects[entIndex]->m_color);
 					s_config.m_renderer->SetStatesIfChanged();
 					for (int i = 0; i < s_debugWorldObjects[entIndex]->m_vertexes.size(); i++)
 					{
@@ -283,7 +342,7 @@ void DebugRenderWorld(const Camera& camera)
 							s_debugWorldObjects[entIndex]->m_vertexes[i].m_color.b,
 							a);
 					}
-					s_config.m_renderer->DrawVertexArray(s_debugWorldObjects[entIndex]->m_vertexes);
+					DrawDebugWorldObject(s_debugWorldObjects[entIndex]);
 				}
 			}
 		}
@@ -349,7 +408,7 @@ void DebugRenderEndFrame()
 void DebugAddWorldSphere(const Vec3& center, float radius, float duration, const Rgba8& startColor, const Rgba8& endColor, DebugRenderMode mode)
 {
 	DebugWorldObject* sphere = new DebugWorldObject;
-	AddVertsForSphere(sphere->m_vertexes, Vec3(), radius, startColor);
+	sphere->m_sharedMesh = GetOrCreateSharedMesh(MeshShape::SPHERE);
 	if (duration >= 0)
 	{
 		sphere->m_timer = new Timer(duration, s_debugClock);
@@ -357,10 +416,10 @@ void DebugAddWorldSphere(const Vec3& center, float radius, float duration, const
 	}
 
 	sphere->m_duration = duration;
-	Mat44 translation = Mat44::MakeTranslation3D(center);
-	sphere->m_transform = translation;
+	sphere->m_transform = MeshCache::GetSphereTransform(center, radius);
 	sphere->m_texture = nullptr;
 	sphere->m_startColor = startColor;
+	sphere->m_color = startColor;
 	sphere->m_endColor = endColor;
 	sphere->m_debugRenderMode = mode;
 	s_debugWorldObjects.push_back(sphere);
@@ -369,7 +428,7 @@ void DebugAddWorldSphere(const Vec3& center, float radius, float duration, const
 void DebugAddWorldWireSphere(const Vec3& center, float radius, float duration, const Rgba8& startColor, const Rgba8& endColor, DebugRenderMode mode)
 {
 	DebugWorldObject* sphere = new DebugWorldObject;
-	AddVertsForSphere(sphere->m_vertexes, Vec3(), radius, startColor);
+	sphere->m_sharedMesh = GetOrCreateSharedMesh(MeshShape::SPHERE);
 	if (duration >= 0)
 	{
 		sphere->m_timer = new Timer(duration, s_debugClock);
@@ -377,10 +436,10 @@ void DebugAddWorldWireSphere(const Vec3& center, float radius, float duration, c
 	}
 
 	sphere->m_duration = duration;
-	Mat44 translation = Mat44::MakeTranslation3D(center);
-	sphere->m_transform = translation;
+	sphere->m_transform = MeshCache::GetSphereTransform(center, radius);
 	sphere->m_texture = nullptr;
 	sphere->m_startColor = startColor;
+	sphere->m_color = startColor;
 	sphere->m_endColor = endColor;
 	sphere->m_debugRenderMode = mode;
 	sphere->m_isWireFrame = true;
@@ -390,7 +449,7 @@ void DebugAddWorldWireSphere(const Vec3& center, float radius, float duration, c
 void DebugAddWorldCylinder(const Vec3& start, const Vec3& end, float radius, float duration, const Rgba8& startColor, const Rgba8& endColor, DebugRenderMode mode)
 {
 	DebugWorldObject* cylinder = new DebugWorldObject;
-	AddVertsForCylinder3D(cylinder->m_vertexes, start, end, radius, startColor);
+	cylinder->m_sharedMesh = GetOrCreateSharedMesh(MeshShape::CYLINDER);
 	if (duration >= 0)
 	{
 		cylinder->m_timer = new Timer(duration, s_debugClock);
@@ -398,10 +457,10 @@ void DebugAddWorldCylinder(const Vec3& start, const Vec3& end, float radius, flo
 	}
 
 	cylinder->m_duration = duration;
-	Mat44 translation = Mat44();
-	cylinder->m_transform = translation;
+	cylinder->m_transform = MeshCache::GetCylinderTransform(start, end, radius);
 	cylinder->m_texture = nullptr;
 	cylinder->m_startColor = startColor;
+	cylinder->m_color = startColor;
 	cylinder->m_endColor = endColor;
 	cylinder->m_debugRenderMode = mode;
 	s_debugWorldObjects.push_back(cylinder);
@@ -410,7 +469,7 @@ void DebugAddWorldCylinder(const Vec3& start, const Vec3& end, float radius, flo
 void DebugAddWorldWireCylinder(const Vec3& start, const Vec3& end, float radius, float duration, const Rgba8& startColor, const Rgba8& endColor, DebugRenderMode mode)
 {
 	DebugWorldObject* cylinder = new DebugWorldObject;
-	AddVertsForCylinder3D(cylinder->m_vertexes, start, end, radius, startColor);
+	cylinder->m_sharedMesh = GetOrCreateSharedMesh(MeshShape::CYLINDER);
 	if (duration >= 0)
 	{
 		cylinder->m_timer = new Timer(duration, s_debugClock);
@@ -418,10 +477,10 @@ void DebugAddWorldWireCylinder(const Vec3& start, const Vec3& end, float radius,
 	}
 
 	cylinder->m_duration = duration;
-	Mat44 translation = Mat44();
-	cylinder->m_transform = translation;
+	cylinder->m_transform = MeshCache::GetCylinderTransform(start, end, radius);
 	cylinder->m_texture = nullptr;
 	cylinder->m_startColor = startColor;
+	cylinder->m_color = startColor;
 	cylinder->m_endColor = endColor;
 	cylinder->m_debugRenderMode = mode;
 	cylinder->m_isWireFrame = true;
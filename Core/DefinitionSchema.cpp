@@ -0,0 +1,156 @@
+#include "Engine/Core/DefinitionSchema.hpp"
+#include <cstring>
+
+//32-bit FNV-1a over a null-terminated name
+static unsigned int HashAttributeName(char const* attributeName)
+{
+	unsigned int hash = 2166136261u;
+	for (char const* character = attributeName; *character != '\0'; character++)
+	{
+		hash ^= static_cast<unsigned char>(*character);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static void ParseFieldValue(char const* valueText, int& out_value)
+{
+	out_value = ParseInt(valueText);
+}
+
+static void ParseFieldValue(char const* valueText, bool& out_value)
+{
+	out_value = false;
+	tinyxml2::XMLUtil::ToBool(valueText, &out_value);
+}
+
+static void ParseFieldValue(char const* valueText, float& out_value)
+{
+	out_value = ParseFloat(valueText);
+}
+
+static void ParseFieldValue(char const* valueText, std::string& out_value)
+{
+	out_value = valueText;
+}
+
+static void ParseFieldValue(char const* valueText, Strings& out_value)
+{
+	out_value = SplitStringOnDelimiter(valueText, ',');
+}
+
+template<typename ValueType>
+static void ParseFieldValue(char const* valueText, ValueType& out_value)
+{
+	out_value.SetFromText(valueText);
+}
+
+void DefinitionSchemaFields::AddField(char const* attributeName, size_t memberOffset, DefinitionFieldValue const& defaultValue)
+{
+	GUARANTEE_OR_DIE(FindFieldIndex(attributeName) < 0, Stringf("Attribute \"%s\" is already in this definition schema", attributeName));
+
+	DefinitionField field;
+	field.m_attributeName = attributeName;
+	field.m_nameHash = HashAttributeName(attributeName);
+	field.m_memberOffset = memberOffset;
+	field.m_defaultValue = defaultValue;
+	m_fields.push_back(field);
+
+	int tableSize = 4;
+	while (tableSize < static_cast<int>(m_fields.size()) * 2)
+	{
+		tableSize *= 2;
+	}
+	m_fieldLookup.assign(static_cast<size_t>(tableSize), -1);
+	for (int fieldIndex = 0; fieldIndex < static_cast<int>(m_fields.size()); fieldIndex++)
+	{
+		int slotIndex = static_cast<int>(m_fields[fieldIndex].m_nameHash) & (tableSize - 1);
+		while (m_fieldLookup[slotIndex] >= 0)
+		{
+			slotIndex = (slotIndex + 1) & (tableSize - 1);
+		}
+		m_fieldLookup[slotIndex] = fieldIndex;
+	}
+}
+
+int DefinitionSchemaFields::FindFieldIndex(char const* attributeName) const
+{
+	if (m_fieldLookup.empty())
+	{
+		return -1;
+	}
+
+	unsigned int nameHash = HashAttributeName(attributeName);
+	int tableMask = static_cast<int>(m_fieldLookup.size()) - 1;
+	for (int slotIndex = static_cast<int>(nameHash) & tableMask; m_fieldLookup[slotIndex] >= 0; slotIndex = (slotIndex + 1) & tableMask)
+	{
+		DefinitionField const& field = m_fields[m_fieldLookup[slotIndex]];
+		if (field.m_nameHash == nameHash && strcmp(field.m_attributeName.c_str(), attributeName) == 0)
+		{
+			return m_fieldLookup[slotIndex];
+		}
+	}
+	return -1;
+}
+
+void DefinitionSchemaFields::ApplyDefaults(void* definition) const
+{
+	for (DefinitionField const& field : m_fields)
+	{
+		void* member = static_cast<char*>(definition) + field.m_memberOffset;
+		std::visit([member](auto const& defaultValue)
+			{
+				typedef std::decay_t<decltype(defaultValue)> MemberType;
+				*static_cast<MemberType*>(member) = defaultValue;
+			}, field.m_defaultValue);
+	}
+}
+
+void DefinitionSchemaFields::ApplyAttribute(void* definition, int fieldIndex, char const* valueText) const
+{
+	DefinitionField const& field = m_fields[fieldIndex];
+	void* member = static_cast<char*>(definition) + field.m_memberOffset;
+	std::visit([member, valueText](auto const& defaultValue)
+		{
+			typedef std::decay_t<decltype(defaultValue)> MemberType;
+			ParseFieldValue(valueText, *static_cast<MemberType*>(member));
+		}, field.m_defaultValue);
+}
+
+void DefinitionSchemaFields::ApplyAttribute(void* definition, int fieldIndex, CompiledXmlAttribute const& attribute) const
+{
+	DefinitionField const& field = m_fields[fieldIndex];
+	void* member = static_cast<char*>(definition) + field.m_memberOffset;
+	std::visit([member, &attribute](auto const& defaultValue)
+		{
+			typedef std::decay_t<decltype(defaultValue)> MemberType;
+			attribute.ReadValue(*static_cast<MemberType*>(member));
+		}, field.m_defaultValue);
+}
+
+void DefinitionSchemaFields::LoadFromElement(XmlElement const& element, void* definition) const
+{
+	ApplyDefaults(definition);
+	for (XmlAttribute const* attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+	{
+		int fieldIndex = FindFieldIndex(attribute->Name());
+		if (fieldIndex >= 0)
+		{
+			ApplyAttribute(definition, fieldIndex, attribute->Value());
+		}
+	}
+}
+
+void DefinitionSchemaFields::LoadFromElement(CompiledXmlElement const& element, void* definition) const
+{
+	ApplyDefaults(definition);
+	for (int attributeIndex = 0; attributeIndex < element.GetNumAttributes(); attributeIndex++)
+	{
+		CompiledXmlAttribute const* attribute = element.GetAttribute(attributeIndex);
+		int fieldIndex = FindFieldIndex(attribute->Name());
+		if (fieldIndex >= 0)
+		{
+			ApplyAttribute(definition, fieldIndex, *attribute);
+		}
+	}
+}
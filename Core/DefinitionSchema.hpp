@@ -0,0 +1,206 @@
+#pragma once
+#include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Core/CompiledXml.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+//The member types a schema field can have; the default value's alternative fixes the field's type
+typedef std::variant<int, bool, float, std::string, Rgba8, Vec2, Vec3, IntVec2, FloatRange, EulerAngles, Strings> DefinitionFieldValue;
+
+template<typename MemberType, typename Variant>
+struct IsDefinitionFieldAlternative;
+
+template<typename MemberType, typename... FieldTypes>
+struct IsDefinitionFieldAlternative<MemberType, std::variant<FieldTypes...>> : std::bool_constant<(std::is_same_v<MemberType, FieldTypes> || ...)> {};
+
+struct DefinitionField
+{
+	std::string				m_attributeName;
+	unsigned int			m_nameHash = 0;
+	size_t					m_memberOffset = 0;
+	DefinitionFieldValue	m_defaultValue;
+};
+
+//Untyped field table shared by every DefinitionSchema<T>: writes parsed attribute values straight to member offsets.
+//Attribute names are looked up through an open-addressing table of name hashes, so each element is read in one pass
+//over its attributes, whatever order they come in. Attributes that are not in the schema are ignored.
+class DefinitionSchemaFields
+{
+public:
+	void	AddField(char const* attributeName, size_t memberOffset, DefinitionFieldValue const& defaultValue);
+	int		FindFieldIndex(char const* attributeName) const; //-1 if the name is not in the schema
+	int		GetNumFields() const { return static_cast<int>(m_fields.size()); }
+
+	void	ApplyDefaults(void* definition) const;
+	void	ApplyAttribute(void* definition, int fieldIndex, char const* valueText) const; //valueText must be null terminated
+	void	ApplyAttribute(void* definition, int fieldIndex, CompiledXmlAttribute const& attribute) const; //Uses the pre-converted components
+	void	LoadFromElement(XmlElement const& element, void* definition) const;
+	void	LoadFromElement(CompiledXmlElement const& element, void* definition) const;
+
+protected:
+	std::vector<DefinitionField>	m_fields;
+	std::vector<int>				m_fieldLookup; //Power-of-two size, at most half full; -1 marks an empty slot
+};
+
+//Declarative description of a definition struct, built once and reused for every element:
+//
+//	DefinitionSchema<ActorDefinition> schema;
+//	schema.AddField("name", &ActorDefinition::m_name)
+//		.AddField("speed", &ActorDefinition::m_speed, 2.f)
+//		.AddField("tint", &ActorDefinition::m_tint, Rgba8::WHITE);
+//	schema.LoadDefinitionFiles(filePaths, "ActorDefinition", s_actorDefinitions);
+//
+//DefinitionType must be default constructible. A field with no explicit default keeps the value from a default-constructed
+//DefinitionType. Member types are limited to the DefinitionFieldValue alternatives, and values parse exactly as the
+//matching ParseXmlAttribute overload would.
+template<typename DefinitionType>
+class DefinitionSchema
+{
+public:
+	template<typename MemberType>
+	DefinitionSchema&	AddField(char const* attributeName, MemberType DefinitionType::* member, MemberType const& defaultValue);
+	template<typename MemberType>
+	DefinitionSchema&	AddField(char const* attributeName, MemberType DefinitionType::* member);
+
+	void				LoadDefinition(XmlElement const& element, DefinitionType& out_definition) const;
+	void				LoadDefinition(CompiledXmlElement const& element, DefinitionType& out_definition) const;
+
+	//Appends one definition per child element named childElementName (every child if null) and returns how many were added
+	template<typename ElementType>
+	int					LoadDefinitions(ElementType const& parentElement, char const* childElementName, std::vector<DefinitionType>& out_definitions) const;
+
+	//Loads the files in parallel (on g_theJobSystem if there is one) through CompiledXmlDocument, so repeat loads skip XML parsing,
+	//and appends their definitions in file order. Dies naming the file if one is missing or malformed. Pass a null cacheFolderPath
+	//to bypass the cache.
+	void				LoadDefinitionFiles(Strings const& xmlFilePaths, char const* childElementName, std::vector<DefinitionType>& out_definitions, char const* cacheFolderPath = "Data/Cache") const;
+
+	DefinitionSchemaFields const& GetFields() const { return m_fields; }
+
+protected:
+	DefinitionSchemaFields m_fields;
+};
+
+template<typename DefinitionType>
+template<typename MemberType>
+DefinitionSchema<DefinitionType>& DefinitionSchema<DefinitionType>::AddField(char const* attributeName, MemberType DefinitionType::* member, MemberType const& defaultValue)
+{
+	static_assert(IsDefinitionFieldAlternative<MemberType, DefinitionFieldValue>::value, "Schema members must be one of the DefinitionFieldValue types");
+	DefinitionType probe;
+	size_t memberOffset = static_cast<size_t>(reinterpret_cast<char const*>(&(probe.*member)) - reinterpret_cast<char const*>(&probe));
+	m_fields.AddField(attributeName, memberOffset, DefinitionFieldValue(std::in_place_type<MemberType>, defaultValue));
+	return *this;
+}
+
+template<typename DefinitionType>
+template<typename MemberType>
+DefinitionSchema<DefinitionType>& DefinitionSchema<DefinitionType>::AddField(char const* attributeName, MemberType DefinitionType::* member)
+{
+	DefinitionType probe;
+	return AddField(attributeName, member, probe.*member);
+}
+
+template<typename DefinitionType>
+void DefinitionSchema<DefinitionType>::LoadDefinition(XmlElement const& element, DefinitionType& out_definition) const
+{
+	m_fields.LoadFromElement(element, &out_definition);
+}
+
+template<typename DefinitionType>
+void DefinitionSchema<DefinitionType>::LoadDefinition(CompiledXmlElement const& element, DefinitionType& out_definition) const
+{
+	m_fields.LoadFromElement(element, &out_definition);
+}
+
+template<typename DefinitionType>
+template<typename ElementType>
+int DefinitionSchema<DefinitionType>::LoadDefinitions(ElementType const& parentElement, char const* childElementName, std::vector<DefinitionType>& out_definitions) const
+{
+	int numChildren = 0;
+	for (ElementType const* child = parentElement.FirstChildElement(childElementName); child; child = child->NextSiblingElement(childElementName))
+	{
+		numChildren++;
+	}
+
+	size_t firstNewIndex = out_definitions.size();
+	out_definitions.resize(firstNewIndex + static_cast<size_t>(numChildren));
+	DefinitionType* definition = out_definitions.data() + firstNewIndex;
+	for (ElementType const* child = parentElement.FirstChildElement(childElementName); child; child = child->NextSiblingElement(childElementName))
+	{
+		m_fields.LoadFromElement(*child, definition);
+		definition++;
+	}
+	return numChildren;
+}
+
+template<typename DefinitionType>
+void DefinitionSchema<DefinitionType>::LoadDefinitionFiles(Strings const& xmlFilePaths, char const* childElementName, std::vector<DefinitionType>& out_definitions, char const* cacheFolderPath) const
+{
+	int numFiles = static_cast<int>(xmlFilePaths.size());
+	std::vector<std::vector<DefinitionType>> definitionsPerFile(static_cast<size_t>(numFiles));
+	std::vector<unsigned char> didLoadFile(static_cast<size_t>(numFiles), 0);
+	std::atomic<int> nextFileIndex(0);
+
+	auto loadFile = [&](int fileIndex)
+	{
+		CompiledXmlDocument document;
+		if (document.LoadFile(xmlFilePaths[fileIndex], cacheFolderPath) && document.RootElement() != nullptr)
+		{
+			LoadDefinitions(*document.RootElement(), childElementName, definitionsPerFile[fileIndex]);
+			didLoadFile[fileIndex] = 1;
+		}
+	};
+
+	if (g_theJobSystem != nullptr)
+	{
+		g_theJobSystem->ParallelFor(0, numFiles, loadFile, 1);
+	}
+	else
+	{
+		auto loadFiles = [&]()
+		{
+			for (int fileIndex = nextFileIndex++; fileIndex < numFiles; fileIndex = nextFileIndex++)
+			{
+				loadFile(fileIndex);
+			}
+		};
+
+		int numWorkers = std::min(numFiles, static_cast<int>(std::thread::hardware_concurrency())) - 1;
+		std::vector<std::thread> workers;
+		for (int workerIndex = 0; workerIndex < numWorkers; workerIndex++)
+		{
+			workers.emplace_back(loadFiles);
+		}
+		loadFiles();
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	size_t numDefinitions = out_definitions.size();
+	for (int fileIndex = 0; fileIndex < numFiles; fileIndex++)
+	{
+		GUARANTEE_OR_DIE(didLoadFile[fileIndex] != 0, Stringf("Could not load definition file \"%s\"", xmlFilePaths[fileIndex].c_str()));
+		numDefinitions += definitionsPerFile[fileIndex].size();
+	}
+	out_definitions.reserve(numDefinitions);
+	for (std::vector<DefinitionType>& fileDefinitions : definitionsPerFile)
+	{
+		std::move(fileDefinitions.begin(), fileDefinitions.end(), std::back_inserter(out_definitions));
+	}
+}
@@ -64,17 +64,18 @@ void DevConsole::EndFrame()
 
 void DevConsole::Execute(std::string const& consoleCommandText, bool echoCommand)
 {
-	Strings command = SplitStringOnDelimiter(consoleCommandText, ' ');
+	StringTokenizer commandTokens(consoleCommandText, ' ');
+	std::string_view commandName;
 	EventArgs args;
 	bool isValidCommand = false;
 
-	if (command.empty())
+	if (!commandTokens.GetNextToken(commandName))
 	{
 		return;
 	}
 	for (int i = 0; i < static_cast<int>(m_registeredCommands.size()); i++)
 	{
-		if (m_registeredCommands[i] == command[0])
+		if (m_registeredCommands[i] == commandName)
 		{
 			isValidCommand = true;
 			break;
@@ -82,7 +83,7 @@ void DevConsole::Execute(std::string const& consoleCommandText, bool echoCommand
 	}
 	if (!isValidCommand)
 	{
-		AddText(ERROR, "Unrecognized command: " + command[0]);
+		AddText(ERROR, "Unrecognized command: " + std::string(commandName));
 		return;
 	}
 
@@ -90,15 +91,16 @@ void DevConsole::Execute(std::string const& consoleCommandText, bool echoCommand
 	{
 		AddText(INFO_MAJOR, consoleCommandText);
 	}
-	for (int argIndex = 1; argIndex < command.size(); argIndex++)
+	std::string_view argToken;
+	while (commandTokens.GetNextToken(argToken))
 	{
-		Strings argPair = SplitStringOnDelimiter(command[argIndex], '=');
-		if (argPair.size() >= 2)
+		std::string_view argPair[2];
+		if (SplitStringViewOnDelimiter(argToken, '=', argPair, 2) >= 2)
 		{
-			args.SetValue(argPair[0], argPair[1]);
+			args.SetValue(std::string(argPair[0]), std::string(argPair[1]));
 		}
 	}
-	FireEvent(command[0], args);
+	FireEvent(std::string(commandName), args);
 
 	m_commandHistory.push_back(consoleCommandText);
 }
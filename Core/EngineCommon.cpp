@@ -16,5 +16,7 @@ EventSystem* g_theEventSystem = new EventSystem(config);
 
 DevConsole* g_theDevConsole = nullptr;
 InputSystem* g_theInputSystem = nullptr;
+AsyncFileLoader* g_theAsyncFileLoader = nullptr;
+JobSystem* g_theJobSystem = nullptr;
 
 Clock* g_theSystemClock = new Clock();
\ No newline at end of file
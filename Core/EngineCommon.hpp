@@ -3,6 +3,11 @@
 
 #define UNUSED(x) (void)(x);
 
+//SIMD kernels are compiled wherever SSE2 is guaranteed. Define ENGINE_DISABLE_SIMD to force the scalar fallbacks.
+#if !defined(ENGINE_DISABLE_SIMD) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__))
+#define ENGINE_SIMD_SSE2
+#endif
+
 constexpr float G_SCREEN_SIZE_X = 1600.f;
 constexpr float G_SCREEN_SIZE_Y = 800.f;
 
@@ -20,9 +25,13 @@ class DevConsole;
 class EventSystem;
 class InputSystem;
 class Clock;
+class AsyncFileLoader;
+class JobSystem;
 
 extern NamedStrings* g_gameConfigBlackboard;
 extern DevConsole* g_theDevConsole;
 extern EventSystem* g_theEventSystem;
 extern InputSystem* g_theInputSystem;
-extern Clock* g_theSystemClock;
\ No newline at end of file
+extern Clock* g_theSystemClock;
+extern AsyncFileLoader* g_theAsyncFileLoader;
+extern JobSystem* g_theJobSystem;
\ No newline at end of file
@@ -0,0 +1,236 @@
+#pragma once
+#include "Engine/Core/InlineFunction.hpp"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+template<typename EventType>
+class EventChannelHandle;
+
+//Statically typed event channel; each payload struct gets its own subscriber list through template instantiation,
+//so publishing does no lookup, string formatting or parsing. Callbacks take the payload by reference and return true to consume it.
+//Main thread only. As in EventSystem, subscribing or unsubscribing during Publish takes effect once the outermost Publish returns.
+//
+//	struct DamageEvent { int m_targetID; float m_amount; };
+//	EventChannelHandle<DamageEvent> m_onDamage = EventChannel<DamageEvent>::Subscribe([this](DamageEvent const& damage) { ...; return false; });
+//	PublishEvent(DamageEvent{ targetID, 12.f });
+template<typename EventType>
+class EventChannel
+{
+public:
+	typedef InlineFunction<bool(EventType const&)> Callback;
+
+	static EventChannelHandle<EventType>	Subscribe(Callback callback);
+	static int								AddSubscription(Callback callback); //Unmanaged; returns the ID for RemoveSubscription
+	static void								RemoveSubscription(int subscriptionID);
+	static void								Publish(EventType const& event);
+	static int								GetNumSubscribers();
+
+protected:
+	struct Subscription
+	{
+		Callback	m_callback;
+		int			m_subscriptionID = -1; //-1 once removed, until compacted
+	};
+
+	static EventChannel&	GetChannel();
+	void					ApplyDeferredChanges();
+
+protected:
+	std::vector<Subscription> m_subscribers;
+	std::vector<Subscription> m_pendingSubscribers;
+	int m_nextSubscriptionID = 0;
+	int m_numRemovedSubscribers = 0;
+	int m_dispatchDepth = 0;
+};
+
+//Unsubscribes from EventChannel<EventType> when destroyed or overwritten. Move only.
+template<typename EventType>
+class EventChannelHandle
+{
+public:
+	EventChannelHandle() = default;
+	explicit EventChannelHandle(int subscriptionID);
+	EventChannelHandle(EventChannelHandle&& moveFrom) noexcept;
+	EventChannelHandle(EventChannelHandle const& copyFrom) = delete;
+	~EventChannelHandle();
+
+	EventChannelHandle& operator=(EventChannelHandle&& moveFrom) noexcept;
+	EventChannelHandle& operator=(EventChannelHandle const& copyFrom) = delete;
+
+	void	Unsubscribe();
+	bool	IsSubscribed() const;
+
+protected:
+	int m_subscriptionID = -1;
+};
+
+template<typename EventType>
+void PublishEvent(EventType const& event)
+{
+	EventChannel<EventType>::Publish(event);
+}
+
+template<typename EventType>
+EventChannelHandle<EventType> SubscribeEvent(typename EventChannel<EventType>::Callback callback)
+{
+	return EventChannel<EventType>::Subscribe(std::move(callback));
+}
+
+template<typename EventType>
+EventChannelHandle<EventType> EventChannel<EventType>::Subscribe(Callback callback)
+{
+	return EventChannelHandle<EventType>(AddSubscription(std::move(callback)));
+}
+
+template<typename EventType>
+int EventChannel<EventType>::AddSubscription(Callback callback)
+{
+	EventChannel& channel = GetChannel();
+	Subscription newSubscription;
+	newSubscription.m_callback = std::move(callback);
+	newSubscription.m_subscriptionID = channel.m_nextSubscriptionID++;
+
+	int subscriptionID = newSubscription.m_subscriptionID;
+	if (channel.m_dispatchDepth > 0)
+	{
+		channel.m_pendingSubscribers.push_back(std::move(newSubscription));
+	}
+	else
+	{
+		channel.m_subscribers.push_back(std::move(newSubscription));
+	}
+	return subscriptionID;
+}
+
+template<typename EventType>
+void EventChannel<EventType>::RemoveSubscription(int subscriptionID)
+{
+	EventChannel& channel = GetChannel();
+	for (Subscription& subscriber : channel.m_subscribers)
+	{
+		if (subscriber.m_subscriptionID == subscriptionID)
+		{
+			subscriber.m_subscriptionID = -1;
+			channel.m_numRemovedSubscribers++;
+			break;
+		}
+	}
+	for (Subscription& pending : channel.m_pendingSubscribers)
+	{
+		if (pending.m_subscriptionID == subscriptionID)
+		{
+			pending.m_subscriptionID = -1;
+		}
+	}
+
+	if (channel.m_dispatchDepth == 0)
+	{
+		channel.ApplyDeferredChanges();
+	}
+}
+
+template<typename EventType>
+void EventChannel<EventType>::Publish(EventType const& event)
+{
+	EventChannel& channel = GetChannel();
+	channel.m_dispatchDepth++;
+	Subscription* subscribers = channel.m_subscribers.data();
+	int numSubscribers = static_cast<int>(channel.m_subscribers.size());
+	for (int subscriberIndex = 0; subscriberIndex < numSubscribers; subscriberIndex++)
+	{
+		Subscription& subscriber = subscribers[subscriberIndex];
+		if (subscriber.m_subscriptionID >= 0 && subscriber.m_callback(event))
+		{
+			break;
+		}
+	}
+	channel.m_dispatchDepth--;
+
+	if (channel.m_dispatchDepth == 0 && (channel.m_numRemovedSubscribers > 0 || !channel.m_pendingSubscribers.empty()))
+	{
+		channel.ApplyDeferredChanges();
+	}
+}
+
+template<typename EventType>
+int EventChannel<EventType>::GetNumSubscribers()
+{
+	EventChannel& channel = GetChannel();
+	return static_cast<int>(channel.m_subscribers.size()) - channel.m_numRemovedSubscribers;
+}
+
+//Never destroyed, like the engine's other globals, so handles released during static destruction stay safe
+template<typename EventType>
+EventChannel<EventType>& EventChannel<EventType>::GetChannel()
+{
+	static EventChannel* s_channel = new EventChannel();
+	return *s_channel;
+}
+
+template<typename EventType>
+void EventChannel<EventType>::ApplyDeferredChanges()
+{
+	if (m_numRemovedSubscribers > 0)
+	{
+		m_subscribers.erase(std::remove_if(m_subscribers.begin(), m_subscribers.end(),
+			[](Subscription const& subscriber) { return subscriber.m_subscriptionID < 0; }), m_subscribers.end());
+		m_numRemovedSubscribers = 0;
+	}
+
+	for (Subscription& pending : m_pendingSubscribers)
+	{
+		if (pending.m_subscriptionID >= 0)
+		{
+			m_subscribers.push_back(std::move(pending));
+		}
+	}
+	m_pendingSubscribers.clear();
+}
+
+template<typename EventType>
+EventChannelHandle<EventType>::EventChannelHandle(int subscriptionID)
+	: m_subscriptionID(subscriptionID)
+{
+}
+
+template<typename EventType>
+EventChannelHandle<EventType>::EventChannelHandle(EventChannelHandle&& moveFrom) noexcept
+	: m_subscriptionID(moveFrom.m_subscriptionID)
+{
+	moveFrom.m_subscriptionID = -1;
+}
+
+template<typename EventType>
+EventChannelHandle<EventType>::~EventChannelHandle()
+{
+	Unsubscribe();
+}
+
+template<typename EventType>
+EventChannelHandle<EventType>& EventChannelHandle<EventType>::operator=(EventChannelHandle&& moveFrom) noexcept
+{
+	if (this != &moveFrom)
+	{
+		Unsubscribe();
+		m_subscriptionID = moveFrom.m_subscriptionID;
+		moveFrom.m_subscriptionID = -1;
+	}
+	return *this;
+}
+
+template<typename EventType>
+void EventChannelHandle<EventType>::Unsubscribe()
+{
+	if (m_subscriptionID >= 0)
+	{
+		EventChannel<EventType>::RemoveSubscription(m_subscriptionID);
+		m_subscriptionID = -1;
+	}
+}
+
+template<typename EventType>
+bool EventChannelHandle<EventType>::IsSubscribed() const
+{
+	return m_subscriptionID >= 0;
+}
@@ -0,0 +1,34 @@
+#include "EventID.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <mutex>
+#include <unordered_map>
+
+//Function-local so IDs built during static initialization still find the table
+static char const* InternEventName(unsigned long long hash, std::string const& eventName)
+{
+	static std::mutex s_internMutex;
+	static std::unordered_map<unsigned long long, std::string> s_internedNames;
+
+	std::lock_guard<std::mutex> lock(s_internMutex);
+	std::unordered_map<unsigned long long, std::string>::iterator found = s_internedNames.find(hash);
+	if (found != s_internedNames.end())
+	{
+		GUARANTEE_OR_DIE(found->second == eventName, "Event names \"" + found->second + "\" and \"" + eventName + "\" hash to the same EventID");
+		return found->second.c_str();
+	}
+	return s_internedNames.emplace(hash, eventName).first->second.c_str();
+}
+
+EventID::EventID(std::string const& eventName)
+	: m_hash(HashEventName(eventName.c_str(), eventName.size()))
+{
+	m_name = InternEventName(m_hash, eventName);
+}
+
+EventID EventID::GetInterned() const
+{
+	EventID interned;
+	interned.m_hash = m_hash;
+	interned.m_name = InternEventName(m_hash, m_name);
+	return interned;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+//64-bit FNV-1a, usable at compile time. Stops early at a null terminator; zero is reserved for "no event" so it maps to one.
+constexpr unsigned long long HashEventName(char const* eventName, size_t length)
+{
+	unsigned long long hash = 14695981039346656037ull;
+	for (size_t charIndex = 0; charIndex < length && eventName[charIndex] != '\0'; charIndex++)
+	{
+		hash ^= static_cast<unsigned char>(eventName[charIndex]);
+		hash *= 1099511628211ull;
+	}
+	return hash != 0 ? hash : 1;
+}
+
+//Hashed event name used as the EventSystem key. IDs compare by hash only.
+//String literals keep a pointer to the literal; the constructor is constexpr, so a constexpr or static EventID always hashes at
+//compile time and one built inline in a call usually folds too. std::string names are interned so every EventID can still report its name.
+//Anything that keeps an ID past the call that made it should store GetInterned(), as EventSystem does for its table.
+struct EventID
+{
+public:
+	constexpr EventID() = default;
+	template<size_t N>
+	constexpr EventID(char const (&literalName)[N])
+		: m_hash(HashEventName(literalName, N - 1))
+		, m_name(literalName) {}
+	template<size_t N>
+	EventID(char (&mutableName)[N]) = delete; //A buffer can change or go out of scope under the stored name; use the std::string constructor
+	explicit EventID(std::string const& eventName);
+
+	EventID			GetInterned() const; //Same hash, with the name copied into the intern table so it outlives any buffer it came from
+
+	constexpr bool	IsValid() const { return m_hash != 0; }
+	char const*		GetName() const { return m_name; }
+	constexpr bool	operator==(EventID const& compare) const { return m_hash == compare.m_hash; }
+	constexpr bool	operator!=(EventID const& compare) const { return m_hash != compare.m_hash; }
+
+	unsigned long long	m_hash = 0;
+	char const*			m_name = "";
+};
@@ -1,13 +1,33 @@
 #include "EventSystem.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include <algorithm>
+#include <cstring>
+
+//Fire and unsubscribe only need the hash, so they skip interning the name
+static EventID GetLookupEventID(std::string const& eventName)
+{
+	EventID lookupID;
+	lookupID.m_hash = HashEventName(eventName.c_str(), eventName.size());
+	return lookupID;
+}
 
 EventSystem::EventSystem(EventSystemConfig const& config)
 	:m_config(config)
+	,m_newestQueuedEvent(nullptr)
 {
+	size_t numSlots = 8;
+	while (numSlots < static_cast<size_t>(config.m_initialEventCapacity))
+	{
+		numSlots *= 2;
+	}
+	m_subscriberSlots.resize(numSlots);
 }
 
 EventSystem::~EventSystem()
 {
+	DiscardQueuedEvents();
 }
 
 void EventSystem::Startup()
@@ -16,72 +36,437 @@ void EventSystem::Startup()
 
 void EventSystem::Shutdown()
 {
+	DiscardQueuedEvents();
 }
 
 void EventSystem::BeginFrame()
 {
+	if (m_config.m_dispatchQueuedEventsInBeginFrame)
+	{
+		DispatchQueuedEvents();
+	}
 }
 
 void EventSystem::EndFrame()
 {
+	if (m_config.m_dispatchQueuedEventsInEndFrame)
+	{
+		DispatchQueuedEvents();
+	}
 }
 
-void EventSystem::SubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction* functionPtr)
+void EventSystem::SubscribeEventCallbackFunction(EventID eventID, EventCallbackFunction* functionPtr)
 {
-	SubscriptionList& subscribersForThisEvent = m_subscriptionListsByEventName[eventName];
-	EventSubscription* newEventSubscription = new EventSubscription(functionPtr);
-	subscribersForThisEvent.push_back(newEventSubscription);
+	AddSubscription(eventID, EventCallback(functionPtr));
 }
 
-void EventSystem::UnsubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction* functionPtr)
+void EventSystem::UnsubscribeEventCallbackFunction(EventID eventID, EventCallbackFunction* functionPtr)
 {
-	std::map< std::string, SubscriptionList >::iterator found = m_subscriptionListsByEventName.find(eventName);
-	if (found == m_subscriptionListsByEventName.end())
+	EventSubscriberSlot* found = FindSlot(eventID);
+	if (found)
 	{
-		return;
+		for (EventSubscription& subscriber : found->m_subscribers)
+		{
+			if (subscriber.m_subscriptionID >= 0 && subscriber.m_callback.IsFunctionPointer(functionPtr))
+			{
+				subscriber.m_subscriptionID = -1;
+				found->m_numRemovedSubscribers++;
+				m_hasDeferredSubscriptionChanges = true;
+			}
+		}
 	}
-
-	SubscriptionList& subscribersForThisEvent = found->second;
-	int numSubscribers = static_cast<int>(subscribersForThisEvent.size());
-	for (int i = 0; i < numSubscribers; ++i)
+	for (PendingEventSubscription& pending : m_pendingSubscriptions)
 	{
-		EventSubscription*& subscriber = subscribersForThisEvent[i];
-		if (subscriber && subscriber->m_functionPtr == functionPtr)
+		if (pending.m_eventID == eventID && pending.m_subscription.m_callback.IsFunctionPointer(functionPtr))
 		{
-			subscriber = nullptr;
+			pending.m_subscription.m_subscriptionID = -1;
 		}
 	}
+
+	if (m_dispatchDepth == 0 && m_hasDeferredSubscriptionChanges)
+	{
+		ApplyDeferredSubscriptionChanges();
+	}
 }
 
-void EventSystem::FireEvent(std::string const& eventName, EventArgs& args)
+void EventSystem::FireEvent(EventID eventID, EventArgs& args)
 {
-	std::map< std::string, SubscriptionList >::iterator found = m_subscriptionListsByEventName.find(eventName);
-	if (found == m_subscriptionListsByEventName.end())
+	EventSubscriberSlot* found = FindSlot(eventID);
+	if (found == nullptr)
 	{
 		return;
 	}
 
 	// Found a list of subscribers for this event; call each one in turn (or until someone "consumes" the event)
-	SubscriptionList& subscribersForThisEvent = found->second;
-	int numSubscribers = static_cast<int>(subscribersForThisEvent.size());
+	// Nothing is added to or removed from any list while m_dispatchDepth is up, so the array stays put
+	m_dispatchDepth++;
+	EventSubscription* subscribersForThisEvent = found->m_subscribers.data();
+	int numSubscribers = static_cast<int>(found->m_subscribers.size());
 	for (int i = 0; i < numSubscribers; ++i)
 	{
-		EventSubscription* subscriber = subscribersForThisEvent[i];
-		if (subscriber)
+		EventSubscription& subscriber = subscribersForThisEvent[i];
+		if (subscriber.m_subscriptionID >= 0)
 		{
-			bool wasConsumed = subscriber->m_functionPtr(args); // Execute the subscriber's callback function!
+			bool wasConsumed = subscriber.m_callback(args); // Execute the subscriber's callback function!
 			if (wasConsumed)
 			{
 				break; // Event was "consumed" by this subscriber; stop notifying any other subscribers!
 			}
 		}
 	}
+	m_dispatchDepth--;
+
+	if (m_dispatchDepth == 0 && m_hasDeferredSubscriptionChanges)
+	{
+		ApplyDeferredSubscriptionChanges();
+	}
+}
+
+void EventSystem::FireEvent(EventID eventID)
+{
+	EventArgs emptyArgs;
+	FireEvent(eventID, emptyArgs);
+}
+
+EventSubscriptionHandle EventSystem::Subscribe(EventID eventID, EventCallback callback)
+{
+	int subscriptionID = AddSubscription(eventID, std::move(callback));
+	return EventSubscriptionHandle(this, eventID, subscriptionID);
+}
+
+int EventSystem::AddSubscription(EventID eventID, EventCallback callback)
+{
+	GUARANTEE_OR_DIE(callback.IsValid(), Stringf("Subscribing an empty callback to event \"%s\"", eventID.GetName()));
+	int subscriptionID = m_nextSubscriptionID++;
+
+	if (m_dispatchDepth > 0)
+	{
+		PendingEventSubscription pending;
+		pending.m_eventID = eventID.GetInterned();
+		pending.m_subscription.m_callback = std::move(callback);
+		pending.m_subscription.m_subscriptionID = subscriptionID;
+		m_pendingSubscriptions.push_back(std::move(pending));
+		m_hasDeferredSubscriptionChanges = true;
+		return subscriptionID;
+	}
+
+	EventSubscription newSubscription;
+	newSubscription.m_callback = std::move(callback);
+	newSubscription.m_subscriptionID = subscriptionID;
+	FindOrAddSlot(eventID).m_subscribers.push_back(std::move(newSubscription));
+	return subscriptionID;
+}
+
+void EventSystem::RemoveSubscription(EventID eventID, int subscriptionID)
+{
+	EventSubscriberSlot* found = FindSlot(eventID);
+	if (found)
+	{
+		for (EventSubscription& subscriber : found->m_subscribers)
+		{
+			if (subscriber.m_subscriptionID == subscriptionID)
+			{
+				subscriber.m_subscriptionID = -1;
+				found->m_numRemovedSubscribers++;
+				m_hasDeferredSubscriptionChanges = true;
+				break;
+			}
+		}
+	}
+	for (PendingEventSubscription& pending : m_pendingSubscriptions)
+	{
+		if (pending.m_subscription.m_subscriptionID == subscriptionID)
+		{
+			pending.m_subscription.m_subscriptionID = -1;
+		}
+	}
+
+	if (m_dispatchDepth == 0 && m_hasDeferredSubscriptionChanges)
+	{
+		ApplyDeferredSubscriptionChanges();
+	}
+}
+
+void EventSystem::SubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction* functionPtr)
+{
+	SubscribeEventCallbackFunction(EventID(eventName), functionPtr);
+}
+
+void EventSystem::UnsubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction* functionPtr)
+{
+	UnsubscribeEventCallbackFunction(GetLookupEventID(eventName), functionPtr);
+}
+
+void EventSystem::FireEvent(std::string const& eventName, EventArgs& args)
+{
+	FireEvent(GetLookupEventID(eventName), args);
 }
 
 void EventSystem::FireEvent(std::string const& eventName)
+{
+	FireEvent(GetLookupEventID(eventName));
+}
+
+void EventSystem::QueueEvent(EventID eventID, EventArgs const& args, bool coalesce)
+{
+	QueuedEvent* queuedEvent = new QueuedEvent();
+	queuedEvent->m_eventID = eventID;
+	queuedEvent->m_args = args;
+	queuedEvent->m_coalesce = coalesce;
+
+	queuedEvent->m_next = m_newestQueuedEvent.load(std::memory_order_relaxed);
+	while (!m_newestQueuedEvent.compare_exchange_weak(queuedEvent->m_next, queuedEvent, std::memory_order_release, std::memory_order_relaxed))
+	{
+	}
+}
+
+void EventSystem::QueueEvent(EventID eventID, bool coalesce)
 {
 	EventArgs emptyArgs;
-	FireEvent(eventName, emptyArgs);
+	QueueEvent(eventID, emptyArgs, coalesce);
+}
+
+void EventSystem::DispatchQueuedEvents()
+{
+	//Take the whole list at once; anything queued from here on waits for the next dispatch
+	QueuedEvent* newestEvent = m_newestQueuedEvent.exchange(nullptr, std::memory_order_acquire);
+	if (newestEvent == nullptr)
+	{
+		return;
+	}
+
+	m_dispatchScratch.clear();
+	for (QueuedEvent* queuedEvent = newestEvent; queuedEvent; queuedEvent = queuedEvent->m_next)
+	{
+		m_dispatchScratch.push_back(queuedEvent);
+	}
+	std::reverse(m_dispatchScratch.begin(), m_dispatchScratch.end());
+
+	//Fold coalesced repeats into the first one, which takes over the newest args
+	m_coalescedScratch.clear();
+	int numQueuedEvents = static_cast<int>(m_dispatchScratch.size());
+	for (int eventIndex = 0; eventIndex < numQueuedEvents; eventIndex++)
+	{
+		QueuedEvent* queuedEvent = m_dispatchScratch[eventIndex];
+		if (!queuedEvent->m_coalesce)
+		{
+			continue;
+		}
+
+		bool wasFolded = false;
+		for (int firstIndex : m_coalescedScratch)
+		{
+			QueuedEvent* firstEvent = m_dispatchScratch[firstIndex];
+			if (firstEvent->m_eventID == queuedEvent->m_eventID)
+			{
+				std::swap(firstEvent->m_args, queuedEvent->m_args);
+				delete queuedEvent;
+				m_dispatchScratch[eventIndex] = nullptr;
+				wasFolded = true;
+				break;
+			}
+		}
+		if (!wasFolded)
+		{
+			m_coalescedScratch.push_back(eventIndex);
+		}
+	}
+
+	for (QueuedEvent* queuedEvent : m_dispatchScratch)
+	{
+		if (queuedEvent)
+		{
+			FireEvent(queuedEvent->m_eventID, queuedEvent->m_args);
+			delete queuedEvent;
+		}
+	}
+	m_dispatchScratch.clear();
+}
+
+void EventSystem::DiscardQueuedEvents()
+{
+	QueuedEvent* queuedEvent = m_newestQueuedEvent.exchange(nullptr, std::memory_order_acquire);
+	while (queuedEvent)
+	{
+		QueuedEvent* nextEvent = queuedEvent->m_next;
+		delete queuedEvent;
+		queuedEvent = nextEvent;
+	}
+}
+
+EventSubscriberSlot* EventSystem::FindSlot(EventID eventID)
+{
+	size_t slotMask = m_subscriberSlots.size() - 1;
+	for (size_t slotIndex = static_cast<size_t>(eventID.m_hash) & slotMask; m_subscriberSlots[slotIndex].m_eventID.IsValid(); slotIndex = (slotIndex + 1) & slotMask)
+	{
+		if (m_subscriberSlots[slotIndex].m_eventID == eventID)
+		{
+			return &m_subscriberSlots[slotIndex];
+		}
+	}
+	return nullptr;
+}
+
+EventSubscriberSlot& EventSystem::FindOrAddSlot(EventID eventID)
+{
+	EventSubscriberSlot* found = FindSlot(eventID);
+	if (found)
+	{
+		GUARANTEE_OR_DIE(strcmp(found->m_eventID.GetName(), eventID.GetName()) == 0, Stringf("Event names \"%s\" and \"%s\" hash to the same EventID", found->m_eventID.GetName(), eventID.GetName()));
+		return *found;
+	}
+
+	if ((m_numUsedSlots + 1) * 2 > static_cast<int>(m_subscriberSlots.size()))
+	{
+		GrowSlots();
+	}
+	size_t slotMask = m_subscriberSlots.size() - 1;
+	size_t slotIndex = static_cast<size_t>(eventID.m_hash) & slotMask;
+	while (m_subscriberSlots[slotIndex].m_eventID.IsValid())
+	{
+		slotIndex = (slotIndex + 1) & slotMask;
+	}
+	//Stored IDs outlive the call, so they must not point into a caller's buffer
+	m_subscriberSlots[slotIndex].m_eventID = eventID.GetInterned();
+	m_numUsedSlots++;
+	return m_subscriberSlots[slotIndex];
+}
+
+void EventSystem::GrowSlots()
+{
+	std::vector<EventSubscriberSlot> oldSlots;
+	oldSlots.swap(m_subscriberSlots);
+	m_subscriberSlots.resize(oldSlots.size() * 2);
+
+	size_t slotMask = m_subscriberSlots.size() - 1;
+	for (EventSubscriberSlot& oldSlot : oldSlots)
+	{
+		if (!oldSlot.m_eventID.IsValid())
+		{
+			continue;
+		}
+		size_t slotIndex = static_cast<size_t>(oldSlot.m_eventID.m_hash) & slotMask;
+		while (m_subscriberSlots[slotIndex].m_eventID.IsValid())
+		{
+			slotIndex = (slotIndex + 1) & slotMask;
+		}
+		m_subscriberSlots[slotIndex].m_eventID = oldSlot.m_eventID;
+		m_subscriberSlots[slotIndex].m_subscribers.swap(oldSlot.m_subscribers);
+		m_subscriberSlots[slotIndex].m_numRemovedSubscribers = oldSlot.m_numRemovedSubscribers;
+	}
+}
+
+void EventSystem::ApplyDeferredSubscriptionChanges()
+{
+	for (EventSubscriberSlot& slot : m_subscriberSlots)
+	{
+		if (slot.m_numRemovedSubscribers > 0)
+		{
+			slot.m_subscribers.erase(std::remove_if(slot.m_subscribers.begin(), slot.m_subscribers.end(),
+				[](EventSubscription const& subscriber) { return subscriber.m_subscriptionID < 0; }), slot.m_subscribers.end());
+			slot.m_numRemovedSubscribers = 0;
+		}
+	}
+
+	for (PendingEventSubscription& pending : m_pendingSubscriptions)
+	{
+		if (pending.m_subscription.m_subscriptionID >= 0)
+		{
+			FindOrAddSlot(pending.m_eventID).m_subscribers.push_back(std::move(pending.m_subscription));
+		}
+	}
+	m_pendingSubscriptions.clear();
+	m_hasDeferredSubscriptionChanges = false;
+}
+
+EventSubscriptionHandle::EventSubscriptionHandle(EventSystem* eventSystem, EventID eventID, int subscriptionID)
+	: m_eventSystem(eventSystem)
+	, m_eventID(eventID)
+	, m_subscriptionID(subscriptionID)
+{
+}
+
+EventSubscriptionHandle::EventSubscriptionHandle(EventSubscriptionHandle&& moveFrom) noexcept
+	: m_eventSystem(moveFrom.m_eventSystem)
+	, m_eventID(moveFrom.m_eventID)
+	, m_subscriptionID(moveFrom.m_subscriptionID)
+{
+	moveFrom.m_eventSystem = nullptr;
+	moveFrom.m_subscriptionID = -1;
+}
+
+EventSubscriptionHandle::~EventSubscriptionHandle()
+{
+	Unsubscribe();
+}
+
+EventSubscriptionHandle& EventSubscriptionHandle::operator=(EventSubscriptionHandle&& moveFrom) noexcept
+{
+	if (this != &moveFrom)
+	{
+		Unsubscribe();
+		m_eventSystem = moveFrom.m_eventSystem;
+		m_eventID = moveFrom.m_eventID;
+		m_subscriptionID = moveFrom.m_subscriptionID;
+		moveFrom.m_eventSystem = nullptr;
+		moveFrom.m_subscriptionID = -1;
+	}
+	return *this;
+}
+
+void EventSubscriptionHandle::Unsubscribe()
+{
+	if (m_eventSystem && m_subscriptionID >= 0)
+	{
+		m_eventSystem->RemoveSubscription(m_eventID, m_subscriptionID);
+	}
+	m_eventSystem = nullptr;
+	m_subscriptionID = -1;
+}
+
+bool EventSubscriptionHandle::IsSubscribed() const
+{
+	return m_eventSystem != nullptr && m_subscriptionID >= 0;
+}
+
+EventID EventSubscriptionHandle::GetEventID() const
+{
+	return m_eventID;
+}
+
+void SubscribeEventCallbackFunction(EventID eventID, EventCallbackFunction* functionPtr)
+{
+	g_theEventSystem->SubscribeEventCallbackFunction(eventID, functionPtr);
+}
+
+void UnsubscribeEventCallbackFunction(EventID eventID, EventCallbackFunction* functionPtr)
+{
+	g_theEventSystem->UnsubscribeEventCallbackFunction(eventID, functionPtr);
+}
+
+void FireEvent(EventID eventID, EventArgs& args)
+{
+	g_theEventSystem->FireEvent(eventID, args);
+}
+
+void FireEvent(EventID eventID)
+{
+	g_theEventSystem->FireEvent(eventID);
+}
+
+EventSubscriptionHandle Subscribe(EventID eventID, EventCallback callback)
+{
+	return g_theEventSystem->Subscribe(eventID, std::move(callback));
+}
+
+void QueueEvent(EventID eventID, EventArgs const& args, bool coalesce)
+{
+	g_theEventSystem->QueueEvent(eventID, args, coalesce);
+}
+
+void QueueEvent(EventID eventID, bool coalesce)
+{
+	g_theEventSystem->QueueEvent(eventID, coalesce);
 }
 
 void SubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction* functionPtr)
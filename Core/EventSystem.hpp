@@ -1,52 +1,200 @@
 #pragma once
 #include "Engine/Core/NamedStrings.hpp"
+#include "Engine/Core/EventID.hpp"
+#include "Engine/Core/InlineFunction.hpp"
 #include <vector>
 #include <string>
-#include <map>
+#include <atomic>
 
 typedef NamedStrings EventArgs;
 typedef bool (EventCallbackFunction)(EventArgs& args);
+typedef InlineFunction<bool(EventArgs&)> EventCallback; //Function pointer, lambda, or EventCallback::FromMethod(this, &Class::Method)
 
+class EventSystem;
+
+//Stored by value in its event's list. m_subscriptionID is -1 once unsubscribed, until the list is compacted.
 struct EventSubscription
 {
-	EventSubscription(EventCallbackFunction* functionPtr)
-		: m_functionPtr(functionPtr) {}
+	EventCallback	m_callback;
+	int				m_subscriptionID = -1;
+};
+
+typedef std::vector<EventSubscription> SubscriptionList;
+
+//One slot of the open-addressing subscriber table; an invalid m_eventID marks it empty
+struct EventSubscriberSlot
+{
+	EventID				m_eventID;
+	SubscriptionList	m_subscribers;
+	int					m_numRemovedSubscribers = 0;
+};
+
+//Subscription made while events were dispatching; it joins its list at the next safe point
+struct PendingEventSubscription
+{
+	EventID				m_eventID;
+	EventSubscription	m_subscription;
+};
+
+//Unsubscribes when destroyed or overwritten. Move only, and must not outlive the EventSystem that issued it.
+class EventSubscriptionHandle
+{
+public:
+	EventSubscriptionHandle() = default;
+	EventSubscriptionHandle(EventSystem* eventSystem, EventID eventID, int subscriptionID);
+	EventSubscriptionHandle(EventSubscriptionHandle&& moveFrom) noexcept;
+	EventSubscriptionHandle(EventSubscriptionHandle const& copyFrom) = delete;
+	~EventSubscriptionHandle();
+
+	EventSubscriptionHandle& operator=(EventSubscriptionHandle&& moveFrom) noexcept;
+	EventSubscriptionHandle& operator=(EventSubscriptionHandle const& copyFrom) = delete;
 
-	EventCallbackFunction* m_functionPtr = nullptr;
+	void	Unsubscribe();
+	bool	IsSubscribed() const;
+	EventID	GetEventID() const;
+
+protected:
+	EventSystem*	m_eventSystem = nullptr;
+	EventID			m_eventID;
+	int				m_subscriptionID = -1;
 };
 
-typedef std::vector<EventSubscription*> SubscriptionList;
+//Queued events form an intrusive singly linked list, newest first, until the main thread drains them
+struct QueuedEvent
+{
+	EventID			m_eventID;
+	EventArgs		m_args;
+	bool			m_coalesce = false;
+	QueuedEvent*	m_next = nullptr;
+};
 
 //Function templates
 
 struct EventSystemConfig
 {
-
+	int m_initialEventCapacity = 64; //Rounded up to a power of two; the table doubles whenever it gets half full
+	bool m_dispatchQueuedEventsInBeginFrame = true;
+	bool m_dispatchQueuedEventsInEndFrame = true;
 };
 
+//Subscribing, unsubscribing and FireEvent are main thread only. QueueEvent may be called from any thread.
+//Adding or removing subscriptions while an event is firing is deferred until the outermost FireEvent returns,
+//so callbacks may safely subscribe or unsubscribe anything, themselves included.
 class EventSystem
 {
 public:
 	EventSystem(EventSystemConfig const& config);
 	~EventSystem();
-	void Startup(); 
-	void Shutdown(); 
+	void Startup();
+	void Shutdown();
 	void BeginFrame();
 	void EndFrame();
 
-	void SubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction* functionPtr); 
-	void UnsubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction* functionPtr); 
+	void SubscribeEventCallbackFunction(EventID eventID, EventCallbackFunction* functionPtr);
+	void UnsubscribeEventCallbackFunction(EventID eventID, EventCallbackFunction* functionPtr);
+	void FireEvent(EventID eventID, EventArgs& args);
+	void FireEvent(EventID eventID);
+
+	//String names are hashed on every call; literals pick the template overloads, whose hash the compiler can fold (see EventID)
+	void SubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction* functionPtr);
+	void UnsubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction* functionPtr);
 	void FireEvent(std::string const& eventName, EventArgs& args);
 	void FireEvent(std::string const& eventName);
+	template<size_t N> void SubscribeEventCallbackFunction(char const (&eventName)[N], EventCallbackFunction* functionPtr);
+	template<size_t N> void UnsubscribeEventCallbackFunction(char const (&eventName)[N], EventCallbackFunction* functionPtr);
+	template<size_t N> void FireEvent(char const (&eventName)[N], EventArgs& args);
+	template<size_t N> void FireEvent(char const (&eventName)[N]);
+
+	EventSubscriptionHandle	Subscribe(EventID eventID, EventCallback callback);
+	int						AddSubscription(EventID eventID, EventCallback callback); //Unmanaged; returns the ID for RemoveSubscription
+	void					RemoveSubscription(EventID eventID, int subscriptionID);
+
+	//Lock free and callable from any thread. Queued events are fired on the main thread by the next dispatch, in the order they were queued;
+	//events queued while dispatching wait for the following one. Coalesced repeats of an event within one dispatch fire once,
+	//at the position of the first, with the newest args.
+	void QueueEvent(EventID eventID, EventArgs const& args, bool coalesce = false);
+	void QueueEvent(EventID eventID, bool coalesce = false);
+	void DispatchQueuedEvents(); //Runs from BeginFrame and EndFrame unless disabled in the config
+	void DiscardQueuedEvents();
+
+protected:
+	EventSubscriberSlot*	FindSlot(EventID eventID);
+	EventSubscriberSlot&	FindOrAddSlot(EventID eventID);
+	void					GrowSlots();
+	void					ApplyDeferredSubscriptionChanges(); //Compacts removed subscriptions and adds pending ones
 
 protected:
 	EventSystemConfig m_config;
-	std::map < std::string, SubscriptionList >  m_subscriptionListsByEventName;
+	std::vector<EventSubscriberSlot> m_subscriberSlots; //Power-of-two size, linear probing on EventID::m_hash
+	int m_numUsedSlots = 0;
+	int m_nextSubscriptionID = 0;
+	int m_dispatchDepth = 0;
+	bool m_hasDeferredSubscriptionChanges = false;
+	std::vector<PendingEventSubscription> m_pendingSubscriptions;
+
+	std::atomic<QueuedEvent*> m_newestQueuedEvent;
+	std::vector<QueuedEvent*> m_dispatchScratch;
+	std::vector<int> m_coalescedScratch;
 };
 
+template<size_t N>
+void EventSystem::SubscribeEventCallbackFunction(char const (&eventName)[N], EventCallbackFunction* functionPtr)
+{
+	SubscribeEventCallbackFunction(EventID(eventName), functionPtr);
+}
+
+template<size_t N>
+void EventSystem::UnsubscribeEventCallbackFunction(char const (&eventName)[N], EventCallbackFunction* functionPtr)
+{
+	UnsubscribeEventCallbackFunction(EventID(eventName), functionPtr);
+}
+
+template<size_t N>
+void EventSystem::FireEvent(char const (&eventName)[N], EventArgs& args)
+{
+	FireEvent(EventID(eventName), args);
+}
+
+template<size_t N>
+void EventSystem::FireEvent(char const (&eventName)[N])
+{
+	FireEvent(EventID(eventName));
+}
+
 
 // Standalone global-namespace helper functions; these forward to "the" event system, if it exists //
+void SubscribeEventCallbackFunction(EventID eventID, EventCallbackFunction* functionPtr);
+void UnsubscribeEventCallbackFunction(EventID eventID, EventCallbackFunction* functionPtr);
+void FireEvent(EventID eventID, EventArgs& args);
+void FireEvent(EventID eventID);
+EventSubscriptionHandle Subscribe(EventID eventID, EventCallback callback);
+void QueueEvent(EventID eventID, EventArgs const& args, bool coalesce = false);
+void QueueEvent(EventID eventID, bool coalesce = false);
 void SubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction* functionPtr);
 void UnsubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction* functionPtr);
 void FireEvent(std::string const& eventName, EventArgs& args);
 void FireEvent(std::string const& eventName);
+
+template<size_t N>
+void SubscribeEventCallbackFunction(char const (&eventName)[N], EventCallbackFunction* functionPtr)
+{
+	SubscribeEventCallbackFunction(EventID(eventName), functionPtr);
+}
+
+template<size_t N>
+void UnsubscribeEventCallbackFunction(char const (&eventName)[N], EventCallbackFunction* functionPtr)
+{
+	UnsubscribeEventCallbackFunction(EventID(eventName), functionPtr);
+}
+
+template<size_t N>
+void FireEvent(char const (&eventName)[N], EventArgs& args)
+{
+	FireEvent(EventID(eventName), args);
+}
+
+template<size_t N>
+void FireEvent(char const (&eventName)[N])
+{
+	FireEvent(EventID(eventName));
+}
\ No newline at end of file
@@ -1,5 +1,9 @@
 #include "FileUtils.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#endif
 
 int FileReadToBuffer(std::vector<uint8_t>& out_buffer, const std::string& filename)
 {
@@ -29,6 +33,7 @@ int FileReadToBuffer(std::vector<uint8_t>& out_buffer, const std::string& filena
 		ERROR_AND_DIE("Could not seek to start of file, but file size is saved.");
 	}
     long bytesRead = static_cast<long>(fread(out_buffer.data(), sizeof(uint8_t), static_cast<size_t>(fileSize), filePointer));
+    fclose(filePointer);
     if (bytesRead != fileSize)
     {
         ERROR_AND_DIE("Read bytes does not match file size. Incomplete read");
@@ -37,13 +42,184 @@ int FileReadToBuffer(std::vector<uint8_t>& out_buffer, const std::string& filena
     return bytesRead;
 }
 
+//One copy, from the mapped view (or fallback buffer) into the string; std::string keeps the null terminator itself
 int FileReadToString(std::string& outString, const std::string& filename)
 {
-    std::vector<uint8_t> buffer;
-    int bytesRead = FileReadToBuffer(buffer, filename);
-    buffer.resize(static_cast<size_t>(buffer.size()) + 1);
-    buffer[buffer.size()-1] = '\0';
+	MappedFile file;
+	if (!file.Open(filename))
+	{
+		ERROR_AND_DIE("File could not be opened or found. Please check the file name.");
+	}
+	outString.assign(file.GetText());
+	return static_cast<int>(file.GetSize());
+}
+
+int TryFileReadToBuffer(std::vector<uint8_t>& out_buffer, const std::string& filename)
+{
+	FILE* filePointer;
+	errno_t err = fopen_s(&filePointer, filename.c_str(), "rb");
+	if (err != 0)
+	{
+		return -1;
+	}
+
+	fseek(filePointer, 0, SEEK_END);
+	long fileSize = ftell(filePointer);
+	fseek(filePointer, 0, SEEK_SET);
+	if (fileSize < 0)
+	{
+		fclose(filePointer);
+		return -1;
+	}
+
+	out_buffer.resize(static_cast<size_t>(fileSize));
+	size_t bytesRead = fread(out_buffer.data(), sizeof(uint8_t), out_buffer.size(), filePointer);
+	fclose(filePointer);
+	if (bytesRead != out_buffer.size())
+	{
+		out_buffer.clear();
+		return -1;
+	}
+	return static_cast<int>(bytesRead);
+}
+
+int FileWriteFromBuffer(std::vector<uint8_t> const& buffer, const std::string& filename)
+{
+	FILE* filePointer;
+	errno_t err = fopen_s(&filePointer, filename.c_str(), "wb");
+	if (err != 0)
+	{
+		return -1;
+	}
+	int bytesWritten = static_cast<int>(fwrite(buffer.data(), sizeof(uint8_t), buffer.size(), filePointer));
+	fclose(filePointer);
+	return bytesWritten;
+}
 
-    outString.assign(reinterpret_cast<char*>(buffer.data()), buffer.size() - 1);
-	return bytesRead;
+bool DoesFileExist(const std::string& filename)
+{
+	FILE* filePointer;
+	errno_t err = fopen_s(&filePointer, filename.c_str(), "rb");
+	if (err != 0)
+	{
+		return false;
+	}
+	fclose(filePointer);
+	return true;
 }
+
+
+MappedFile::MappedFile(std::string const& filename)
+{
+	Open(filename);
+}
+
+MappedFile::MappedFile(MappedFile&& moveFrom) noexcept
+{
+	*this = std::move(moveFrom);
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& moveFrom) noexcept
+{
+	if (this != &moveFrom)
+	{
+		Close();
+		m_filename = std::move(moveFrom.m_filename);
+		m_size = moveFrom.m_size;
+		m_isOpen = moveFrom.m_isOpen;
+		m_isMapped = moveFrom.m_isMapped;
+		m_fallbackBuffer = std::move(moveFrom.m_fallbackBuffer);
+		m_data = m_isMapped ? moveFrom.m_data : m_fallbackBuffer.data();
+
+		moveFrom.m_data = nullptr;
+		moveFrom.m_size = 0;
+		moveFrom.m_isOpen = false;
+		moveFrom.m_isMapped = false;
+		moveFrom.m_filename.clear();
+	}
+	return *this;
+}
+
+bool MappedFile::Open(std::string const& filename)
+{
+	Close();
+	m_filename = filename;
+#ifdef _WIN32
+	//Sharing writes lets files an editor or tool still holds open be read, as fopen_s allowed
+	HANDLE fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return ReadWithoutMapping(filename);
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		CloseHandle(fileHandle);
+		return ReadWithoutMapping(filename);
+	}
+
+	//Windows cannot map an empty file, and there is nothing to map anyway
+	if (fileSize.QuadPart == 0)
+	{
+		CloseHandle(fileHandle);
+		m_isOpen = true;
+		return true;
+	}
+
+	//The view keeps the mapping alive, so neither handle is needed once it exists
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	void* view = mappingHandle ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (mappingHandle)
+	{
+		CloseHandle(mappingHandle);
+	}
+	CloseHandle(fileHandle);
+	if (view == nullptr)
+	{
+		return ReadWithoutMapping(filename);
+	}
+
+	m_data = static_cast<uint8_t const*>(view);
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+	m_isOpen = true;
+	m_isMapped = true;
+	return true;
+#else
+	return ReadWithoutMapping(filename);
+#endif
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (m_isMapped)
+	{
+		UnmapViewOfFile(m_data);
+	}
+#endif
+	m_data = nullptr;
+	m_size = 0;
+	m_isOpen = false;
+	m_isMapped = false;
+	m_filename.clear();
+	m_fallbackBuffer.clear();
+	m_fallbackBuffer.shrink_to_fit();
+}
+
+bool MappedFile::ReadWithoutMapping(std::string const& filename)
+{
+	if (TryFileReadToBuffer(m_fallbackBuffer, filename) < 0)
+	{
+		return false;
+	}
+	m_data = m_fallbackBuffer.data();
+	m_size = m_fallbackBuffer.size();
+	m_isOpen = true;
+	return true;
+}
\ No newline at end of file
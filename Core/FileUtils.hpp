@@ -1,6 +1,48 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <string_view>
+#include <cstdint>
 
 int FileReadToBuffer(std::vector<uint8_t>& out_buffer, const std::string& filename);
-int FileReadToString(std::string& outString, const std::string& filename);
\ No newline at end of file
+int FileReadToString(std::string& outString, const std::string& filename);
+int TryFileReadToBuffer(std::vector<uint8_t>& out_buffer, const std::string& filename); //Returns the bytes read, or -1 if the file could not be read
+int FileWriteFromBuffer(std::vector<uint8_t> const& buffer, const std::string& filename); //Returns the bytes written, or -1 if the file could not be opened
+bool DoesFileExist(const std::string& filename);
+
+//Read-only view of a whole file, memory mapped where the platform allows so nothing is copied; pages load on first touch.
+//Falls back to reading the file into an owned buffer when mapping is unavailable or fails. Unmaps when closed, destroyed
+//or overwritten. Move only; the data is not null terminated.
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	explicit MappedFile(std::string const& filename);
+	MappedFile(MappedFile&& moveFrom) noexcept;
+	MappedFile(MappedFile const& copyFrom) = delete;
+	~MappedFile();
+
+	MappedFile& operator=(MappedFile&& moveFrom) noexcept;
+	MappedFile& operator=(MappedFile const& copyFrom) = delete;
+
+	bool				Open(std::string const& filename); //Returns false if the file is missing or unreadable
+	void				Close();
+
+	bool				IsOpen() const { return m_isOpen; }
+	bool				IsMapped() const { return m_isMapped; } //False for empty files and the fallback path
+	uint8_t const*		GetData() const { return m_data; }
+	size_t				GetSize() const { return m_size; }
+	std::string_view	GetText() const { return std::string_view(reinterpret_cast<char const*>(m_data), m_size); }
+	std::string const&	GetFilename() const { return m_filename; } //Kept after a failed Open, for error messages
+
+protected:
+	bool				ReadWithoutMapping(std::string const& filename);
+
+protected:
+	std::string				m_filename;
+	uint8_t const*			m_data = nullptr;
+	size_t					m_size = 0;
+	bool					m_isOpen = false;
+	bool					m_isMapped = false;
+	std::vector<uint8_t>	m_fallbackBuffer;
+};
\ No newline at end of file
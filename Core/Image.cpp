@@ -1,5 +1,8 @@
 #include "Image.hpp"
 #include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "ThirdParty/stb/stb_image.h"
@@ -16,14 +19,25 @@ Image::~Image()
 }
 
 Image::Image(const char* imageFilePath)
+	: Image(MappedFile(imageFilePath))
 {
-	m_imageFilePath = imageFilePath;
+	GUARANTEE_OR_DIE(m_dimensions.x > 0, Stringf("Could not load image \"%s\"", m_imageFilePath.c_str()));
+}
+
+Image::Image(MappedFile const& imageFile)
+{
+	m_imageFilePath = imageFile.GetFilename();
 
 	int width;
 	int height;
 	int channels;
 	stbi_set_flip_vertically_on_load(1);
-	unsigned char* rawData = stbi_load(imageFilePath, &width, &height, &channels, 4);
+	unsigned char* rawData = stbi_load_from_memory(imageFile.GetData(), static_cast<int>(imageFile.GetSize()), &width, &height, &channels, 4);
+	if (rawData == nullptr)
+	{
+		m_dimensions = IntVec2(0, 0);
+		return;
+	}
 
 	m_dimensions = IntVec2(width, height);
 	m_texelRgba8Data.resize(width * height);
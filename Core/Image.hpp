@@ -4,6 +4,7 @@
 #include "Engine/Math/IntVec2.hpp"
 
 struct Rgba8;
+class MappedFile;
 
 class Image
 {
@@ -13,6 +14,7 @@ public:
 	Image();
 	~Image();
 	Image(const char* imageFilePath);
+	Image(MappedFile const& imageFile); //Decodes straight from the file's bytes; left 0x0 if they are not a valid image
 	Image(IntVec2 size, Rgba8 color);
 
 	IntVec2 GetDimensions() const;
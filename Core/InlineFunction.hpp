@@ -0,0 +1,284 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+enum class InlineFunctionOperation
+{
+	COPY,
+	MOVE,
+	DESTROY
+};
+
+template<typename SignatureType, size_t INLINE_CAPACITY = 32>
+class InlineFunction;
+
+//Type-erased callable like std::function, but anything up to INLINE_CAPACITY bytes lives inside the object itself.
+//Function pointers, lambdas capturing a few pointers and bound member functions never allocate; bigger callables fall back to the heap.
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+class InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>
+{
+public:
+	typedef ReturnType (FunctionPointerType)(ArgTypes...);
+
+	InlineFunction() = default;
+	InlineFunction(FunctionPointerType* functionPtr);
+	template<typename CallableType, typename = std::enable_if_t<!std::is_same<std::decay_t<CallableType>, InlineFunction>::value>>
+	InlineFunction(CallableType&& callable);
+	InlineFunction(InlineFunction const& copyFrom);
+	InlineFunction(InlineFunction&& moveFrom) noexcept;
+	~InlineFunction();
+
+	InlineFunction& operator=(InlineFunction const& copyFrom);
+	InlineFunction& operator=(InlineFunction&& moveFrom) noexcept;
+	ReturnType		operator()(ArgTypes... args);
+
+	//Wraps a member function; the object must outlive every copy of the returned function
+	template<typename ObjectType>
+	static InlineFunction FromMethod(ObjectType* object, ReturnType (ObjectType::*method)(ArgTypes...));
+
+	bool	IsValid() const;
+	bool	IsFunctionPointer(FunctionPointerType* functionPtr) const;
+	void	Clear();
+
+protected:
+	typedef ReturnType (InvokeFunction)(void* storage, ArgTypes... args);
+	typedef void (ManageFunction)(InlineFunctionOperation operation, void* storage, void* otherStorage);
+
+	template<typename CallableType> static ReturnType InvokeInline(void* storage, ArgTypes... args);
+	template<typename CallableType> static ReturnType InvokeOnHeap(void* storage, ArgTypes... args);
+	template<typename CallableType> static void ManageInline(InlineFunctionOperation operation, void* storage, void* otherStorage);
+	template<typename CallableType> static void ManageOnHeap(InlineFunctionOperation operation, void* storage, void* otherStorage);
+	static ReturnType InvokeFunctionPointer(void* storage, ArgTypes... args);
+
+	void	CopyFrom(InlineFunction const& copyFrom);
+	void	MoveFrom(InlineFunction& moveFrom);
+
+protected:
+	alignas(std::max_align_t) unsigned char m_storage[INLINE_CAPACITY] = {};
+	InvokeFunction* m_invoke = nullptr;
+	ManageFunction* m_manage = nullptr; //Null when the stored callable is trivially copyable and can be copied as raw bytes
+};
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::InlineFunction(FunctionPointerType* functionPtr)
+{
+	if (functionPtr)
+	{
+		memcpy(m_storage, &functionPtr, sizeof(functionPtr));
+		m_invoke = &InvokeFunctionPointer;
+	}
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+template<typename CallableType, typename>
+InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::InlineFunction(CallableType&& callable)
+{
+	typedef std::decay_t<CallableType> StoredType;
+	if constexpr (std::is_convertible<StoredType, FunctionPointerType*>::value && std::is_pointer<StoredType>::value)
+	{
+		FunctionPointerType* functionPtr = callable;
+		memcpy(m_storage, &functionPtr, sizeof(functionPtr));
+		m_invoke = functionPtr ? &InvokeFunctionPointer : nullptr;
+	}
+	else if constexpr (sizeof(StoredType) <= INLINE_CAPACITY && alignof(StoredType) <= alignof(std::max_align_t))
+	{
+		new (m_storage) StoredType(std::forward<CallableType>(callable));
+		m_invoke = &InvokeInline<StoredType>;
+		if constexpr (!std::is_trivially_copyable<StoredType>::value || !std::is_trivially_destructible<StoredType>::value)
+		{
+			m_manage = &ManageInline<StoredType>;
+		}
+	}
+	else
+	{
+		StoredType* heapCallable = new StoredType(std::forward<CallableType>(callable));
+		memcpy(m_storage, &heapCallable, sizeof(heapCallable));
+		m_invoke = &InvokeOnHeap<StoredType>;
+		m_manage = &ManageOnHeap<StoredType>;
+	}
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::InlineFunction(InlineFunction const& copyFrom)
+{
+	CopyFrom(copyFrom);
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::InlineFunction(InlineFunction&& moveFrom) noexcept
+{
+	MoveFrom(moveFrom);
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::~InlineFunction()
+{
+	Clear();
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>& InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::operator=(InlineFunction const& copyFrom)
+{
+	if (this != &copyFrom)
+	{
+		Clear();
+		CopyFrom(copyFrom);
+	}
+	return *this;
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>& InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::operator=(InlineFunction&& moveFrom) noexcept
+{
+	if (this != &moveFrom)
+	{
+		Clear();
+		MoveFrom(moveFrom);
+	}
+	return *this;
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+ReturnType InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::operator()(ArgTypes... args)
+{
+	return m_invoke(m_storage, std::forward<ArgTypes>(args)...);
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+template<typename ObjectType>
+InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY> InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::FromMethod(ObjectType* object, ReturnType (ObjectType::*method)(ArgTypes...))
+{
+	return InlineFunction([object, method](ArgTypes... args) -> ReturnType { return (object->*method)(std::forward<ArgTypes>(args)...); });
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+bool InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::IsValid() const
+{
+	return m_invoke != nullptr;
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+bool InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::IsFunctionPointer(FunctionPointerType* functionPtr) const
+{
+	if (m_invoke != &InvokeFunctionPointer)
+	{
+		return false;
+	}
+	FunctionPointerType* storedPtr = nullptr;
+	memcpy(&storedPtr, m_storage, sizeof(storedPtr));
+	return storedPtr == functionPtr;
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+void InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::Clear()
+{
+	if (m_manage)
+	{
+		m_manage(InlineFunctionOperation::DESTROY, m_storage, nullptr);
+	}
+	m_invoke = nullptr;
+	m_manage = nullptr;
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+template<typename CallableType>
+ReturnType InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::InvokeInline(void* storage, ArgTypes... args)
+{
+	return (*static_cast<CallableType*>(storage))(std::forward<ArgTypes>(args)...);
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+template<typename CallableType>
+ReturnType InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::InvokeOnHeap(void* storage, ArgTypes... args)
+{
+	CallableType* heapCallable = nullptr;
+	memcpy(&heapCallable, storage, sizeof(heapCallable));
+	return (*heapCallable)(std::forward<ArgTypes>(args)...);
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+ReturnType InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::InvokeFunctionPointer(void* storage, ArgTypes... args)
+{
+	FunctionPointerType* functionPtr = nullptr;
+	memcpy(&functionPtr, storage, sizeof(functionPtr));
+	return functionPtr(std::forward<ArgTypes>(args)...);
+}
+
+//COPY and MOVE construct into storage from otherStorage; MOVE also destroys the source
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+template<typename CallableType>
+void InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::ManageInline(InlineFunctionOperation operation, void* storage, void* otherStorage)
+{
+	CallableType* callable = static_cast<CallableType*>(storage);
+	CallableType* otherCallable = static_cast<CallableType*>(otherStorage);
+	switch (operation)
+	{
+	case InlineFunctionOperation::COPY:
+		new (storage) CallableType(*otherCallable);
+		break;
+	case InlineFunctionOperation::MOVE:
+		new (storage) CallableType(std::move(*otherCallable));
+		otherCallable->~CallableType();
+		break;
+	case InlineFunctionOperation::DESTROY:
+		callable->~CallableType();
+		break;
+	}
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+template<typename CallableType>
+void InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::ManageOnHeap(InlineFunctionOperation operation, void* storage, void* otherStorage)
+{
+	CallableType* heapCallable = nullptr;
+	switch (operation)
+	{
+	case InlineFunctionOperation::COPY:
+		memcpy(&heapCallable, otherStorage, sizeof(heapCallable));
+		heapCallable = new CallableType(*heapCallable);
+		memcpy(storage, &heapCallable, sizeof(heapCallable));
+		break;
+	case InlineFunctionOperation::MOVE:
+		memcpy(storage, otherStorage, sizeof(heapCallable));
+		break;
+	case InlineFunctionOperation::DESTROY:
+		memcpy(&heapCallable, storage, sizeof(heapCallable));
+		delete heapCallable;
+		break;
+	}
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+void InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::CopyFrom(InlineFunction const& copyFrom)
+{
+	m_invoke = copyFrom.m_invoke;
+	m_manage = copyFrom.m_manage;
+	if (m_manage)
+	{
+		m_manage(InlineFunctionOperation::COPY, m_storage, const_cast<unsigned char*>(copyFrom.m_storage));
+	}
+	else
+	{
+		memcpy(m_storage, copyFrom.m_storage, INLINE_CAPACITY);
+	}
+}
+
+template<typename ReturnType, typename... ArgTypes, size_t INLINE_CAPACITY>
+void InlineFunction<ReturnType(ArgTypes...), INLINE_CAPACITY>::MoveFrom(InlineFunction& moveFrom)
+{
+	m_invoke = moveFrom.m_invoke;
+	m_manage = moveFrom.m_manage;
+	if (m_manage)
+	{
+		m_manage(InlineFunctionOperation::MOVE, m_storage, moveFrom.m_storage);
+	}
+	else
+	{
+		memcpy(m_storage, moveFrom.m_storage, INLINE_CAPACITY);
+	}
+	moveFrom.m_invoke = nullptr;
+	moveFrom.m_manage = nullptr;
+}
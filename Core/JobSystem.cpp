@@ -0,0 +1,269 @@
+#include "Engine/Core/JobSystem.hpp"
+
+//Which queue the calling thread owns; only meaningful while s_queueOwner is the system asking
+static thread_local JobSystem const*	s_queueOwner = nullptr;
+static thread_local int					s_queueIndex = -1;
+
+JobSystem::JobSystem(JobSystemConfig const& config)
+	: m_config(config)
+{
+}
+
+JobSystem::~JobSystem()
+{
+	Shutdown();
+}
+
+void JobSystem::Startup()
+{
+	int numWorkers = m_config.m_numWorkerThreads;
+	if (numWorkers < 0)
+	{
+		numWorkers = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 0);
+	}
+
+	for (int queueIndex = 0; queueIndex < numWorkers + 1; queueIndex++)
+	{
+		m_workerQueues.push_back(new WorkerQueue());
+	}
+	s_queueOwner = this;
+	s_queueIndex = 0;
+
+	m_isRunning = true;
+	for (int workerIndex = 1; workerIndex <= numWorkers; workerIndex++)
+	{
+		m_workers.emplace_back(&JobSystem::WorkerMain, this, workerIndex);
+	}
+}
+
+void JobSystem::Shutdown()
+{
+	if (m_workerQueues.empty())
+	{
+		return;
+	}
+
+	while (RunOneJob())
+	{
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_isRunning = false;
+	}
+	m_jobAvailable.notify_all();
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+	m_workers.clear();
+
+	for (WorkerQueue* queue : m_workerQueues)
+	{
+		delete queue;
+	}
+	m_workerQueues.clear();
+	m_parkedJobs.clear();
+	m_numParkedJobs = 0;
+	m_numQueuedJobs = 0;
+	if (s_queueOwner == this)
+	{
+		s_queueOwner = nullptr;
+		s_queueIndex = -1;
+	}
+}
+
+void JobSystem::BeginFrame()
+{
+}
+
+void JobSystem::EndFrame()
+{
+}
+
+void JobSystem::KickJob(JobFunction function, JobCounter* counter, JobCounter const* dependency)
+{
+	Job job;
+	job.m_function = std::move(function);
+	job.m_counter = counter;
+	job.m_dependency = dependency;
+	if (counter)
+	{
+		counter->m_numUnfinishedJobs.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	if (dependency && !dependency->IsDone())
+	{
+		//Counted as parked before the final check; whoever finishes the dependency's last job sees the count and releases it
+		std::lock_guard<std::mutex> lock(m_parkedJobsMutex);
+		m_numParkedJobs++;
+		if (dependency->m_numUnfinishedJobs.load() != 0)
+		{
+			m_parkedJobs.push_back(std::move(job));
+			return;
+		}
+		m_numParkedJobs--;
+	}
+
+	if (m_workerQueues.empty())
+	{
+		RunJob(job);
+		return;
+	}
+	PushJob(std::move(job));
+}
+
+void JobSystem::WaitForCounter(JobCounter const& counter)
+{
+	while (!counter.IsDone())
+	{
+		if (!RunOneJob())
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool JobSystem::RunOneJob()
+{
+	Job job;
+	if (!PopOrStealJob(job))
+	{
+		return false;
+	}
+	RunJob(job);
+	return true;
+}
+
+void JobSystem::PushJob(Job&& job)
+{
+	unsigned int queueIndex = s_queueOwner == this ? static_cast<unsigned int>(s_queueIndex) : m_nextExternalQueueIndex++ % static_cast<unsigned int>(m_workerQueues.size());
+	WorkerQueue& queue = *m_workerQueues[queueIndex];
+	{
+		std::lock_guard<std::mutex> lock(queue.m_mutex);
+		queue.m_jobs.push_back(std::move(job));
+	}
+	m_numQueuedJobs++;
+
+	if (m_numSleepingWorkers.load() > 0)
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_jobAvailable.notify_one();
+	}
+}
+
+//Own queue newest first, then steal the oldest job from each other queue in turn
+bool JobSystem::PopOrStealJob(Job& out_job)
+{
+	if (m_numQueuedJobs.load(std::memory_order_acquire) == 0)
+	{
+		return false;
+	}
+
+	int numQueues = static_cast<int>(m_workerQueues.size());
+	int ownQueueIndex = s_queueOwner == this ? s_queueIndex : -1;
+	if (ownQueueIndex >= 0)
+	{
+		WorkerQueue& queue = *m_workerQueues[ownQueueIndex];
+		std::lock_guard<std::mutex> lock(queue.m_mutex);
+		if (!queue.m_jobs.empty())
+		{
+			out_job = std::move(queue.m_jobs.back());
+			queue.m_jobs.pop_back();
+			m_numQueuedJobs--;
+			return true;
+		}
+	}
+
+	int firstVictimIndex = ownQueueIndex >= 0 ? ownQueueIndex + 1 : 0;
+	for (int victimOffset = 0; victimOffset < numQueues; victimOffset++)
+	{
+		int victimIndex = (firstVictimIndex + victimOffset) % numQueues;
+		if (victimIndex == ownQueueIndex)
+		{
+			continue;
+		}
+		WorkerQueue& queue = *m_workerQueues[victimIndex];
+		std::lock_guard<std::mutex> lock(queue.m_mutex);
+		if (!queue.m_jobs.empty())
+		{
+			out_job = std::move(queue.m_jobs.front());
+			queue.m_jobs.pop_front();
+			m_numQueuedJobs--;
+			return true;
+		}
+	}
+	return false;
+}
+
+void JobSystem::RunJob(Job& job)
+{
+	job.m_function();
+	job.m_function.Clear();
+
+	//The counter may be destroyed the moment it reads zero, so it is not touched after the decrement
+	if (job.m_counter && job.m_counter->m_numUnfinishedJobs.fetch_sub(1) == 1 && m_numParkedJobs.load() > 0)
+	{
+		ReleaseParkedJobs();
+	}
+}
+
+//Every parked job's dependency is alive by contract, so checking them all needs no record of which counter just finished
+void JobSystem::ReleaseParkedJobs()
+{
+	std::vector<Job> releasedJobs;
+	{
+		std::lock_guard<std::mutex> lock(m_parkedJobsMutex);
+		for (size_t parkedIndex = 0; parkedIndex < m_parkedJobs.size();)
+		{
+			if (m_parkedJobs[parkedIndex].m_dependency->IsDone())
+			{
+				releasedJobs.push_back(std::move(m_parkedJobs[parkedIndex]));
+				if (parkedIndex + 1 < m_parkedJobs.size())
+				{
+					m_parkedJobs[parkedIndex] = std::move(m_parkedJobs.back());
+				}
+				m_parkedJobs.pop_back();
+				m_numParkedJobs--;
+			}
+			else
+			{
+				parkedIndex++;
+			}
+		}
+	}
+
+	for (Job& job : releasedJobs)
+	{
+		if (m_workerQueues.empty())
+		{
+			RunJob(job);
+		}
+		else
+		{
+			PushJob(std::move(job));
+		}
+	}
+}
+
+void JobSystem::WorkerMain(int workerIndex)
+{
+	s_queueOwner = this;
+	s_queueIndex = workerIndex;
+
+	for (;;)
+	{
+		if (RunOneJob())
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_numSleepingWorkers++;
+		m_jobAvailable.wait(lock, [this]() { return m_numQueuedJobs.load() > 0 || !m_isRunning; });
+		m_numSleepingWorkers--;
+		if (!m_isRunning && m_numQueuedJobs.load() == 0)
+		{
+			return;
+		}
+	}
+}
@@ -0,0 +1,148 @@
+#pragma once
+#include "Engine/Core/InlineFunction.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+
+extern JobSystem* g_theJobSystem;
+
+typedef InlineFunction<void()> JobFunction;
+
+class JobCounter;
+
+struct Job
+{
+	JobFunction			m_function;
+	JobCounter*			m_counter = nullptr; //Decremented once the function returns
+	JobCounter const*	m_dependency = nullptr; //The job stays parked until this reaches zero
+};
+
+//Counts unfinished jobs. Kicking a job with a counter increments it and finishing the job decrements it, so a counter
+//shared by a batch reaches zero when the whole batch is done. Nothing touches a counter after its last job finishes, so it
+//may be destroyed as soon as it reads zero, but it must outlive any job parked on it as a dependency.
+class JobCounter
+{
+	friend class JobSystem;
+
+public:
+	JobCounter() = default;
+	JobCounter(JobCounter const& copyFrom) = delete;
+	JobCounter& operator=(JobCounter const& copyFrom) = delete;
+
+	bool	IsDone() const { return m_numUnfinishedJobs.load(std::memory_order_acquire) == 0; }
+	int		GetNumUnfinishedJobs() const { return m_numUnfinishedJobs.load(std::memory_order_acquire); }
+
+protected:
+	std::atomic<int> m_numUnfinishedJobs = 0;
+};
+
+struct JobSystemConfig
+{
+	int m_numWorkerThreads = -1; //-1 uses one per hardware thread beyond the main thread; 0 runs every job on waiting threads
+	int m_parallelForChunksPerThread = 4; //Automatic ParallelFor grain sizing aims for this many chunks per thread
+};
+
+//Each thread, the main thread included, owns a deque of jobs: it pushes and pops its own at the back, most recent first,
+//while idle threads steal the oldest from the front of the others', so big early jobs spread out and recent ones stay cache-warm.
+//Waiting on a counter runs jobs instead of blocking, so the main thread helps and nested waits inside jobs cannot deadlock.
+//Jobs may be kicked from any thread. Typical use:
+//
+//	JobCounter counter;
+//	g_theJobSystem->KickJob([&]() { BuildTerrainVerts(); }, &counter);
+//	g_theJobSystem->KickJob([&]() { BuildFoliageVerts(); }, &counter);
+//	g_theJobSystem->WaitForCounter(counter);
+//
+//	g_theJobSystem->ParallelFor(0, numTiles, [&](int tileIndex) { UpdateTile(tileIndex); });
+class JobSystem
+{
+public:
+	JobSystem(JobSystemConfig const& config);
+	~JobSystem();
+	void Startup(); //Call from the main thread
+	void Shutdown(); //Runs every job still queued, then stops the workers
+	void BeginFrame();
+	void EndFrame();
+
+	void	KickJob(JobFunction function, JobCounter* counter = nullptr, JobCounter const* dependency = nullptr); //Runs inline if the system is not started
+	void	WaitForCounter(JobCounter const& counter); //Runs other jobs until the counter reaches zero
+	bool	RunOneJob(); //Runs one queued job on the calling thread, if there is any; returns false if there was none
+
+	//Calls function(index) for every index in [startIndex, endIndex) across all threads and returns once all calls are done.
+	//A grainSize of 0 picks one from the range size and thread count.
+	template<typename IndexFunctionType>
+	void	ParallelFor(int startIndex, int endIndex, IndexFunctionType&& function, int grainSize = 0);
+
+	int		GetNumThreads() const { return static_cast<int>(m_workerQueues.size()); } //Workers plus the main thread
+	int		GetNumQueuedJobs() const { return m_numQueuedJobs.load(std::memory_order_acquire); }
+
+protected:
+	struct WorkerQueue
+	{
+		std::mutex		m_mutex;
+		std::deque<Job>	m_jobs;
+	};
+
+	void	PushJob(Job&& job);
+	bool	PopOrStealJob(Job& out_job);
+	void	RunJob(Job& job);
+	void	ReleaseParkedJobs(); //Pushes every parked job whose dependency is done
+	void	WorkerMain(int workerIndex);
+
+protected:
+	JobSystemConfig m_config;
+	std::vector<std::thread> m_workers;
+	std::vector<WorkerQueue*> m_workerQueues; //Index 0 belongs to the main thread
+	std::atomic<unsigned int> m_nextExternalQueueIndex = 0; //Round robin for threads that own no queue
+	std::atomic<int> m_numQueuedJobs = 0;
+
+	std::mutex m_parkedJobsMutex;
+	std::vector<Job> m_parkedJobs;
+	std::atomic<int> m_numParkedJobs = 0;
+
+	std::mutex m_sleepMutex;
+	std::condition_variable m_jobAvailable;
+	std::atomic<int> m_numSleepingWorkers = 0;
+	bool m_isRunning = false;
+};
+
+template<typename IndexFunctionType>
+void JobSystem::ParallelFor(int startIndex, int endIndex, IndexFunctionType&& function, int grainSize)
+{
+	int numIndices = endIndex - startIndex;
+	if (numIndices <= 0)
+	{
+		return;
+	}
+	if (grainSize <= 0)
+	{
+		int numChunks = std::max(GetNumThreads(), 1) * std::max(m_config.m_parallelForChunksPerThread, 1);
+		grainSize = std::max((numIndices + numChunks - 1) / numChunks, 1);
+	}
+
+	//The caller's chunk comes last so the other threads can steal the earlier ones while it runs
+	JobCounter counter;
+	auto* functionPtr = &function;
+	int chunkStart = startIndex;
+	for (; chunkStart + grainSize < endIndex; chunkStart += grainSize)
+	{
+		int chunkEnd = chunkStart + grainSize;
+		KickJob([functionPtr, chunkStart, chunkEnd]()
+		{
+			for (int index = chunkStart; index < chunkEnd; index++)
+			{
+				(*functionPtr)(index);
+			}
+		}, &counter);
+	}
+	for (int index = chunkStart; index < endIndex; index++)
+	{
+		function(index);
+	}
+	WaitForCounter(counter);
+}
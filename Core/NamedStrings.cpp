@@ -1,11 +1,86 @@
 #include "Engine/Core/NamedStrings.hpp"
 #include "Engine/Core/XmlUtils.hpp"
-#include "Engine/Math/Vec2.hpp"
-#include "Engine/Math/IntVec2.hpp"
-#include "Engine/Core/Rgba8.hpp"
-#include "Engine/Math/Vec3.hpp"
-#include "Engine/Math/EulerAngles.hpp"
-#include "Engine/Math/FloatRange.hpp"
+#include "Engine/Core/XmlStreamReader.hpp"
+#include <functional>
+#include <type_traits>
+
+static void ParseNamedValue(std::string const& text, int& out_value)
+{
+	out_value = ParseInt(text);
+}
+
+static void ParseNamedValue(std::string const& text, float& out_value)
+{
+	out_value = ParseFloat(text);
+}
+
+template<typename ValueType>
+static void ParseNamedValue(std::string const& text, ValueType& out_value)
+{
+	out_value.SetFromText(text);
+}
+
+template<typename ValueType, size_t TypeIndex = 0>
+constexpr int GetCachedValueTypeIndex()
+{
+	if constexpr (std::is_same_v<ValueType, std::variant_alternative_t<TypeIndex, NamedStringsCachedValue>>)
+	{
+		return static_cast<int>(TypeIndex);
+	}
+	else
+	{
+		return GetCachedValueTypeIndex<ValueType, TypeIndex + 1>();
+	}
+}
+
+template<typename ValueType>
+static bool TryGetCachedValue(NamedStringsEntry const& entry, ValueType& out_value)
+{
+	if (entry.m_cacheState.load(std::memory_order_acquire) != GetCachedValueTypeIndex<ValueType>())
+	{
+		return false;
+	}
+	out_value = std::get<ValueType>(entry.m_cachedValue);
+	return true;
+}
+
+//Only the reader that claims an empty cache writes it, and it is published before anyone may read it
+template<typename ValueType>
+static void TryCacheValue(NamedStringsEntry const& entry, ValueType const& value)
+{
+	int expectedState = NAMED_STRINGS_CACHE_EMPTY;
+	if (entry.m_cacheState.compare_exchange_strong(expectedState, NAMED_STRINGS_CACHE_FILLING, std::memory_order_acquire))
+	{
+		entry.m_cachedValue = value;
+		entry.m_cacheState.store(GetCachedValueTypeIndex<ValueType>(), std::memory_order_release);
+	}
+}
+
+NamedStringsEntry::NamedStringsEntry(NamedStringsEntry const& copyFrom)
+{
+	*this = copyFrom;
+}
+
+//A cache another thread is still filling is not copied
+NamedStringsEntry& NamedStringsEntry::operator=(NamedStringsEntry const& copyFrom)
+{
+	m_key = copyFrom.m_key;
+	m_value = copyFrom.m_value;
+	m_keyHash = copyFrom.m_keyHash;
+	m_isUsed = copyFrom.m_isUsed;
+	int cacheState = copyFrom.m_cacheState.load(std::memory_order_acquire);
+	if (cacheState >= 0)
+	{
+		m_cachedValue = copyFrom.m_cachedValue;
+		m_cacheState.store(cacheState, std::memory_order_relaxed);
+	}
+	else
+	{
+		m_cachedValue = std::monostate();
+		m_cacheState.store(NAMED_STRINGS_CACHE_EMPTY, std::memory_order_relaxed);
+	}
+	return *this;
+}
 
 void NamedStrings::PopulateFromXmlElementAttributes(XmlElement const& element)
 {
@@ -17,42 +92,91 @@ void NamedStrings::PopulateFromXmlElementAttributes(XmlElement const& element)
 	const XmlAttribute* attribute = element.FirstAttribute();
 	while (attribute)
 	{
-		m_keyValuePairs[attribute->Name()] = attribute->Value();
+		SetValue(attribute->Name(), attribute->Value());
 		attribute = attribute->Next();
 	}
 }
 
+void NamedStrings::PopulateFromXmlElementAttributes(XmlStreamReader const& reader)
+{
+	for (int attributeIndex = 0; attributeIndex < reader.GetNumAttributes(); attributeIndex++)
+	{
+		XmlStreamAttribute const& attribute = reader.GetAttribute(attributeIndex);
+		SetValue(std::string(attribute.m_name), std::string(attribute.m_value));
+	}
+}
+
 void NamedStrings::SetValue(std::string const& keyName, std::string const& newValue)
 {
-	m_keyValuePairs[keyName] = newValue;
+	size_t keyHash = std::hash<std::string>()(keyName);
+	if (!m_entries.empty())
+	{
+		size_t entryMask = m_entries.size() - 1;
+		for (size_t entryIndex = keyHash & entryMask; m_entries[entryIndex].m_isUsed; entryIndex = (entryIndex + 1) & entryMask)
+		{
+			NamedStringsEntry& entry = m_entries[entryIndex];
+			if (entry.m_keyHash == keyHash && entry.m_key == keyName)
+			{
+				entry.m_value = newValue;
+				entry.m_cachedValue = std::monostate();
+				entry.m_cacheState.store(NAMED_STRINGS_CACHE_EMPTY, std::memory_order_relaxed);
+				return;
+			}
+		}
+	}
+
+	if ((m_numKeys + 1) * 2 > static_cast<int>(m_entries.size()))
+	{
+		GrowEntries();
+	}
+	size_t entryMask = m_entries.size() - 1;
+	size_t entryIndex = keyHash & entryMask;
+	while (m_entries[entryIndex].m_isUsed)
+	{
+		entryIndex = (entryIndex + 1) & entryMask;
+	}
+	NamedStringsEntry& newEntry = m_entries[entryIndex];
+	newEntry.m_key = keyName;
+	newEntry.m_value = newValue;
+	newEntry.m_keyHash = keyHash;
+	newEntry.m_isUsed = true;
+	newEntry.m_cachedValue = std::monostate();
+	newEntry.m_cacheState.store(NAMED_STRINGS_CACHE_EMPTY, std::memory_order_relaxed);
+	m_numKeys++;
 }
 
 std::string NamedStrings::GetValue(std::string const& keyName, std::string const& defaultValue) const
 {
-	std::string result;
-	if (m_keyValuePairs.find(keyName) == m_keyValuePairs.end())
+	NamedStringsEntry const* entry = FindEntry(keyName);
+	if (entry == nullptr)
 	{
 		return defaultValue;
 	}
-	result = m_keyValuePairs.at(keyName);
-	return result;
+	return entry->m_value;
 }
 
 bool NamedStrings::GetValue(std::string const& keyName, bool defaultValue) const
 {
-	std::string str;
-	if (m_keyValuePairs.find(keyName) == m_keyValuePairs.end())
+	NamedStringsEntry const* entry = FindEntry(keyName);
+	if (entry == nullptr)
 	{
 		return defaultValue;
 	}
+	bool cachedValue = false;
+	if (TryGetCachedValue(*entry, cachedValue))
+	{
+		return cachedValue;
+	}
 
-	str = m_keyValuePairs.at(keyName);
-	if (str.compare("true") == 0)
+	//Anything but "true" or "false" falls back to the default and is not cached, since the default can change per call
+	if (entry->m_value.compare("true") == 0)
 	{
+		TryCacheValue(*entry, true);
 		return true;
 	}
-	else if (str.compare("false") == 0)
+	else if (entry->m_value.compare("false") == 0)
 	{
+		TryCacheValue(*entry, false);
 		return false;
 	}
 	else
@@ -63,119 +187,121 @@ bool NamedStrings::GetValue(std::string const& keyName, bool defaultValue) const
 
 int NamedStrings::GetValue(std::string const& keyName, int defaultValue) const
 {
-	std::string str;
-	if (m_keyValuePairs.find(keyName) == m_keyValuePairs.end())
-	{
-		return defaultValue;
-	}
-
-	str = m_keyValuePairs.at(keyName);
-	return atoi(str.c_str());
+	return GetParsedValue(keyName, defaultValue);
 }
 
 float NamedStrings::GetValue(std::string const& keyName, float defaultValue) const
 {
-	std::string str;
-	if (m_keyValuePairs.find(keyName) == m_keyValuePairs.end())
-	{
-		return defaultValue;
-	}
-
-	str = m_keyValuePairs.at(keyName);
-	return static_cast<float>(atof(str.c_str()));
+	return GetParsedValue(keyName, defaultValue);
 }
 
 std::string NamedStrings::GetValue(std::string const& keyName, char const* defaultValue) const
 {
-	std::string result;
-	if (m_keyValuePairs.find(keyName) == m_keyValuePairs.end())
+	NamedStringsEntry const* entry = FindEntry(keyName);
+	if (entry == nullptr)
 	{
 		return defaultValue;
 	}
-	result = m_keyValuePairs.at(keyName);
-	return result;
+	return entry->m_value;
 }
 
 Rgba8 NamedStrings::GetValue(std::string const& keyName, Rgba8 const& defaultValue) const
 {
-	std::string str;
-	if (m_keyValuePairs.find(keyName) == m_keyValuePairs.end())
-	{
-		return defaultValue;
-	}
-
-	str = m_keyValuePairs.at(keyName);
-	Rgba8 result = Rgba8();
-	result.SetFromText(str.c_str());
-	return result;
+	return GetParsedValue(keyName, defaultValue);
 }
 
 Vec2 NamedStrings::GetValue(std::string const& keyName, Vec2 const& defaultValue) const
 {
-	std::string str;
-	if (m_keyValuePairs.find(keyName) == m_keyValuePairs.end())
-	{
-		return defaultValue;
-	}
-
-	str = m_keyValuePairs.at(keyName);
-	Vec2 result = Vec2();
-	result.SetFromText(str.c_str());
-	return result;
+	return GetParsedValue(keyName, defaultValue);
 }
 
 Vec3 NamedStrings::GetValue(std::string const& keyName, Vec3 const& defaultValue) const
 {
-	std::string str;
-	if (m_keyValuePairs.find(keyName) == m_keyValuePairs.end())
-	{
-		return defaultValue;
-	}
-
-	str = m_keyValuePairs.at(keyName);
-	Vec3 result = Vec3();
-	result.SetFromText(str.c_str());
-	return result;
+	return GetParsedValue(keyName, defaultValue);
 }
 
 EulerAngles NamedStrings::GetValue(std::string const& keyName, EulerAngles const& defaultValue) const
 {
-	std::string str;
-	if (m_keyValuePairs.find(keyName) == m_keyValuePairs.end())
+	return GetParsedValue(keyName, defaultValue);
+}
+
+IntVec2 NamedStrings::GetValue(std::string const& keyName, IntVec2 const& defaultValue) const
+{
+	return GetParsedValue(keyName, defaultValue);
+}
+
+FloatRange NamedStrings::GetValue(std::string const& keyName, FloatRange const& defaultValue) const
+{
+	return GetParsedValue(keyName, defaultValue);
+}
+
+bool NamedStrings::HasKey(std::string const& keyName) const
+{
+	return FindEntry(keyName) != nullptr;
+}
+
+int NamedStrings::GetNumKeys() const
+{
+	return m_numKeys;
+}
+
+NamedStringsEntry const* NamedStrings::FindEntry(std::string const& keyName) const
+{
+	if (m_entries.empty())
 	{
-		return defaultValue;
+		return nullptr;
 	}
 
-	str = m_keyValuePairs.at(keyName);
-	EulerAngles result = EulerAngles();
-	result.SetFromText(str.c_str());
-	return result;
+	size_t keyHash = std::hash<std::string>()(keyName);
+	size_t entryMask = m_entries.size() - 1;
+	for (size_t entryIndex = keyHash & entryMask; m_entries[entryIndex].m_isUsed; entryIndex = (entryIndex + 1) & entryMask)
+	{
+		NamedStringsEntry const& entry = m_entries[entryIndex];
+		if (entry.m_keyHash == keyHash && entry.m_key == keyName)
+		{
+			return &entry;
+		}
+	}
+	return nullptr;
 }
 
-IntVec2 NamedStrings::GetValue(std::string const& keyName, IntVec2 const& defaultValue) const
+void NamedStrings::GrowEntries()
 {
-	std::string str;
-	if (m_keyValuePairs.find(keyName) == m_keyValuePairs.end())
+	std::vector<NamedStringsEntry> oldEntries;
+	oldEntries.swap(m_entries);
+	m_entries.resize(oldEntries.empty() ? 4 : oldEntries.size() * 2);
+
+	size_t entryMask = m_entries.size() - 1;
+	for (NamedStringsEntry& oldEntry : oldEntries)
 	{
-		return defaultValue;
+		if (!oldEntry.m_isUsed)
+		{
+			continue;
+		}
+		size_t entryIndex = oldEntry.m_keyHash & entryMask;
+		while (m_entries[entryIndex].m_isUsed)
+		{
+			entryIndex = (entryIndex + 1) & entryMask;
+		}
+		m_entries[entryIndex] = std::move(oldEntry);
 	}
-
-	str = m_keyValuePairs.at(keyName);
-	IntVec2 result = IntVec2();
-	result.SetFromText(str.c_str());
-	return result;
 }
 
-FloatRange NamedStrings::GetValue(std::string const& keyName, FloatRange const& defaultValue) const
+template<typename ValueType>
+ValueType NamedStrings::GetParsedValue(std::string const& keyName, ValueType const& defaultValue) const
 {
-	std::string str;
-	if (m_keyValuePairs.find(keyName) == m_keyValuePairs.end())
+	NamedStringsEntry const* entry = FindEntry(keyName);
+	if (entry == nullptr)
 	{
 		return defaultValue;
 	}
+	ValueType result = ValueType();
+	if (TryGetCachedValue(*entry, result))
+	{
+		return result;
+	}
 
-	str = m_keyValuePairs.at(keyName);
-	FloatRange result = FloatRange();
-	result.SetFromText(str.c_str());
+	ParseNamedValue(entry->m_value, result);
+	TryCacheValue(*entry, result);
 	return result;
-}
+}
\ No newline at end of file
@@ -1,12 +1,47 @@
 #include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include <atomic>
 #include <string>
-#include <map>
+#include <variant>
+#include <vector>
 #pragma once
 
+class XmlStreamReader;
+
+//First typed value read from an entry, so repeated reads of that type skip parsing
+typedef std::variant<std::monostate, bool, int, float, Rgba8, Vec2, Vec3, EulerAngles, IntVec2, FloatRange> NamedStringsCachedValue;
+
+constexpr int NAMED_STRINGS_CACHE_EMPTY = -1;
+constexpr int NAMED_STRINGS_CACHE_FILLING = -2;
+
+struct NamedStringsEntry
+{
+	NamedStringsEntry() = default;
+	NamedStringsEntry(NamedStringsEntry const& copyFrom);
+	NamedStringsEntry& operator=(NamedStringsEntry const& copyFrom);
+
+	std::string						m_key;
+	std::string						m_value;
+	size_t							m_keyHash = 0;
+	bool							m_isUsed = false;
+	mutable NamedStringsCachedValue	m_cachedValue;
+	mutable std::atomic<int>		m_cacheState = NAMED_STRINGS_CACHE_EMPTY; //Index of the cached type once m_cachedValue is filled
+};
+
+//String key/value store backed by an open-addressing hash table. Typed GetValue calls parse the stored text once and
+//cache the result until the value is set again. The first reader to parse a key claims its cache and fills it once; other
+//readers never write it, and reads of another type just parse, so const reads stay safe from any number of threads.
+//SetValue and PopulateFrom* are writes and need the usual exclusive access.
 class NamedStrings
 {
 public:
 	void		PopulateFromXmlElementAttributes(XmlElement const& element);
+	void		PopulateFromXmlElementAttributes(XmlStreamReader const& reader); //Attributes of the reader's current START_ELEMENT
 	void		SetValue(std::string const& keyName, std::string const& newValue);
 	std::string	GetValue(std::string const& keyName, std::string const& defaultValue) const;
 	bool		GetValue(std::string const& keyName, bool defaultValue) const;
@@ -20,6 +55,16 @@ public:
 	IntVec2		GetValue(std::string const& keyName, IntVec2 const& defaultValue) const;
 	FloatRange  GetValue(std::string const& keyName, FloatRange const& defaultValue) const;
 
+	bool		HasKey(std::string const& keyName) const;
+	int			GetNumKeys() const;
+
+private:
+	NamedStringsEntry const*	FindEntry(std::string const& keyName) const;
+	void						GrowEntries();
+	template<typename ValueType>
+	ValueType					GetParsedValue(std::string const& keyName, ValueType const& defaultValue) const;
+
 private:
-	std::map< std::string, std::string >	m_keyValuePairs;
+	std::vector<NamedStringsEntry>	m_entries; //Power-of-two size, linear probing, never more than half full
+	int								m_numKeys = 0;
 };
\ No newline at end of file
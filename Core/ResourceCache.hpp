@@ -0,0 +1,428 @@
+#pragma once
+#include "Engine/Core/AssetPipeline.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/InlineFunction.hpp"
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+template<typename ResourceType>
+class ResourceCache;
+
+struct ResourceCacheConfig
+{
+	size_t m_budgetBytes = 0; //Unreferenced resources are evicted, least recently used first, while over this; 0 never evicts
+};
+
+//Keeps its resource cached for as long as it, or a copy of it, exists. Reports the load state and returns the placeholder
+//until the resource is ready, like AssetHandle. Main thread only. A handle that outlives its entry's place in the cache, through
+//a failed load or Clear, is detached: it reports FAILED and returns the placeholder, and releasing it is still safe.
+//AssetHandle is a protected base so a handle cannot decay into a plain AssetHandle copy that holds no reference.
+template<typename ResourceType>
+class ResourceHandle : protected AssetHandle<ResourceType>
+{
+	friend class ResourceCache<ResourceType>;
+
+public:
+	using AssetHandle<ResourceType>::GetState;
+	using AssetHandle<ResourceType>::IsValid;
+	using AssetHandle<ResourceType>::IsLoading;
+	using AssetHandle<ResourceType>::IsReady;
+	using AssetHandle<ResourceType>::HasFailed;
+	using AssetHandle<ResourceType>::Get;
+
+
+	ResourceHandle() = default;
+	ResourceHandle(ResourceHandle const& copyFrom);
+	ResourceHandle(ResourceHandle&& moveFrom) noexcept;
+	~ResourceHandle();
+
+	ResourceHandle& operator=(ResourceHandle assignFrom) noexcept;
+
+	void	Release();
+
+protected:
+	explicit ResourceHandle(AssetLoadStatus<ResourceType>* status);
+};
+
+//Owns loaded resources of one type, looked up by hashed key (usually the file path), with per-type memory accounting.
+//An entry stays cached while any ResourceHandle refers to it, while it is pinned, or while it is loading. Once none of those
+//hold, it joins an LRU list and is destroyed, oldest first, whenever the cache is over budget. Pins stand in for the
+//raw pointers the synchronous CreateOrGet functions hand out, which nothing tracks; they are counted, so each Unpin undoes
+//one Pin. A failed load leaves the cache at once, so the key can be loaded again. Main thread only.
+template<typename ResourceType>
+class ResourceCache
+{
+	friend class ResourceHandle<ResourceType>;
+
+public:
+	typedef InlineFunction<void(ResourceType)> ResourceDestroyFunction;
+
+	ResourceCache(ResourceCacheConfig const& config, ResourceDestroyFunction destroyFunction);
+	ResourceCache(ResourceCache const& copyFrom) = delete;
+	ResourceCache& operator=(ResourceCache const& copyFrom) = delete;
+	~ResourceCache();
+
+	bool	Find(std::string const& key, ResourceType& out_resource); //False unless cached and ready; counts as a use for eviction order
+	bool	IsCached(std::string const& key) const;
+	bool	IsLoading(std::string const& key) const;
+
+	ResourceHandle<ResourceType>	Acquire(std::string const& key); //Empty if the key is not cached
+	ResourceHandle<ResourceType>	Add(std::string const& key, ResourceType resource, size_t sizeBytes); //The key must not be cached yet
+
+	//For loads that finish later: the entry reports LOADING, and Get returns the placeholder, until FinishLoad is called with
+	//the resource. A failed load passes failed = true; the entry leaves the cache and its handles are detached.
+	ResourceHandle<ResourceType>	AddLoading(std::string const& key, ResourceType placeholder);
+	void							FinishLoad(ResourceHandle<ResourceType> const& handle, ResourceType resource, size_t sizeBytes, bool failed = false);
+
+	void	Pin(ResourceType resource);
+	void	Unpin(ResourceType resource); //Undoes one Pin; once none are left an unreferenced resource may be evicted
+
+	void	SetBudgetBytes(size_t budgetBytes);
+	size_t	GetBudgetBytes() const { return m_config.m_budgetBytes; }
+	size_t	GetMemoryUsedBytes() const { return m_memoryUsedBytes; }
+	int		GetNumEntries() const { return static_cast<int>(m_entriesByKey.size()); }
+	int		GetNumEvictableEntries() const { return static_cast<int>(m_evictableEntries.size()); }
+
+	void	TrimToBudget();
+	void	EvictAllUnreferenced();
+	void	Clear(); //Destroys every resource, referenced or not, and detaches the handles still alive
+
+protected:
+	struct Entry : public AssetLoadStatus<ResourceType>
+	{
+		std::string								m_key;
+		size_t									m_sizeBytes = 0;
+		ResourceCache*							m_cache = nullptr; //Null once detached; the last handle then deletes the entry
+		int										m_numHandles = 0;
+		int										m_numPins = 0;
+		bool									m_isEvictable = false;
+		typename std::list<Entry*>::iterator	m_evictablePosition;
+	};
+
+	Entry*	CreateEntry(std::string const& key);
+	void	DetachEntry(Entry* entry); //Takes the entry out of the cache; it lives on, FAILED, until its last handle is released
+
+	static void	AddHandleReference(AssetLoadStatus<ResourceType>* status);
+	static void	ReleaseHandleReference(AssetLoadStatus<ResourceType>* status);
+	void	UpdateEvictable(Entry* entry); //Moves the entry on or off the LRU list to match its references, then trims
+	void	DestroyEntry(Entry* entry);
+
+protected:
+	ResourceCacheConfig m_config;
+	ResourceDestroyFunction m_destroyFunction;
+	std::unordered_map<std::string, Entry*> m_entriesByKey;
+	std::unordered_map<ResourceType, Entry*> m_entriesByResource; //Ready entries only
+	std::list<Entry*> m_evictableEntries; //Most recently used at the front
+	size_t m_memoryUsedBytes = 0;
+};
+
+template<typename ResourceType>
+ResourceHandle<ResourceType>::ResourceHandle(AssetLoadStatus<ResourceType>* status)
+	: AssetHandle<ResourceType>(status)
+{
+	ResourceCache<ResourceType>::AddHandleReference(this->m_status);
+}
+
+template<typename ResourceType>
+ResourceHandle<ResourceType>::ResourceHandle(ResourceHandle const& copyFrom)
+	: AssetHandle<ResourceType>(copyFrom)
+{
+	if (this->m_status)
+	{
+		ResourceCache<ResourceType>::AddHandleReference(this->m_status);
+	}
+}
+
+template<typename ResourceType>
+ResourceHandle<ResourceType>::ResourceHandle(ResourceHandle&& moveFrom) noexcept
+	: AssetHandle<ResourceType>(moveFrom)
+{
+	moveFrom.m_status = nullptr;
+}
+
+template<typename ResourceType>
+ResourceHandle<ResourceType>::~ResourceHandle()
+{
+	Release();
+}
+
+template<typename ResourceType>
+ResourceHandle<ResourceType>& ResourceHandle<ResourceType>::operator=(ResourceHandle assignFrom) noexcept
+{
+	std::swap(this->m_status, assignFrom.m_status);
+	return *this;
+}
+
+template<typename ResourceType>
+void ResourceHandle<ResourceType>::Release()
+{
+	if (this->m_status)
+	{
+		ResourceCache<ResourceType>::ReleaseHandleReference(this->m_status);
+	}
+	this->m_status = nullptr;
+}
+
+template<typename ResourceType>
+ResourceCache<ResourceType>::ResourceCache(ResourceCacheConfig const& config, ResourceDestroyFunction destroyFunction)
+	: m_config(config)
+	, m_destroyFunction(std::move(destroyFunction))
+{
+}
+
+template<typename ResourceType>
+ResourceCache<ResourceType>::~ResourceCache()
+{
+	Clear();
+}
+
+template<typename ResourceType>
+bool ResourceCache<ResourceType>::Find(std::string const& key, ResourceType& out_resource)
+{
+	auto found = m_entriesByKey.find(key);
+	if (found == m_entriesByKey.end() || found->second->m_state.load(std::memory_order_relaxed) != AssetLoadState::READY)
+	{
+		return false;
+	}
+
+	Entry* entry = found->second;
+	if (entry->m_isEvictable)
+	{
+		m_evictableEntries.splice(m_evictableEntries.begin(), m_evictableEntries, entry->m_evictablePosition);
+	}
+	out_resource = entry->m_asset;
+	return true;
+}
+
+template<typename ResourceType>
+bool ResourceCache<ResourceType>::IsCached(std::string const& key) const
+{
+	return m_entriesByKey.find(key) != m_entriesByKey.end();
+}
+
+template<typename ResourceType>
+bool ResourceCache<ResourceType>::IsLoading(std::string const& key) const
+{
+	auto found = m_entriesByKey.find(key);
+	return found != m_entriesByKey.end() && found->second->m_state.load(std::memory_order_relaxed) == AssetLoadState::LOADING;
+}
+
+template<typename ResourceType>
+ResourceHandle<ResourceType> ResourceCache<ResourceType>::Acquire(std::string const& key)
+{
+	auto found = m_entriesByKey.find(key);
+	if (found == m_entriesByKey.end())
+	{
+		return ResourceHandle<ResourceType>();
+	}
+	return ResourceHandle<ResourceType>(found->second);
+}
+
+template<typename ResourceType>
+ResourceHandle<ResourceType> ResourceCache<ResourceType>::Add(std::string const& key, ResourceType resource, size_t sizeBytes)
+{
+	Entry* entry = CreateEntry(key);
+	entry->m_asset = resource;
+	entry->m_sizeBytes = sizeBytes;
+	entry->m_state.store(AssetLoadState::READY, std::memory_order_release);
+	m_entriesByResource[resource] = entry;
+	m_memoryUsedBytes += sizeBytes;
+	TrimToBudget();
+	return ResourceHandle<ResourceType>(entry);
+}
+
+template<typename ResourceType>
+ResourceHandle<ResourceType> ResourceCache<ResourceType>::AddLoading(std::string const& key, ResourceType placeholder)
+{
+	Entry* entry = CreateEntry(key);
+	entry->m_placeholder = placeholder;
+	return ResourceHandle<ResourceType>(entry);
+}
+
+template<typename ResourceType>
+void ResourceCache<ResourceType>::FinishLoad(ResourceHandle<ResourceType> const& handle, ResourceType resource, size_t sizeBytes, bool failed)
+{
+	Entry* entry = static_cast<Entry*>(handle.m_status);
+	GUARANTEE_OR_DIE(entry != nullptr && entry->m_cache == this && entry->m_state.load(std::memory_order_relaxed) == AssetLoadState::LOADING, "FinishLoad needs a handle to a loading entry of this cache");
+	if (failed)
+	{
+		DetachEntry(entry);
+		return;
+	}
+
+	entry->m_asset = resource;
+	entry->m_sizeBytes = sizeBytes;
+	entry->m_state.store(AssetLoadState::READY, std::memory_order_release);
+	m_entriesByResource[resource] = entry;
+	m_memoryUsedBytes += sizeBytes;
+	UpdateEvictable(entry);
+	TrimToBudget();
+}
+
+template<typename ResourceType>
+void ResourceCache<ResourceType>::Pin(ResourceType resource)
+{
+	auto found = m_entriesByResource.find(resource);
+	if (found != m_entriesByResource.end())
+	{
+		found->second->m_numPins++;
+		UpdateEvictable(found->second);
+	}
+}
+
+template<typename ResourceType>
+void ResourceCache<ResourceType>::Unpin(ResourceType resource)
+{
+	auto found = m_entriesByResource.find(resource);
+	if (found != m_entriesByResource.end())
+	{
+		GUARANTEE_OR_DIE(found->second->m_numPins > 0, "Resource \"" + found->second->m_key + "\" was unpinned more times than it was pinned");
+		found->second->m_numPins--;
+		UpdateEvictable(found->second);
+	}
+}
+
+template<typename ResourceType>
+void ResourceCache<ResourceType>::SetBudgetBytes(size_t budgetBytes)
+{
+	m_config.m_budgetBytes = budgetBytes;
+	TrimToBudget();
+}
+
+template<typename ResourceType>
+void ResourceCache<ResourceType>::TrimToBudget()
+{
+	while (m_config.m_budgetBytes > 0 && m_memoryUsedBytes > m_config.m_budgetBytes && !m_evictableEntries.empty())
+	{
+		DestroyEntry(m_evictableEntries.back());
+	}
+}
+
+template<typename ResourceType>
+void ResourceCache<ResourceType>::EvictAllUnreferenced()
+{
+	while (!m_evictableEntries.empty())
+	{
+		DestroyEntry(m_evictableEntries.back());
+	}
+}
+
+template<typename ResourceType>
+void ResourceCache<ResourceType>::Clear()
+{
+	for (auto& keyAndEntry : m_entriesByKey)
+	{
+		Entry* entry = keyAndEntry.second;
+		if (entry->m_state.load(std::memory_order_relaxed) == AssetLoadState::READY)
+		{
+			m_destroyFunction(entry->m_asset);
+		}
+		if (entry->m_numHandles > 0)
+		{
+			entry->m_cache = nullptr;
+			entry->m_state.store(AssetLoadState::FAILED, std::memory_order_release);
+		}
+		else
+		{
+			delete entry;
+		}
+	}
+	m_entriesByKey.clear();
+	m_entriesByResource.clear();
+	m_evictableEntries.clear();
+	m_memoryUsedBytes = 0;
+}
+
+template<typename ResourceType>
+typename ResourceCache<ResourceType>::Entry* ResourceCache<ResourceType>::CreateEntry(std::string const& key)
+{
+	Entry*& entry = m_entriesByKey[key];
+	GUARANTEE_OR_DIE(entry == nullptr, "Resource \"" + key + "\" is already cached");
+	entry = new Entry();
+	entry->m_key = key;
+	entry->m_cache = this;
+	return entry;
+}
+
+template<typename ResourceType>
+void ResourceCache<ResourceType>::DetachEntry(Entry* entry)
+{
+	if (entry->m_isEvictable)
+	{
+		m_evictableEntries.erase(entry->m_evictablePosition);
+		entry->m_isEvictable = false;
+	}
+	m_entriesByKey.erase(entry->m_key);
+	entry->m_cache = nullptr;
+	entry->m_state.store(AssetLoadState::FAILED, std::memory_order_release);
+	if (entry->m_numHandles == 0)
+	{
+		delete entry;
+	}
+}
+
+template<typename ResourceType>
+void ResourceCache<ResourceType>::AddHandleReference(AssetLoadStatus<ResourceType>* status)
+{
+	Entry* entry = static_cast<Entry*>(status);
+	entry->m_numHandles++;
+	if (entry->m_cache && entry->m_isEvictable)
+	{
+		entry->m_cache->UpdateEvictable(entry);
+	}
+}
+
+template<typename ResourceType>
+void ResourceCache<ResourceType>::ReleaseHandleReference(AssetLoadStatus<ResourceType>* status)
+{
+	Entry* entry = static_cast<Entry*>(status);
+	entry->m_numHandles--;
+	if (entry->m_numHandles > 0)
+	{
+		return;
+	}
+	if (entry->m_cache)
+	{
+		entry->m_cache->UpdateEvictable(entry);
+	}
+	else
+	{
+		delete entry;
+	}
+}
+
+template<typename ResourceType>
+void ResourceCache<ResourceType>::UpdateEvictable(Entry* entry)
+{
+	bool isReferenced = entry->m_numHandles > 0 || entry->m_numPins > 0 || entry->m_state.load(std::memory_order_relaxed) == AssetLoadState::LOADING;
+	if (isReferenced && entry->m_isEvictable)
+	{
+		m_evictableEntries.erase(entry->m_evictablePosition);
+		entry->m_isEvictable = false;
+	}
+	else if (!isReferenced && !entry->m_isEvictable)
+	{
+		entry->m_evictablePosition = m_evictableEntries.insert(m_evictableEntries.begin(), entry);
+		entry->m_isEvictable = true;
+		TrimToBudget();
+	}
+}
+
+template<typename ResourceType>
+void ResourceCache<ResourceType>::DestroyEntry(Entry* entry)
+{
+	if (entry->m_isEvictable)
+	{
+		m_evictableEntries.erase(entry->m_evictablePosition);
+	}
+	if (entry->m_state.load(std::memory_order_relaxed) == AssetLoadState::READY)
+	{
+		m_entriesByResource.erase(entry->m_asset);
+		m_memoryUsedBytes -= entry->m_sizeBytes;
+		m_destroyFunction(entry->m_asset);
+	}
+	m_entriesByKey.erase(entry->m_key);
+	delete entry;
+}
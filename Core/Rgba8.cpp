@@ -32,20 +32,21 @@ bool Rgba8::operator==(const Rgba8& rhs) const
 	return false;
 }
 
-void Rgba8::SetFromText(char const* text)
+void Rgba8::SetFromText(std::string_view text)
 {
-	Strings variables = SplitStringOnDelimiter(text, ',');
-	if ((variables.size() != 3 && variables.size() != 4) || variables[0].c_str() == nullptr || variables[1].c_str() == nullptr || variables[2].c_str() == nullptr)
+	std::string_view variables[4];
+	int numVariables = SplitStringViewOnDelimiter(text, ',', variables, 4);
+	if (numVariables != 3 && numVariables != 4)
 	{
 		ERROR_AND_DIE("Invalid arguments passed into RGBA8 String");
 	}
-	r = static_cast<unsigned char>(atoi(variables[0].c_str()));
-	g = static_cast<unsigned char>(atoi(variables[1].c_str()));
-	b = static_cast<unsigned char>(atoi(variables[2].c_str()));
+	r = static_cast<unsigned char>(ParseInt(variables[0]));
+	g = static_cast<unsigned char>(ParseInt(variables[1]));
+	b = static_cast<unsigned char>(ParseInt(variables[2]));
 
-	if (variables.size() == 4 && variables[3].c_str() != nullptr)
+	if (numVariables == 4)
 	{
-		a = static_cast<unsigned char>(atoi(variables[3].c_str()));
+		a = static_cast<unsigned char>(ParseInt(variables[3]));
 	}
 	else
 	{
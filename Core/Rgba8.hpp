@@ -1,4 +1,5 @@
 #pragma once
+#include <string_view>
 
 struct Rgba8
 {
@@ -13,7 +14,7 @@ public:
 	Rgba8() {}												// default constructor (do nothing)	
 	explicit Rgba8(unsigned char initialR, unsigned char initialG, unsigned char initialB, unsigned char initialA);		// explicit constructor (from r,g,b,a)
 
-	void SetFromText(char const* text);
+	void SetFromText(std::string_view text);
 	void GetAsFloats(float* colorAsFloats) const;
 	bool operator==(const Rgba8& rhs) const;
 
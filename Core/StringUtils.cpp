@@ -1,5 +1,7 @@
 #include "Engine/Core/StringUtils.hpp"
 #include <stdarg.h>
+#include <algorithm>
+#include <charconv>
 
 
 //-----------------------------------------------------------------------------------------------
@@ -41,22 +43,129 @@ const std::string Stringf( int maxLength, char const* format, ... )
 	return returnValue;
 }
 
-Strings SplitStringOnDelimiter(std::string const& originalString, char delimiterToSplitOn)
+Strings SplitStringOnDelimiter(std::string_view originalString, char delimiterToSplitOn)
 {
 	Strings resultList;
-	std::string current = "";
-	for (int stringIndex = 0; stringIndex < static_cast<int>(originalString.size()); stringIndex++)
+	resultList.reserve(std::count(originalString.begin(), originalString.end(), delimiterToSplitOn) + 1);
+
+	StringTokenizer tokens(originalString, delimiterToSplitOn);
+	std::string_view token;
+	while (tokens.GetNextToken(token))
+	{
+		resultList.emplace_back(token);
+	}
+	return resultList;
+}
+
+StringTokenizer::StringTokenizer(std::string_view text, char delimiter)
+	: m_remainingText(text)
+	, m_delimiter(delimiter)
+{
+}
+
+bool StringTokenizer::GetNextToken(std::string_view& out_token)
+{
+	if (m_isFinished)
+	{
+		return false;
+	}
+
+	size_t delimiterIndex = m_remainingText.find(m_delimiter);
+	if (delimiterIndex == std::string_view::npos)
 	{
-		if (originalString[stringIndex] == delimiterToSplitOn)
+		out_token = m_remainingText;
+		m_remainingText = std::string_view();
+		m_isFinished = true;
+	}
+	else
+	{
+		out_token = m_remainingText.substr(0, delimiterIndex);
+		m_remainingText.remove_prefix(delimiterIndex + 1);
+	}
+	return true;
+}
+
+int SplitStringViewOnDelimiter(std::string_view text, char delimiterToSplitOn, std::string_view* out_tokens, int maxTokens)
+{
+	int numTokens = 0;
+	StringTokenizer tokens(text, delimiterToSplitOn);
+	std::string_view token;
+	while (tokens.GetNextToken(token))
+	{
+		if (numTokens < maxTokens)
 		{
-			resultList.push_back(std::string(current));
-			current = "";
+			out_tokens[numTokens] = token;
 		}
-		else
+		numTokens++;
+	}
+	return numTokens;
+}
+
+static bool IsWhitespace(char character)
+{
+	return character == ' ' || character == '\t' || character == '\n' || character == '\r' || character == '\f' || character == '\v';
+}
+
+std::string_view TrimWhitespace(std::string_view text)
+{
+	while (!text.empty() && IsWhitespace(text.front()))
+	{
+		text.remove_prefix(1);
+	}
+	while (!text.empty() && IsWhitespace(text.back()))
+	{
+		text.remove_suffix(1);
+	}
+	return text;
+}
+
+//from_chars accepts neither leading whitespace nor '+', which atoi and atof both skip
+static std::string_view SkipNumberPrefix(std::string_view text)
+{
+	while (!text.empty() && IsWhitespace(text.front()))
+	{
+		text.remove_prefix(1);
+	}
+	if (text.size() > 1 && text[0] == '+' && text[1] != '-')
+	{
+		text.remove_prefix(1);
+	}
+	return text;
+}
+
+int ParseInt(std::string_view text, int defaultValue)
+{
+	text = SkipNumberPrefix(text);
+	int base = 10;
+	if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+	{
+		text.remove_prefix(2);
+		base = 16;
+	}
+
+	int value = 0;
+	std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value, base);
+	return result.ec == std::errc() ? value : defaultValue;
+}
+
+float ParseFloat(std::string_view text, float defaultValue)
+{
+	text = SkipNumberPrefix(text);
+	bool isNegative = !text.empty() && text[0] == '-';
+	std::string_view digits = isNegative ? text.substr(1) : text;
+	if (digits.size() > 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X'))
+	{
+		digits.remove_prefix(2);
+		float hexValue = 0.f;
+		std::from_chars_result hexResult = std::from_chars(digits.data(), digits.data() + digits.size(), hexValue, std::chars_format::hex);
+		if (hexResult.ec != std::errc())
 		{
-			current += originalString[stringIndex];
+			return defaultValue;
 		}
+		return isNegative ? -hexValue : hexValue;
 	}
-	resultList.push_back(current);
-	return resultList;
+
+	float value = 0.f;
+	std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+	return result.ec == std::errc() ? value : defaultValue;
 }
\ No newline at end of file
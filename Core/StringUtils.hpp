@@ -1,6 +1,7 @@
 #pragma once
 //-----------------------------------------------------------------------------------------------
 #include <string>
+#include <string_view>
 #include <vector>
 
 
@@ -9,7 +10,35 @@ const std::string Stringf( char const* format, ... );
 const std::string Stringf( int maxLength, char const* format, ... );
 typedef std::vector< std::string >		Strings;
 
-Strings SplitStringOnDelimiter(std::string const& originalString, char delimiterToSplitOn);
+Strings SplitStringOnDelimiter(std::string_view originalString, char delimiterToSplitOn);
+
+//Walks the tokens of a string as views into it, without allocating. Yields the same tokens as SplitStringOnDelimiter, empty ones included,
+//so text with no delimiter is one token. The text must outlive the tokenizer and its tokens.
+//
+//	StringTokenizer tokens(text, ',');
+//	std::string_view token;
+//	while (tokens.GetNextToken(token)) { ... }
+class StringTokenizer
+{
+public:
+	StringTokenizer(std::string_view text, char delimiter);
+
+	bool	GetNextToken(std::string_view& out_token);
+
+protected:
+	std::string_view	m_remainingText;
+	char				m_delimiter = ',';
+	bool				m_isFinished = false;
+};
+
+//Writes at most maxTokens views into out_tokens and returns the full token count, so callers can check for an exact count
+int SplitStringViewOnDelimiter(std::string_view text, char delimiterToSplitOn, std::string_view* out_tokens, int maxTokens);
+std::string_view TrimWhitespace(std::string_view text);
+
+//std::from_chars based, with atoi/atof leniency: leading whitespace and a '+' are skipped, trailing characters are ignored,
+//and text that does not start with a number (or is out of range) gives defaultValue. Both also read a 0x hex prefix.
+int		ParseInt(std::string_view text, int defaultValue = 0);
+float	ParseFloat(std::string_view text, float defaultValue = 0.f);
 
 
 
@@ -3,6 +3,12 @@
 #include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Math/VertexUtils.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
 
 TileHeatMap::TileHeatMap()
 {
@@ -49,6 +55,11 @@ int TileHeatMap::GetSize() const
 	return m_dimensions.x * m_dimensions.y;
 }
 
+IntVec2 TileHeatMap::GetDimensions() const
+{
+	return m_dimensions;
+}
+
 float TileHeatMap::GetHighestNonSolidValue() const
 {
 	float max = 0.f;
@@ -66,6 +77,7 @@ void TileHeatMap::AddVertsForDebugDraw(std::vector<Vertex_PCU>& vertexArray, AAB
 {
 	float tileWidth = (totalBounds.m_maxs.x - totalBounds.m_mins.x)/m_dimensions.x;
 	float tileHeight = (totalBounds.m_maxs.y - totalBounds.m_mins.y)/m_dimensions.y;
+	vertexArray.reserve(vertexArray.size() + GetSize() * GetNumVertsForAABB2D());
 
 	for (int y = 0; y < m_dimensions.y; y++)
 	{
@@ -87,3 +99,285 @@ void TileHeatMap::AddVertsForDebugDraw(std::vector<Vertex_PCU>& vertexArray, AAB
 		}
 	}
 }
+
+//Distance fields /////////////////////////////////////////////////////////////////////////////////
+constexpr int UNREACHED_DISTANCE = INT_MAX;
+constexpr int SERIAL_DISTANCE_FIELD_MAX_TILES = 128 * 128;
+constexpr int DISTANCE_FIELD_MIN_TILES_PER_CHUNK = 256;
+
+void TileHeatMap::GenerateDistanceField(std::vector<bool> const& solidTiles, std::vector<IntVec2> const& seedTiles, float unreachableValue, std::vector<unsigned char> const* tileEntryCosts)
+{
+	int numTiles = GetSize();
+	GUARANTEE_OR_DIE(static_cast<int>(solidTiles.size()) >= numTiles, "TileHeatMap::GenerateDistanceField solidity mask is smaller than the heat map");
+	GUARANTEE_OR_DIE(tileEntryCosts == nullptr || static_cast<int>(tileEntryCosts->size()) >= numTiles, "TileHeatMap::GenerateDistanceField entry costs are smaller than the heat map");
+
+	//Dial's algorithm: every distance is an integer and no step costs more than maxCost, so maxCost + 1 rotating buckets hold the whole open set
+	int maxCost = 1;
+	if (tileEntryCosts)
+	{
+		for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+		{
+			maxCost = std::max(maxCost, static_cast<int>((*tileEntryCosts)[tileIndex]));
+		}
+	}
+	int numBuckets = maxCost + 1;
+	std::vector<std::vector<int>> buckets(numBuckets);
+	std::vector<int> distances(numTiles, UNREACHED_DISTANCE);
+	int numQueued = 0;
+
+	for (IntVec2 const& seed : seedTiles)
+	{
+		if (seed.x < 0 || seed.y < 0 || seed.x >= m_dimensions.x || seed.y >= m_dimensions.y)
+		{
+			continue;
+		}
+		int seedIndex = seed.y * m_dimensions.x + seed.x;
+		if (solidTiles[seedIndex] || distances[seedIndex] == 0)
+		{
+			continue;
+		}
+		distances[seedIndex] = 0;
+		buckets[0].push_back(seedIndex);
+		numQueued++;
+	}
+
+	IntVec2 const stepOffsets[4] = { IntVec2(1, 0), IntVec2(-1, 0), IntVec2(0, 1), IntVec2(0, -1) };
+	for (int currentDistance = 0; numQueued > 0; currentDistance++)
+	{
+		//Costs are at least 1, so nothing relaxed from this bucket can land back in it
+		std::vector<int>& bucket = buckets[currentDistance % numBuckets];
+		for (int bucketIndex = 0; bucketIndex < static_cast<int>(bucket.size()); bucketIndex++)
+		{
+			int tileIndex = bucket[bucketIndex];
+			numQueued--;
+			if (distances[tileIndex] != currentDistance)
+			{
+				continue;
+			}
+
+			int tileX = tileIndex % m_dimensions.x;
+			int tileY = tileIndex / m_dimensions.x;
+			for (IntVec2 const& offset : stepOffsets)
+			{
+				int neighborX = tileX + offset.x;
+				int neighborY = tileY + offset.y;
+				if (neighborX < 0 || neighborY < 0 || neighborX >= m_dimensions.x || neighborY >= m_dimensions.y)
+				{
+					continue;
+				}
+				int neighborIndex = neighborY * m_dimensions.x + neighborX;
+				if (solidTiles[neighborIndex])
+				{
+					continue;
+				}
+
+				int stepCost = tileEntryCosts ? std::max(1, static_cast<int>((*tileEntryCosts)[neighborIndex])) : 1;
+				int neighborDistance = currentDistance + stepCost;
+				if (neighborDistance < distances[neighborIndex])
+				{
+					distances[neighborIndex] = neighborDistance;
+					buckets[neighborDistance % numBuckets].push_back(neighborIndex);
+					numQueued++;
+				}
+			}
+		}
+		bucket.clear();
+	}
+
+	for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+	{
+		m_values[tileIndex] = distances[tileIndex] == UNREACHED_DISTANCE ? unreachableValue : static_cast<float>(distances[tileIndex]);
+	}
+}
+
+void TileHeatMap::GenerateDistanceFieldParallel(std::vector<bool> const& solidTiles, std::vector<IntVec2> const& seedTiles, float unreachableValue, std::vector<unsigned char> const* tileEntryCosts)
+{
+	int numTiles = GetSize();
+	if (g_theJobSystem == nullptr || g_theJobSystem->GetNumThreads() <= 1 || numTiles <= SERIAL_DISTANCE_FIELD_MAX_TILES)
+	{
+		GenerateDistanceField(solidTiles, seedTiles, unreachableValue, tileEntryCosts);
+		return;
+	}
+	GUARANTEE_OR_DIE(static_cast<int>(solidTiles.size()) >= numTiles, "TileHeatMap::GenerateDistanceFieldParallel solidity mask is smaller than the heat map");
+	GUARANTEE_OR_DIE(tileEntryCosts == nullptr || static_cast<int>(tileEntryCosts->size()) >= numTiles, "TileHeatMap::GenerateDistanceFieldParallel entry costs are smaller than the heat map");
+
+	//Same buckets as the serial version, but each bucket is expanded with a ParallelFor. Everything relaxed from bucket d lands in a
+	//later bucket, so the tiles of bucket d are final while it runs and only the lowering of neighbors needs to be atomic.
+	int maxCost = 1;
+	if (tileEntryCosts)
+	{
+		for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+		{
+			maxCost = std::max(maxCost, static_cast<int>((*tileEntryCosts)[tileIndex]));
+		}
+	}
+	int numBuckets = maxCost + 1;
+	std::vector<std::vector<int>> buckets(numBuckets);
+	std::vector<std::atomic<int>> distances(numTiles);
+	std::vector<int> queuedDistances(numTiles, UNREACHED_DISTANCE);
+	for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+	{
+		distances[tileIndex].store(UNREACHED_DISTANCE, std::memory_order_relaxed);
+	}
+	int numQueued = 0;
+
+	for (IntVec2 const& seed : seedTiles)
+	{
+		if (seed.x < 0 || seed.y < 0 || seed.x >= m_dimensions.x || seed.y >= m_dimensions.y)
+		{
+			continue;
+		}
+		int seedIndex = seed.y * m_dimensions.x + seed.x;
+		if (solidTiles[seedIndex] || queuedDistances[seedIndex] == 0)
+		{
+			continue;
+		}
+		distances[seedIndex].store(0, std::memory_order_relaxed);
+		queuedDistances[seedIndex] = 0;
+		buckets[0].push_back(seedIndex);
+		numQueued++;
+	}
+
+	//Each chunk collects the tiles it lowered; merging them afterwards on this thread keeps the buckets free of locks
+	int const maxNumChunks = g_theJobSystem->GetNumThreads() * 4;
+	std::vector<std::vector<int>> loweredTilesByChunk(maxNumChunks);
+	IntVec2 const dimensions = m_dimensions;
+	for (int currentDistance = 0; numQueued > 0; currentDistance++)
+	{
+		std::vector<int>& bucket = buckets[currentDistance % numBuckets];
+		int numBucketTiles = static_cast<int>(bucket.size());
+		if (numBucketTiles == 0)
+		{
+			continue;
+		}
+		numQueued -= numBucketTiles;
+
+		//Small wavefronts run in one chunk on this thread rather than paying for jobs
+		int numChunks = std::min(maxNumChunks, (numBucketTiles + DISTANCE_FIELD_MIN_TILES_PER_CHUNK - 1) / DISTANCE_FIELD_MIN_TILES_PER_CHUNK);
+		int chunkSize = (numBucketTiles + numChunks - 1) / numChunks;
+		g_theJobSystem->ParallelFor(0, numChunks, [&](int chunkIndex)
+			{
+				IntVec2 const stepOffsets[4] = { IntVec2(1, 0), IntVec2(-1, 0), IntVec2(0, 1), IntVec2(0, -1) };
+				std::vector<int>& loweredTiles = loweredTilesByChunk[chunkIndex];
+				int chunkEnd = std::min(numBucketTiles, (chunkIndex + 1) * chunkSize);
+				for (int bucketIndex = chunkIndex * chunkSize; bucketIndex < chunkEnd; bucketIndex++)
+				{
+					int tileIndex = bucket[bucketIndex];
+					if (distances[tileIndex].load(std::memory_order_relaxed) != currentDistance)
+					{
+						continue;
+					}
+
+					int tileX = tileIndex % dimensions.x;
+					int tileY = tileIndex / dimensions.x;
+					for (IntVec2 const& offset : stepOffsets)
+					{
+						int neighborX = tileX + offset.x;
+						int neighborY = tileY + offset.y;
+						if (neighborX < 0 || neighborY < 0 || neighborX >= dimensions.x || neighborY >= dimensions.y)
+						{
+							continue;
+						}
+						int neighborIndex = neighborY * dimensions.x + neighborX;
+						if (solidTiles[neighborIndex])
+						{
+							continue;
+						}
+
+						int stepCost = tileEntryCosts ? std::max(1, static_cast<int>((*tileEntryCosts)[neighborIndex])) : 1;
+						int neighborDistance = currentDistance + stepCost;
+						int oldDistance = distances[neighborIndex].load(std::memory_order_relaxed);
+						while (neighborDistance < oldDistance)
+						{
+							if (distances[neighborIndex].compare_exchange_weak(oldDistance, neighborDistance, std::memory_order_relaxed))
+							{
+								loweredTiles.push_back(neighborIndex);
+								break;
+							}
+						}
+					}
+				}
+			}, 1);
+		bucket.clear();
+
+		//A tile lowered by several chunks is queued once, in the bucket of the lowest distance it reached
+		for (int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+		{
+			for (int tileIndex : loweredTilesByChunk[chunkIndex])
+			{
+				int distance = distances[tileIndex].load(std::memory_order_relaxed);
+				if (queuedDistances[tileIndex] != distance)
+				{
+					queuedDistances[tileIndex] = distance;
+					buckets[distance % numBuckets].push_back(tileIndex);
+					numQueued++;
+				}
+			}
+			loweredTilesByChunk[chunkIndex].clear();
+		}
+	}
+
+	for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+	{
+		int distance = distances[tileIndex].load(std::memory_order_relaxed);
+		m_values[tileIndex] = distance == UNREACHED_DISTANCE ? unreachableValue : static_cast<float>(distance);
+	}
+}
+
+void TileHeatMap::GenerateFlowField(std::vector<Vec2>& flowDirections, float unreachableValue) const
+{
+	int numTiles = GetSize();
+	flowDirections.assign(numTiles, Vec2());
+	float const diagonalLength = sqrtf(2.f);
+	for (int tileY = 0; tileY < m_dimensions.y; tileY++)
+	{
+		for (int tileX = 0; tileX < m_dimensions.x; tileX++)
+		{
+			int tileIndex = tileY * m_dimensions.x + tileX;
+			float lowestValue = m_values[tileIndex];
+			if (lowestValue >= unreachableValue)
+			{
+				continue;
+			}
+
+			auto isOpen = [&](int x, int y)
+				{
+					return x >= 0 && y >= 0 && x < m_dimensions.x && y < m_dimensions.y && m_values[y * m_dimensions.x + x] < unreachableValue;
+				};
+
+			//Cardinals first so a diagonal only wins when it is strictly lower, and only when both tiles beside it are open
+			IntVec2 bestOffset;
+			IntVec2 const offsets[8] = { IntVec2(1, 0), IntVec2(-1, 0), IntVec2(0, 1), IntVec2(0, -1), IntVec2(1, 1), IntVec2(-1, 1), IntVec2(1, -1), IntVec2(-1, -1) };
+			for (int offsetIndex = 0; offsetIndex < 8; offsetIndex++)
+			{
+				IntVec2 const& offset = offsets[offsetIndex];
+				int neighborX = tileX + offset.x;
+				int neighborY = tileY + offset.y;
+				if (!isOpen(neighborX, neighborY))
+				{
+					continue;
+				}
+				if (offset.x != 0 && offset.y != 0 && (!isOpen(tileX + offset.x, tileY) || !isOpen(tileX, tileY + offset.y)))
+				{
+					continue;
+				}
+
+				float neighborValue = m_values[neighborY * m_dimensions.x + neighborX];
+				if (neighborValue < lowestValue)
+				{
+					lowestValue = neighborValue;
+					bestOffset = offset;
+				}
+			}
+
+			if (bestOffset.x != 0 && bestOffset.y != 0)
+			{
+				flowDirections[tileIndex] = Vec2(static_cast<float>(bestOffset.x), static_cast<float>(bestOffset.y)) / diagonalLength;
+			}
+			else
+			{
+				flowDirections[tileIndex] = Vec2(static_cast<float>(bestOffset.x), static_cast<float>(bestOffset.y));
+			}
+		}
+	}
+}
@@ -1,4 +1,5 @@
 #include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec2.hpp"
 #include "Engine/Math/FloatRange.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include <vector>
@@ -18,8 +19,22 @@ public:
 	void	SetTileHeatValue(int tileIndex, float heatValue);
 	float	GetTileHeatValue(int tileIndex) const;
 	int		GetSize() const;
+	IntVec2	GetDimensions() const;
 	float	GetHighestNonSolidValue() const;
 
+	//Distance fields: every tile gets its step distance (4-connected) from the nearest seed. Solid tiles, tiles no seed reaches
+	//and seeds on solid tiles get unreachableValue. solidTiles and tileEntryCosts are indexed like the heat map, y * width + x.
+	//The serial version runs on a bucket queue; tileEntryCosts (each at least 1) makes entering that tile cost more than one step.
+	void	GenerateDistanceField(std::vector<bool> const& solidTiles, std::vector<IntVec2> const& seedTiles, float unreachableValue = 999999.f, std::vector<unsigned char> const* tileEntryCosts = nullptr);
+
+	//Same result as the serial version, entry costs included, with each bucket expanded by a g_theJobSystem ParallelFor.
+	//Worth it on large open maps; small maps, or no job system or no worker threads, fall back to the serial version.
+	void	GenerateDistanceFieldParallel(std::vector<bool> const& solidTiles, std::vector<IntVec2> const& seedTiles, float unreachableValue = 999999.f, std::vector<unsigned char> const* tileEntryCosts = nullptr);
+
+	//Unit direction per tile toward its lowest neighbor, diagonals included when neither side is blocked. Seeds, blocked tiles and
+	//local minimums get (0, 0). Agents can follow this instead of pathing individually.
+	void	GenerateFlowField(std::vector<Vec2>& flowDirections, float unreachableValue = 999999.f) const;
+
 	void	AddVertsForDebugDraw(std::vector<Vertex_PCU>& vertexArray, AABB2 totalBounds, FloatRange valueRange = FloatRange(0.f, 1.f), Rgba8 lowColor = Rgba8(0, 0, 0, 100), Rgba8 highColor = Rgba8(255, 255, 255, 100), float specialValue = 999999.f, Rgba8 specialColor = Rgba8(255, 0, 255, 255)) const;
 
 private:
@@ -0,0 +1,483 @@
+#include "TilePathfinder.hpp"
+#include "Engine/Core/TileHeatMap.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <algorithm>
+#include <cmath>
+
+constexpr float DIAGONAL_STEP_COST = 1.41421356f;
+constexpr int NO_JUMP_POINT = -1;
+
+//Min-heap on f; ties go to the entry further from the start so searches across open ground run straight at the goal
+static bool IsOpenEntryWorse(TilePathOpenEntry const& entryA, TilePathOpenEntry const& entryB)
+{
+	if (entryA.m_fCost != entryB.m_fCost)
+	{
+		return entryA.m_fCost > entryB.m_fCost;
+	}
+	return entryA.m_gCost < entryB.m_gCost;
+}
+
+static int GetStepSign(int value)
+{
+	return value > 0 ? 1 : (value < 0 ? -1 : 0);
+}
+
+TilePathfinder::TilePathfinder(IntVec2 const& dimensions)
+	: m_dimensions(dimensions)
+{
+	int numTiles = dimensions.x * dimensions.y;
+	m_paddedWidth = dimensions.x + 2;
+	m_walkableTiles.resize(m_paddedWidth * (dimensions.y + 2), 0);
+	for (int tileY = 0; tileY < dimensions.y; tileY++)
+	{
+		for (int tileX = 0; tileX < dimensions.x; tileX++)
+		{
+			m_walkableTiles[(tileY + 1) * m_paddedWidth + tileX + 1] = 1;
+		}
+	}
+	m_nodes.resize(numTiles);
+}
+
+void TilePathfinder::SetSolidTiles(std::vector<bool> const& solidTiles)
+{
+	GUARANTEE_OR_DIE(static_cast<int>(solidTiles.size()) >= m_dimensions.x * m_dimensions.y, "TilePathfinder::SetSolidTiles mask is smaller than the grid");
+	for (int tileY = 0; tileY < m_dimensions.y; tileY++)
+	{
+		for (int tileX = 0; tileX < m_dimensions.x; tileX++)
+		{
+			m_walkableTiles[(tileY + 1) * m_paddedWidth + tileX + 1] = solidTiles[tileY * m_dimensions.x + tileX] ? 0 : 1;
+		}
+	}
+	m_areJumpDistancesDirty = true;
+}
+
+void TilePathfinder::SetTileSolid(IntVec2 const& tileCoords, bool isSolid)
+{
+	GUARANTEE_OR_DIE(tileCoords.x >= 0 && tileCoords.y >= 0 && tileCoords.x < m_dimensions.x && tileCoords.y < m_dimensions.y, "TilePathfinder::SetTileSolid tile is outside the grid");
+	m_walkableTiles[(tileCoords.y + 1) * m_paddedWidth + tileCoords.x + 1] = isSolid ? 0 : 1;
+	m_areJumpDistancesDirty = true;
+}
+
+bool TilePathfinder::IsTileSolid(IntVec2 const& tileCoords) const
+{
+	if (tileCoords.x < 0 || tileCoords.y < 0 || tileCoords.x >= m_dimensions.x || tileCoords.y >= m_dimensions.y)
+	{
+		return true;
+	}
+	return !IsWalkable(tileCoords.x, tileCoords.y);
+}
+
+void TilePathfinder::SetTileCosts(std::vector<unsigned char> const& tileEntryCosts)
+{
+	GUARANTEE_OR_DIE(static_cast<int>(tileEntryCosts.size()) >= m_dimensions.x * m_dimensions.y, "TilePathfinder::SetTileCosts costs are smaller than the grid");
+	m_tileCosts.assign(tileEntryCosts.begin(), tileEntryCosts.begin() + m_dimensions.x * m_dimensions.y);
+	for (unsigned char& cost : m_tileCosts)
+	{
+		cost = std::max(cost, static_cast<unsigned char>(1));
+	}
+}
+
+void TilePathfinder::ClearTileCosts()
+{
+	m_tileCosts.clear();
+}
+
+IntVec2 TilePathfinder::GetDimensions() const
+{
+	return m_dimensions;
+}
+
+bool TilePathfinder::FindPathAStar(IntVec2 const& start, IntVec2 const& goal, std::vector<IntVec2>& path, TileHeatMap const* heuristicMap, float heuristicScale)
+{
+	if (!BeginQuery(start, goal, path))
+	{
+		return false;
+	}
+	GUARANTEE_OR_DIE(heuristicMap == nullptr || heuristicMap->GetSize() == m_dimensions.x * m_dimensions.y, "TilePathfinder heuristic map does not match the grid");
+
+	int goalIndex = goal.y * m_dimensions.x + goal.x;
+	PushOpen(start.y * m_dimensions.x + start.x, 0.f, GetOctileDistance(start.x, start.y, goal.x, goal.y), -1);
+
+	IntVec2 const stepOffsets[8] = { IntVec2(1, 0), IntVec2(-1, 0), IntVec2(0, 1), IntVec2(0, -1), IntVec2(1, 1), IntVec2(-1, 1), IntVec2(1, -1), IntVec2(-1, -1) };
+	while (!m_openHeap.empty())
+	{
+		int tileIndex = PopOpen();
+		if (tileIndex < 0)
+		{
+			continue;
+		}
+		if (tileIndex == goalIndex)
+		{
+			BuildPath(goalIndex, path);
+			return true;
+		}
+
+		int tileX = tileIndex % m_dimensions.x;
+		int tileY = tileIndex / m_dimensions.x;
+		float tileGCost = m_nodes[tileIndex].m_gCost;
+		for (IntVec2 const& offset : stepOffsets)
+		{
+			int neighborX = tileX + offset.x;
+			int neighborY = tileY + offset.y;
+			if (!IsWalkable(neighborX, neighborY))
+			{
+				continue;
+			}
+			bool isDiagonal = offset.x != 0 && offset.y != 0;
+			if (isDiagonal && (!IsWalkable(tileX + offset.x, tileY) || !IsWalkable(tileX, tileY + offset.y)))
+			{
+				continue;
+			}
+
+			int neighborIndex = neighborY * m_dimensions.x + neighborX;
+			float stepCost = isDiagonal ? DIAGONAL_STEP_COST : 1.f;
+			if (!m_tileCosts.empty())
+			{
+				stepCost *= static_cast<float>(m_tileCosts[neighborIndex]);
+			}
+
+			TilePathNode& neighbor = GetNode(neighborIndex);
+			float neighborGCost = tileGCost + stepCost;
+			if (neighbor.m_isClosed || (neighbor.m_parentIndex >= 0 && neighborGCost >= neighbor.m_gCost))
+			{
+				continue;
+			}
+
+			float hCost = GetOctileDistance(neighborX, neighborY, goal.x, goal.y);
+			if (heuristicMap)
+			{
+				hCost = std::max(hCost, heuristicMap->GetTileHeatValue(neighborIndex) * heuristicScale);
+			}
+			PushOpen(neighborIndex, neighborGCost, hCost, tileIndex);
+		}
+	}
+	return false;
+}
+
+bool TilePathfinder::FindPathJPS(IntVec2 const& start, IntVec2 const& goal, std::vector<IntVec2>& path)
+{
+	if (!m_tileCosts.empty())
+	{
+		return FindPathAStar(start, goal, path);
+	}
+	if (m_areJumpDistancesDirty)
+	{
+		RebuildJumpDistances();
+	}
+	if (!BeginQuery(start, goal, path))
+	{
+		return false;
+	}
+
+	int goalIndex = goal.y * m_dimensions.x + goal.x;
+	PushOpen(start.y * m_dimensions.x + start.x, 0.f, GetOctileDistance(start.x, start.y, goal.x, goal.y), -1);
+
+	IntVec2 const allOffsets[8] = { IntVec2(1, 0), IntVec2(-1, 0), IntVec2(0, 1), IntVec2(0, -1), IntVec2(1, 1), IntVec2(-1, 1), IntVec2(1, -1), IntVec2(-1, -1) };
+	while (!m_openHeap.empty())
+	{
+		int tileIndex = PopOpen();
+		if (tileIndex < 0)
+		{
+			continue;
+		}
+		if (tileIndex == goalIndex)
+		{
+			BuildPath(goalIndex, path);
+			return true;
+		}
+
+		int tileX = tileIndex % m_dimensions.x;
+		int tileY = tileIndex / m_dimensions.x;
+		TilePathNode const& node = m_nodes[tileIndex];
+
+		//Prune to the natural and forced neighbors of the direction we arrived from; the start node looks every way
+		IntVec2 directions[8];
+		int numDirections = 0;
+		if (node.m_parentIndex < 0)
+		{
+			for (IntVec2 const& offset : allOffsets)
+			{
+				directions[numDirections++] = offset;
+			}
+		}
+		else
+		{
+			int stepX = GetStepSign(tileX - node.m_parentIndex % m_dimensions.x);
+			int stepY = GetStepSign(tileY - node.m_parentIndex / m_dimensions.x);
+			if (stepX != 0 && stepY != 0)
+			{
+				directions[numDirections++] = IntVec2(0, stepY);
+				directions[numDirections++] = IntVec2(stepX, 0);
+				directions[numDirections++] = IntVec2(stepX, stepY);
+			}
+			else if (stepX != 0)
+			{
+				directions[numDirections++] = IntVec2(stepX, 0);
+				directions[numDirections++] = IntVec2(stepX, 1);
+				directions[numDirections++] = IntVec2(stepX, -1);
+				directions[numDirections++] = IntVec2(0, 1);
+				directions[numDirections++] = IntVec2(0, -1);
+			}
+			else
+			{
+				directions[numDirections++] = IntVec2(0, stepY);
+				directions[numDirections++] = IntVec2(1, stepY);
+				directions[numDirections++] = IntVec2(-1, stepY);
+				directions[numDirections++] = IntVec2(1, 0);
+				directions[numDirections++] = IntVec2(-1, 0);
+			}
+		}
+
+		float tileGCost = node.m_gCost;
+		for (int directionIndex = 0; directionIndex < numDirections; directionIndex++)
+		{
+			IntVec2 const& direction = directions[directionIndex];
+			if (direction.x != 0 && direction.y != 0 && (!IsWalkable(tileX + direction.x, tileY) || !IsWalkable(tileX, tileY + direction.y)))
+			{
+				continue;
+			}
+
+			int jumpIndex = NO_JUMP_POINT;
+			if (direction.x != 0 && direction.y != 0)
+			{
+				jumpIndex = JumpDiagonal(tileX + direction.x, tileY + direction.y, direction.x, direction.y, goal);
+			}
+			else
+			{
+				jumpIndex = JumpStraight(tileX, tileY, direction.x, direction.y, goal);
+			}
+			if (jumpIndex == NO_JUMP_POINT)
+			{
+				continue;
+			}
+
+			int jumpX = jumpIndex % m_dimensions.x;
+			int jumpY = jumpIndex / m_dimensions.x;
+			TilePathNode& jumpNode = GetNode(jumpIndex);
+			float jumpGCost = tileGCost + GetOctileDistance(tileX, tileY, jumpX, jumpY);
+			if (jumpNode.m_isClosed || (jumpNode.m_parentIndex >= 0 && jumpGCost >= jumpNode.m_gCost))
+			{
+				continue;
+			}
+			PushOpen(jumpIndex, jumpGCost, GetOctileDistance(jumpX, jumpY, goal.x, goal.y), tileIndex);
+		}
+	}
+	return false;
+}
+
+int TilePathfinder::GetNumNodesExpanded() const
+{
+	return m_numNodesExpanded;
+}
+
+float TilePathfinder::GetLastPathCost() const
+{
+	return m_lastPathCost;
+}
+
+bool TilePathfinder::IsWalkable(int tileX, int tileY) const
+{
+	return m_walkableTiles[(tileY + 1) * m_paddedWidth + tileX + 1] != 0;
+}
+
+float TilePathfinder::GetOctileDistance(int fromX, int fromY, int toX, int toY) const
+{
+	int deltaX = abs(toX - fromX);
+	int deltaY = abs(toY - fromY);
+	int numDiagonal = std::min(deltaX, deltaY);
+	int numStraight = std::max(deltaX, deltaY) - numDiagonal;
+	return static_cast<float>(numStraight) + DIAGONAL_STEP_COST * static_cast<float>(numDiagonal);
+}
+
+bool TilePathfinder::BeginQuery(IntVec2 const& start, IntVec2 const& goal, std::vector<IntVec2>& path)
+{
+	path.clear();
+	m_openHeap.clear();
+	m_numNodesExpanded = 0;
+	m_lastPathCost = 0.f;
+
+	//Bumping the generation invalidates every node at once; only a wraparound needs a real clear
+	m_generation++;
+	if (m_generation == 0)
+	{
+		for (TilePathNode& node : m_nodes)
+		{
+			node.m_generation = 0;
+		}
+		m_generation = 1;
+	}
+	return !IsTileSolid(start) && !IsTileSolid(goal);
+}
+
+TilePathNode& TilePathfinder::GetNode(int tileIndex)
+{
+	TilePathNode& node = m_nodes[tileIndex];
+	if (node.m_generation != m_generation)
+	{
+		node.m_generation = m_generation;
+		node.m_gCost = 0.f;
+		node.m_parentIndex = -1;
+		node.m_isClosed = false;
+	}
+	return node;
+}
+
+void TilePathfinder::PushOpen(int tileIndex, float gCost, float hCost, int parentIndex)
+{
+	TilePathNode& node = GetNode(tileIndex);
+	node.m_gCost = gCost;
+	node.m_parentIndex = parentIndex;
+
+	TilePathOpenEntry entry;
+	entry.m_fCost = gCost + hCost;
+	entry.m_gCost = gCost;
+	entry.m_tileIndex = tileIndex;
+	m_openHeap.push_back(entry);
+	std::push_heap(m_openHeap.begin(), m_openHeap.end(), IsOpenEntryWorse);
+}
+
+//Returns -1 for entries left behind when a tile was pushed again with a cheaper cost
+int TilePathfinder::PopOpen()
+{
+	std::pop_heap(m_openHeap.begin(), m_openHeap.end(), IsOpenEntryWorse);
+	int tileIndex = m_openHeap.back().m_tileIndex;
+	m_openHeap.pop_back();
+
+	TilePathNode& node = m_nodes[tileIndex];
+	if (node.m_isClosed)
+	{
+		return -1;
+	}
+	node.m_isClosed = true;
+	m_numNodesExpanded++;
+	return tileIndex;
+}
+
+void TilePathfinder::BuildPath(int goalIndex, std::vector<IntVec2>& path)
+{
+	m_lastPathCost = m_nodes[goalIndex].m_gCost;
+
+	//Walk parents back to the start, filling in the straight or diagonal runs between jump points one tile at a time
+	for (int tileIndex = goalIndex; tileIndex >= 0; tileIndex = m_nodes[tileIndex].m_parentIndex)
+	{
+		IntVec2 tileCoords = IntVec2(tileIndex % m_dimensions.x, tileIndex / m_dimensions.x);
+		path.push_back(tileCoords);
+
+		int parentIndex = m_nodes[tileIndex].m_parentIndex;
+		if (parentIndex < 0)
+		{
+			break;
+		}
+		IntVec2 parentCoords = IntVec2(parentIndex % m_dimensions.x, parentIndex / m_dimensions.x);
+		IntVec2 step = IntVec2(GetStepSign(parentCoords.x - tileCoords.x), GetStepSign(parentCoords.y - tileCoords.y));
+		for (IntVec2 between = tileCoords + step; between != parentCoords; between += step)
+		{
+			path.push_back(between);
+		}
+	}
+	std::reverse(path.begin(), path.end());
+}
+
+void TilePathfinder::RebuildJumpDistances()
+{
+	//Each straight direction is swept against its step so the tile ahead is always finished first
+	IntVec2 const directionSteps[4] = { IntVec2(1, 0), IntVec2(-1, 0), IntVec2(0, 1), IntVec2(0, -1) };
+	for (int directionIndex = 0; directionIndex < 4; directionIndex++)
+	{
+		int stepX = directionSteps[directionIndex].x;
+		int stepY = directionSteps[directionIndex].y;
+		std::vector<int>& distances = m_jumpDistances[directionIndex];
+		distances.resize(m_dimensions.x * m_dimensions.y);
+
+		int startX = stepX > 0 ? m_dimensions.x - 1 : 0;
+		int sweepX = stepX > 0 ? -1 : 1;
+		int startY = stepY > 0 ? m_dimensions.y - 1 : 0;
+		int sweepY = stepY > 0 ? -1 : 1;
+		for (int tileY = startY; tileY >= 0 && tileY < m_dimensions.y; tileY += sweepY)
+		{
+			for (int tileX = startX; tileX >= 0 && tileX < m_dimensions.x; tileX += sweepX)
+			{
+				int aheadX = tileX + stepX;
+				int aheadY = tileY + stepY;
+				int distance = 0;
+				if (!IsWalkable(aheadX, aheadY))
+				{
+					distance = 0;
+				}
+				else if (HasStraightForcedNeighbor(aheadX, aheadY, stepX, stepY))
+				{
+					distance = 1;
+				}
+				else
+				{
+					int aheadDistance = distances[aheadY * m_dimensions.x + aheadX];
+					distance = aheadDistance > 0 ? aheadDistance + 1 : aheadDistance - 1;
+				}
+				distances[tileY * m_dimensions.x + tileX] = distance;
+			}
+		}
+	}
+	m_areJumpDistancesDirty = false;
+}
+
+bool TilePathfinder::HasStraightForcedNeighbor(int tileX, int tileY, int stepX, int stepY) const
+{
+	if (stepX != 0)
+	{
+		return (IsWalkable(tileX, tileY - 1) && !IsWalkable(tileX - stepX, tileY - 1)) || (IsWalkable(tileX, tileY + 1) && !IsWalkable(tileX - stepX, tileY + 1));
+	}
+	return (IsWalkable(tileX - 1, tileY) && !IsWalkable(tileX - 1, tileY - stepY)) || (IsWalkable(tileX + 1, tileY) && !IsWalkable(tileX + 1, tileY - stepY));
+}
+
+//Looks up the straight run leaving (fromX, fromY); the goal counts as a jump point when it lies on that run
+int TilePathfinder::JumpStraight(int fromX, int fromY, int stepX, int stepY, IntVec2 const& goal) const
+{
+	int directionIndex = stepX > 0 ? 0 : (stepX < 0 ? 1 : (stepY > 0 ? 2 : 3));
+	int distance = m_jumpDistances[directionIndex][fromY * m_dimensions.x + fromX];
+
+	int stepsToGoal = -1;
+	if (stepX != 0 && goal.y == fromY)
+	{
+		stepsToGoal = (goal.x - fromX) * stepX;
+	}
+	else if (stepY != 0 && goal.x == fromX)
+	{
+		stepsToGoal = (goal.y - fromY) * stepY;
+	}
+	if (stepsToGoal > 0 && stepsToGoal <= abs(distance))
+	{
+		return goal.y * m_dimensions.x + goal.x;
+	}
+	if (distance > 0)
+	{
+		return (fromY + stepY * distance) * m_dimensions.x + fromX + stepX * distance;
+	}
+	return NO_JUMP_POINT;
+}
+
+//Walks diagonally from (tileX, tileY) until it reaches the goal, a tile where either straight component finds a jump point, or a blocked corner
+int TilePathfinder::JumpDiagonal(int tileX, int tileY, int stepX, int stepY, IntVec2 const& goal) const
+{
+	while (true)
+	{
+		if (!IsWalkable(tileX, tileY))
+		{
+			return NO_JUMP_POINT;
+		}
+		if (tileX == goal.x && tileY == goal.y)
+		{
+			return tileY * m_dimensions.x + tileX;
+		}
+		if (JumpStraight(tileX, tileY, stepX, 0, goal) != NO_JUMP_POINT || JumpStraight(tileX, tileY, 0, stepY, goal) != NO_JUMP_POINT)
+		{
+			return tileY * m_dimensions.x + tileX;
+		}
+		if (!IsWalkable(tileX + stepX, tileY) || !IsWalkable(tileX, tileY + stepY))
+		{
+			return NO_JUMP_POINT;
+		}
+		tileX += stepX;
+		tileY += stepY;
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "Engine/Math/IntVec2.hpp"
+#include <vector>
+
+class TileHeatMap;
+
+//Per-tile search state. m_generation says which query last touched the tile, so nothing is cleared between queries.
+struct TilePathNode
+{
+	float			m_gCost = 0.f;
+	int				m_parentIndex = -1;
+	unsigned int	m_generation = 0;
+	bool			m_isClosed = false;
+};
+
+struct TilePathOpenEntry
+{
+	float	m_fCost = 0.f;
+	float	m_gCost = 0.f;
+	int		m_tileIndex = -1;
+};
+
+//Grid pathfinder over 8-connected tiles. Diagonal steps cost sqrt(2) and are only allowed when both tiles beside them are open,
+//so paths never cut corners. Tile solidity and costs are indexed y * width + x like TileHeatMap.
+//Keep one pathfinder per map (or per thread); its scratch memory is reused by every query.
+class TilePathfinder
+{
+public:
+	explicit TilePathfinder(IntVec2 const& dimensions);
+
+	void	SetSolidTiles(std::vector<bool> const& solidTiles);
+	void	SetTileSolid(IntVec2 const& tileCoords, bool isSolid); //Dies on tiles outside the grid
+	bool	IsTileSolid(IntVec2 const& tileCoords) const; //Tiles outside the grid count as solid
+	void	SetTileCosts(std::vector<unsigned char> const& tileEntryCosts); //Step cost multiplier for entering each tile, at least 1
+	void	ClearTileCosts();
+	IntVec2	GetDimensions() const;
+
+	//Paths are written start to goal inclusive; both return false and leave path empty when the goal cannot be reached.
+	//heuristicMap is optional, e.g. a 4-connected GenerateDistanceField seeded at the goal. It is scaled by heuristicScale and
+	//combined with the octile distance; the default scale keeps a step-count map admissible for diagonal movement.
+	bool	FindPathAStar(IntVec2 const& start, IntVec2 const& goal, std::vector<IntVec2>& path, TileHeatMap const* heuristicMap = nullptr, float heuristicScale = 0.70710678f);
+
+	//Jump point search, same path costs as A* on uniform cost grids while expanding far fewer nodes. Falls back to A* when tile costs are set.
+	//Batch solidity edits between queries; each change makes the next JPS query rebuild its jump distance tables.
+	bool	FindPathJPS(IntVec2 const& start, IntVec2 const& goal, std::vector<IntVec2>& path);
+
+	//Stats from the most recent query
+	int		GetNumNodesExpanded() const;
+	float	GetLastPathCost() const;
+
+protected:
+	bool	IsWalkable(int tileX, int tileY) const; //Only valid from -1 to width/height; the solid border covers one step off the grid
+	float	GetOctileDistance(int fromX, int fromY, int toX, int toY) const;
+	bool	BeginQuery(IntVec2 const& start, IntVec2 const& goal, std::vector<IntVec2>& path);
+	TilePathNode& GetNode(int tileIndex);
+	void	PushOpen(int tileIndex, float gCost, float hCost, int parentIndex);
+	int		PopOpen();
+	void	BuildPath(int goalIndex, std::vector<IntVec2>& path);
+	void	RebuildJumpDistances();
+	bool	HasStraightForcedNeighbor(int tileX, int tileY, int stepX, int stepY) const;
+	int		JumpStraight(int fromX, int fromY, int stepX, int stepY, IntVec2 const& goal) const;
+	int		JumpDiagonal(int tileX, int tileY, int stepX, int stepY, IntVec2 const& goal) const;
+
+protected:
+	IntVec2 m_dimensions;
+	std::vector<unsigned char> m_walkableTiles; //Padded by a solid one-tile border so neighbor checks need no bounds tests
+	int m_paddedWidth = 0;
+
+	//Per tile and straight direction (+x, -x, +y, -y): steps to the next straight jump point, or minus the steps to a wall.
+	//Goal independent, so they are rebuilt by the first JPS query after the solidity changes.
+	std::vector<int> m_jumpDistances[4];
+	bool m_areJumpDistancesDirty = true;
+	std::vector<unsigned char> m_tileCosts; //Empty when every tile costs 1
+	std::vector<TilePathNode> m_nodes;
+	std::vector<TilePathOpenEntry> m_openHeap;
+	unsigned int m_generation = 0;
+	int m_numNodesExpanded = 0;
+	float m_lastPathCost = 0.f;
+};
@@ -0,0 +1,190 @@
+#include "VertexStream.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include <cstddef>
+#if defined(ENGINE_SIMD_SSE2)
+#include <xmmintrin.h>
+#endif
+
+VertexStream::VertexStream(bool hasTBN)
+	: m_hasTBN(hasTBN)
+{
+}
+
+void VertexStream::Reserve(int numVerts)
+{
+	m_positionsX.reserve(numVerts);
+	m_positionsY.reserve(numVerts);
+	m_positionsZ.reserve(numVerts);
+	m_colors.reserve(numVerts);
+	m_uvTexCoords.reserve(numVerts);
+	if (m_hasTBN)
+	{
+		m_tangents.reserve(numVerts);
+		m_bitangents.reserve(numVerts);
+		m_normals.reserve(numVerts);
+	}
+}
+
+void VertexStream::Clear()
+{
+	m_positionsX.clear();
+	m_positionsY.clear();
+	m_positionsZ.clear();
+	m_colors.clear();
+	m_uvTexCoords.clear();
+	m_tangents.clear();
+	m_bitangents.clear();
+	m_normals.clear();
+}
+
+int VertexStream::GetNumVerts() const
+{
+	return static_cast<int>(m_positionsX.size());
+}
+
+bool VertexStream::HasTBN() const
+{
+	return m_hasTBN;
+}
+
+void VertexStream::AddVertex(Vec3 const& position, Rgba8 const& color, Vec2 const& uvTexCoords)
+{
+	m_positionsX.push_back(position.x);
+	m_positionsY.push_back(position.y);
+	m_positionsZ.push_back(position.z);
+	m_colors.push_back(color);
+	m_uvTexCoords.push_back(uvTexCoords);
+	if (m_hasTBN)
+	{
+		m_tangents.push_back(Vec3());
+		m_bitangents.push_back(Vec3());
+		m_normals.push_back(Vec3());
+	}
+}
+
+void VertexStream::AddVertex(Vertex_PCU const& vert)
+{
+	AddVertex(vert.m_position, vert.m_color, vert.m_uvTexCoords);
+}
+
+void VertexStream::AddVertex(Vertex_PCUTBN const& vert)
+{
+	m_positionsX.push_back(vert.m_position.x);
+	m_positionsY.push_back(vert.m_position.y);
+	m_positionsZ.push_back(vert.m_position.z);
+	m_colors.push_back(vert.m_color);
+	m_uvTexCoords.push_back(vert.m_uvTexCoords);
+	if (m_hasTBN)
+	{
+		m_tangents.push_back(vert.m_tangent);
+		m_bitangents.push_back(vert.m_bitangent);
+		m_normals.push_back(vert.m_normal);
+	}
+}
+
+void VertexStream::AddVerts(Vertex_PCU const* verts, int numVerts)
+{
+	Reserve(GetNumVerts() + numVerts);
+	for (int vertIndex = 0; vertIndex < numVerts; vertIndex++)
+	{
+		AddVertex(verts[vertIndex]);
+	}
+}
+
+void VertexStream::AddVerts(Vertex_PCUTBN const* verts, int numVerts)
+{
+	Reserve(GetNumVerts() + numVerts);
+	for (int vertIndex = 0; vertIndex < numVerts; vertIndex++)
+	{
+		AddVertex(verts[vertIndex]);
+	}
+}
+
+void VertexStream::SetAllColors(Rgba8 const& color)
+{
+	for (int vertIndex = 0; vertIndex < static_cast<int>(m_colors.size()); vertIndex++)
+	{
+		m_colors[vertIndex] = color;
+	}
+}
+
+void VertexStream::Interleave(Vertex_PCU* verts) const
+{
+	int numVerts = GetNumVerts();
+	int vertIndex = 0;
+
+#if defined(ENGINE_SIMD_SSE2)
+	//Transpose four x, y, z and color lanes into four position+color rows, one 16 byte store per vertex
+	static_assert(offsetof(Vertex_PCU, m_position) == 0 && offsetof(Vertex_PCU, m_color) == 12 && sizeof(Rgba8) == 4, "SSE interleave expects position then color");
+	float const* colorsAsFloats = reinterpret_cast<float const*>(m_colors.data());
+	for (; vertIndex + 4 <= numVerts; vertIndex += 4)
+	{
+		__m128 x = _mm_loadu_ps(m_positionsX.data() + vertIndex);
+		__m128 y = _mm_loadu_ps(m_positionsY.data() + vertIndex);
+		__m128 z = _mm_loadu_ps(m_positionsZ.data() + vertIndex);
+		__m128 colors = _mm_loadu_ps(colorsAsFloats + vertIndex);
+		_MM_TRANSPOSE4_PS(x, y, z, colors);
+		_mm_storeu_ps(reinterpret_cast<float*>(&verts[vertIndex]), x);
+		_mm_storeu_ps(reinterpret_cast<float*>(&verts[vertIndex + 1]), y);
+		_mm_storeu_ps(reinterpret_cast<float*>(&verts[vertIndex + 2]), z);
+		_mm_storeu_ps(reinterpret_cast<float*>(&verts[vertIndex + 3]), colors);
+		verts[vertIndex].m_uvTexCoords = m_uvTexCoords[vertIndex];
+		verts[vertIndex + 1].m_uvTexCoords = m_uvTexCoords[vertIndex + 1];
+		verts[vertIndex + 2].m_uvTexCoords = m_uvTexCoords[vertIndex + 2];
+		verts[vertIndex + 3].m_uvTexCoords = m_uvTexCoords[vertIndex + 3];
+	}
+#endif
+
+	for (; vertIndex < numVerts; vertIndex++)
+	{
+		verts[vertIndex] = Vertex_PCU(Vec3(m_positionsX[vertIndex], m_positionsY[vertIndex], m_positionsZ[vertIndex]), m_colors[vertIndex], m_uvTexCoords[vertIndex]);
+	}
+}
+
+void VertexStream::Interleave(Vertex_PCUTBN* verts) const
+{
+	int numVerts = GetNumVerts();
+	for (int vertIndex = 0; vertIndex < numVerts; vertIndex++)
+	{
+		Vertex_PCUTBN& vert = verts[vertIndex];
+		vert.m_position = Vec3(m_positionsX[vertIndex], m_positionsY[vertIndex], m_positionsZ[vertIndex]);
+		vert.m_color = m_colors[vertIndex];
+		vert.m_uvTexCoords = m_uvTexCoords[vertIndex];
+		if (m_hasTBN)
+		{
+			vert.m_tangent = m_tangents[vertIndex];
+			vert.m_bitangent = m_bitangents[vertIndex];
+			vert.m_normal = m_normals[vertIndex];
+		}
+		else
+		{
+			vert.m_tangent = Vec3();
+			vert.m_bitangent = Vec3();
+			vert.m_normal = Vec3();
+		}
+	}
+}
+
+void VertexStream::AppendInterleaved(std::vector<Vertex_PCU>& verts) const
+{
+	size_t startIndex = verts.size();
+	verts.resize(startIndex + GetNumVerts());
+	Interleave(verts.data() + startIndex);
+}
+
+void VertexStream::AppendInterleaved(std::vector<Vertex_PCUTBN>& verts) const
+{
+	size_t startIndex = verts.size();
+	verts.resize(startIndex + GetNumVerts());
+	Interleave(verts.data() + startIndex);
+}
+
+std::vector<Vertex_PCU>& VertexStream::GetBuilderScratch(Vertex_PCU const*)
+{
+	return m_builderScratch;
+}
+
+std::vector<Vertex_PCUTBN>& VertexStream::GetBuilderScratch(Vertex_PCUTBN const*)
+{
+	return m_litBuilderScratch;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <vector>
+
+//Structure-of-arrays vertex storage. Bulk passes (recolor, transform, bounds) walk one tightly packed array at a time,
+//then Interleave turns the stream back into Vertex_PCU/Vertex_PCUTBN for upload.
+class VertexStream
+{
+public:
+	VertexStream() = default;
+	explicit VertexStream(bool hasTBN);
+
+	void	Reserve(int numVerts);
+	void	Clear();
+	int		GetNumVerts() const;
+	bool	HasTBN() const;
+
+	void	AddVertex(Vec3 const& position, Rgba8 const& color, Vec2 const& uvTexCoords);
+	void	AddVertex(Vertex_PCU const& vert);
+	void	AddVertex(Vertex_PCUTBN const& vert);
+	void	AddVerts(Vertex_PCU const* verts, int numVerts);
+	void	AddVerts(Vertex_PCUTBN const* verts, int numVerts);
+
+	//Runs a pre-sized AddVertsFor* builder into reused scratch memory and scatters the result into the stream, e.g.
+	//stream.AddVertsFromBuilder(GetNumVertsForDisc2D(), [&](Vertex_PCU* verts) { return AddVertsForDisc2D(verts, center, radius, color); });
+	//Lit builders name the vertex type and keep their own indexes, offset by GetNumVerts() taken before the call:
+	//stream.AddVertsFromBuilder<Vertex_PCUTBN>(numVerts, [&](Vertex_PCUTBN* verts) { return AddVertsForLitSphere(verts, indexes, firstVertexIndex, center, radius); });
+	template<typename VertexType = Vertex_PCU, typename BuilderFunction>
+	void	AddVertsFromBuilder(int maxVerts, BuilderFunction const& builder);
+
+	void	SetAllColors(Rgba8 const& color);
+
+	//Writes GetNumVerts() vertexes to the destination. Streams without TBN write zero tangent, bitangent and normal.
+	void	Interleave(Vertex_PCU* verts) const;
+	void	Interleave(Vertex_PCUTBN* verts) const;
+	void	AppendInterleaved(std::vector<Vertex_PCU>& verts) const;
+	void	AppendInterleaved(std::vector<Vertex_PCUTBN>& verts) const;
+
+public:
+	std::vector<float>	m_positionsX;
+	std::vector<float>	m_positionsY;
+	std::vector<float>	m_positionsZ;
+	std::vector<Rgba8>	m_colors;
+	std::vector<Vec2>	m_uvTexCoords;
+
+	//Only filled when the stream was created with TBN
+	std::vector<Vec3>	m_tangents;
+	std::vector<Vec3>	m_bitangents;
+	std::vector<Vec3>	m_normals;
+
+protected:
+	bool m_hasTBN = false;
+	std::vector<Vertex_PCU> m_builderScratch;
+	std::vector<Vertex_PCUTBN> m_litBuilderScratch;
+
+	std::vector<Vertex_PCU>&	GetBuilderScratch(Vertex_PCU const*);
+	std::vector<Vertex_PCUTBN>&	GetBuilderScratch(Vertex_PCUTBN const*);
+};
+
+template<typename VertexType, typename BuilderFunction>
+void VertexStream::AddVertsFromBuilder(int maxVerts, BuilderFunction const& builder)
+{
+	std::vector<VertexType>& scratch = GetBuilderScratch(static_cast<VertexType const*>(nullptr));
+	if (static_cast<int>(scratch.size()) < maxVerts)
+	{
+		scratch.resize(maxVerts);
+	}
+	int numVerts = builder(scratch.data());
+	AddVerts(scratch.data(), numVerts);
+}
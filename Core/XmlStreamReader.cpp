@@ -0,0 +1,624 @@
+#include "Engine/Core/XmlStreamReader.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include <charconv>
+
+static bool IsXmlWhitespace(char character)
+{
+	return character == ' ' || character == '\t' || character == '\n' || character == '\r';
+}
+
+static bool IsXmlNameEnd(char character)
+{
+	return IsXmlWhitespace(character) || character == '/' || character == '>' || character == '=';
+}
+
+static void AppendUtf8(unsigned int codePoint, std::string& out_text)
+{
+	if (codePoint < 0x80)
+	{
+		out_text.push_back(static_cast<char>(codePoint));
+	}
+	else if (codePoint < 0x800)
+	{
+		out_text.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+		out_text.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+	else if (codePoint < 0x10000)
+	{
+		out_text.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+		out_text.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+		out_text.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+	else
+	{
+		out_text.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+		out_text.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+		out_text.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+		out_text.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+}
+
+//Decodes the five predefined entities and character references; anything else is kept as written, like TinyXML2 does
+static void AppendDecodedXml(std::string_view rawText, std::string& out_text)
+{
+	size_t readIndex = 0;
+	while (readIndex < rawText.size())
+	{
+		size_t ampersandIndex = rawText.find('&', readIndex);
+		if (ampersandIndex == std::string_view::npos)
+		{
+			out_text.append(rawText.substr(readIndex));
+			return;
+		}
+		out_text.append(rawText.substr(readIndex, ampersandIndex - readIndex));
+		readIndex = ampersandIndex + 1;
+
+		size_t semicolonIndex = rawText.find(';', ampersandIndex);
+		if (semicolonIndex == std::string_view::npos)
+		{
+			out_text.push_back('&');
+			continue;
+		}
+
+		std::string_view entity = rawText.substr(ampersandIndex + 1, semicolonIndex - ampersandIndex - 1);
+		char replacement = '\0';
+		if (entity == "lt")			replacement = '<';
+		else if (entity == "gt")	replacement = '>';
+		else if (entity == "amp")	replacement = '&';
+		else if (entity == "quot")	replacement = '"';
+		else if (entity == "apos")	replacement = '\'';
+
+		if (replacement != '\0')
+		{
+			out_text.push_back(replacement);
+			readIndex = semicolonIndex + 1;
+		}
+		else if (entity.size() > 1 && entity[0] == '#')
+		{
+			bool isHex = entity[1] == 'x' || entity[1] == 'X';
+			std::string_view digits = entity.substr(isHex ? 2 : 1);
+			unsigned int codePoint = 0;
+			std::from_chars_result result = std::from_chars(digits.data(), digits.data() + digits.size(), codePoint, isHex ? 16 : 10);
+			if (result.ec == std::errc() && result.ptr == digits.data() + digits.size() && codePoint <= 0x10FFFF)
+			{
+				AppendUtf8(codePoint, out_text);
+				readIndex = semicolonIndex + 1;
+			}
+			else
+			{
+				out_text.push_back('&');
+			}
+		}
+		else
+		{
+			out_text.push_back('&');
+		}
+	}
+}
+
+XmlStreamReader::XmlStreamReader(std::string_view xmlText)
+{
+	SetText(xmlText);
+}
+
+bool XmlStreamReader::OpenFile(std::string const& xmlFilePath)
+{
+	bool didOpen = m_file.Open(xmlFilePath);
+	SetText(m_file.GetText());
+	return didOpen;
+}
+
+void XmlStreamReader::SetText(std::string_view xmlText)
+{
+	if (xmlText.substr(0, 3) == "\xEF\xBB\xBF")
+	{
+		xmlText.remove_prefix(3);
+	}
+	m_document = xmlText;
+	m_position = 0;
+	m_event = XmlStreamEvent::END_OF_DOCUMENT;
+	m_elementName = std::string_view();
+	m_text = std::string_view();
+	m_openElements.clear();
+	m_attributes.clear();
+	m_isPendingSelfClose = false;
+	m_isPendingPop = false;
+	m_errorMessage.clear();
+}
+
+XmlStreamEvent XmlStreamReader::ReadNext()
+{
+	if (m_event == XmlStreamEvent::PARSE_ERROR)
+	{
+		return m_event;
+	}
+	if (m_isPendingPop)
+	{
+		m_openElements.pop_back();
+		m_isPendingPop = false;
+	}
+	m_attributes.clear();
+	m_text = std::string_view();
+
+	if (m_isPendingSelfClose)
+	{
+		m_isPendingSelfClose = false;
+		m_isPendingPop = true;
+		m_elementName = m_openElements.back();
+		return m_event = XmlStreamEvent::END_ELEMENT;
+	}
+
+	while (m_position < m_document.size())
+	{
+		if (m_document[m_position] != '<')
+		{
+			XmlStreamEvent textEvent = ReadText();
+			if (textEvent != XmlStreamEvent::END_OF_DOCUMENT)
+			{
+				return m_event = textEvent;
+			}
+			continue;
+		}
+
+		std::string_view remaining = m_document.substr(m_position);
+		if (remaining.substr(0, 9) == "<![CDATA[")
+		{
+			size_t endIndex = m_document.find("]]>", m_position + 9);
+			if (endIndex == std::string_view::npos)
+			{
+				return Fail("unterminated CDATA section");
+			}
+			m_text = m_document.substr(m_position + 9, endIndex - m_position - 9);
+			m_position = endIndex + 3;
+			if (m_openElements.empty())
+			{
+				return Fail("CDATA outside the root element");
+			}
+			return m_event = XmlStreamEvent::TEXT;
+		}
+		if (remaining.substr(0, 2) == "<?" || remaining.substr(0, 2) == "<!")
+		{
+			if (!SkipMarkup())
+			{
+				return m_event;
+			}
+			continue;
+		}
+		if (remaining.substr(0, 2) == "</")
+		{
+			return m_event = ReadEndElement();
+		}
+		return m_event = ReadStartElement();
+	}
+
+	if (!m_openElements.empty())
+	{
+		return Fail("unexpected end of document inside an element");
+	}
+	m_elementName = std::string_view();
+	return m_event = XmlStreamEvent::END_OF_DOCUMENT;
+}
+
+void XmlStreamReader::SkipElement()
+{
+	if (m_event != XmlStreamEvent::START_ELEMENT)
+	{
+		return;
+	}
+	int elementDepth = GetDepth();
+	for (XmlStreamEvent event = ReadNext(); event != XmlStreamEvent::PARSE_ERROR && event != XmlStreamEvent::END_OF_DOCUMENT; event = ReadNext())
+	{
+		if (event == XmlStreamEvent::END_ELEMENT && GetDepth() == elementDepth)
+		{
+			return;
+		}
+	}
+}
+
+XmlStreamAttribute const* XmlStreamReader::FindAttribute(char const* attributeName) const
+{
+	for (XmlStreamAttribute const& attribute : m_attributes)
+	{
+		if (attribute.m_name == attributeName)
+		{
+			return &attribute;
+		}
+	}
+	return nullptr;
+}
+
+XmlStreamEvent XmlStreamReader::ReadStartElement()
+{
+	size_t nameStart = m_position + 1;
+	size_t readIndex = nameStart;
+	while (readIndex < m_document.size() && !IsXmlNameEnd(m_document[readIndex]))
+	{
+		readIndex++;
+	}
+	if (readIndex == nameStart)
+	{
+		return Fail("missing element name");
+	}
+	m_elementName = m_document.substr(nameStart, readIndex - nameStart);
+
+	size_t numEncodedBytes = 0;
+	for (;;)
+	{
+		while (readIndex < m_document.size() && IsXmlWhitespace(m_document[readIndex]))
+		{
+			readIndex++;
+		}
+		if (readIndex >= m_document.size())
+		{
+			return Fail("unterminated start tag");
+		}
+
+		char character = m_document[readIndex];
+		if (character == '>')
+		{
+			m_position = readIndex + 1;
+			break;
+		}
+		if (character == '/')
+		{
+			if (readIndex + 1 >= m_document.size() || m_document[readIndex + 1] != '>')
+			{
+				return Fail("expected '>' after '/'");
+			}
+			m_position = readIndex + 2;
+			m_isPendingSelfClose = true;
+			break;
+		}
+
+		size_t attributeNameStart = readIndex;
+		while (readIndex < m_document.size() && !IsXmlNameEnd(m_document[readIndex]))
+		{
+			readIndex++;
+		}
+		std::string_view attributeName = m_document.substr(attributeNameStart, readIndex - attributeNameStart);
+		while (readIndex < m_document.size() && IsXmlWhitespace(m_document[readIndex]))
+		{
+			readIndex++;
+		}
+		if (attributeName.empty() || readIndex >= m_document.size() || m_document[readIndex] != '=')
+		{
+			return Fail("expected an attribute name followed by '='");
+		}
+		readIndex++;
+		while (readIndex < m_document.size() && IsXmlWhitespace(m_document[readIndex]))
+		{
+			readIndex++;
+		}
+		if (readIndex >= m_document.size() || (m_document[readIndex] != '"' && m_document[readIndex] != '\''))
+		{
+			return Fail("expected a quoted attribute value");
+		}
+		size_t valueStart = readIndex + 1;
+		size_t valueEnd = m_document.find(m_document[readIndex], valueStart);
+		if (valueEnd == std::string_view::npos)
+		{
+			return Fail("unterminated attribute value");
+		}
+		readIndex = valueEnd + 1;
+
+		XmlStreamAttribute attribute;
+		attribute.m_name = attributeName;
+		attribute.m_value = m_document.substr(valueStart, valueEnd - valueStart);
+		if (attribute.m_value.find('&') != std::string_view::npos)
+		{
+			numEncodedBytes += attribute.m_value.size();
+		}
+		m_attributes.push_back(attribute);
+	}
+
+	//Decoding never lengthens a value, so reserving the raw lengths keeps earlier views into the scratch valid
+	if (numEncodedBytes > 0)
+	{
+		m_attributeScratch.clear();
+		m_attributeScratch.reserve(numEncodedBytes);
+		for (XmlStreamAttribute& attribute : m_attributes)
+		{
+			if (attribute.m_value.find('&') != std::string_view::npos)
+			{
+				size_t decodedStart = m_attributeScratch.size();
+				AppendDecodedXml(attribute.m_value, m_attributeScratch);
+				attribute.m_value = std::string_view(m_attributeScratch.data() + decodedStart, m_attributeScratch.size() - decodedStart);
+			}
+		}
+	}
+
+	m_openElements.push_back(m_elementName);
+	return XmlStreamEvent::START_ELEMENT;
+}
+
+XmlStreamEvent XmlStreamReader::ReadEndElement()
+{
+	size_t nameStart = m_position + 2;
+	size_t readIndex = nameStart;
+	while (readIndex < m_document.size() && !IsXmlNameEnd(m_document[readIndex]))
+	{
+		readIndex++;
+	}
+	m_elementName = m_document.substr(nameStart, readIndex - nameStart);
+	while (readIndex < m_document.size() && IsXmlWhitespace(m_document[readIndex]))
+	{
+		readIndex++;
+	}
+	if (readIndex >= m_document.size() || m_document[readIndex] != '>')
+	{
+		return Fail("unterminated end tag");
+	}
+	if (m_openElements.empty() || m_openElements.back() != m_elementName)
+	{
+		return Fail("end tag does not match the open element");
+	}
+	m_position = readIndex + 1;
+	m_isPendingPop = true;
+	return XmlStreamEvent::END_ELEMENT;
+}
+
+//Returns END_OF_DOCUMENT for whitespace-only runs, which are skipped
+XmlStreamEvent XmlStreamReader::ReadText()
+{
+	size_t textEnd = m_document.find('<', m_position);
+	if (textEnd == std::string_view::npos)
+	{
+		textEnd = m_document.size();
+	}
+	std::string_view rawText = m_document.substr(m_position, textEnd - m_position);
+	m_position = textEnd;
+
+	bool isWhitespace = true;
+	for (char character : rawText)
+	{
+		if (!IsXmlWhitespace(character))
+		{
+			isWhitespace = false;
+			break;
+		}
+	}
+	if (isWhitespace)
+	{
+		return XmlStreamEvent::END_OF_DOCUMENT;
+	}
+	if (m_openElements.empty())
+	{
+		return Fail("text outside the root element");
+	}
+
+	if (rawText.find('&') == std::string_view::npos)
+	{
+		m_text = rawText;
+	}
+	else
+	{
+		m_textScratch.clear();
+		AppendDecodedXml(rawText, m_textScratch);
+		m_text = m_textScratch;
+	}
+	return XmlStreamEvent::TEXT;
+}
+
+bool XmlStreamReader::SkipMarkup()
+{
+	std::string_view remaining = m_document.substr(m_position);
+	size_t endIndex = std::string_view::npos;
+	if (remaining.substr(0, 4) == "<!--")
+	{
+		endIndex = remaining.find("-->", 4);
+		endIndex = endIndex != std::string_view::npos ? endIndex + 3 : endIndex;
+	}
+	else if (remaining.substr(0, 2) == "<?")
+	{
+		endIndex = remaining.find("?>", 2);
+		endIndex = endIndex != std::string_view::npos ? endIndex + 2 : endIndex;
+	}
+	else
+	{
+		//DOCTYPE and other declarations; an internal subset in [] may itself contain '>'
+		int bracketDepth = 0;
+		for (size_t readIndex = 2; readIndex < remaining.size(); readIndex++)
+		{
+			if (remaining[readIndex] == '[')
+			{
+				bracketDepth++;
+			}
+			else if (remaining[readIndex] == ']')
+			{
+				bracketDepth--;
+			}
+			else if (remaining[readIndex] == '>' && bracketDepth <= 0)
+			{
+				endIndex = readIndex + 1;
+				break;
+			}
+		}
+	}
+
+	if (endIndex == std::string_view::npos)
+	{
+		Fail("unterminated comment or declaration");
+		return false;
+	}
+	m_position += endIndex;
+	return true;
+}
+
+XmlStreamEvent XmlStreamReader::Fail(char const* reason)
+{
+	int lineNumber = 1;
+	for (size_t readIndex = 0; readIndex < m_position && readIndex < m_document.size(); readIndex++)
+	{
+		if (m_document[readIndex] == '\n')
+		{
+			lineNumber++;
+		}
+	}
+	m_errorMessage = Stringf("XML error on line %d: %s", lineNumber, reason);
+	m_attributes.clear();
+	m_isPendingSelfClose = false;
+	return m_event = XmlStreamEvent::PARSE_ERROR;
+}
+
+//Mirrors XMLUtil::ToBool, which XMLAttribute::BoolValue uses: a leading integer decides, otherwise only exact true spellings are true
+static bool ParseXmlBool(std::string_view text)
+{
+	std::string_view trimmed = text;
+	while (!trimmed.empty() && IsXmlWhitespace(trimmed.front()))
+	{
+		trimmed.remove_prefix(1);
+	}
+	size_t digitIndex = (!trimmed.empty() && (trimmed[0] == '-' || trimmed[0] == '+')) ? 1 : 0;
+	if (digitIndex < trimmed.size() && trimmed[digitIndex] >= '0' && trimmed[digitIndex] <= '9')
+	{
+		return ParseInt(trimmed) != 0;
+	}
+	return text == "true" || text == "True" || text == "TRUE";
+}
+
+int ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, int defaultValue)
+{
+	XmlStreamAttribute const* attribute = reader.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	return ParseInt(attribute->m_value);
+}
+
+char ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, char defaultValue)
+{
+	XmlStreamAttribute const* attribute = reader.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	return static_cast<char>(ParseInt(attribute->m_value));
+}
+
+bool ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, bool defaultValue)
+{
+	XmlStreamAttribute const* attribute = reader.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	return ParseXmlBool(attribute->m_value);
+}
+
+float ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, float defaultValue)
+{
+	XmlStreamAttribute const* attribute = reader.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	return ParseFloat(attribute->m_value);
+}
+
+Rgba8 ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, Rgba8 const& defaultValue)
+{
+	XmlStreamAttribute const* attribute = reader.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	Rgba8 var;
+	var.SetFromText(attribute->m_value);
+	return var;
+}
+
+Vec2 ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, Vec2 const& defaultValue)
+{
+	XmlStreamAttribute const* attribute = reader.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	Vec2 var;
+	var.SetFromText(attribute->m_value);
+	return var;
+}
+
+Vec3 ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, Vec3 const& defaultValue)
+{
+	XmlStreamAttribute const* attribute = reader.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	Vec3 var;
+	var.SetFromText(attribute->m_value);
+	return var;
+}
+
+EulerAngles ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, EulerAngles const& defaultValue)
+{
+	XmlStreamAttribute const* attribute = reader.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	EulerAngles var;
+	var.SetFromText(attribute->m_value);
+	return var;
+}
+
+FloatRange ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, FloatRange const& defaultValue)
+{
+	XmlStreamAttribute const* attribute = reader.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	FloatRange var;
+	var.SetFromText(attribute->m_value);
+	return var;
+}
+
+IntVec2 ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, IntVec2 const& defaultValue)
+{
+	XmlStreamAttribute const* attribute = reader.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	IntVec2 var;
+	var.SetFromText(attribute->m_value);
+	return var;
+}
+
+std::string ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, std::string const& defaultValue)
+{
+	XmlStreamAttribute const* attribute = reader.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	return std::string(attribute->m_value);
+}
+
+std::string ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, char const* defaultValue)
+{
+	XmlStreamAttribute const* attribute = reader.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	return std::string(attribute->m_value);
+}
+
+Strings ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, Strings const& defaultValue)
+{
+	XmlStreamAttribute const* attribute = reader.FindAttribute(attributename);
+	if (attribute == nullptr)
+	{
+		return defaultValue;
+	}
+	return SplitStringOnDelimiter(attribute->m_value, ',');
+}
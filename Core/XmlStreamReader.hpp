@@ -0,0 +1,97 @@
+#pragma once
+#include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum class XmlStreamEvent
+{
+	START_ELEMENT,	//Name and attributes are available until the next ReadNext
+	END_ELEMENT,	//Also reported straight after the START_ELEMENT of a self-closing element
+	TEXT,			//Character data or CDATA with entities decoded; whitespace-only runs are skipped
+	END_OF_DOCUMENT,
+	PARSE_ERROR,	//Malformed XML; GetErrorMessage says what and where. Every later ReadNext returns PARSE_ERROR too
+};
+
+struct XmlStreamAttribute
+{
+	std::string_view m_name;
+	std::string_view m_value; //Entities decoded
+};
+
+//Pull parser over XML text: each ReadNext yields one event with string_views into the text, so no tree is built and nothing
+//is allocated per node. State is the stack of open element names plus the current element's attributes, so memory grows
+//with nesting depth, not file size. The text must outlive the reader (OpenFile keeps the file mapped itself).
+//Comments, processing instructions and DOCTYPE are skipped. Typical use:
+//
+//	XmlStreamReader reader;
+//	reader.OpenFile("Data/Maps/Level1.xml");
+//	for (XmlStreamEvent event = reader.ReadNext(); event != XmlStreamEvent::END_OF_DOCUMENT; event = reader.ReadNext())
+//	{
+//		GUARANTEE_OR_DIE(event != XmlStreamEvent::PARSE_ERROR, reader.GetErrorMessage());
+//		if (event == XmlStreamEvent::START_ELEMENT && reader.GetElementName() == "Tile")
+//		{
+//			IntVec2 coords = ParseXmlAttribute(reader, "coords", IntVec2());
+//		}
+//	}
+class XmlStreamReader
+{
+public:
+	XmlStreamReader() = default;
+	explicit XmlStreamReader(std::string_view xmlText);
+
+	bool						OpenFile(std::string const& xmlFilePath); //Returns false if the file does not exist
+	void						SetText(std::string_view xmlText);
+
+	XmlStreamEvent				ReadNext();
+	void						SkipElement(); //After START_ELEMENT, consumes everything up to and including its END_ELEMENT
+
+	XmlStreamEvent				GetEvent() const { return m_event; }
+	std::string_view			GetElementName() const { return m_elementName; }
+	int							GetDepth() const { return static_cast<int>(m_openElements.size()); } //1 for the root's START and END, 2 for its children; TEXT reports its parent's
+	int							GetNumAttributes() const { return static_cast<int>(m_attributes.size()); }
+	XmlStreamAttribute const&	GetAttribute(int attributeIndex) const { return m_attributes[attributeIndex]; }
+	XmlStreamAttribute const*	FindAttribute(char const* attributeName) const;
+	std::string_view			GetText() const { return m_text; }
+	std::string const&			GetErrorMessage() const { return m_errorMessage; }
+
+protected:
+	XmlStreamEvent				ReadStartElement();
+	XmlStreamEvent				ReadEndElement();
+	XmlStreamEvent				ReadText();
+	bool						SkipMarkup(); //Comments, processing instructions and DOCTYPE
+	XmlStreamEvent				Fail(char const* reason);
+
+protected:
+	MappedFile						m_file;
+	std::string_view				m_document;
+	size_t							m_position = 0;
+
+	XmlStreamEvent					m_event = XmlStreamEvent::END_OF_DOCUMENT;
+	std::string_view				m_elementName;
+	std::string_view				m_text;
+	std::vector<std::string_view>	m_openElements;
+	std::vector<XmlStreamAttribute>	m_attributes;
+	std::string						m_attributeScratch; //Decoded attribute values that contained entities
+	std::string						m_textScratch;
+	bool							m_isPendingSelfClose = false;
+	bool							m_isPendingPop = false; //The END_ELEMENT just reported still counts toward GetDepth
+	std::string						m_errorMessage;
+};
+
+//Same parsing as the XmlElement overloads, applied to the current START_ELEMENT's attributes
+int			ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, int defaultValue);
+char		ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, char defaultValue);
+bool		ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, bool defaultValue);
+float		ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, float defaultValue);
+Rgba8		ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, Rgba8 const& defaultValue);
+Vec2		ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, Vec2 const& defaultValue);
+Vec3		ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, Vec3 const& defaultValue);
+EulerAngles ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, EulerAngles const& defaultValue);
+FloatRange	ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, FloatRange const& defaultValue);
+IntVec2		ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, IntVec2 const& defaultValue);
+std::string	ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, std::string const& defaultValue);
+std::string ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, char const* defaultValue);
+Strings		ParseXmlAttribute(XmlStreamReader const& reader, char const* attributename, Strings const& defaultValue);
@@ -8,139 +8,147 @@
 
 int ParseXmlAttribute(XmlElement const& element, char const* attributename, int defaultValue)
 {
-	if (element.FindAttribute(attributename) == nullptr)
+	XmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
 	{
 		return defaultValue;
 	}
-    int var = element.FindAttribute(attributename)->IntValue();
-	return var;
+	return ParseInt(attribute->Value());
 }
 
 char ParseXmlAttribute(XmlElement const& element, char const* attributename, char defaultValue)
 {
-	if (element.FindAttribute(attributename) == nullptr)
+	XmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
 	{
 		return defaultValue;
 	}
-	char var = static_cast<char>(element.FindAttribute(attributename)->IntValue());
-	return var;
+	return static_cast<char>(ParseInt(attribute->Value()));
 }
 
 bool ParseXmlAttribute(XmlElement const& element, char const* attributename, bool defaultValue)
 {
-	if (element.FindAttribute(attributename) == nullptr)
+	XmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
 	{
 		return defaultValue;
 	}
-	bool var = element.FindAttribute(attributename)->BoolValue();
+	bool var = attribute->BoolValue();
 	return var;
 }
 
 float ParseXmlAttribute(XmlElement const& element, char const* attributename, float defaultValue)
 {
-	if (element.FindAttribute(attributename) == nullptr)
+	XmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
 	{
 		return defaultValue;
 	}
-	float var = element.FindAttribute(attributename)->FloatValue();
-	return var;
+	return ParseFloat(attribute->Value());
 }
 
 Rgba8 ParseXmlAttribute(XmlElement const& element, char const* attributename, Rgba8 const& defaultValue)
 {
-	if (element.FindAttribute(attributename) == nullptr)
+	XmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
 	{
 		return defaultValue;
 	}
 	Rgba8 var;
-	var.SetFromText(element.FindAttribute(attributename)->Value());
+	var.SetFromText(attribute->Value());
 	return var;
 }
 
 Vec2 ParseXmlAttribute(XmlElement const& element, char const* attributename, Vec2 const& defaultValue)
 {
-	if (element.FindAttribute(attributename) == nullptr)
+	XmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
 	{
 		return defaultValue;
 	}
 	Vec2 var;
-	var.SetFromText(element.FindAttribute(attributename)->Value());
+	var.SetFromText(attribute->Value());
 	return var;
 }
 
 Vec3 ParseXmlAttribute(XmlElement const& element, char const* attributename, Vec3 const& defaultValue)
 {
-	if (element.FindAttribute(attributename) == nullptr)
+	XmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
 	{
 		return defaultValue;
 	}
 	Vec3 var;
-	var.SetFromText(element.FindAttribute(attributename)->Value());
+	var.SetFromText(attribute->Value());
 	return var;
 }
 
 EulerAngles ParseXmlAttribute(XmlElement const& element, char const* attributename, EulerAngles const& defaultValue)
 {
-	if (element.FindAttribute(attributename) == nullptr)
+	XmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
 	{
 		return defaultValue;
 	}
 	EulerAngles var;
-	var.SetFromText(element.FindAttribute(attributename)->Value());
+	var.SetFromText(attribute->Value());
 	return var;
 }
 
 FloatRange ParseXmlAttribute(XmlElement const& element, char const* attributename, FloatRange const& defaultValue)
 {
-	if (element.FindAttribute(attributename) == nullptr)
+	XmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
 	{
 		return defaultValue;
 	}
 	FloatRange var;
-	var.SetFromText(element.FindAttribute(attributename)->Value());
+	var.SetFromText(attribute->Value());
 	return var;
 }
 
 IntVec2 ParseXmlAttribute(XmlElement const& element, char const* attributename, IntVec2 const& defaultValue)
 {
-	if (element.FindAttribute(attributename) == nullptr)
+	XmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
 	{
 		return defaultValue;
 	}
 	IntVec2 var;
-	var.SetFromText(element.FindAttribute(attributename)->Value());
+	var.SetFromText(attribute->Value());
 	return var;
 }
 
 std::string ParseXmlAttribute(XmlElement const& element, char const* attributename, std::string const& defaultValue)
 {
-	if (element.FindAttribute(attributename) == nullptr)
+	XmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
 	{
 		return defaultValue;
 	}
 	std::string var;
-	var = element.FindAttribute(attributename)->Value();
+	var = attribute->Value();
 	return var;
 }
 
 std::string ParseXmlAttribute(XmlElement const& element, char const* attributename, char const* defaultValue)
 {
-	if (element.FindAttribute(attributename) == nullptr)
+	XmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
 	{
 		return defaultValue;
 	}
 	std::string var;
-	var = element.FindAttribute(attributename)->Value();
+	var = attribute->Value();
 	return var;
 }
 
 Strings ParseXmlAttribute(XmlElement const& element, char const* attributename, Strings const& defaultValue)
 {
-	if (element.FindAttribute(attributename) == nullptr)
+	XmlAttribute const* attribute = element.FindAttribute(attributename);
+	if (attribute == nullptr)
 	{
 		return defaultValue;
 	}
-	std::string var;
-	var = element.FindAttribute(attributename)->Value();
-	return SplitStringOnDelimiter(var, ',');
+	return SplitStringOnDelimiter(attribute->Value(), ',');
 }
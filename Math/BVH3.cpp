@@ -0,0 +1,639 @@
+#include "BVH3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+//Deeper trees fall back to larger leaves so the fixed traversal stacks below can never overflow
+constexpr int BVH_MAX_DEPTH = 48;
+constexpr int BVH_STACK_SIZE = 64;
+
+static AABB3 GetEmptyBounds()
+{
+	return AABB3(Vec3(FLT_MAX, FLT_MAX, FLT_MAX), Vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX));
+}
+
+static void StretchToIncludeBounds(AABB3& bounds, AABB3 const& include)
+{
+	bounds.m_mins.x = std::min(bounds.m_mins.x, include.m_mins.x);
+	bounds.m_mins.y = std::min(bounds.m_mins.y, include.m_mins.y);
+	bounds.m_mins.z = std::min(bounds.m_mins.z, include.m_mins.z);
+	bounds.m_maxs.x = std::max(bounds.m_maxs.x, include.m_maxs.x);
+	bounds.m_maxs.y = std::max(bounds.m_maxs.y, include.m_maxs.y);
+	bounds.m_maxs.z = std::max(bounds.m_maxs.z, include.m_maxs.z);
+}
+
+//Half the surface area; SAH only compares ratios so the factor of two never matters
+static float GetHalfSurfaceArea(AABB3 const& bounds)
+{
+	if (bounds.m_mins.x > bounds.m_maxs.x)
+	{
+		return 0.f;
+	}
+	Vec3 dims = bounds.m_maxs - bounds.m_mins;
+	return dims.x * dims.y + dims.y * dims.z + dims.z * dims.x;
+}
+
+static float GetAxisValue(Vec3 const& vec, int axis)
+{
+	return axis == 0 ? vec.x : (axis == 1 ? vec.y : vec.z);
+}
+
+static Vec3 GetBoundsCenter(AABB3 const& bounds)
+{
+	return (bounds.m_mins + bounds.m_maxs) * 0.5f;
+}
+
+//Slab test clipped to [0, maxDist]. Axes the ray runs parallel to only check that the start is between the slabs, so no NaN from 0/0.
+static bool RaycastVsNodeBounds(AABB3 const& bounds, Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, float& tEnter)
+{
+	float tNear = 0.f;
+	float tFar = maxDist;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float start = GetAxisValue(startPos, axis);
+		float fwd = GetAxisValue(fwdNormal, axis);
+		float mins = GetAxisValue(bounds.m_mins, axis);
+		float maxs = GetAxisValue(bounds.m_maxs, axis);
+		if (fwd == 0.f)
+		{
+			if (start < mins || start > maxs)
+			{
+				return false;
+			}
+			continue;
+		}
+
+		float tMin = (mins - start) / fwd;
+		float tMax = (maxs - start) / fwd;
+		if (tMin > tMax) std::swap(tMin, tMax);
+		tNear = std::max(tNear, tMin);
+		tFar = std::min(tFar, tMax);
+		if (tNear > tFar)
+		{
+			return false;
+		}
+	}
+	tEnter = tNear;
+	return true;
+}
+
+//Node culling only covers [0, maxDist], so impacts some narrow phases report behind the start are ignored to keep results independent of tree shape
+static bool IsImpactOnRay(RaycastResult3D const& result)
+{
+	return result.m_didImpact && result.m_impactDist >= 0.f;
+}
+
+BVH3::BVH3(BVH3Config const& config)
+	: m_config(config)
+{
+}
+
+int BVH3::AddSphere(Vec3 const& center, float radius)
+{
+	BVHPrimitive3D primitive;
+	primitive.m_shape = BVHShape3D::SPHERE;
+	primitive.m_center = center;
+	primitive.m_radius = radius;
+	return AddPrimitive(primitive);
+}
+
+int BVH3::AddAABB(AABB3 const& box)
+{
+	BVHPrimitive3D primitive;
+	primitive.m_shape = BVHShape3D::AABB;
+	primitive.m_box = box;
+	return AddPrimitive(primitive);
+}
+
+int BVH3::AddOBB(OBB3 const& box)
+{
+	BVHPrimitive3D primitive;
+	primitive.m_shape = BVHShape3D::OBB;
+	primitive.m_orientedBox = box;
+	return AddPrimitive(primitive);
+}
+
+int BVH3::AddZCylinder(Vec3 const& center, float radiusXY, FloatRange const& minMaxZ)
+{
+	BVHPrimitive3D primitive;
+	primitive.m_shape = BVHShape3D::ZCYLINDER;
+	primitive.m_center = center;
+	primitive.m_radius = radiusXY;
+	primitive.m_minMaxZ = minMaxZ;
+	return AddPrimitive(primitive);
+}
+
+void BVH3::SetSphere(int primitiveIndex, Vec3 const& center, float radius)
+{
+	BVHPrimitive3D& primitive = m_primitives[primitiveIndex];
+	GUARANTEE_OR_DIE(primitive.m_shape == BVHShape3D::SPHERE, "BVH3::SetSphere called on a primitive that is not a sphere");
+	primitive.m_center = center;
+	primitive.m_radius = radius;
+	UpdatePrimitiveBounds(primitive);
+}
+
+void BVH3::SetAABB(int primitiveIndex, AABB3 const& box)
+{
+	BVHPrimitive3D& primitive = m_primitives[primitiveIndex];
+	GUARANTEE_OR_DIE(primitive.m_shape == BVHShape3D::AABB, "BVH3::SetAABB called on a primitive that is not an AABB");
+	primitive.m_box = box;
+	UpdatePrimitiveBounds(primitive);
+}
+
+void BVH3::SetOBB(int primitiveIndex, OBB3 const& box)
+{
+	BVHPrimitive3D& primitive = m_primitives[primitiveIndex];
+	GUARANTEE_OR_DIE(primitive.m_shape == BVHShape3D::OBB, "BVH3::SetOBB called on a primitive that is not an OBB");
+	primitive.m_orientedBox = box;
+	UpdatePrimitiveBounds(primitive);
+}
+
+void BVH3::SetZCylinder(int primitiveIndex, Vec3 const& center, float radiusXY, FloatRange const& minMaxZ)
+{
+	BVHPrimitive3D& primitive = m_primitives[primitiveIndex];
+	GUARANTEE_OR_DIE(primitive.m_shape == BVHShape3D::ZCYLINDER, "BVH3::SetZCylinder called on a primitive that is not a Z cylinder");
+	primitive.m_center = center;
+	primitive.m_radius = radiusXY;
+	primitive.m_minMaxZ = minMaxZ;
+	UpdatePrimitiveBounds(primitive);
+}
+
+void BVH3::Build()
+{
+	m_nodes.clear();
+	m_primitiveOrder.resize(m_primitives.size());
+	for (int primitiveIndex = 0; primitiveIndex < static_cast<int>(m_primitives.size()); primitiveIndex++)
+	{
+		m_primitiveOrder[primitiveIndex] = primitiveIndex;
+	}
+
+	if (!m_primitives.empty())
+	{
+		m_nodes.reserve(2 * m_primitives.size());
+		m_nodes.push_back(BVHNode3D());
+		BuildNode(0, 0, static_cast<int>(m_primitives.size()), 0);
+	}
+	m_isBuilt = true;
+}
+
+void BVH3::Refit()
+{
+	GUARANTEE_OR_DIE(m_isBuilt, "BVH3::Refit called before Build or after adding primitives");
+
+	//Children always sit after their parent, so walking backwards finishes both children before their parent
+	for (int nodeIndex = static_cast<int>(m_nodes.size()) - 1; nodeIndex >= 0; nodeIndex--)
+	{
+		BVHNode3D& node = m_nodes[nodeIndex];
+		if (node.m_numPrimitives > 0)
+		{
+			node.m_bounds = GetEmptyBounds();
+			for (int orderIndex = node.m_firstPrimitive; orderIndex < node.m_firstPrimitive + node.m_numPrimitives; orderIndex++)
+			{
+				StretchToIncludeBounds(node.m_bounds, m_primitives[m_primitiveOrder[orderIndex]].m_bounds);
+			}
+		}
+		else
+		{
+			node.m_bounds = m_nodes[node.m_leftChild].m_bounds;
+			StretchToIncludeBounds(node.m_bounds, m_nodes[node.m_rightChild].m_bounds);
+		}
+	}
+}
+
+void BVH3::Clear()
+{
+	m_primitives.clear();
+	m_nodes.clear();
+	m_primitiveOrder.clear();
+	m_isBuilt = false;
+}
+
+int BVH3::GetNumPrimitives() const
+{
+	return static_cast<int>(m_primitives.size());
+}
+
+int BVH3::GetNumNodes() const
+{
+	return static_cast<int>(m_nodes.size());
+}
+
+BVHPrimitive3D const& BVH3::GetPrimitive(int primitiveIndex) const
+{
+	return m_primitives[primitiveIndex];
+}
+
+AABB3 BVH3::GetBounds() const
+{
+	if (m_nodes.empty())
+	{
+		return AABB3();
+	}
+	return m_nodes[0].m_bounds;
+}
+
+RaycastResult3D BVH3::RaycastClosest(Vec3 startPos, Vec3 fwdNormal, float maxDist, int* hitPrimitiveIndex) const
+{
+	GUARANTEE_OR_DIE(m_isBuilt, "BVH3::RaycastClosest called before Build or after adding primitives");
+
+	RaycastResult3D nearestResult;
+	nearestResult.m_rayFwdNormal = fwdNormal;
+	nearestResult.m_rayStartPos = startPos;
+	nearestResult.m_rayMaxLength = maxDist;
+	nearestResult.m_didImpact = false;
+	nearestResult.m_impactDist = maxDist;
+	nearestResult.m_impactPos = startPos + fwdNormal * maxDist;
+	nearestResult.m_impactNormal = fwdNormal;
+	int nearestIndex = -1;
+
+	float rootEnter = 0.f;
+	if (m_nodes.empty() || !RaycastVsNodeBounds(m_nodes[0].m_bounds, startPos, fwdNormal, maxDist, rootEnter))
+	{
+		if (hitPrimitiveIndex)
+		{
+			*hitPrimitiveIndex = -1;
+		}
+		return nearestResult;
+	}
+
+	//Pending nodes with their entry distance, nearer child on top so hits found early prune the farther subtrees
+	int stackNodes[BVH_STACK_SIZE];
+	float stackEnters[BVH_STACK_SIZE];
+	int stackSize = 0;
+	stackNodes[stackSize] = 0;
+	stackEnters[stackSize++] = rootEnter;
+
+	while (stackSize > 0)
+	{
+		stackSize--;
+		if (nearestIndex >= 0 && stackEnters[stackSize] > nearestResult.m_impactDist)
+		{
+			continue;
+		}
+
+		BVHNode3D const& node = m_nodes[stackNodes[stackSize]];
+		if (node.m_numPrimitives > 0)
+		{
+			for (int orderIndex = node.m_firstPrimitive; orderIndex < node.m_firstPrimitive + node.m_numPrimitives; orderIndex++)
+			{
+				int primitiveIndex = m_primitiveOrder[orderIndex];
+				RaycastResult3D result = RaycastVsPrimitive(startPos, fwdNormal, maxDist, m_primitives[primitiveIndex]);
+				if (!IsImpactOnRay(result))
+				{
+					continue;
+				}
+				if (nearestIndex < 0 || result.m_impactDist < nearestResult.m_impactDist ||
+					(result.m_impactDist == nearestResult.m_impactDist && primitiveIndex < nearestIndex))
+				{
+					nearestResult = result;
+					nearestIndex = primitiveIndex;
+				}
+			}
+			continue;
+		}
+
+		float clipDist = nearestIndex >= 0 ? nearestResult.m_impactDist : maxDist;
+		float leftEnter = 0.f;
+		float rightEnter = 0.f;
+		bool hitLeft = RaycastVsNodeBounds(m_nodes[node.m_leftChild].m_bounds, startPos, fwdNormal, clipDist, leftEnter);
+		bool hitRight = RaycastVsNodeBounds(m_nodes[node.m_rightChild].m_bounds, startPos, fwdNormal, clipDist, rightEnter);
+		if (hitLeft && hitRight && leftEnter < rightEnter)
+		{
+			stackNodes[stackSize] = node.m_rightChild;
+			stackEnters[stackSize++] = rightEnter;
+			stackNodes[stackSize] = node.m_leftChild;
+			stackEnters[stackSize++] = leftEnter;
+			continue;
+		}
+		if (hitLeft)
+		{
+			stackNodes[stackSize] = node.m_leftChild;
+			stackEnters[stackSize++] = leftEnter;
+		}
+		if (hitRight)
+		{
+			stackNodes[stackSize] = node.m_rightChild;
+			stackEnters[stackSize++] = rightEnter;
+		}
+	}
+
+	if (hitPrimitiveIndex)
+	{
+		*hitPrimitiveIndex = nearestIndex;
+	}
+	return nearestResult;
+}
+
+bool BVH3::RaycastAny(Vec3 startPos, Vec3 fwdNormal, float maxDist) const
+{
+	GUARANTEE_OR_DIE(m_isBuilt, "BVH3::RaycastAny called before Build or after adding primitives");
+	if (m_nodes.empty())
+	{
+		return false;
+	}
+
+	int stackNodes[BVH_STACK_SIZE];
+	int stackSize = 0;
+	stackNodes[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		BVHNode3D const& node = m_nodes[stackNodes[--stackSize]];
+		float tEnter = 0.f;
+		if (!RaycastVsNodeBounds(node.m_bounds, startPos, fwdNormal, maxDist, tEnter))
+		{
+			continue;
+		}
+
+		if (node.m_numPrimitives > 0)
+		{
+			for (int orderIndex = node.m_firstPrimitive; orderIndex < node.m_firstPrimitive + node.m_numPrimitives; orderIndex++)
+			{
+				if (IsImpactOnRay(RaycastVsPrimitive(startPos, fwdNormal, maxDist, m_primitives[m_primitiveOrder[orderIndex]])))
+				{
+					return true;
+				}
+			}
+			continue;
+		}
+		stackNodes[stackSize++] = node.m_rightChild;
+		stackNodes[stackSize++] = node.m_leftChild;
+	}
+	return false;
+}
+
+void BVH3::QuerySphere(Vec3 const& center, float radius, std::vector<int>& primitiveIndexes) const
+{
+	GUARANTEE_OR_DIE(m_isBuilt, "BVH3::QuerySphere called before Build or after adding primitives");
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	int stackNodes[BVH_STACK_SIZE];
+	int stackSize = 0;
+	stackNodes[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		BVHNode3D const& node = m_nodes[stackNodes[--stackSize]];
+		if (!DoesSphereAABBOverlap3D(center, radius, node.m_bounds))
+		{
+			continue;
+		}
+
+		if (node.m_numPrimitives > 0)
+		{
+			for (int orderIndex = node.m_firstPrimitive; orderIndex < node.m_firstPrimitive + node.m_numPrimitives; orderIndex++)
+			{
+				int primitiveIndex = m_primitiveOrder[orderIndex];
+				if (DoesSphereOverlapPrimitive(center, radius, m_primitives[primitiveIndex]))
+				{
+					primitiveIndexes.push_back(primitiveIndex);
+				}
+			}
+			continue;
+		}
+		stackNodes[stackSize++] = node.m_rightChild;
+		stackNodes[stackSize++] = node.m_leftChild;
+	}
+}
+
+void BVH3::QueryAABB(AABB3 const& box, std::vector<int>& primitiveIndexes) const
+{
+	GUARANTEE_OR_DIE(m_isBuilt, "BVH3::QueryAABB called before Build or after adding primitives");
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	int stackNodes[BVH_STACK_SIZE];
+	int stackSize = 0;
+	stackNodes[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		BVHNode3D const& node = m_nodes[stackNodes[--stackSize]];
+		if (!DoAABBsOverlap3D(box, node.m_bounds))
+		{
+			continue;
+		}
+
+		if (node.m_numPrimitives > 0)
+		{
+			for (int orderIndex = node.m_firstPrimitive; orderIndex < node.m_firstPrimitive + node.m_numPrimitives; orderIndex++)
+			{
+				int primitiveIndex = m_primitiveOrder[orderIndex];
+				if (DoesAABBOverlapPrimitive(box, m_primitives[primitiveIndex]))
+				{
+					primitiveIndexes.push_back(primitiveIndex);
+				}
+			}
+			continue;
+		}
+		stackNodes[stackSize++] = node.m_rightChild;
+		stackNodes[stackSize++] = node.m_leftChild;
+	}
+}
+
+int BVH3::AddPrimitive(BVHPrimitive3D const& primitive)
+{
+	m_primitives.push_back(primitive);
+	UpdatePrimitiveBounds(m_primitives.back());
+	m_isBuilt = false;
+	return static_cast<int>(m_primitives.size()) - 1;
+}
+
+void BVH3::UpdatePrimitiveBounds(BVHPrimitive3D& primitive)
+{
+	switch (primitive.m_shape)
+	{
+	case BVHShape3D::SPHERE:
+	{
+		Vec3 radii = Vec3(primitive.m_radius, primitive.m_radius, primitive.m_radius);
+		primitive.m_bounds = AABB3(primitive.m_center - radii, primitive.m_center + radii);
+		break;
+	}
+	case BVHShape3D::AABB:
+		primitive.m_bounds = primitive.m_box;
+		break;
+	case BVHShape3D::OBB:
+	{
+		OBB3 const& box = primitive.m_orientedBox;
+		Vec3 extents;
+		extents.x = fabsf(box.m_iBasis.x) * box.m_halfDims.x + fabsf(box.m_jBasis.x) * box.m_halfDims.y + fabsf(box.m_kBasis.x) * box.m_halfDims.z;
+		extents.y = fabsf(box.m_iBasis.y) * box.m_halfDims.x + fabsf(box.m_jBasis.y) * box.m_halfDims.y + fabsf(box.m_kBasis.y) * box.m_halfDims.z;
+		extents.z = fabsf(box.m_iBasis.z) * box.m_halfDims.x + fabsf(box.m_jBasis.z) * box.m_halfDims.y + fabsf(box.m_kBasis.z) * box.m_halfDims.z;
+		primitive.m_bounds = AABB3(box.m_center - extents, box.m_center + extents);
+		break;
+	}
+	case BVHShape3D::ZCYLINDER:
+		primitive.m_bounds = AABB3(primitive.m_center.x - primitive.m_radius, primitive.m_center.y - primitive.m_radius, primitive.m_minMaxZ.m_min,
+			primitive.m_center.x + primitive.m_radius, primitive.m_center.y + primitive.m_radius, primitive.m_minMaxZ.m_max);
+		break;
+	default:
+		ERROR_AND_DIE("Unknown BVHShape3D");
+	}
+}
+
+void BVH3::BuildNode(int nodeIndex, int firstPrimitive, int numPrimitives, int depth)
+{
+	AABB3 bounds = GetEmptyBounds();
+	AABB3 centerBounds = GetEmptyBounds();
+	for (int orderIndex = firstPrimitive; orderIndex < firstPrimitive + numPrimitives; orderIndex++)
+	{
+		AABB3 const& primitiveBounds = m_primitives[m_primitiveOrder[orderIndex]].m_bounds;
+		Vec3 center = GetBoundsCenter(primitiveBounds);
+		StretchToIncludeBounds(bounds, primitiveBounds);
+		StretchToIncludeBounds(centerBounds, AABB3(center, center));
+	}
+	m_nodes[nodeIndex].m_bounds = bounds;
+
+	if (numPrimitives <= m_config.m_maxPrimitivesPerLeaf || depth >= BVH_MAX_DEPTH)
+	{
+		m_nodes[nodeIndex].m_firstPrimitive = firstPrimitive;
+		m_nodes[nodeIndex].m_numPrimitives = numPrimitives;
+		return;
+	}
+
+	//Binned SAH: drop primitive centers into equal-width bins per axis and try every plane between bins
+	constexpr int MAX_SAH_BINS = 32;
+	int numBins = std::max(2, std::min(m_config.m_numSAHBins, MAX_SAH_BINS));
+	float bestCost = FLT_MAX;
+	int bestAxis = -1;
+	int bestSplit = 0;
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float centerMin = GetAxisValue(centerBounds.m_mins, axis);
+		float centerMax = GetAxisValue(centerBounds.m_maxs, axis);
+		if (centerMax <= centerMin)
+		{
+			continue;
+		}
+
+		AABB3 binBounds[MAX_SAH_BINS];
+		int binCounts[MAX_SAH_BINS] = {};
+		for (int binIndex = 0; binIndex < numBins; binIndex++)
+		{
+			binBounds[binIndex] = GetEmptyBounds();
+		}
+		float binScale = static_cast<float>(numBins) / (centerMax - centerMin);
+		for (int orderIndex = firstPrimitive; orderIndex < firstPrimitive + numPrimitives; orderIndex++)
+		{
+			AABB3 const& primitiveBounds = m_primitives[m_primitiveOrder[orderIndex]].m_bounds;
+			int binIndex = std::min(numBins - 1, static_cast<int>((GetAxisValue(GetBoundsCenter(primitiveBounds), axis) - centerMin) * binScale));
+			binCounts[binIndex]++;
+			StretchToIncludeBounds(binBounds[binIndex], primitiveBounds);
+		}
+
+		//Sweep from the right once to get every right-side area, then from the left to price each split
+		float rightAreas[MAX_SAH_BINS];
+		int rightCounts[MAX_SAH_BINS];
+		AABB3 rightBounds = GetEmptyBounds();
+		int rightCount = 0;
+		for (int binIndex = numBins - 1; binIndex > 0; binIndex--)
+		{
+			StretchToIncludeBounds(rightBounds, binBounds[binIndex]);
+			rightCount += binCounts[binIndex];
+			rightAreas[binIndex] = GetHalfSurfaceArea(rightBounds);
+			rightCounts[binIndex] = rightCount;
+		}
+
+		AABB3 leftBounds = GetEmptyBounds();
+		int leftCount = 0;
+		for (int split = 1; split < numBins; split++)
+		{
+			StretchToIncludeBounds(leftBounds, binBounds[split - 1]);
+			leftCount += binCounts[split - 1];
+			if (leftCount == 0 || rightCounts[split] == 0)
+			{
+				continue;
+			}
+			float cost = GetHalfSurfaceArea(leftBounds) * leftCount + rightAreas[split] * rightCounts[split];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = split;
+			}
+		}
+	}
+
+	int* orderBegin = m_primitiveOrder.data() + firstPrimitive;
+	int* orderEnd = orderBegin + numPrimitives;
+	int numLeft = 0;
+	if (bestAxis >= 0)
+	{
+		float centerMin = GetAxisValue(centerBounds.m_mins, bestAxis);
+		float binScale = static_cast<float>(numBins) / (GetAxisValue(centerBounds.m_maxs, bestAxis) - centerMin);
+		int* middle = std::partition(orderBegin, orderEnd, [&](int primitiveIndex)
+			{
+				float center = GetAxisValue(GetBoundsCenter(m_primitives[primitiveIndex].m_bounds), bestAxis);
+				return std::min(numBins - 1, static_cast<int>((center - centerMin) * binScale)) < bestSplit;
+			});
+		numLeft = static_cast<int>(middle - orderBegin);
+	}
+	else
+	{
+		//Every center is the same point, so any split is as good as another; halve the list to keep leaves small
+		numLeft = numPrimitives / 2;
+	}
+
+	int leftChild = static_cast<int>(m_nodes.size());
+	m_nodes.push_back(BVHNode3D());
+	m_nodes.push_back(BVHNode3D());
+	m_nodes[nodeIndex].m_leftChild = leftChild;
+	m_nodes[nodeIndex].m_rightChild = leftChild + 1;
+	BuildNode(leftChild, firstPrimitive, numLeft, depth + 1);
+	BuildNode(leftChild + 1, firstPrimitive + numLeft, numPrimitives - numLeft, depth + 1);
+}
+
+RaycastResult3D BVH3::RaycastVsPrimitive(Vec3 startPos, Vec3 fwdNormal, float maxDist, BVHPrimitive3D const& primitive) const
+{
+	switch (primitive.m_shape)
+	{
+	case BVHShape3D::SPHERE:
+		return RaycastVsSphere3D(startPos, fwdNormal, maxDist, primitive.m_center, primitive.m_radius);
+	case BVHShape3D::AABB:
+		return RaycastVsAABB3D(startPos, fwdNormal, maxDist, primitive.m_box);
+	case BVHShape3D::OBB:
+		return RaycastVsOBB3D(startPos, fwdNormal, maxDist, primitive.m_orientedBox);
+	case BVHShape3D::ZCYLINDER:
+		return RaycastVsCylinderZ3D(startPos, fwdNormal, maxDist, primitive.m_center, primitive.m_minMaxZ, primitive.m_radius);
+	default:
+		ERROR_AND_DIE("Unknown BVHShape3D");
+	}
+}
+
+bool BVH3::DoesSphereOverlapPrimitive(Vec3 const& center, float radius, BVHPrimitive3D const& primitive) const
+{
+	switch (primitive.m_shape)
+	{
+	case BVHShape3D::SPHERE:
+		return DoSpheresOverlap3D(center, radius, primitive.m_center, primitive.m_radius);
+	case BVHShape3D::AABB:
+		return DoesSphereAABBOverlap3D(center, radius, primitive.m_box);
+	case BVHShape3D::OBB:
+		return DoesSphereOBBOverlap3D(center, radius, primitive.m_orientedBox);
+	case BVHShape3D::ZCYLINDER:
+		return DoesSphereZCylinderOverlap3D(center, radius, primitive.m_center, primitive.m_radius, primitive.m_minMaxZ);
+	default:
+		ERROR_AND_DIE("Unknown BVHShape3D");
+	}
+}
+
+bool BVH3::DoesAABBOverlapPrimitive(AABB3 const& box, BVHPrimitive3D const& primitive) const
+{
+	switch (primitive.m_shape)
+	{
+	case BVHShape3D::SPHERE:
+		return DoesSphereAABBOverlap3D(primitive.m_center, primitive.m_radius, box);
+	case BVHShape3D::AABB:
+		return DoAABBsOverlap3D(box, primitive.m_box);
+	case BVHShape3D::OBB:
+		return DoesAABBOBBOverlap3D(box, primitive.m_orientedBox);
+	case BVHShape3D::ZCYLINDER:
+		return DoesAABBZCylinderOverlap3D(box, primitive.m_center, primitive.m_radius, primitive.m_minMaxZ);
+	default:
+		ERROR_AND_DIE("Unknown BVHShape3D");
+	}
+}
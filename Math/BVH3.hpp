@@ -0,0 +1,91 @@
+#pragma once
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/OBB3.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+#include <vector>
+
+enum class BVHShape3D
+{
+	SPHERE,
+	AABB,
+	OBB,
+	ZCYLINDER,
+	COUNT
+};
+
+//One leaf shape. Only the fields for m_shape are used; spheres and Z cylinders share m_center and m_radius (XY radius for cylinders).
+struct BVHPrimitive3D
+{
+	BVHShape3D	m_shape = BVHShape3D::SPHERE;
+	Vec3		m_center;
+	float		m_radius = 0.f;
+	FloatRange	m_minMaxZ;
+	AABB3		m_box;
+	OBB3		m_orientedBox;
+	AABB3		m_bounds;
+};
+
+struct BVHNode3D
+{
+	AABB3	m_bounds;
+	int		m_leftChild = -1;
+	int		m_rightChild = -1;
+	int		m_firstPrimitive = 0; //Into BVH3's primitive order, leaves only
+	int		m_numPrimitives = 0; //Zero for interior nodes
+};
+
+struct BVH3Config
+{
+	int m_maxPrimitivesPerLeaf = 4;
+	int m_numSAHBins = 12;
+};
+
+//Bounding volume hierarchy over mixed 3D primitives. Add primitives, Build once, then after moving primitives with Set* call Refit,
+//which keeps the tree shape and only grows or shrinks the node bounds. Rebuild when objects have moved far enough that queries slow down.
+class BVH3
+{
+public:
+	explicit BVH3(BVH3Config const& config = BVH3Config());
+
+	//Each returns the primitive index used by Set* and reported by queries
+	int		AddSphere(Vec3 const& center, float radius);
+	int		AddAABB(AABB3 const& box);
+	int		AddOBB(OBB3 const& box);
+	int		AddZCylinder(Vec3 const& center, float radiusXY, FloatRange const& minMaxZ);
+
+	void	SetSphere(int primitiveIndex, Vec3 const& center, float radius);
+	void	SetAABB(int primitiveIndex, AABB3 const& box);
+	void	SetOBB(int primitiveIndex, OBB3 const& box);
+	void	SetZCylinder(int primitiveIndex, Vec3 const& center, float radiusXY, FloatRange const& minMaxZ);
+
+	void	Build();
+	void	Refit();
+	void	Clear();
+
+	int						GetNumPrimitives() const;
+	int						GetNumNodes() const;
+	BVHPrimitive3D const&	GetPrimitive(int primitiveIndex) const;
+	AABB3					GetBounds() const;
+
+	//Queries reuse the single-shape RaycastVs* and Do*Overlap3D functions on the leaves they reach. Overlap queries append to primitiveIndexes.
+	RaycastResult3D	RaycastClosest(Vec3 startPos, Vec3 fwdNormal, float maxDist, int* hitPrimitiveIndex = nullptr) const;
+	bool			RaycastAny(Vec3 startPos, Vec3 fwdNormal, float maxDist) const;
+	void			QuerySphere(Vec3 const& center, float radius, std::vector<int>& primitiveIndexes) const;
+	void			QueryAABB(AABB3 const& box, std::vector<int>& primitiveIndexes) const;
+
+protected:
+	int		AddPrimitive(BVHPrimitive3D const& primitive);
+	void	UpdatePrimitiveBounds(BVHPrimitive3D& primitive);
+	void	BuildNode(int nodeIndex, int firstPrimitive, int numPrimitives, int depth);
+	RaycastResult3D RaycastVsPrimitive(Vec3 startPos, Vec3 fwdNormal, float maxDist, BVHPrimitive3D const& primitive) const;
+	bool	DoesSphereOverlapPrimitive(Vec3 const& center, float radius, BVHPrimitive3D const& primitive) const;
+	bool	DoesAABBOverlapPrimitive(AABB3 const& box, BVHPrimitive3D const& primitive) const;
+
+protected:
+	BVH3Config m_config;
+	std::vector<BVHPrimitive3D> m_primitives;
+	std::vector<BVHNode3D> m_nodes; //Root is node 0, children always come after their parent
+	std::vector<int> m_primitiveOrder; //Leaf ranges index into this
+	bool m_isBuilt = false;
+};
@@ -0,0 +1,400 @@
+#include "DiscBroadphase2D.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include <algorithm>
+#include <cmath>
+
+static void RemoveIDFromList(std::vector<int>& ids, int id)
+{
+	for (int index = 0; index < static_cast<int>(ids.size()); index++)
+	{
+		if (ids[index] == id)
+		{
+			ids[index] = ids.back();
+			ids.pop_back();
+			return;
+		}
+	}
+}
+
+DiscBroadphase2D::DiscBroadphase2D(DiscBroadphase2DConfig const& config)
+	: m_config(config)
+{
+	GUARANTEE_OR_DIE(m_config.m_cellSize > 0.f, "DiscBroadphase2D cell size must be positive");
+}
+
+int DiscBroadphase2D::AddDisc(Vec2 const& center, float radius, bool isStatic)
+{
+	int discID;
+	if (!m_freeDiscIDs.empty())
+	{
+		discID = m_freeDiscIDs.back();
+		m_freeDiscIDs.pop_back();
+	}
+	else
+	{
+		discID = static_cast<int>(m_discs.size());
+		m_discs.push_back(BroadphaseDisc2D());
+	}
+
+	BroadphaseDisc2D& disc = m_discs[discID];
+	disc.m_center = center;
+	disc.m_radius = radius;
+	disc.m_isStatic = isStatic;
+	disc.m_isActive = true;
+	GetDiscCellRange(center, radius, disc.m_minCell, disc.m_maxCell);
+	AddDiscToCells(discID);
+	m_numDiscs++;
+	return discID;
+}
+
+void DiscBroadphase2D::MoveDisc(int discID, Vec2 const& newCenter)
+{
+	GUARANTEE_OR_DIE(IsDiscValid(discID), "DiscBroadphase2D::MoveDisc called with an invalid disc ID");
+	m_discs[discID].m_center = newCenter;
+	UpdateDiscCells(discID);
+}
+
+void DiscBroadphase2D::SetDiscRadius(int discID, float newRadius)
+{
+	GUARANTEE_OR_DIE(IsDiscValid(discID), "DiscBroadphase2D::SetDiscRadius called with an invalid disc ID");
+	m_discs[discID].m_radius = newRadius;
+	UpdateDiscCells(discID);
+}
+
+void DiscBroadphase2D::RemoveDisc(int discID)
+{
+	GUARANTEE_OR_DIE(IsDiscValid(discID), "DiscBroadphase2D::RemoveDisc called with an invalid disc ID");
+	RemoveDiscFromCells(discID);
+	m_discs[discID].m_isActive = false;
+	m_freeDiscIDs.push_back(discID);
+	m_numDiscs--;
+}
+
+int DiscBroadphase2D::AddStaticBox(AABB2 const& bounds)
+{
+	int boxID;
+	if (!m_freeBoxIDs.empty())
+	{
+		boxID = m_freeBoxIDs.back();
+		m_freeBoxIDs.pop_back();
+	}
+	else
+	{
+		boxID = static_cast<int>(m_boxes.size());
+		m_boxes.push_back(BroadphaseBox2D());
+	}
+
+	BroadphaseBox2D& box = m_boxes[boxID];
+	box.m_bounds = bounds;
+	box.m_isActive = true;
+	GetCellRange(bounds.m_mins, bounds.m_maxs, box.m_minCell, box.m_maxCell);
+	for (int cellY = box.m_minCell.y; cellY <= box.m_maxCell.y; cellY++)
+	{
+		for (int cellX = box.m_minCell.x; cellX <= box.m_maxCell.x; cellX++)
+		{
+			m_cells[IntVec2(cellX, cellY)].m_boxIDs.push_back(boxID);
+		}
+	}
+	return boxID;
+}
+
+void DiscBroadphase2D::RemoveStaticBox(int boxID)
+{
+	GUARANTEE_OR_DIE(boxID >= 0 && boxID < static_cast<int>(m_boxes.size()) && m_boxes[boxID].m_isActive, "DiscBroadphase2D::RemoveStaticBox called with an invalid box ID");
+	BroadphaseBox2D& box = m_boxes[boxID];
+	for (int cellY = box.m_minCell.y; cellY <= box.m_maxCell.y; cellY++)
+	{
+		for (int cellX = box.m_minCell.x; cellX <= box.m_maxCell.x; cellX++)
+		{
+			RemoveIDFromCell(IntVec2(cellX, cellY), boxID, true);
+		}
+	}
+	box.m_isActive = false;
+	m_freeBoxIDs.push_back(boxID);
+}
+
+void DiscBroadphase2D::Clear()
+{
+	m_discs.clear();
+	m_freeDiscIDs.clear();
+	m_boxes.clear();
+	m_freeBoxIDs.clear();
+	m_cells.clear();
+	m_numDiscs = 0;
+}
+
+Vec2 DiscBroadphase2D::GetDiscCenter(int discID) const
+{
+	return m_discs[discID].m_center;
+}
+
+float DiscBroadphase2D::GetDiscRadius(int discID) const
+{
+	return m_discs[discID].m_radius;
+}
+
+bool DiscBroadphase2D::IsDiscValid(int discID) const
+{
+	return discID >= 0 && discID < static_cast<int>(m_discs.size()) && m_discs[discID].m_isActive;
+}
+
+int DiscBroadphase2D::GetNumDiscs() const
+{
+	return m_numDiscs;
+}
+
+int DiscBroadphase2D::GetNumOccupiedCells() const
+{
+	return static_cast<int>(m_cells.size());
+}
+
+void DiscBroadphase2D::GetCandidatePairs(std::vector<DiscPair2D>& pairs) const
+{
+	for (auto const& cellPair : m_cells)
+	{
+		IntVec2 const& cell = cellPair.first;
+		std::vector<int> const& discIDs = cellPair.second.m_discIDs;
+		int numDiscsInCell = static_cast<int>(discIDs.size());
+		for (int indexA = 0; indexA < numDiscsInCell; indexA++)
+		{
+			BroadphaseDisc2D const& discA = m_discs[discIDs[indexA]];
+			for (int indexB = indexA + 1; indexB < numDiscsInCell; indexB++)
+			{
+				BroadphaseDisc2D const& discB = m_discs[discIDs[indexB]];
+				if (discA.m_isStatic && discB.m_isStatic)
+				{
+					continue;
+				}
+				if (!IsFirstSharedCell(cell, discA.m_minCell, discB.m_minCell))
+				{
+					continue;
+				}
+
+				DiscPair2D pair;
+				pair.m_discA = discIDs[indexA];
+				pair.m_discB = discIDs[indexB];
+				pairs.push_back(pair);
+			}
+		}
+	}
+}
+
+void DiscBroadphase2D::GetOverlappingPairs(std::vector<DiscPair2D>& pairs) const
+{
+	size_t firstNewPair = pairs.size();
+	GetCandidatePairs(pairs);
+
+	size_t numKept = firstNewPair;
+	for (size_t pairIndex = firstNewPair; pairIndex < pairs.size(); pairIndex++)
+	{
+		BroadphaseDisc2D const& discA = m_discs[pairs[pairIndex].m_discA];
+		BroadphaseDisc2D const& discB = m_discs[pairs[pairIndex].m_discB];
+		if (DoDiscsOverlap2D(discA.m_center, discA.m_radius, discB.m_center, discB.m_radius))
+		{
+			pairs[numKept++] = pairs[pairIndex];
+		}
+	}
+	pairs.resize(numKept);
+}
+
+void DiscBroadphase2D::QueryDisc(Vec2 const& center, float radius, std::vector<int>& discIDs) const
+{
+	IntVec2 minCell;
+	IntVec2 maxCell;
+	GetDiscCellRange(center, radius, minCell, maxCell);
+	for (int cellY = minCell.y; cellY <= maxCell.y; cellY++)
+	{
+		for (int cellX = minCell.x; cellX <= maxCell.x; cellX++)
+		{
+			IntVec2 cell = IntVec2(cellX, cellY);
+			auto found = m_cells.find(cell);
+			if (found == m_cells.end())
+			{
+				continue;
+			}
+
+			for (int discID : found->second.m_discIDs)
+			{
+				//Report each disc only from the first cell it shares with the query range
+				BroadphaseDisc2D const& disc = m_discs[discID];
+				if (!IsFirstSharedCell(cell, disc.m_minCell, minCell))
+				{
+					continue;
+				}
+				if (DoDiscsOverlap2D(center, radius, disc.m_center, disc.m_radius))
+				{
+					discIDs.push_back(discID);
+				}
+			}
+		}
+	}
+}
+
+int DiscBroadphase2D::ResolveCollisions(int numIterations)
+{
+	int numPushes = 0;
+	for (int iteration = 0; iteration < numIterations; iteration++)
+	{
+		m_pairScratch.clear();
+		m_boxPairScratch.clear();
+		GetCandidatePairs(m_pairScratch);
+		GetDiscBoxCandidatePairs(m_boxPairScratch);
+
+		int numPushesThisIteration = 0;
+		for (DiscPair2D const& pair : m_pairScratch)
+		{
+			BroadphaseDisc2D& discA = m_discs[pair.m_discA];
+			BroadphaseDisc2D& discB = m_discs[pair.m_discB];
+			bool didPush = false;
+			if (discA.m_isStatic)
+			{
+				didPush = PushDiscOutOfDisc2D(discB.m_center, discB.m_radius, discA.m_center, discA.m_radius);
+			}
+			else if (discB.m_isStatic)
+			{
+				didPush = PushDiscOutOfDisc2D(discA.m_center, discA.m_radius, discB.m_center, discB.m_radius);
+			}
+			else
+			{
+				didPush = PushDiscsOutOfEachOther2D(discA.m_center, discA.m_radius, discB.m_center, discB.m_radius);
+			}
+			if (didPush)
+			{
+				numPushesThisIteration++;
+			}
+		}
+
+		for (DiscPair2D const& pair : m_boxPairScratch)
+		{
+			BroadphaseDisc2D& disc = m_discs[pair.m_discA];
+			if (PushDiscOutOfAABB2D(disc.m_center, disc.m_radius, m_boxes[pair.m_discB].m_bounds))
+			{
+				numPushesThisIteration++;
+			}
+		}
+
+		//Grid cells are only refreshed once the pass is done, pushes are small enough that stale cells for one pass are harmless
+		for (int discID = 0; discID < static_cast<int>(m_discs.size()); discID++)
+		{
+			if (m_discs[discID].m_isActive && !m_discs[discID].m_isStatic)
+			{
+				UpdateDiscCells(discID);
+			}
+		}
+
+		numPushes += numPushesThisIteration;
+		if (numPushesThisIteration == 0)
+		{
+			break;
+		}
+	}
+	return numPushes;
+}
+
+void DiscBroadphase2D::GetCellRange(Vec2 const& mins, Vec2 const& maxs, IntVec2& minCell, IntVec2& maxCell) const
+{
+	float cellsPerUnit = 1.f / m_config.m_cellSize;
+	minCell = IntVec2(static_cast<int>(floorf(mins.x * cellsPerUnit)), static_cast<int>(floorf(mins.y * cellsPerUnit)));
+	maxCell = IntVec2(static_cast<int>(floorf(maxs.x * cellsPerUnit)), static_cast<int>(floorf(maxs.y * cellsPerUnit)));
+}
+
+void DiscBroadphase2D::GetDiscCellRange(Vec2 const& center, float radius, IntVec2& minCell, IntVec2& maxCell) const
+{
+	GetCellRange(center - Vec2(radius, radius), center + Vec2(radius, radius), minCell, maxCell);
+}
+
+void DiscBroadphase2D::AddDiscToCells(int discID)
+{
+	BroadphaseDisc2D const& disc = m_discs[discID];
+	for (int cellY = disc.m_minCell.y; cellY <= disc.m_maxCell.y; cellY++)
+	{
+		for (int cellX = disc.m_minCell.x; cellX <= disc.m_maxCell.x; cellX++)
+		{
+			m_cells[IntVec2(cellX, cellY)].m_discIDs.push_back(discID);
+		}
+	}
+}
+
+void DiscBroadphase2D::RemoveDiscFromCells(int discID)
+{
+	BroadphaseDisc2D const& disc = m_discs[discID];
+	for (int cellY = disc.m_minCell.y; cellY <= disc.m_maxCell.y; cellY++)
+	{
+		for (int cellX = disc.m_minCell.x; cellX <= disc.m_maxCell.x; cellX++)
+		{
+			RemoveIDFromCell(IntVec2(cellX, cellY), discID, false);
+		}
+	}
+}
+
+void DiscBroadphase2D::RemoveIDFromCell(IntVec2 const& cell, int id, bool isBoxID)
+{
+	auto found = m_cells.find(cell);
+	if (found == m_cells.end())
+	{
+		return;
+	}
+	BroadphaseCell2D& foundCell = found->second;
+	RemoveIDFromList(isBoxID ? foundCell.m_boxIDs : foundCell.m_discIDs, id);
+	if (foundCell.m_discIDs.empty() && foundCell.m_boxIDs.empty())
+	{
+		m_cells.erase(found);
+	}
+}
+
+void DiscBroadphase2D::UpdateDiscCells(int discID)
+{
+	BroadphaseDisc2D& disc = m_discs[discID];
+	IntVec2 newMinCell;
+	IntVec2 newMaxCell;
+	GetDiscCellRange(disc.m_center, disc.m_radius, newMinCell, newMaxCell);
+	if (newMinCell == disc.m_minCell && newMaxCell == disc.m_maxCell)
+	{
+		return;
+	}
+
+	RemoveDiscFromCells(discID);
+	disc.m_minCell = newMinCell;
+	disc.m_maxCell = newMaxCell;
+	AddDiscToCells(discID);
+}
+
+//Two ranges that overlap share a block of cells; only its min corner reports the pair, so no pair comes out twice
+bool DiscBroadphase2D::IsFirstSharedCell(IntVec2 const& cell, IntVec2 const& minCellA, IntVec2 const& minCellB) const
+{
+	return cell.x == std::max(minCellA.x, minCellB.x) && cell.y == std::max(minCellA.y, minCellB.y);
+}
+
+void DiscBroadphase2D::GetDiscBoxCandidatePairs(std::vector<DiscPair2D>& pairs) const
+{
+	for (auto const& cellPair : m_cells)
+	{
+		BroadphaseCell2D const& cell = cellPair.second;
+		if (cell.m_boxIDs.empty())
+		{
+			continue;
+		}
+
+		for (int discID : cell.m_discIDs)
+		{
+			BroadphaseDisc2D const& disc = m_discs[discID];
+			if (disc.m_isStatic)
+			{
+				continue;
+			}
+			for (int boxID : cell.m_boxIDs)
+			{
+				if (!IsFirstSharedCell(cellPair.first, disc.m_minCell, m_boxes[boxID].m_minCell))
+				{
+					continue;
+				}
+
+				DiscPair2D pair;
+				pair.m_discA = discID;
+				pair.m_discB = boxID;
+				pairs.push_back(pair);
+			}
+		}
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include <vector>
+#include <unordered_map>
+
+struct DiscBroadphase2DConfig
+{
+	float m_cellSize = 2.f; //Around twice the typical disc radius keeps most discs in one to four cells
+};
+
+struct DiscPair2D
+{
+	int m_discA = -1;
+	int m_discB = -1;
+};
+
+struct BroadphaseDisc2D
+{
+	Vec2	m_center;
+	float	m_radius = 0.f;
+	bool	m_isStatic = false;
+	bool	m_isActive = false;
+	IntVec2	m_minCell;
+	IntVec2	m_maxCell;
+};
+
+struct BroadphaseBox2D
+{
+	AABB2	m_bounds;
+	bool	m_isActive = false;
+	IntVec2	m_minCell;
+	IntVec2	m_maxCell;
+};
+
+struct BroadphaseCell2D
+{
+	std::vector<int> m_discIDs;
+	std::vector<int> m_boxIDs;
+};
+
+//Spatial hash over IntVec2 cells for disc physics built on PushDiscsOutOfEachOther2D, PushDiscOutOfDisc2D and PushDiscOutOfAABB2D.
+//Each disc is listed in every cell its bounds touch, and moving a disc only touches the grid when that cell range changes.
+//Static discs and boxes never move during ResolveCollisions; dynamic discs are pushed out of everything they overlap.
+class DiscBroadphase2D
+{
+public:
+	explicit DiscBroadphase2D(DiscBroadphase2DConfig const& config = DiscBroadphase2DConfig());
+
+	//IDs stay valid until removed and are reused afterwards
+	int		AddDisc(Vec2 const& center, float radius, bool isStatic = false);
+	void	MoveDisc(int discID, Vec2 const& newCenter);
+	void	SetDiscRadius(int discID, float newRadius);
+	void	RemoveDisc(int discID);
+	int		AddStaticBox(AABB2 const& bounds);
+	void	RemoveStaticBox(int boxID);
+	void	Clear();
+
+	Vec2	GetDiscCenter(int discID) const;
+	float	GetDiscRadius(int discID) const;
+	bool	IsDiscValid(int discID) const;
+	int		GetNumDiscs() const;
+	int		GetNumOccupiedCells() const;
+
+	//Append each unordered pair once. Candidates only share a cell, overlapping pairs also pass DoDiscsOverlap2D. Static-static pairs are skipped.
+	void	GetCandidatePairs(std::vector<DiscPair2D>& pairs) const;
+	void	GetOverlappingPairs(std::vector<DiscPair2D>& pairs) const;
+	void	QueryDisc(Vec2 const& center, float radius, std::vector<int>& discIDs) const;
+
+	//Pushes overlapping discs apart, numIterations times over the whole set, and returns how many pushes were made
+	int		ResolveCollisions(int numIterations = 1);
+
+protected:
+	void	GetCellRange(Vec2 const& mins, Vec2 const& maxs, IntVec2& minCell, IntVec2& maxCell) const;
+	void	GetDiscCellRange(Vec2 const& center, float radius, IntVec2& minCell, IntVec2& maxCell) const;
+	void	AddDiscToCells(int discID);
+	void	RemoveDiscFromCells(int discID);
+	void	RemoveIDFromCell(IntVec2 const& cell, int id, bool isBoxID); //Erases the cell once it holds nothing
+	void	UpdateDiscCells(int discID);
+	bool	IsFirstSharedCell(IntVec2 const& cell, IntVec2 const& minCellA, IntVec2 const& minCellB) const;
+	void	GetDiscBoxCandidatePairs(std::vector<DiscPair2D>& pairs) const; //m_discB holds the box ID
+
+protected:
+	DiscBroadphase2DConfig m_config;
+	std::vector<BroadphaseDisc2D> m_discs;
+	std::vector<int> m_freeDiscIDs;
+	std::vector<BroadphaseBox2D> m_boxes;
+	std::vector<int> m_freeBoxIDs;
+	int m_numDiscs = 0;
+
+	//Only occupied cells are stored, so walking the map costs nothing for ground discs have left
+	std::unordered_map<IntVec2, BroadphaseCell2D, IntVec2Hash> m_cells;
+	std::vector<DiscPair2D> m_pairScratch;
+	std::vector<DiscPair2D> m_boxPairScratch;
+};
@@ -41,17 +41,17 @@ Mat44 EulerAngles::GetAsMatrix_IFwd_JLeft_KUp() const
 	return returningMatrix;
 }
 
-void EulerAngles::SetFromText(const char* text)
+void EulerAngles::SetFromText(std::string_view text)
 {
 	//VALID: y, p, r
-	Strings variables = SplitStringOnDelimiter(text, ',');
-	if (variables.size() != 3 || variables[0].c_str() == nullptr || variables[1].c_str() == nullptr || variables[2].c_str() == nullptr)
+	std::string_view variables[3];
+	if (SplitStringViewOnDelimiter(text, ',', variables, 3) != 3)
 	{
 		ERROR_AND_DIE("Invalid arguments passed into EulerAngles String");
 	}
-	m_yawDegrees = static_cast<float>(atof(variables[0].c_str()));
-	m_pitchDegrees = static_cast<float>(atof(variables[1].c_str()));
-	m_rollDegrees = static_cast<float>(atof(variables[2].c_str()));
+	m_yawDegrees = ParseFloat(variables[0]);
+	m_pitchDegrees = ParseFloat(variables[1]);
+	m_rollDegrees = ParseFloat(variables[2]);
 }
 
 Vec3 EulerAngles::GetForwardNormal() const
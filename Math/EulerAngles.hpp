@@ -1,4 +1,5 @@
 #pragma once
+#include <string_view>
 
 struct Vec3;
 struct Mat44;
@@ -10,7 +11,7 @@ public:
 	EulerAngles(float yawDegrees, float pitchDegrees, float rollDegrees);
 	void GetAsVectors_IFwd_JLeft_KUp(Vec3& out_fwdIBasis, Vec3& out_rightJBasis, Vec3& out_upKBasis);
 	Mat44 GetAsMatrix_IFwd_JLeft_KUp() const;
-	void SetFromText(const char* text);
+	void SetFromText(std::string_view text);
 	Vec3 GetForwardNormal() const;
 
 	float m_yawDegrees = 0.0f;
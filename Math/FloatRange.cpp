@@ -62,14 +62,14 @@ float FloatRange::GetRandomFloatInclusive() const
 	return g_rng->RollRandomFloatInRange(m_min, m_max);
 }
 
-void FloatRange::SetFromText(char const* text)
+void FloatRange::SetFromText(std::string_view text)
 {
-	//VALID: min, max
-	Strings variables = SplitStringOnDelimiter(text, '~');
-	if (variables.size() != 2 || variables[0].c_str() == nullptr || variables[1].c_str() == nullptr)
+	//VALID: min~max
+	std::string_view variables[2];
+	if (SplitStringViewOnDelimiter(text, '~', variables, 2) != 2)
 	{
 		ERROR_AND_DIE("Invalid arguments passed into FloatRange String");
 	}
-	m_min = static_cast<float>(atof(variables[0].c_str()));
-	m_max = static_cast<float>(atof(variables[1].c_str()));
+	m_min = ParseFloat(variables[0]);
+	m_max = ParseFloat(variables[1]);
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <string_view>
 
 struct FloatRange
 {
@@ -19,7 +20,7 @@ public:
 	bool IsOverlappingWith(FloatRange range) const;
 	float GetRandomFloatInclusive() const;
 
-	void SetFromText(char const* text);
+	void SetFromText(std::string_view text);
 
 	static const FloatRange ZERO;
 	static const FloatRange ONE;
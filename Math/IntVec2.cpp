@@ -147,13 +147,20 @@ void IntVec2::RotateMinus90Degrees()
 	y = -temp;
 }
 
-void IntVec2::SetFromText(char const* text)
+void IntVec2::SetFromText(std::string_view text)
 {
-	Strings variables = SplitStringOnDelimiter(text, ',');
-	if (variables.size() != 2 || variables[0].c_str() == nullptr || variables[1].c_str() == nullptr)
+	std::string_view variables[2];
+	if (SplitStringViewOnDelimiter(text, ',', variables, 2) != 2)
 	{
 		ERROR_AND_DIE("Invalid arguments passed into IntVec2 String");
 	}
-	x = atoi(variables[0].c_str());
-	y = atoi(variables[1].c_str());
+	x = ParseInt(variables[0]);
+	y = ParseInt(variables[1]);
+}
+
+size_t IntVec2Hash::operator()(IntVec2 const& coords) const
+{
+	unsigned long long key = (static_cast<unsigned long long>(static_cast<unsigned int>(coords.x)) << 32) | static_cast<unsigned int>(coords.y);
+	key *= 0x9E3779B97F4A7C15ull;
+	return static_cast<size_t>(key ^ (key >> 32));
 }
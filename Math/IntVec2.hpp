@@ -1,4 +1,6 @@
 #pragma once
+#include <cstddef>
+#include <string_view>
 
 struct IntVec2
 {
@@ -41,5 +43,11 @@ public:
 
 	void	Rotate90Degrees();
 	void	RotateMinus90Degrees();
-	void	SetFromText(char const* text);
+	void	SetFromText(std::string_view text);
+};
+
+//Lets IntVec2 key unordered containers, e.g. std::unordered_map<IntVec2, Cell, IntVec2Hash>
+struct IntVec2Hash
+{
+	size_t operator()(IntVec2 const& coords) const;
 };
\ No newline at end of file
@@ -112,6 +112,7 @@ bool			DoesSphereAABBOverlap3D(Vec3 const& center, float const& radius, AABB3 bo
 bool			DoesSphereZCylinderOverlap3D(Vec3 const& centerSphere, float const& radiusSphere, Vec3 centerCylinder, float radiusCylinder, FloatRange zRangeCylinder);
 bool			DoesSphereOBBOverlap3D(Vec3 const& center, float const& radius, OBB3 const& box);
 bool			DoesAABBZCylinderOverlap3D(AABB3 box, Vec3 centerCylinder, float radiusCylinder, FloatRange zRangeCylinder);
+bool			DoesAABBOBBOverlap3D(AABB3 const& box, OBB3 const& orientedBox);
 bool			DoesPlaneOverlapSphere3D(Plane3 const& plane, Vec3 const& center, float radius);
 bool			DoesPlaneOverlapAABB3D(Plane3 const& plane, AABB3 const& box);
 bool			DoesPlaneOverlapOBB3D(Plane3 const& plane, OBB3 const& box);
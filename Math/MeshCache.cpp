@@ -0,0 +1,288 @@
+#include "MeshCache.hpp"
+#include "Engine/Math/VertexUtils.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <cmath>
+
+bool MeshCacheKey::operator<(MeshCacheKey const& compare) const
+{
+	if (m_shape != compare.m_shape)
+	{
+		return m_shape < compare.m_shape;
+	}
+	if (m_isLit != compare.m_isLit)
+	{
+		return !m_isLit;
+	}
+	if (m_numSlices != compare.m_numSlices)
+	{
+		return m_numSlices < compare.m_numSlices;
+	}
+	if (m_numStacks != compare.m_numStacks)
+	{
+		return m_numStacks < compare.m_numStacks;
+	}
+	if (m_UVs.m_mins.x != compare.m_UVs.m_mins.x)
+	{
+		return m_UVs.m_mins.x < compare.m_UVs.m_mins.x;
+	}
+	if (m_UVs.m_mins.y != compare.m_UVs.m_mins.y)
+	{
+		return m_UVs.m_mins.y < compare.m_UVs.m_mins.y;
+	}
+	if (m_UVs.m_maxs.x != compare.m_UVs.m_maxs.x)
+	{
+		return m_UVs.m_maxs.x < compare.m_UVs.m_maxs.x;
+	}
+	return m_UVs.m_maxs.y < compare.m_UVs.m_maxs.y;
+}
+
+MeshCache::MeshCache(MeshCacheConfig const& config)
+	: m_config(config)
+{
+}
+
+MeshCache::~MeshCache()
+{
+	Clear();
+}
+
+CachedMesh const& MeshCache::GetOrCreateMesh(MeshCacheKey const& key)
+{
+	MeshCacheKey normalizedKey = key;
+	if (normalizedKey.m_shape != MeshShape::SPHERE)
+	{
+		normalizedKey.m_numStacks = 0;
+	}
+
+	auto found = m_meshesByKey.find(normalizedKey);
+	if (found != m_meshesByKey.end())
+	{
+		m_stats.m_numHits++;
+		CachedMesh* mesh = found->second;
+		m_lruMeshes.splice(m_lruMeshes.begin(), m_lruMeshes, mesh->m_lruPosition);
+		return *mesh;
+	}
+
+	m_stats.m_numMisses++;
+	CachedMesh* mesh = new CachedMesh();
+	mesh->m_key = normalizedKey;
+	BuildMesh(*mesh);
+	mesh->m_sizeBytes = mesh->m_vertexes.size() * sizeof(Vertex_PCU) + mesh->m_litVertexes.size() * sizeof(Vertex_PCUTBN) + mesh->m_indexes.size() * sizeof(unsigned int);
+
+	m_lruMeshes.push_front(mesh);
+	mesh->m_lruPosition = m_lruMeshes.begin();
+	m_meshesByKey[normalizedKey] = mesh;
+	m_stats.m_numMeshes++;
+	m_stats.m_bytesUsed += mesh->m_sizeBytes;
+
+	EvictToBudget();
+	return *mesh;
+}
+
+CachedMesh const& MeshCache::GetOrCreateSphere(bool isLit, int numSlices, int numStacks, AABB2 const& UVs)
+{
+	MeshCacheKey key;
+	key.m_shape = MeshShape::SPHERE;
+	key.m_isLit = isLit;
+	key.m_numSlices = numSlices;
+	key.m_numStacks = numStacks;
+	key.m_UVs = UVs;
+	return GetOrCreateMesh(key);
+}
+
+CachedMesh const& MeshCache::GetOrCreateCylinder(bool isLit, int numSlices, AABB2 const& UVs)
+{
+	MeshCacheKey key;
+	key.m_shape = MeshShape::CYLINDER;
+	key.m_isLit = isLit;
+	key.m_numSlices = numSlices;
+	key.m_UVs = UVs;
+	return GetOrCreateMesh(key);
+}
+
+CachedMesh const& MeshCache::GetOrCreateCone(bool isLit, int numSlices, AABB2 const& UVs)
+{
+	MeshCacheKey key;
+	key.m_shape = MeshShape::CONE;
+	key.m_isLit = isLit;
+	key.m_numSlices = numSlices;
+	key.m_UVs = UVs;
+	return GetOrCreateMesh(key);
+}
+
+void MeshCache::SetMemoryBudget(size_t memoryBudgetBytes)
+{
+	m_config.m_memoryBudgetBytes = memoryBudgetBytes;
+	EvictToBudget();
+}
+
+size_t MeshCache::GetMemoryBudget() const
+{
+	return m_config.m_memoryBudgetBytes;
+}
+
+MeshCacheStats const& MeshCache::GetStats() const
+{
+	return m_stats;
+}
+
+void MeshCache::ResetStats()
+{
+	m_stats.m_numHits = 0;
+	m_stats.m_numMisses = 0;
+	m_stats.m_numEvictions = 0;
+}
+
+void MeshCache::Clear()
+{
+	for (CachedMesh* mesh : m_lruMeshes)
+	{
+		delete mesh;
+	}
+	m_lruMeshes.clear();
+	m_meshesByKey.clear();
+	m_stats.m_numMeshes = 0;
+	m_stats.m_bytesUsed = 0;
+}
+
+Mat44 MeshCache::GetSphereTransform(Vec3 const& center, float radius)
+{
+	Mat44 transform = Mat44::MakeTranslation3D(center);
+	transform.AppendScaleUniform3D(radius);
+	return transform;
+}
+
+Mat44 MeshCache::GetCylinderTransform(Vec3 const& start, Vec3 const& end, float radius)
+{
+	//Same ring basis AddVertsForCylinder3D picks, so the unit ring's +X/+Y land on its j/k
+	Vec3 fwd = end - start;
+	Vec3 fwdNormal = fwd.GetNormalized();
+
+	Vec3 reference;
+	if (fabsf(fwdNormal.y) < 0.9f)
+	{
+		reference = Vec3(0, 1, 0);
+	}
+	else
+	{
+		reference = Vec3(0, 0, 1);
+	}
+	Vec3 j = CrossProduct3D(reference, fwdNormal).GetNormalized();
+	Vec3 k = CrossProduct3D(fwdNormal, j);
+	return Mat44(j * radius, k * radius, fwd, start);
+}
+
+void MeshCache::BuildMesh(CachedMesh& mesh) const
+{
+	MeshCacheKey const& key = mesh.m_key;
+	switch (key.m_shape)
+	{
+	case MeshShape::SPHERE:
+		if (key.m_isLit)
+		{
+			AddVertsForLitSphere(mesh.m_litVertexes, mesh.m_indexes, Vec3(), 1.f, Rgba8::WHITE, key.m_UVs, key.m_numSlices, key.m_numStacks);
+		}
+		else
+		{
+			AddVertsForSphere(mesh.m_vertexes, mesh.m_indexes, Vec3(), 1.f, Rgba8::WHITE, key.m_UVs, key.m_numSlices, key.m_numStacks);
+		}
+		break;
+	case MeshShape::CYLINDER:
+		if (key.m_isLit)
+		{
+			AddVertsForLitCylinder3D(mesh.m_litVertexes, mesh.m_indexes, Vec3(), Vec3(0.f, 0.f, 1.f), 1.f, Rgba8::WHITE, key.m_UVs, key.m_numSlices);
+		}
+		else
+		{
+			AddVertsForCylinder3D(mesh.m_vertexes, mesh.m_indexes, Vec3(), Vec3(0.f, 0.f, 1.f), 1.f, Rgba8::WHITE, key.m_UVs, key.m_numSlices);
+		}
+		break;
+	case MeshShape::CONE:
+		if (key.m_isLit)
+		{
+			AddVertsForLitCone3D(mesh.m_litVertexes, mesh.m_indexes, Vec3(), Vec3(0.f, 0.f, 1.f), 1.f, Rgba8::WHITE, key.m_UVs, key.m_numSlices);
+		}
+		else
+		{
+			AddVertsForCone3D(mesh.m_vertexes, mesh.m_indexes, Vec3(), Vec3(0.f, 0.f, 1.f), 1.f, Rgba8::WHITE, key.m_UVs, key.m_numSlices);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void MeshCache::EvictToBudget()
+{
+	//The most recent mesh is never evicted so the caller's reference is always good
+	while (m_stats.m_bytesUsed > m_config.m_memoryBudgetBytes && m_lruMeshes.size() > 1)
+	{
+		EvictMesh(m_lruMeshes.back());
+	}
+}
+
+void MeshCache::EvictMesh(CachedMesh* mesh)
+{
+	m_stats.m_numEvictions++;
+	m_stats.m_numMeshes--;
+	m_stats.m_bytesUsed -= mesh->m_sizeBytes;
+	m_meshesByKey.erase(mesh->m_key);
+	m_lruMeshes.erase(mesh->m_lruPosition);
+	delete mesh;
+}
+
+void AddVertsForCachedMesh(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, CachedMesh const& mesh, Mat44 const& transform, Rgba8 const& color)
+{
+	unsigned int firstVertexIndex = static_cast<unsigned int>(verts.size());
+	verts.reserve(verts.size() + mesh.m_vertexes.size());
+	indexes.reserve(indexes.size() + mesh.m_indexes.size());
+
+	for (int vertIndex = 0; vertIndex < static_cast<int>(mesh.m_vertexes.size()); vertIndex++)
+	{
+		Vertex_PCU const& unitVert = mesh.m_vertexes[vertIndex];
+		verts.push_back(Vertex_PCU(transform.TransformPosition3D(unitVert.m_position), color, unitVert.m_uvTexCoords));
+	}
+	for (int index = 0; index < static_cast<int>(mesh.m_indexes.size()); index++)
+	{
+		indexes.push_back(firstVertexIndex + mesh.m_indexes[index]);
+	}
+}
+
+void AddVertsForCachedMesh(std::vector<Vertex_PCU>& verts, CachedMesh const& mesh, Mat44 const& transform, Rgba8 const& color)
+{
+	verts.reserve(verts.size() + mesh.m_indexes.size());
+	for (int index = 0; index < static_cast<int>(mesh.m_indexes.size()); index++)
+	{
+		Vertex_PCU const& unitVert = mesh.m_vertexes[mesh.m_indexes[index]];
+		verts.push_back(Vertex_PCU(transform.TransformPosition3D(unitVert.m_position), color, unitVert.m_uvTexCoords));
+	}
+}
+
+void AddVertsForCachedMesh(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, CachedMesh const& mesh, Mat44 const& transform, Rgba8 const& color)
+{
+	unsigned int firstVertexIndex = static_cast<unsigned int>(verts.size());
+	verts.reserve(verts.size() + mesh.m_litVertexes.size());
+	indexes.reserve(indexes.size() + mesh.m_indexes.size());
+
+	//Normals go through the inverse transpose, which for perpendicular bases is each basis divided by its squared length
+	Vec3 iBasis = transform.GetIBasis3D();
+	Vec3 jBasis = transform.GetJBasis3D();
+	Vec3 kBasis = transform.GetKBasis3D();
+	Vec3 iNormalBasis = iBasis / iBasis.GetLengthSquared();
+	Vec3 jNormalBasis = jBasis / jBasis.GetLengthSquared();
+	Vec3 kNormalBasis = kBasis / kBasis.GetLengthSquared();
+
+	for (int vertIndex = 0; vertIndex < static_cast<int>(mesh.m_litVertexes.size()); vertIndex++)
+	{
+		Vertex_PCUTBN const& unitVert = mesh.m_litVertexes[vertIndex];
+		Vec3 normal = (iNormalBasis * unitVert.m_normal.x + jNormalBasis * unitVert.m_normal.y + kNormalBasis * unitVert.m_normal.z).GetNormalized();
+		verts.push_back(Vertex_PCUTBN(transform.TransformPosition3D(unitVert.m_position), color, unitVert.m_uvTexCoords,
+			transform.TransformVectorQuantity3D(unitVert.m_tangent), transform.TransformVectorQuantity3D(unitVert.m_bitangent), normal));
+	}
+	for (int index = 0; index < static_cast<int>(mesh.m_indexes.size()); index++)
+	{
+		indexes.push_back(firstVertexIndex + mesh.m_indexes[index]);
+	}
+}
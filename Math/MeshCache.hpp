@@ -0,0 +1,99 @@
+#pragma once
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include <vector>
+#include <map>
+#include <list>
+
+struct Mat44;
+
+enum class MeshShape
+{
+	SPHERE,
+	CYLINDER, //Unit cylinder runs from the origin to +Z with radius 1
+	CONE, //Unit cone has its base disc at the origin and its point at +Z, radius 1
+	COUNT
+};
+
+struct MeshCacheKey
+{
+	MeshShape m_shape = MeshShape::SPHERE;
+	bool m_isLit = false;
+	int m_numSlices = 32;
+	int m_numStacks = 16; //Spheres only
+	AABB2 m_UVs = AABB2::ZERO_TO_ONE;
+
+	bool operator<(MeshCacheKey const& compare) const;
+};
+
+//A unit shape built once and then placed by transform. Exactly one of the vertex arrays is filled depending on m_key.m_isLit.
+struct CachedMesh
+{
+	MeshCacheKey m_key;
+	std::vector<Vertex_PCU> m_vertexes;
+	std::vector<Vertex_PCUTBN> m_litVertexes;
+	std::vector<unsigned int> m_indexes;
+	size_t m_sizeBytes = 0;
+	std::list<CachedMesh*>::iterator m_lruPosition;
+};
+
+struct MeshCacheConfig
+{
+	size_t m_memoryBudgetBytes = 4 * 1024 * 1024;
+};
+
+struct MeshCacheStats
+{
+	int		m_numHits		= 0;
+	int		m_numMisses		= 0;
+	int		m_numEvictions	= 0;
+	int		m_numMeshes		= 0;
+	size_t	m_bytesUsed		= 0;
+};
+
+class MeshCache
+{
+public:
+	explicit MeshCache(MeshCacheConfig const& config = MeshCacheConfig());
+	~MeshCache();
+	MeshCache(MeshCache const& copy) = delete;
+	MeshCache& operator=(MeshCache const& copy) = delete;
+
+	//Returned meshes stay valid until the next GetOrCreate call can evict them, so copy or draw them before asking for another
+	CachedMesh const& GetOrCreateMesh(MeshCacheKey const& key);
+	CachedMesh const& GetOrCreateSphere(bool isLit, int numSlices = 32, int numStacks = 16, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+	CachedMesh const& GetOrCreateCylinder(bool isLit, int numSlices = 32, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+	CachedMesh const& GetOrCreateCone(bool isLit, int numSlices = 32, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+
+	//Evicts least recently used meshes right away if the new budget is already exceeded
+	void	SetMemoryBudget(size_t memoryBudgetBytes);
+	size_t	GetMemoryBudget() const;
+
+	MeshCacheStats const&	GetStats() const;
+	void					ResetStats();
+	void					Clear();
+
+public:
+	//Transforms that place the unit shapes where the matching AddVertsFor* call would have built them
+	static Mat44 GetSphereTransform(Vec3 const& center, float radius);
+	static Mat44 GetCylinderTransform(Vec3 const& start, Vec3 const& end, float radius); //Also cones
+
+protected:
+	void BuildMesh(CachedMesh& mesh) const;
+	void EvictToBudget();
+	void EvictMesh(CachedMesh* mesh);
+
+protected:
+	MeshCacheConfig m_config;
+	MeshCacheStats m_stats;
+	std::map<MeshCacheKey, CachedMesh*> m_meshesByKey;
+
+	//Most recently used at the front
+	std::list<CachedMesh*> m_lruMeshes;
+};
+
+//Bake a cached mesh into a batch. Transform bases must be mutually perpendicular (rotation plus per-axis scale) for lit normals to stay correct.
+void AddVertsForCachedMesh(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, CachedMesh const& mesh, Mat44 const& transform, Rgba8 const& color = Rgba8::WHITE);
+void AddVertsForCachedMesh(std::vector<Vertex_PCU>& verts, CachedMesh const& mesh, Mat44 const& transform, Rgba8 const& color = Rgba8::WHITE); //Unindexed triangle list
+void AddVertsForCachedMesh(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, CachedMesh const& mesh, Mat44 const& transform, Rgba8 const& color = Rgba8::WHITE);
@@ -4,6 +4,11 @@
 #include "Engine/Math/LineSegment2.hpp"
 #include "Engine/Math/Plane3.hpp"
 #include "Engine/Math/OBB3.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include <cfloat>
+#if defined(ENGINE_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
 
 RaycastResult2D RaycastVsDisc2D(Vec2 startPos, Vec2 fwdNormal, float maxDist, Vec2 discCenter, float discRadius)
 {
@@ -244,6 +249,23 @@ RaycastResult3D RaycastVsSphere3D(Vec3 startPos, Vec3 fwdNormal, float maxDist,
 	return result;
 }
 
+//Entry and exit distances through one pair of slabs, nearest first. Axes the ray runs parallel to never leave or enter,
+//so they span everything when the start is between the slabs (faces included) and nothing otherwise, instead of 0/0 = NaN.
+static void GetSlabEnterExit(float start, float fwd, float mins, float maxs, float& tMin, float& tMax)
+{
+	if (fwd == 0.f)
+	{
+		bool isBetweenSlabs = start >= mins && start <= maxs;
+		tMin = isBetweenSlabs ? -FLT_MAX : FLT_MAX;
+		tMax = isBetweenSlabs ? FLT_MAX : -FLT_MAX;
+		return;
+	}
+
+	tMin = (mins - start) / fwd;
+	tMax = (maxs - start) / fwd;
+	if (tMin > tMax) std::swap(tMin, tMax);
+}
+
 RaycastResult3D RaycastVsAABB3D(Vec3 startPos, Vec3 fwdNormal, float maxDist, AABB3 box)
 {
 	RaycastResult3D result;
@@ -262,16 +284,10 @@ RaycastResult3D RaycastVsAABB3D(Vec3 startPos, Vec3 fwdNormal, float maxDist, AA
 
 	Vec3 rayMaxEnd = startPos + (fwdNormal * maxDist);
 
-	float tXMin = (box.m_mins.x - startPos.x) / fwdNormal.x;
-	float tXMax = (box.m_maxs.x - startPos.x) / fwdNormal.x;
-	float tYMin = (box.m_mins.y - startPos.y) / fwdNormal.y;
-	float tYMax = (box.m_maxs.y - startPos.y) / fwdNormal.y;
-	float tZMin = (box.m_mins.z - startPos.z) / fwdNormal.z;
-	float tZMax = (box.m_maxs.z - startPos.z) / fwdNormal.z;
-
-	if (tXMin > tXMax) std::swap(tXMin, tXMax);
-	if (tYMin > tYMax) std::swap(tYMin, tYMax);
-	if (tZMin > tZMax) std::swap(tZMin, tZMax);
+	float tXMin, tXMax, tYMin, tYMax, tZMin, tZMax;
+	GetSlabEnterExit(startPos.x, fwdNormal.x, box.m_mins.x, box.m_maxs.x, tXMin, tXMax);
+	GetSlabEnterExit(startPos.y, fwdNormal.y, box.m_mins.y, box.m_maxs.y, tYMin, tYMax);
+	GetSlabEnterExit(startPos.z, fwdNormal.z, box.m_mins.z, box.m_maxs.z, tZMin, tZMax);
 
 	float tEnter = std::max(tXMin, tYMin);
 	tEnter = std::max(tEnter, tZMin);
@@ -344,16 +360,10 @@ RaycastResult3D RaycastVsOBB3D(Vec3 startPos, Vec3 fwdNormal, float maxDist, OBB
 		return result;
 	}
 
-	float tIMin = (-box.m_halfDims.x - localSpaceStart.x) / localFwdNormal.x;
-	float tIMax = ( box.m_halfDims.x - localSpaceStart.x) / localFwdNormal.x;
-	float tJMin = (-box.m_halfDims.y - localSpaceStart.y) / localFwdNormal.y;
-	float tJMax = ( box.m_halfDims.y - localSpaceStart.y) / localFwdNormal.y;
-	float tKMin = (-box.m_halfDims.z - localSpaceStart.z) / localFwdNormal.z;
-	float tKMax = ( box.m_halfDims.z - localSpaceStart.z) / localFwdNormal.z;
-
-	if (tIMin > tIMax) std::swap(tIMin, tIMax);
-	if (tJMin > tJMax) std::swap(tJMin, tJMax);
-	if (tKMin > tKMax) std::swap(tKMin, tKMax);
+	float tIMin, tIMax, tJMin, tJMax, tKMin, tKMax;
+	GetSlabEnterExit(localSpaceStart.x, localFwdNormal.x, -box.m_halfDims.x, box.m_halfDims.x, tIMin, tIMax);
+	GetSlabEnterExit(localSpaceStart.y, localFwdNormal.y, -box.m_halfDims.y, box.m_halfDims.y, tJMin, tJMax);
+	GetSlabEnterExit(localSpaceStart.z, localFwdNormal.z, -box.m_halfDims.z, box.m_halfDims.z, tKMin, tKMax);
 
 	float tEnter = std::max(tIMin, tJMin);
 	tEnter = std::max(tEnter, tKMin);
@@ -609,3 +619,596 @@ RaycastResult3D RaycastVsPlane3D(Vec3 startPos, Vec3 fwdNormal, float maxDist, P
 
 	return result;
 }
+
+//Batched raycasts ////////////////////////////////////////////////////////////////////////////////
+void RaycastBatch3D::AddRay(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist)
+{
+	m_startX.push_back(startPos.x);
+	m_startY.push_back(startPos.y);
+	m_startZ.push_back(startPos.z);
+	m_fwdX.push_back(fwdNormal.x);
+	m_fwdY.push_back(fwdNormal.y);
+	m_fwdZ.push_back(fwdNormal.z);
+	m_maxDist.push_back(maxDist);
+}
+
+void RaycastBatch3D::Reserve(int numRays)
+{
+	m_startX.reserve(numRays);
+	m_startY.reserve(numRays);
+	m_startZ.reserve(numRays);
+	m_fwdX.reserve(numRays);
+	m_fwdY.reserve(numRays);
+	m_fwdZ.reserve(numRays);
+	m_maxDist.reserve(numRays);
+}
+
+void RaycastBatch3D::Clear()
+{
+	m_startX.clear();
+	m_startY.clear();
+	m_startZ.clear();
+	m_fwdX.clear();
+	m_fwdY.clear();
+	m_fwdZ.clear();
+	m_maxDist.clear();
+}
+
+int RaycastBatch3D::GetNumRays() const
+{
+	return static_cast<int>(m_startX.size());
+}
+
+void SphereBatch3D::AddSphere(Vec3 const& center, float radius)
+{
+	m_centerX.push_back(center.x);
+	m_centerY.push_back(center.y);
+	m_centerZ.push_back(center.z);
+	m_radius.push_back(radius);
+}
+
+void SphereBatch3D::Reserve(int numSpheres)
+{
+	m_centerX.reserve(numSpheres);
+	m_centerY.reserve(numSpheres);
+	m_centerZ.reserve(numSpheres);
+	m_radius.reserve(numSpheres);
+}
+
+void SphereBatch3D::Clear()
+{
+	m_centerX.clear();
+	m_centerY.clear();
+	m_centerZ.clear();
+	m_radius.clear();
+}
+
+int SphereBatch3D::GetNumSpheres() const
+{
+	return static_cast<int>(m_centerX.size());
+}
+
+void AABB3Batch3D::AddBox(AABB3 const& box)
+{
+	m_minsX.push_back(box.m_mins.x);
+	m_minsY.push_back(box.m_mins.y);
+	m_minsZ.push_back(box.m_mins.z);
+	m_maxsX.push_back(box.m_maxs.x);
+	m_maxsY.push_back(box.m_maxs.y);
+	m_maxsZ.push_back(box.m_maxs.z);
+}
+
+AABB3 AABB3Batch3D::GetBox(int boxIndex) const
+{
+	return AABB3(Vec3(m_minsX[boxIndex], m_minsY[boxIndex], m_minsZ[boxIndex]), Vec3(m_maxsX[boxIndex], m_maxsY[boxIndex], m_maxsZ[boxIndex]));
+}
+
+void AABB3Batch3D::Reserve(int numBoxes)
+{
+	m_minsX.reserve(numBoxes);
+	m_minsY.reserve(numBoxes);
+	m_minsZ.reserve(numBoxes);
+	m_maxsX.reserve(numBoxes);
+	m_maxsY.reserve(numBoxes);
+	m_maxsZ.reserve(numBoxes);
+}
+
+void AABB3Batch3D::Clear()
+{
+	m_minsX.clear();
+	m_minsY.clear();
+	m_minsZ.clear();
+	m_maxsX.clear();
+	m_maxsY.clear();
+	m_maxsZ.clear();
+}
+
+int AABB3Batch3D::GetNumBoxes() const
+{
+	return static_cast<int>(m_minsX.size());
+}
+
+void OBB3Batch3D::AddBox(OBB3 const& box)
+{
+	m_centerX.push_back(box.m_center.x);
+	m_centerY.push_back(box.m_center.y);
+	m_centerZ.push_back(box.m_center.z);
+	m_iBasisX.push_back(box.m_iBasis.x);
+	m_iBasisY.push_back(box.m_iBasis.y);
+	m_iBasisZ.push_back(box.m_iBasis.z);
+	m_jBasisX.push_back(box.m_jBasis.x);
+	m_jBasisY.push_back(box.m_jBasis.y);
+	m_jBasisZ.push_back(box.m_jBasis.z);
+	m_kBasisX.push_back(box.m_kBasis.x);
+	m_kBasisY.push_back(box.m_kBasis.y);
+	m_kBasisZ.push_back(box.m_kBasis.z);
+	m_halfDimsX.push_back(box.m_halfDims.x);
+	m_halfDimsY.push_back(box.m_halfDims.y);
+	m_halfDimsZ.push_back(box.m_halfDims.z);
+}
+
+OBB3 OBB3Batch3D::GetBox(int boxIndex) const
+{
+	return OBB3(Vec3(m_centerX[boxIndex], m_centerY[boxIndex], m_centerZ[boxIndex]),
+		Vec3(m_iBasisX[boxIndex], m_iBasisY[boxIndex], m_iBasisZ[boxIndex]),
+		Vec3(m_jBasisX[boxIndex], m_jBasisY[boxIndex], m_jBasisZ[boxIndex]),
+		Vec3(m_kBasisX[boxIndex], m_kBasisY[boxIndex], m_kBasisZ[boxIndex]),
+		Vec3(m_halfDimsX[boxIndex], m_halfDimsY[boxIndex], m_halfDimsZ[boxIndex]));
+}
+
+void OBB3Batch3D::Reserve(int numBoxes)
+{
+	m_centerX.reserve(numBoxes);
+	m_centerY.reserve(numBoxes);
+	m_centerZ.reserve(numBoxes);
+	m_iBasisX.reserve(numBoxes);
+	m_iBasisY.reserve(numBoxes);
+	m_iBasisZ.reserve(numBoxes);
+	m_jBasisX.reserve(numBoxes);
+	m_jBasisY.reserve(numBoxes);
+	m_jBasisZ.reserve(numBoxes);
+	m_kBasisX.reserve(numBoxes);
+	m_kBasisY.reserve(numBoxes);
+	m_kBasisZ.reserve(numBoxes);
+	m_halfDimsX.reserve(numBoxes);
+	m_halfDimsY.reserve(numBoxes);
+	m_halfDimsZ.reserve(numBoxes);
+}
+
+void OBB3Batch3D::Clear()
+{
+	m_centerX.clear();
+	m_centerY.clear();
+	m_centerZ.clear();
+	m_iBasisX.clear();
+	m_iBasisY.clear();
+	m_iBasisZ.clear();
+	m_jBasisX.clear();
+	m_jBasisY.clear();
+	m_jBasisZ.clear();
+	m_kBasisX.clear();
+	m_kBasisY.clear();
+	m_kBasisZ.clear();
+	m_halfDimsX.clear();
+	m_halfDimsY.clear();
+	m_halfDimsZ.clear();
+}
+
+int OBB3Batch3D::GetNumBoxes() const
+{
+	return static_cast<int>(m_centerX.size());
+}
+
+static RaycastResult3D MakeRaycastMiss3D(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist)
+{
+	RaycastResult3D result;
+	result.m_rayFwdNormal = fwdNormal;
+	result.m_rayStartPos = startPos;
+	result.m_rayMaxLength = maxDist;
+	result.m_didImpact = false;
+	result.m_impactDist = maxDist;
+	result.m_impactPos = startPos + fwdNormal * maxDist;
+	result.m_impactNormal = fwdNormal;
+	return result;
+}
+
+static void KeepIfNearer(RaycastResult3D const& candidate, int shapeIndex, float& nearestDist, int& nearestIndex)
+{
+	if (candidate.m_didImpact && (nearestIndex < 0 || candidate.m_impactDist < nearestDist))
+	{
+		nearestDist = candidate.m_impactDist;
+		nearestIndex = shapeIndex;
+	}
+}
+
+#if defined(ENGINE_SIMD_SSE2)
+//Each lane remembers the nearest hit among the shapes it has seen. Strict less-than keeps the earlier shape on ties, like the scalar loop.
+static void KeepNearerLanes(__m128 didImpact, __m128 impactDist, __m128i shapeIndexes, __m128& nearestDists, __m128i& nearestIndexes)
+{
+	__m128 isNearer = _mm_and_ps(didImpact, _mm_cmplt_ps(impactDist, nearestDists));
+	__m128i isNearerMask = _mm_castps_si128(isNearer);
+	nearestDists = _mm_or_ps(_mm_and_ps(isNearer, impactDist), _mm_andnot_ps(isNearer, nearestDists));
+	nearestIndexes = _mm_or_si128(_mm_and_si128(isNearerMask, shapeIndexes), _mm_andnot_si128(isNearerMask, nearestIndexes));
+}
+
+static void ReduceNearerLanes(__m128 nearestDists, __m128i nearestIndexes, float& nearestDist, int& nearestIndex)
+{
+	float laneDists[4];
+	int laneIndexes[4];
+	_mm_storeu_ps(laneDists, nearestDists);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(laneIndexes), nearestIndexes);
+	for (int lane = 0; lane < 4; lane++)
+	{
+		if (laneIndexes[lane] < 0)
+		{
+			continue;
+		}
+		if (nearestIndex < 0 || laneDists[lane] < nearestDist || (laneDists[lane] == nearestDist && laneIndexes[lane] < nearestIndex))
+		{
+			nearestDist = laneDists[lane];
+			nearestIndex = laneIndexes[lane];
+		}
+	}
+}
+
+static __m128 Select4(__m128 mask, __m128 ifTrue, __m128 ifFalse)
+{
+	return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+}
+
+//Four-wide GetSlabEnterExit, including the parallel axis case, so lanes never see the NaN from 0/0
+static void GetSlabEnterExit4(__m128 startToMins, __m128 startToMaxs, __m128 fwd, __m128& tNear, __m128& tFar)
+{
+	__m128 tMin = _mm_div_ps(startToMins, fwd);
+	__m128 tMax = _mm_div_ps(startToMaxs, fwd);
+	tNear = _mm_min_ps(tMin, tMax);
+	tFar = _mm_max_ps(tMin, tMax);
+
+	__m128 isParallel = _mm_cmpeq_ps(fwd, _mm_setzero_ps());
+	__m128 isBetweenSlabs = _mm_and_ps(_mm_cmple_ps(startToMins, _mm_setzero_ps()), _mm_cmpge_ps(startToMaxs, _mm_setzero_ps()));
+	__m128 parallelNear = Select4(isBetweenSlabs, _mm_set1_ps(-FLT_MAX), _mm_set1_ps(FLT_MAX));
+	__m128 parallelFar = Select4(isBetweenSlabs, _mm_set1_ps(FLT_MAX), _mm_set1_ps(-FLT_MAX));
+	tNear = Select4(isParallel, parallelNear, tNear);
+	tFar = Select4(isParallel, parallelFar, tFar);
+}
+
+//Slab test for four boxes already in the ray's frame, same operation order as RaycastVsAABB3D
+static void GetSlabEnterExit4(__m128 startToMinsX, __m128 startToMaxsX, __m128 startToMinsY, __m128 startToMaxsY, __m128 startToMinsZ, __m128 startToMaxsZ,
+	__m128 fwdX, __m128 fwdY, __m128 fwdZ, __m128& tEnter, __m128& tExit)
+{
+	__m128 tXNear, tXFar, tYNear, tYFar, tZNear, tZFar;
+	GetSlabEnterExit4(startToMinsX, startToMaxsX, fwdX, tXNear, tXFar);
+	GetSlabEnterExit4(startToMinsY, startToMaxsY, fwdY, tYNear, tYFar);
+	GetSlabEnterExit4(startToMinsZ, startToMaxsZ, fwdZ, tZNear, tZFar);
+
+	tEnter = _mm_max_ps(_mm_max_ps(tXNear, tYNear), tZNear);
+	tExit = _mm_min_ps(_mm_min_ps(tXFar, tYFar), tZFar);
+}
+
+static __m128 DidSlabsImpact4(__m128 tEnter, __m128 tExit, __m128 maxDist)
+{
+	__m128 didMiss = _mm_or_ps(_mm_cmpgt_ps(tEnter, tExit), _mm_or_ps(_mm_cmplt_ps(tExit, _mm_setzero_ps()), _mm_cmpgt_ps(tEnter, maxDist)));
+	return _mm_andnot_ps(didMiss, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+}
+#endif
+
+void RaycastVsSpheres3D(RaycastBatch3D const& rays, SphereBatch3D const& spheres, std::vector<RaycastResult3D>& results, std::vector<int>* hitIndexes)
+{
+	int numRays = rays.GetNumRays();
+	int numSpheres = spheres.GetNumSpheres();
+	results.resize(numRays);
+	if (hitIndexes)
+	{
+		hitIndexes->resize(numRays);
+	}
+
+	for (int rayIndex = 0; rayIndex < numRays; rayIndex++)
+	{
+		Vec3 startPos = Vec3(rays.m_startX[rayIndex], rays.m_startY[rayIndex], rays.m_startZ[rayIndex]);
+		Vec3 fwdNormal = Vec3(rays.m_fwdX[rayIndex], rays.m_fwdY[rayIndex], rays.m_fwdZ[rayIndex]);
+		float maxDist = rays.m_maxDist[rayIndex];
+		float nearestDist = maxDist;
+		int nearestIndex = -1;
+		int sphereIndex = 0;
+
+#if defined(ENGINE_SIMD_SSE2)
+		//Quadratic test against four spheres at a time, same math and miss conditions as RaycastVsSphere3D
+		__m128 startX = _mm_set1_ps(startPos.x);
+		__m128 startY = _mm_set1_ps(startPos.y);
+		__m128 startZ = _mm_set1_ps(startPos.z);
+		__m128 fwdX = _mm_set1_ps(fwdNormal.x);
+		__m128 fwdY = _mm_set1_ps(fwdNormal.y);
+		__m128 fwdZ = _mm_set1_ps(fwdNormal.z);
+		__m128 maxDist4 = _mm_set1_ps(maxDist);
+		__m128 nearestDists = _mm_set1_ps(FLT_MAX);
+		__m128i nearestIndexes = _mm_set1_epi32(-1);
+		__m128i shapeIndexes = _mm_setr_epi32(0, 1, 2, 3);
+		for (; sphereIndex + 4 <= numSpheres; sphereIndex += 4)
+		{
+			__m128 radius = _mm_loadu_ps(spheres.m_radius.data() + sphereIndex);
+			__m128 radiusSquared = _mm_mul_ps(radius, radius);
+			__m128 startToCenterX = _mm_sub_ps(_mm_loadu_ps(spheres.m_centerX.data() + sphereIndex), startX);
+			__m128 startToCenterY = _mm_sub_ps(_mm_loadu_ps(spheres.m_centerY.data() + sphereIndex), startY);
+			__m128 startToCenterZ = _mm_sub_ps(_mm_loadu_ps(spheres.m_centerZ.data() + sphereIndex), startZ);
+
+			__m128 distSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(startToCenterX, startToCenterX), _mm_mul_ps(startToCenterY, startToCenterY)), _mm_mul_ps(startToCenterZ, startToCenterZ));
+			__m128 isInside = _mm_cmplt_ps(distSquared, radiusSquared);
+
+			__m128 startToCenterI = _mm_add_ps(_mm_add_ps(_mm_mul_ps(startToCenterX, fwdX), _mm_mul_ps(startToCenterY, fwdY)), _mm_mul_ps(startToCenterZ, fwdZ));
+			__m128 closestToCenterX = _mm_sub_ps(_mm_loadu_ps(spheres.m_centerX.data() + sphereIndex), _mm_add_ps(startX, _mm_mul_ps(fwdX, startToCenterI)));
+			__m128 closestToCenterY = _mm_sub_ps(_mm_loadu_ps(spheres.m_centerY.data() + sphereIndex), _mm_add_ps(startY, _mm_mul_ps(fwdY, startToCenterI)));
+			__m128 closestToCenterZ = _mm_sub_ps(_mm_loadu_ps(spheres.m_centerZ.data() + sphereIndex), _mm_add_ps(startZ, _mm_mul_ps(fwdZ, startToCenterI)));
+			__m128 startToCenterJ = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(closestToCenterX, closestToCenterX), _mm_mul_ps(closestToCenterY, closestToCenterY)), _mm_mul_ps(closestToCenterZ, closestToCenterZ)));
+			__m128 centerToImpactAdjustment = _mm_sqrt_ps(_mm_sub_ps(radiusSquared, _mm_mul_ps(startToCenterJ, startToCenterJ)));
+			__m128 impactDist = _mm_sub_ps(startToCenterI, centerToImpactAdjustment);
+
+			__m128 didMiss = _mm_or_ps(_mm_cmpge_ps(startToCenterI, _mm_add_ps(radius, maxDist4)), _mm_cmplt_ps(startToCenterI, _mm_sub_ps(_mm_setzero_ps(), radius)));
+			didMiss = _mm_or_ps(didMiss, _mm_cmpge_ps(startToCenterJ, radius));
+			didMiss = _mm_or_ps(didMiss, _mm_cmplt_ps(maxDist4, impactDist));
+			__m128 didImpact = _mm_or_ps(isInside, _mm_andnot_ps(didMiss, _mm_castsi128_ps(_mm_set1_epi32(-1))));
+			impactDist = Select4(isInside, _mm_setzero_ps(), impactDist);
+
+			KeepNearerLanes(didImpact, impactDist, shapeIndexes, nearestDists, nearestIndexes);
+			shapeIndexes = _mm_add_epi32(shapeIndexes, _mm_set1_epi32(4));
+		}
+		ReduceNearerLanes(nearestDists, nearestIndexes, nearestDist, nearestIndex);
+#endif
+
+		for (; sphereIndex < numSpheres; sphereIndex++)
+		{
+			Vec3 center = Vec3(spheres.m_centerX[sphereIndex], spheres.m_centerY[sphereIndex], spheres.m_centerZ[sphereIndex]);
+			KeepIfNearer(RaycastVsSphere3D(startPos, fwdNormal, maxDist, center, spheres.m_radius[sphereIndex]), sphereIndex, nearestDist, nearestIndex);
+		}
+
+		if (nearestIndex >= 0)
+		{
+			Vec3 center = Vec3(spheres.m_centerX[nearestIndex], spheres.m_centerY[nearestIndex], spheres.m_centerZ[nearestIndex]);
+			results[rayIndex] = RaycastVsSphere3D(startPos, fwdNormal, maxDist, center, spheres.m_radius[nearestIndex]);
+		}
+		else
+		{
+			results[rayIndex] = MakeRaycastMiss3D(startPos, fwdNormal, maxDist);
+		}
+		if (hitIndexes)
+		{
+			(*hitIndexes)[rayIndex] = nearestIndex;
+		}
+	}
+}
+
+void RaycastVsAABBs3D(RaycastBatch3D const& rays, AABB3Batch3D const& boxes, std::vector<RaycastResult3D>& results, std::vector<int>* hitIndexes)
+{
+	int numRays = rays.GetNumRays();
+	int numBoxes = boxes.GetNumBoxes();
+	results.resize(numRays);
+	if (hitIndexes)
+	{
+		hitIndexes->resize(numRays);
+	}
+
+	for (int rayIndex = 0; rayIndex < numRays; rayIndex++)
+	{
+		Vec3 startPos = Vec3(rays.m_startX[rayIndex], rays.m_startY[rayIndex], rays.m_startZ[rayIndex]);
+		Vec3 fwdNormal = Vec3(rays.m_fwdX[rayIndex], rays.m_fwdY[rayIndex], rays.m_fwdZ[rayIndex]);
+		float maxDist = rays.m_maxDist[rayIndex];
+		float nearestDist = maxDist;
+		int nearestIndex = -1;
+		int boxIndex = 0;
+
+#if defined(ENGINE_SIMD_SSE2)
+		__m128 startX = _mm_set1_ps(startPos.x);
+		__m128 startY = _mm_set1_ps(startPos.y);
+		__m128 startZ = _mm_set1_ps(startPos.z);
+		__m128 fwdX = _mm_set1_ps(fwdNormal.x);
+		__m128 fwdY = _mm_set1_ps(fwdNormal.y);
+		__m128 fwdZ = _mm_set1_ps(fwdNormal.z);
+		__m128 maxDist4 = _mm_set1_ps(maxDist);
+		__m128 nearestDists = _mm_set1_ps(FLT_MAX);
+		__m128i nearestIndexes = _mm_set1_epi32(-1);
+		__m128i shapeIndexes = _mm_setr_epi32(0, 1, 2, 3);
+		for (; boxIndex + 4 <= numBoxes; boxIndex += 4)
+		{
+			__m128 minsX = _mm_loadu_ps(boxes.m_minsX.data() + boxIndex);
+			__m128 minsY = _mm_loadu_ps(boxes.m_minsY.data() + boxIndex);
+			__m128 minsZ = _mm_loadu_ps(boxes.m_minsZ.data() + boxIndex);
+			__m128 maxsX = _mm_loadu_ps(boxes.m_maxsX.data() + boxIndex);
+			__m128 maxsY = _mm_loadu_ps(boxes.m_maxsY.data() + boxIndex);
+			__m128 maxsZ = _mm_loadu_ps(boxes.m_maxsZ.data() + boxIndex);
+
+			__m128 isInside = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(minsX, startX), _mm_cmpgt_ps(maxsX, startX)),
+				_mm_and_ps(_mm_and_ps(_mm_cmplt_ps(minsY, startY), _mm_cmpgt_ps(maxsY, startY)), _mm_and_ps(_mm_cmplt_ps(minsZ, startZ), _mm_cmpgt_ps(maxsZ, startZ))));
+
+			__m128 tEnter;
+			__m128 tExit;
+			GetSlabEnterExit4(_mm_sub_ps(minsX, startX), _mm_sub_ps(maxsX, startX), _mm_sub_ps(minsY, startY), _mm_sub_ps(maxsY, startY), _mm_sub_ps(minsZ, startZ), _mm_sub_ps(maxsZ, startZ),
+				fwdX, fwdY, fwdZ, tEnter, tExit);
+			__m128 didImpact = _mm_or_ps(isInside, DidSlabsImpact4(tEnter, tExit, maxDist4));
+			__m128 impactDist = Select4(isInside, _mm_setzero_ps(), tEnter);
+
+			KeepNearerLanes(didImpact, impactDist, shapeIndexes, nearestDists, nearestIndexes);
+			shapeIndexes = _mm_add_epi32(shapeIndexes, _mm_set1_epi32(4));
+		}
+		ReduceNearerLanes(nearestDists, nearestIndexes, nearestDist, nearestIndex);
+#endif
+
+		for (; boxIndex < numBoxes; boxIndex++)
+		{
+			KeepIfNearer(RaycastVsAABB3D(startPos, fwdNormal, maxDist, boxes.GetBox(boxIndex)), boxIndex, nearestDist, nearestIndex);
+		}
+
+		if (nearestIndex >= 0)
+		{
+			results[rayIndex] = RaycastVsAABB3D(startPos, fwdNormal, maxDist, boxes.GetBox(nearestIndex));
+		}
+		else
+		{
+			results[rayIndex] = MakeRaycastMiss3D(startPos, fwdNormal, maxDist);
+		}
+		if (hitIndexes)
+		{
+			(*hitIndexes)[rayIndex] = nearestIndex;
+		}
+	}
+}
+
+void RaycastVsOBBs3D(RaycastBatch3D const& rays, OBB3Batch3D const& boxes, std::vector<RaycastResult3D>& results, std::vector<int>* hitIndexes)
+{
+	int numRays = rays.GetNumRays();
+	int numBoxes = boxes.GetNumBoxes();
+	results.resize(numRays);
+	if (hitIndexes)
+	{
+		hitIndexes->resize(numRays);
+	}
+
+	for (int rayIndex = 0; rayIndex < numRays; rayIndex++)
+	{
+		Vec3 startPos = Vec3(rays.m_startX[rayIndex], rays.m_startY[rayIndex], rays.m_startZ[rayIndex]);
+		Vec3 fwdNormal = Vec3(rays.m_fwdX[rayIndex], rays.m_fwdY[rayIndex], rays.m_fwdZ[rayIndex]);
+		float maxDist = rays.m_maxDist[rayIndex];
+		float nearestDist = maxDist;
+		int nearestIndex = -1;
+		int boxIndex = 0;
+
+#if defined(ENGINE_SIMD_SSE2)
+		//Moves the ray into each box's local space the way RaycastVsOBB3D does, then runs the AABB slab test around the origin
+		Vec3 rayMaxEnd = startPos + fwdNormal * maxDist;
+		__m128 startX = _mm_set1_ps(startPos.x);
+		__m128 startY = _mm_set1_ps(startPos.y);
+		__m128 startZ = _mm_set1_ps(startPos.z);
+		__m128 endX = _mm_set1_ps(rayMaxEnd.x);
+		__m128 endY = _mm_set1_ps(rayMaxEnd.y);
+		__m128 endZ = _mm_set1_ps(rayMaxEnd.z);
+		__m128 maxDist4 = _mm_set1_ps(maxDist);
+		__m128 nearestDists = _mm_set1_ps(FLT_MAX);
+		__m128i nearestIndexes = _mm_set1_epi32(-1);
+		__m128i shapeIndexes = _mm_setr_epi32(0, 1, 2, 3);
+		for (; boxIndex + 4 <= numBoxes; boxIndex += 4)
+		{
+			__m128 centerX = _mm_loadu_ps(boxes.m_centerX.data() + boxIndex);
+			__m128 centerY = _mm_loadu_ps(boxes.m_centerY.data() + boxIndex);
+			__m128 centerZ = _mm_loadu_ps(boxes.m_centerZ.data() + boxIndex);
+			__m128 iBasisX = _mm_loadu_ps(boxes.m_iBasisX.data() + boxIndex);
+			__m128 iBasisY = _mm_loadu_ps(boxes.m_iBasisY.data() + boxIndex);
+			__m128 iBasisZ = _mm_loadu_ps(boxes.m_iBasisZ.data() + boxIndex);
+			__m128 jBasisX = _mm_loadu_ps(boxes.m_jBasisX.data() + boxIndex);
+			__m128 jBasisY = _mm_loadu_ps(boxes.m_jBasisY.data() + boxIndex);
+			__m128 jBasisZ = _mm_loadu_ps(boxes.m_jBasisZ.data() + boxIndex);
+			__m128 kBasisX = _mm_loadu_ps(boxes.m_kBasisX.data() + boxIndex);
+			__m128 kBasisY = _mm_loadu_ps(boxes.m_kBasisY.data() + boxIndex);
+			__m128 kBasisZ = _mm_loadu_ps(boxes.m_kBasisZ.data() + boxIndex);
+			__m128 halfDimsX = _mm_loadu_ps(boxes.m_halfDimsX.data() + boxIndex);
+			__m128 halfDimsY = _mm_loadu_ps(boxes.m_halfDimsY.data() + boxIndex);
+			__m128 halfDimsZ = _mm_loadu_ps(boxes.m_halfDimsZ.data() + boxIndex);
+
+			__m128 startRelX = _mm_sub_ps(startX, centerX);
+			__m128 startRelY = _mm_sub_ps(startY, centerY);
+			__m128 startRelZ = _mm_sub_ps(startZ, centerZ);
+			__m128 endRelX = _mm_sub_ps(endX, centerX);
+			__m128 endRelY = _mm_sub_ps(endY, centerY);
+			__m128 endRelZ = _mm_sub_ps(endZ, centerZ);
+
+			__m128 startI = _mm_add_ps(_mm_add_ps(_mm_mul_ps(startRelX, iBasisX), _mm_mul_ps(startRelY, iBasisY)), _mm_mul_ps(startRelZ, iBasisZ));
+			__m128 startJ = _mm_add_ps(_mm_add_ps(_mm_mul_ps(startRelX, jBasisX), _mm_mul_ps(startRelY, jBasisY)), _mm_mul_ps(startRelZ, jBasisZ));
+			__m128 startK = _mm_add_ps(_mm_add_ps(_mm_mul_ps(startRelX, kBasisX), _mm_mul_ps(startRelY, kBasisY)), _mm_mul_ps(startRelZ, kBasisZ));
+			__m128 localFwdI = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(endRelX, iBasisX), _mm_mul_ps(endRelY, iBasisY)), _mm_mul_ps(endRelZ, iBasisZ)), startI);
+			__m128 localFwdJ = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(endRelX, jBasisX), _mm_mul_ps(endRelY, jBasisY)), _mm_mul_ps(endRelZ, jBasisZ)), startJ);
+			__m128 localFwdK = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(endRelX, kBasisX), _mm_mul_ps(endRelY, kBasisY)), _mm_mul_ps(endRelZ, kBasisZ)), startK);
+			__m128 localFwdLength = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(localFwdI, localFwdI), _mm_mul_ps(localFwdJ, localFwdJ)), _mm_mul_ps(localFwdK, localFwdK)));
+			__m128 lengthMult = _mm_div_ps(_mm_set1_ps(1.f), localFwdLength);
+			localFwdI = _mm_mul_ps(localFwdI, lengthMult);
+			localFwdJ = _mm_mul_ps(localFwdJ, lengthMult);
+			localFwdK = _mm_mul_ps(localFwdK, lengthMult);
+
+			__m128 negHalfDimsX = _mm_sub_ps(_mm_setzero_ps(), halfDimsX);
+			__m128 negHalfDimsY = _mm_sub_ps(_mm_setzero_ps(), halfDimsY);
+			__m128 negHalfDimsZ = _mm_sub_ps(_mm_setzero_ps(), halfDimsZ);
+			__m128 isInside = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(negHalfDimsX, startI), _mm_cmpgt_ps(halfDimsX, startI)),
+				_mm_and_ps(_mm_and_ps(_mm_cmplt_ps(negHalfDimsY, startJ), _mm_cmpgt_ps(halfDimsY, startJ)), _mm_and_ps(_mm_cmplt_ps(negHalfDimsZ, startK), _mm_cmpgt_ps(halfDimsZ, startK))));
+
+			__m128 tEnter;
+			__m128 tExit;
+			GetSlabEnterExit4(_mm_sub_ps(negHalfDimsX, startI), _mm_sub_ps(halfDimsX, startI), _mm_sub_ps(negHalfDimsY, startJ), _mm_sub_ps(halfDimsY, startJ), _mm_sub_ps(negHalfDimsZ, startK), _mm_sub_ps(halfDimsZ, startK),
+				localFwdI, localFwdJ, localFwdK, tEnter, tExit);
+			__m128 didImpact = _mm_or_ps(isInside, DidSlabsImpact4(tEnter, tExit, maxDist4));
+			__m128 impactDist = Select4(isInside, _mm_setzero_ps(), tEnter);
+
+			KeepNearerLanes(didImpact, impactDist, shapeIndexes, nearestDists, nearestIndexes);
+			shapeIndexes = _mm_add_epi32(shapeIndexes, _mm_set1_epi32(4));
+		}
+		ReduceNearerLanes(nearestDists, nearestIndexes, nearestDist, nearestIndex);
+#endif
+
+		for (; boxIndex < numBoxes; boxIndex++)
+		{
+			KeepIfNearer(RaycastVsOBB3D(startPos, fwdNormal, maxDist, boxes.GetBox(boxIndex)), boxIndex, nearestDist, nearestIndex);
+		}
+
+		if (nearestIndex >= 0)
+		{
+			results[rayIndex] = RaycastVsOBB3D(startPos, fwdNormal, maxDist, boxes.GetBox(nearestIndex));
+		}
+		else
+		{
+			results[rayIndex] = MakeRaycastMiss3D(startPos, fwdNormal, maxDist);
+		}
+		if (hitIndexes)
+		{
+			(*hitIndexes)[rayIndex] = nearestIndex;
+		}
+	}
+}
+
+//Tile grid raycasts //////////////////////////////////////////////////////////////////////////////
+RaycastResult2D RaycastVsTileGrid2D(Vec2 startPos, Vec2 fwdNormal, float maxDist, IntVec2 const& dimensions, std::vector<bool> const& solidTiles)
+{
+	return RaycastVsTileGrid2D(startPos, fwdNormal, maxDist, dimensions, [&](IntVec2 const& tileCoords)
+		{
+			return solidTiles[tileCoords.y * dimensions.x + tileCoords.x];
+		});
+}
+
+void RaycastBatch2D::AddRay(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist)
+{
+	m_startX.push_back(startPos.x);
+	m_startY.push_back(startPos.y);
+	m_fwdX.push_back(fwdNormal.x);
+	m_fwdY.push_back(fwdNormal.y);
+	m_maxDist.push_back(maxDist);
+}
+
+void RaycastBatch2D::Reserve(int numRays)
+{
+	m_startX.reserve(numRays);
+	m_startY.reserve(numRays);
+	m_fwdX.reserve(numRays);
+	m_fwdY.reserve(numRays);
+	m_maxDist.reserve(numRays);
+}
+
+void RaycastBatch2D::Clear()
+{
+	m_startX.clear();
+	m_startY.clear();
+	m_fwdX.clear();
+	m_fwdY.clear();
+	m_maxDist.clear();
+}
+
+int RaycastBatch2D::GetNumRays() const
+{
+	return static_cast<int>(m_startX.size());
+}
+
+void RaycastVsTileGrid2D(RaycastBatch2D const& rays, IntVec2 const& dimensions, std::vector<bool> const& solidTiles, std::vector<RaycastResult2D>& results)
+{
+	GUARANTEE_OR_DIE(static_cast<int>(solidTiles.size()) >= dimensions.x * dimensions.y, "RaycastVsTileGrid2D solidity bitset is smaller than the grid");
+	int numRays = rays.GetNumRays();
+	results.resize(numRays);
+	for (int rayIndex = 0; rayIndex < numRays; rayIndex++)
+	{
+		Vec2 startPos = Vec2(rays.m_startX[rayIndex], rays.m_startY[rayIndex]);
+		Vec2 fwdNormal = Vec2(rays.m_fwdX[rayIndex], rays.m_fwdY[rayIndex]);
+		results[rayIndex] = RaycastVsTileGrid2D(startPos, fwdNormal, rays.m_maxDist[rayIndex], dimensions, solidTiles);
+	}
+}
@@ -1,8 +1,13 @@
 #pragma once
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/FloatRange.hpp"
+#include <vector>
+#include <cfloat>
+#include <cmath>
+#include <utility>
 
 struct AABB2;
 struct Plane3;
@@ -45,4 +50,205 @@ RaycastResult3D RaycastVsSphere3D(Vec3 startPos, Vec3 fwdNormal, float maxDist,
 RaycastResult3D RaycastVsAABB3D(Vec3 startPos, Vec3 fwdNormal, float maxDist, AABB3 box);
 RaycastResult3D RaycastVsOBB3D(Vec3 startPos, Vec3 fwdNormal, float maxDist, OBB3 box);
 RaycastResult3D RaycastVsCylinderZ3D(Vec3 startPos, Vec3 fwdNormal, float maxDist, Vec3 const& center, FloatRange const& minMaxZ, float radiusXY);
-RaycastResult3D RaycastVsPlane3D(Vec3 startPos, Vec3 fwdNormal, float maxDist, Plane3 plane);
\ No newline at end of file
+RaycastResult3D RaycastVsPlane3D(Vec3 startPos, Vec3 fwdNormal, float maxDist, Plane3 plane);
+
+//Batched raycasts ////////////////////////////////////////////////////////////////////////////////
+//Structure-of-arrays inputs so the SIMD kernels can load four shapes per instruction
+struct RaycastBatch3D
+{
+	std::vector<float> m_startX;
+	std::vector<float> m_startY;
+	std::vector<float> m_startZ;
+	std::vector<float> m_fwdX;
+	std::vector<float> m_fwdY;
+	std::vector<float> m_fwdZ;
+	std::vector<float> m_maxDist;
+
+	void	AddRay(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist);
+	void	Reserve(int numRays);
+	void	Clear();
+	int		GetNumRays() const;
+};
+
+struct SphereBatch3D
+{
+	std::vector<float> m_centerX;
+	std::vector<float> m_centerY;
+	std::vector<float> m_centerZ;
+	std::vector<float> m_radius;
+
+	void	AddSphere(Vec3 const& center, float radius);
+	void	Reserve(int numSpheres);
+	void	Clear();
+	int		GetNumSpheres() const;
+};
+
+struct AABB3Batch3D
+{
+	std::vector<float> m_minsX;
+	std::vector<float> m_minsY;
+	std::vector<float> m_minsZ;
+	std::vector<float> m_maxsX;
+	std::vector<float> m_maxsY;
+	std::vector<float> m_maxsZ;
+
+	void	AddBox(AABB3 const& box);
+	AABB3	GetBox(int boxIndex) const;
+	void	Reserve(int numBoxes);
+	void	Clear();
+	int		GetNumBoxes() const;
+};
+
+struct OBB3Batch3D
+{
+	std::vector<float> m_centerX;
+	std::vector<float> m_centerY;
+	std::vector<float> m_centerZ;
+	std::vector<float> m_iBasisX;
+	std::vector<float> m_iBasisY;
+	std::vector<float> m_iBasisZ;
+	std::vector<float> m_jBasisX;
+	std::vector<float> m_jBasisY;
+	std::vector<float> m_jBasisZ;
+	std::vector<float> m_kBasisX;
+	std::vector<float> m_kBasisY;
+	std::vector<float> m_kBasisZ;
+	std::vector<float> m_halfDimsX;
+	std::vector<float> m_halfDimsY;
+	std::vector<float> m_halfDimsZ;
+
+	void	AddBox(OBB3 const& box);
+	OBB3	GetBox(int boxIndex) const;
+	void	Reserve(int numBoxes);
+	void	Clear();
+	int		GetNumBoxes() const;
+};
+
+//Every ray against every shape, keeping each ray's nearest hit. results (and hitIndexes when given) are resized to one entry per ray.
+//Hits are filled in by the single-shape functions above so they match exactly; rays that hit nothing get the usual miss result and index -1.
+void RaycastVsSpheres3D(RaycastBatch3D const& rays, SphereBatch3D const& spheres, std::vector<RaycastResult3D>& results, std::vector<int>* hitIndexes = nullptr);
+void RaycastVsAABBs3D(RaycastBatch3D const& rays, AABB3Batch3D const& boxes, std::vector<RaycastResult3D>& results, std::vector<int>* hitIndexes = nullptr);
+void RaycastVsOBBs3D(RaycastBatch3D const& rays, OBB3Batch3D const& boxes, std::vector<RaycastResult3D>& results, std::vector<int>* hitIndexes = nullptr);
+
+//Tile grid raycasts //////////////////////////////////////////////////////////////////////////////
+//Amanatides-Woo DDA in tile space, where tile (x, y) covers [x, x + 1) by [y, y + 1); scale world positions by 1 / tileSize first.
+//Only tiles inside the grid can be solid. Rays starting outside jump straight to where they enter the grid; rays starting in a solid tile hit at distance 0.
+//isTileSolid is called as bool(IntVec2 const& tileCoords) once per tile crossed.
+template<typename IsTileSolidFunction>
+RaycastResult2D RaycastVsTileGrid2D(Vec2 startPos, Vec2 fwdNormal, float maxDist, IntVec2 const& dimensions, IsTileSolidFunction const& isTileSolid);
+
+//Same walk with solidity read from a bitset indexed y * dimensions.x + x, the layout TileHeatMap uses
+RaycastResult2D RaycastVsTileGrid2D(Vec2 startPos, Vec2 fwdNormal, float maxDist, IntVec2 const& dimensions, std::vector<bool> const& solidTiles);
+
+struct RaycastBatch2D
+{
+	std::vector<float> m_startX;
+	std::vector<float> m_startY;
+	std::vector<float> m_fwdX;
+	std::vector<float> m_fwdY;
+	std::vector<float> m_maxDist;
+
+	void	AddRay(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist);
+	void	Reserve(int numRays);
+	void	Clear();
+	int		GetNumRays() const;
+};
+
+//results is resized to one entry per ray
+void RaycastVsTileGrid2D(RaycastBatch2D const& rays, IntVec2 const& dimensions, std::vector<bool> const& solidTiles, std::vector<RaycastResult2D>& results);
+
+template<typename IsTileSolidFunction>
+RaycastResult2D RaycastVsTileGrid2D(Vec2 startPos, Vec2 fwdNormal, float maxDist, IntVec2 const& dimensions, IsTileSolidFunction const& isTileSolid)
+{
+	RaycastResult2D result;
+	result.m_rayFwdNormal = fwdNormal;
+	result.m_rayStartPos = startPos;
+	result.m_rayMaxLength = maxDist;
+	result.m_didImpact = false;
+	result.m_impactDist = maxDist;
+	result.m_impactPos = startPos + fwdNormal * maxDist;
+	result.m_impactNormal = fwdNormal;
+
+	//Clip the ray to the grid bounds, remembering which side it came in through
+	float tEnter = 0.f;
+	float tExit = maxDist;
+	Vec2 entryNormal = -fwdNormal;
+	float starts[2] = { startPos.x, startPos.y };
+	float fwds[2] = { fwdNormal.x, fwdNormal.y };
+	float sizes[2] = { static_cast<float>(dimensions.x), static_cast<float>(dimensions.y) };
+	for (int axis = 0; axis < 2; axis++)
+	{
+		if (fwds[axis] == 0.f)
+		{
+			if (starts[axis] < 0.f || starts[axis] >= sizes[axis])
+			{
+				return result;
+			}
+			continue;
+		}
+
+		float tNear = (0.f - starts[axis]) / fwds[axis];
+		float tFar = (sizes[axis] - starts[axis]) / fwds[axis];
+		if (tNear > tFar) std::swap(tNear, tFar);
+		if (tNear > tEnter)
+		{
+			tEnter = tNear;
+			float side = fwds[axis] > 0.f ? -1.f : 1.f;
+			entryNormal = axis == 0 ? Vec2(side, 0.f) : Vec2(0.f, side);
+		}
+		tExit = tFar < tExit ? tFar : tExit;
+	}
+	if (tEnter > tExit)
+	{
+		return result;
+	}
+
+	Vec2 entryPos = startPos + fwdNormal * tEnter;
+	IntVec2 tileCoords = IntVec2(static_cast<int>(floorf(entryPos.x)), static_cast<int>(floorf(entryPos.y)));
+	tileCoords.x = tileCoords.x < 0 ? 0 : (tileCoords.x >= dimensions.x ? dimensions.x - 1 : tileCoords.x);
+	tileCoords.y = tileCoords.y < 0 ? 0 : (tileCoords.y >= dimensions.y ? dimensions.y - 1 : tileCoords.y);
+	if (isTileSolid(tileCoords))
+	{
+		result.m_didImpact = true;
+		result.m_impactDist = tEnter;
+		result.m_impactPos = entryPos;
+		result.m_impactNormal = entryNormal;
+		return result;
+	}
+
+	//Step into whichever neighbor's edge the ray crosses first. Edge distances are recomputed from the start each step so they never drift.
+	int stepX = fwdNormal.x > 0.f ? 1 : -1;
+	int stepY = fwdNormal.y > 0.f ? 1 : -1;
+	while (true)
+	{
+		float tNextX = fwdNormal.x != 0.f ? (static_cast<float>(stepX > 0 ? tileCoords.x + 1 : tileCoords.x) - startPos.x) / fwdNormal.x : FLT_MAX;
+		float tNextY = fwdNormal.y != 0.f ? (static_cast<float>(stepY > 0 ? tileCoords.y + 1 : tileCoords.y) - startPos.y) / fwdNormal.y : FLT_MAX;
+		float tCrossing;
+		Vec2 crossingNormal;
+		if (tNextX < tNextY)
+		{
+			tCrossing = tNextX;
+			tileCoords.x += stepX;
+			crossingNormal = Vec2(static_cast<float>(-stepX), 0.f);
+		}
+		else
+		{
+			tCrossing = tNextY;
+			tileCoords.y += stepY;
+			crossingNormal = Vec2(0.f, static_cast<float>(-stepY));
+		}
+
+		if (tCrossing > tExit || tileCoords.x < 0 || tileCoords.y < 0 || tileCoords.x >= dimensions.x || tileCoords.y >= dimensions.y)
+		{
+			return result;
+		}
+		if (isTileSolid(tileCoords))
+		{
+			result.m_didImpact = true;
+			result.m_impactDist = tCrossing;
+			result.m_impactPos = startPos + fwdNormal * tCrossing;
+			result.m_impactNormal = crossingNormal;
+			return result;
+		}
+	}
+}
\ No newline at end of file
@@ -315,13 +315,13 @@ Vec2 Vec2::Reflect(Vec2 const& normalOfReflectionSurface)
 	return *this;
 }
 
-void Vec2::SetFromText(char const* text)
+void Vec2::SetFromText(std::string_view text)
 {
-	Strings variables = SplitStringOnDelimiter(text, ',');
-	if (variables.size() != 2 || variables[0].c_str() == nullptr || variables[1].c_str() == nullptr)
+	std::string_view variables[2];
+	if (SplitStringViewOnDelimiter(text, ',', variables, 2) != 2)
 	{
 		ERROR_AND_DIE("Invalid arguments passed into Vec2 String");
 	}
-	x = static_cast<float>(atof(variables[0].c_str()));
-	y = static_cast<float>(atof(variables[1].c_str()));
+	x = ParseFloat(variables[0]);
+	y = ParseFloat(variables[1]);
 }
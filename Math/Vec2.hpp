@@ -1,4 +1,5 @@
 #pragma once
+#include <string_view>
 
 
 //-----------------------------------------------------------------------------------------------
@@ -70,5 +71,5 @@ public:
 	void		Normalize();
 	float		NormalizeAndGetPreviousLength();
 	Vec2		Reflect(Vec2 const& normalOfReflectionSurface);
-	void		SetFromText(char const* text);
+	void		SetFromText(std::string_view text);
 };
\ No newline at end of file
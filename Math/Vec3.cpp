@@ -211,14 +211,14 @@ const Vec3 Vec3::MakeFromPolarDegrees(float yawDegrees, float pitchDegrees, floa
 	return Vec3(tempX, tempY, tempZ);
 }
 
-void Vec3::SetFromText(char const* text)
+void Vec3::SetFromText(std::string_view text)
 {
-	Strings variables = SplitStringOnDelimiter(text, ',');
-	if (variables.size() != 3 || variables[0].c_str() == nullptr || variables[1].c_str() == nullptr || variables[2].c_str() == nullptr)
+	std::string_view variables[3];
+	if (SplitStringViewOnDelimiter(text, ',', variables, 3) != 3)
 	{
 		ERROR_AND_DIE("Invalid arguments passed into Vec3 String");
 	}
-	x = static_cast<float>(atof(variables[0].c_str()));
-	y = static_cast<float>(atof(variables[1].c_str()));
-	z = static_cast<float>(atof(variables[2].c_str()));
+	x = ParseFloat(variables[0]);
+	y = ParseFloat(variables[1]);
+	z = ParseFloat(variables[2]);
 }
\ No newline at end of file
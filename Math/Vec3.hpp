@@ -1,4 +1,5 @@
 #pragma once
+#include <string_view>
 
 struct Vec2;
 
@@ -51,7 +52,7 @@ public:
 
 	const static Vec3 MakeFromPolarRadians(float yawRadians, float pitchRadians, float length = 1.0f);
 	const static Vec3 MakeFromPolarDegrees(float yawDegrees, float pitchDegrees, float length = 1.0f);
-	void SetFromText(char const* text);
+	void SetFromText(std::string_view text);
 
 	static const Vec3 ZERO;
 	static const Vec3 WORLD_UP;
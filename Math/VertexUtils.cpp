@@ -17,101 +17,599 @@
 #include "Engine/Math/Triangle2.hpp"
 #include "Engine/Math/EulerAngles.hpp"
 #include "Engine/Math/Mat44.hpp"
+#include "Engine/Core/VertexStream.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <cstddef>
+#include <cmath>
+#if defined(ENGINE_SIMD_SSE2)
+#include <xmmintrin.h>
+#endif
+
+constexpr int NUM_CAPSULE_SIDES_PER_END = 30;
+constexpr int NUM_DISC_SIDES = 60;
+
+//Grows the array once by the exact amount a shape needs and returns where that shape should start writing
+template<typename T>
+static T* GrowForAppend(std::vector<T>& array, int numToAppend)
+{
+	size_t startIndex = array.size();
+	array.resize(startIndex + static_cast<size_t>(numToAppend));
+	return array.data() + startIndex;
+}
+
+#if defined(ENGINE_SIMD_SSE2)
+static float GetLowestLane(__m128 lanes)
+{
+	lanes = _mm_min_ps(lanes, _mm_movehl_ps(lanes, lanes));
+	lanes = _mm_min_ss(lanes, _mm_shuffle_ps(lanes, lanes, 1));
+	return _mm_cvtss_f32(lanes);
+}
+
+static float GetHighestLane(__m128 lanes)
+{
+	lanes = _mm_max_ps(lanes, _mm_movehl_ps(lanes, lanes));
+	lanes = _mm_max_ss(lanes, _mm_shuffle_ps(lanes, lanes, 1));
+	return _mm_cvtss_f32(lanes);
+}
+#endif
+
+//Vector front ends ///////////////////////////////////////////////////////////////////////////////////////////
+void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Capsule2 const& capsule, Rgba8 const& color)
+{
+	AddVertsForCapsule2D(GrowForAppend(verts, GetNumVertsForCapsule2D()), capsule, color);
+}
+
+void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& aabb, Rgba8 const& color)
+{
+	AddVertsForAABB2D(GrowForAppend(verts, GetNumVertsForAABB2D()), aabb, color);
+}
+
+void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& aabb, AABB2 const& UVs, Rgba8 const& color)
+{
+	AddVertsForAABB2D(GrowForAppend(verts, GetNumVertsForAABB2D()), aabb, UVs, color);
+}
+
+void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, float minX, float minY, float maxX, float maxY, Rgba8 const& color)
+{
+	AddVertsForAABB2D(GrowForAppend(verts, GetNumVertsForAABB2D()), minX, minY, maxX, maxY, color);
+}
+
+void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, float minX, float minY, float maxX, float maxY, AABB2 UVs, Rgba8 const& color)
+{
+	AddVertsForAABB2D(GrowForAppend(verts, GetNumVertsForAABB2D()), minX, minY, maxX, maxY, UVs, color);
+}
+
+void AddVertsForOBB2D(std::vector<Vertex_PCU>& verts, OBB2 const& obb, Rgba8 const& color)
+{
+	AddVertsForOBB2D(GrowForAppend(verts, GetNumVertsForOBB2D()), obb, color);
+}
+
+void AddVertsForDisc2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float radius, Rgba8 const& color)
+{
+	AddVertsForDisc2D(GrowForAppend(verts, GetNumVertsForDisc2D()), center, radius, color);
+}
+
+void AddVertsForRing2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float radius, float thickness, Rgba8 const& color)
+{
+	AddVertsForRing2D(GrowForAppend(verts, GetNumVertsForRing2D()), center, radius, thickness, color);
+}
+
+void AddVertsForLineSegment2D(std::vector<Vertex_PCU>& verts, LineSegment2 line, float thickness, Rgba8 const& color)
+{
+	AddVertsForLineSegment2D(GrowForAppend(verts, GetNumVertsForLineSegment2D()), line, thickness, color);
+}
+
+void AddVertsForTriangle2D(std::vector<Vertex_PCU>& verts, Triangle2 triangle, Rgba8 const& color)
+{
+	AddVertsForTriangle2D(GrowForAppend(verts, GetNumVertsForTriangle2D()), triangle, color);
+}
+
+void AddVertsForArrow2D(std::vector<Vertex_PCU>& verts, Vec2 tailPos, Vec2 tipPos, float arrowSize, float lineThickness, Rgba8 color)
+{
+	AddVertsForArrow2D(GrowForAppend(verts, GetNumVertsForArrow2D()), tailPos, tipPos, arrowSize, lineThickness, color);
+}
+
+void AddVertsForCurve2D(std::vector<Vertex_PCU>& verts, std::vector<Vec2> points, float thickness, Rgba8 const& color)
+{
+	AddVertsForCurve2D(GrowForAppend(verts, GetNumVertsForCurve2D((int)points.size())), points, thickness, color);
+}
+
+void AddVertsForQuad3D(std::vector<Vertex_PCU>& verts, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Rgba8& color, const AABB2& UVs)
+{
+	AddVertsForQuad3D(GrowForAppend(verts, GetNumVertsForQuad3D()), bottomLeft, bottomRight, topRight, topLeft, color, UVs);
+}
+
+void AddVertsForQuad3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Rgba8& color, const AABB2& UVs)
+{
+	unsigned int firstVertexIndex = static_cast<unsigned int>(verts.size());
+	AddVertsForQuad3D(GrowForAppend(verts, GetNumVertsForIndexedQuad3D()), GrowForAppend(indexes, GetNumIndexesForQuad3D()), firstVertexIndex, bottomLeft, bottomRight, topRight, topLeft, color, UVs);
+}
+
+void AddVertsForQuad3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Vec3& normal, const Rgba8& color, const AABB2& UVs)
+{
+	unsigned int firstVertexIndex = static_cast<unsigned int>(verts.size());
+	AddVertsForQuad3D(GrowForAppend(verts, GetNumVertsForIndexedQuad3D()), GrowForAppend(indexes, GetNumIndexesForQuad3D()), firstVertexIndex, bottomLeft, bottomRight, topRight, topLeft, normal, color, UVs);
+}
+
+void AddVertsForQuad3D(std::vector<Vertex_PCUTBN>& verts, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Vec3& normal, const Rgba8& color, const AABB2& UVs)
+{
+	AddVertsForQuad3D(GrowForAppend(verts, GetNumVertsForQuad3D()), bottomLeft, bottomRight, topRight, topLeft, normal, color, UVs);
+}
+
+void AddVertsForRoundedQuad3D(std::vector<Vertex_PCUTBN>& verts, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Vec3& normal, const Rgba8& color, const AABB2& UVs)
+{
+	AddVertsForRoundedQuad3D(GrowForAppend(verts, GetNumVertsForRoundedQuad3D()), bottomLeft, bottomRight, topRight, topLeft, normal, color, UVs);
+}
+
+void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
+{
+	AddVertsForAABB3D(GrowForAppend(verts, GetNumVertsForAABB3D()), bounds, color, UVs);
+}
+
+void AddVertsForInverseAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
+{
+	AddVertsForInverseAABB3D(GrowForAppend(verts, GetNumVertsForAABB3D()), bounds, color, UVs);
+}
+
+void AddVertsForSkyBoxAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, const SpriteSheet& sheet, const Rgba8& color)
+{
+	AddVertsForSkyBoxAABB3D(GrowForAppend(verts, GetNumVertsForAABB3D()), bounds, sheet, color);
+}
+
+void AddVertsForOBB3D(std::vector<Vertex_PCU>& verts, const OBB3& box, const Rgba8& color, const AABB2& UVs)
+{
+	AddVertsForOBB3D(GrowForAppend(verts, GetNumVertsForOBB3D()), box, color, UVs);
+}
+
+void AddVertsForCylinder3D(std::vector<Vertex_PCU>& verts, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
+{
+	AddVertsForCylinder3D(GrowForAppend(verts, GetNumVertsForCylinder3D(numSlices)), start, end, radius, color, UVs, numSlices);
+}
+
+void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
+{
+	AddVertsForCone3D(GrowForAppend(verts, GetNumVertsForCone3D(numSlices)), start, end, radius, color, UVs, numSlices);
+}
+
+void AddVertsForRoundArrow3D(std::vector<Vertex_PCU>& verts, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, int numSlices)
+{
+	AddVertsForRoundArrow3D(GrowForAppend(verts, GetNumVertsForRoundArrow3D(numSlices)), start, end, radius, color, numSlices);
+}
+
+void AddVertsForSphere(std::vector<Vertex_PCU>& verts, const Vec3& center, float radius, const Rgba8& color, const AABB2& UVs, int numSlices, int numStacks)
+{
+	AddVertsForSphere(GrowForAppend(verts, GetNumVertsForSphere(numSlices, numStacks)), center, radius, color, UVs, numSlices, numStacks);
+}
+
+void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
+{
+	unsigned int firstVertexIndex = static_cast<unsigned int>(verts.size());
+	AddVertsForAABB3D(GrowForAppend(verts, GetNumVertsForIndexedAABB3D()), GrowForAppend(indexes, GetNumIndexesForAABB3D()), firstVertexIndex, bounds, color, UVs);
+}
+
+void AddVertsForOBB3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const OBB3& box, const Rgba8& color, const AABB2& UVs)
+{
+	unsigned int firstVertexIndex = static_cast<unsigned int>(verts.size());
+	AddVertsForOBB3D(GrowForAppend(verts, GetNumVertsForIndexedOBB3D()), GrowForAppend(indexes, GetNumIndexesForOBB3D()), firstVertexIndex, box, color, UVs);
+}
+
+void AddVertsForCylinder3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
+{
+	unsigned int firstVertexIndex = static_cast<unsigned int>(verts.size());
+	AddVertsForCylinder3D(GrowForAppend(verts, GetNumVertsForIndexedCylinder3D(numSlices)), GrowForAppend(indexes, GetNumIndexesForCylinder3D(numSlices)), firstVertexIndex, start, end, radius, color, UVs, numSlices);
+}
+
+void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
+{
+	unsigned int firstVertexIndex = static_cast<unsigned int>(verts.size());
+	AddVertsForCone3D(GrowForAppend(verts, GetNumVertsForIndexedCone3D(numSlices)), GrowForAppend(indexes, GetNumIndexesForCone3D(numSlices)), firstVertexIndex, start, end, radius, color, UVs, numSlices);
+}
+
+void AddVertsForSphere(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& center, float radius, const Rgba8& color, const AABB2& UVs, int numSlices, int numStacks)
+{
+	unsigned int firstVertexIndex = static_cast<unsigned int>(verts.size());
+	AddVertsForSphere(GrowForAppend(verts, GetNumVertsForIndexedSphere(numSlices, numStacks)), GrowForAppend(indexes, GetNumIndexesForSphere(numSlices, numStacks)), firstVertexIndex, center, radius, color, UVs, numSlices, numStacks);
+}
+
+void AddVertsForLitAABB3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
+{
+	unsigned int firstVertexIndex = static_cast<unsigned int>(verts.size());
+	AddVertsForLitAABB3D(GrowForAppend(verts, GetNumVertsForLitAABB3D()), GrowForAppend(indexes, GetNumIndexesForLitAABB3D()), firstVertexIndex, bounds, color, UVs);
+}
+
+void AddVertsForLitOBB3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const OBB3& box, const Rgba8& color, const AABB2& UVs)
+{
+	unsigned int firstVertexIndex = static_cast<unsigned int>(verts.size());
+	AddVertsForLitOBB3D(GrowForAppend(verts, GetNumVertsForLitOBB3D()), GrowForAppend(indexes, GetNumIndexesForLitOBB3D()), firstVertexIndex, box, color, UVs);
+}
+
+void AddVertsForLitCylinder3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
+{
+	unsigned int firstVertexIndex = static_cast<unsigned int>(verts.size());
+	AddVertsForLitCylinder3D(GrowForAppend(verts, GetNumVertsForLitCylinder3D(numSlices)), GrowForAppend(indexes, GetNumIndexesForLitCylinder3D(numSlices)), firstVertexIndex, start, end, radius, color, UVs, numSlices);
+}
+
+void AddVertsForLitCone3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
+{
+	unsigned int firstVertexIndex = static_cast<unsigned int>(verts.size());
+	AddVertsForLitCone3D(GrowForAppend(verts, GetNumVertsForLitCone3D(numSlices)), GrowForAppend(indexes, GetNumIndexesForLitCone3D(numSlices)), firstVertexIndex, start, end, radius, color, UVs, numSlices);
+}
+
+void AddVertsForLitSphere(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const Vec3& center, float radius, const Rgba8& color, const AABB2& UVs, int numSlices, int numStacks)
+{
+	unsigned int firstVertexIndex = static_cast<unsigned int>(verts.size());
+	AddVertsForLitSphere(GrowForAppend(verts, GetNumVertsForLitSphere(numSlices, numStacks)), GrowForAppend(indexes, GetNumIndexesForLitSphere(numSlices, numStacks)), firstVertexIndex, center, radius, color, UVs, numSlices, numStacks);
+}
+
+//Vertex and index counts /////////////////////////////////////////////////////////////////////////////////////
+int GetNumVertsForCapsule2D()
+{
+	return 6 + (NUM_CAPSULE_SIDES_PER_END * 3 * 2);
+}
+
+int GetNumVertsForAABB2D()
+{
+	return 6;
+}
+
+int GetNumVertsForOBB2D()
+{
+	return 6;
+}
+
+int GetNumVertsForDisc2D()
+{
+	return NUM_DISC_SIDES * 3;
+}
+
+int GetNumVertsForRing2D()
+{
+	return NUM_DISC_SIDES * GetNumVertsForLineSegment2D();
+}
+
+int GetNumVertsForLineSegment2D()
+{
+	return 6;
+}
+
+int GetNumVertsForTriangle2D()
+{
+	return 3;
+}
+
+int GetNumVertsForArrow2D()
+{
+	return 3 * GetNumVertsForLineSegment2D();
+}
+
+int GetNumVertsForCurve2D(int numPoints)
+{
+	if (numPoints < 2)
+	{
+		return 0;
+	}
+	return (numPoints - 1) * GetNumVertsForLineSegment2D();
+}
+
+int GetNumVertsForQuad3D()
+{
+	return 6;
+}
+
+int GetNumVertsForIndexedQuad3D()
+{
+	return 4;
+}
+
+int GetNumIndexesForQuad3D()
+{
+	return 6;
+}
+
+int GetNumVertsForRoundedQuad3D()
+{
+	return 12;
+}
+
+int GetNumVertsForAABB3D()
+{
+	return 6 * GetNumVertsForQuad3D();
+}
+
+int GetNumVertsForOBB3D()
+{
+	return 6 * GetNumVertsForQuad3D();
+}
+
+int GetNumVertsForCylinder3D(int numSlices)
+{
+	if (numSlices <= 0)
+	{
+		return 0;
+	}
+	return numSlices * (3 + GetNumVertsForQuad3D() + 3);
+}
+
+int GetNumVertsForCone3D(int numSlices)
+{
+	if (numSlices <= 0)
+	{
+		return 0;
+	}
+	return numSlices * 6;
+}
+
+int GetNumVertsForRoundArrow3D(int numSlices)
+{
+	return GetNumVertsForCylinder3D(numSlices) + GetNumVertsForCone3D(numSlices);
+}
+
+int GetNumVertsForSphere(int numSlices, int numStacks)
+{
+	if (numSlices <= 0 || numStacks <= 0)
+	{
+		return 0;
+	}
+	if (numStacks == 1)
+	{
+		return numSlices * 3;
+	}
+	//Two single-triangle caps plus a quad per slice on every middle stack
+	return numSlices * (3 + 3 + (numStacks - 2) * GetNumVertsForQuad3D());
+}
+
+int GetNumVertsForIndexedAABB3D()
+{
+	return 6 * GetNumVertsForIndexedQuad3D();
+}
+
+int GetNumIndexesForAABB3D()
+{
+	return 6 * GetNumIndexesForQuad3D();
+}
+
+int GetNumVertsForIndexedOBB3D()
+{
+	return 6 * GetNumVertsForIndexedQuad3D();
+}
+
+int GetNumIndexesForOBB3D()
+{
+	return 6 * GetNumIndexesForQuad3D();
+}
+
+int GetNumVertsForIndexedCylinder3D(int numSlices)
+{
+	if (numSlices <= 0)
+	{
+		return 0;
+	}
+	//Two centers, two round-UV cap rings, and two wall rings that repeat their first column to close the UV seam
+	return 2 + (2 * numSlices) + (2 * (numSlices + 1));
+}
+
+int GetNumIndexesForCylinder3D(int numSlices)
+{
+	if (numSlices <= 0)
+	{
+		return 0;
+	}
+	return numSlices * (3 + GetNumIndexesForQuad3D() + 3);
+}
+
+int GetNumVertsForIndexedCone3D(int numSlices)
+{
+	if (numSlices <= 0)
+	{
+		return 0;
+	}
+	return numSlices + 2;
+}
+
+int GetNumIndexesForCone3D(int numSlices)
+{
+	if (numSlices <= 0)
+	{
+		return 0;
+	}
+	return numSlices * 6;
+}
+
+int GetNumVertsForIndexedSphere(int numSlices, int numStacks)
+{
+	GUARANTEE_OR_DIE(numSlices > 0 && numStacks >= 2, "Indexed spheres need at least one slice and two stacks");
+	//One pole vertex per slice at each end so every cap triangle keeps its own U, plus a seamed ring per stack line
+	return (2 * numSlices) + ((numStacks - 1) * (numSlices + 1));
+}
+
+int GetNumIndexesForSphere(int numSlices, int numStacks)
+{
+	GUARANTEE_OR_DIE(numSlices > 0 && numStacks >= 2, "Indexed spheres need at least one slice and two stacks");
+	return numSlices * (3 + 3 + (numStacks - 2) * GetNumIndexesForQuad3D());
+}
+
+int GetNumVertsForLitAABB3D()
+{
+	return 6 * GetNumVertsForIndexedQuad3D();
+}
+
+int GetNumIndexesForLitAABB3D()
+{
+	return 6 * GetNumIndexesForQuad3D();
+}
+
+int GetNumVertsForLitOBB3D()
+{
+	return 6 * GetNumVertsForIndexedQuad3D();
+}
+
+int GetNumIndexesForLitOBB3D()
+{
+	return 6 * GetNumIndexesForQuad3D();
+}
+
+int GetNumVertsForLitCylinder3D(int numSlices)
+{
+	if (numSlices <= 0)
+	{
+		return 0;
+	}
+	return numSlices * (3 + GetNumVertsForIndexedQuad3D() + 3);
+}
+
+int GetNumIndexesForLitCylinder3D(int numSlices)
+{
+	if (numSlices <= 0)
+	{
+		return 0;
+	}
+	return numSlices * (3 + GetNumIndexesForQuad3D() + 3);
+}
+
+int GetNumVertsForLitCone3D(int numSlices)
+{
+	if (numSlices <= 0)
+	{
+		return 0;
+	}
+	return numSlices * 6;
+}
+
+int GetNumIndexesForLitCone3D(int numSlices)
+{
+	if (numSlices <= 0)
+	{
+		return 0;
+	}
+	return numSlices * 6;
+}
 
-void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Capsule2 const& capsule, Rgba8 const& color)
+int GetNumVertsForLitSphere(int numSlices, int numStacks)
+{
+	if (numSlices <= 0 || numStacks <= 0)
+	{
+		return 0;
+	}
+	if (numStacks == 1)
+	{
+		return numSlices * 3;
+	}
+	return numSlices * (3 + 3 + (numStacks - 2) * GetNumVertsForIndexedQuad3D());
+}
+
+int GetNumIndexesForLitSphere(int numSlices, int numStacks)
+{
+	if (numSlices <= 0 || numStacks <= 0)
+	{
+		return 0;
+	}
+	if (numStacks == 1)
+	{
+		return numSlices * 3;
+	}
+	return numSlices * (3 + 3 + (numStacks - 2) * GetNumIndexesForQuad3D());
+}
+
+//Pre-sized output ////////////////////////////////////////////////////////////////////////////////////////////
+int AddVertsForCapsule2D(Vertex_PCU* verts, Capsule2 const& capsule, Rgba8 const& color)
 {
 	Vec2 start = capsule.m_bone.m_start;
 	Vec2 end = capsule.m_bone.m_end;
 	Vec2 perpendicularRadius = (capsule.m_bone.m_end - capsule.m_bone.m_start).GetRotated90Degrees().GetClamped(capsule.m_radius);
+	int numVerts = 0;
 
-	verts.push_back(Vertex_PCU(start + perpendicularRadius, color,Vec2(0,0)));
-	verts.push_back(Vertex_PCU(start - perpendicularRadius, color, Vec2(0, 0)));
-	verts.push_back(Vertex_PCU(end + perpendicularRadius, color, Vec2(0, 0)));
+	verts[numVerts++] = Vertex_PCU(start + perpendicularRadius, color,Vec2(0,0));
+	verts[numVerts++] = Vertex_PCU(start - perpendicularRadius, color, Vec2(0, 0));
+	verts[numVerts++] = Vertex_PCU(end + perpendicularRadius, color, Vec2(0, 0));
 
-	verts.push_back(Vertex_PCU(start - perpendicularRadius, color, Vec2(0, 0)));
-	verts.push_back(Vertex_PCU(end - perpendicularRadius, color, Vec2(0, 0)));
-	verts.push_back(Vertex_PCU(end + perpendicularRadius, color, Vec2(0, 0)));
+	verts[numVerts++] = Vertex_PCU(start - perpendicularRadius, color, Vec2(0, 0));
+	verts[numVerts++] = Vertex_PCU(end - perpendicularRadius, color, Vec2(0, 0));
+	verts[numVerts++] = Vertex_PCU(end + perpendicularRadius, color, Vec2(0, 0));
 
-	int numSidesOnEnd = 30;
+	int numSidesOnEnd = NUM_CAPSULE_SIDES_PER_END;
 	float degreesPerSide = 180.f / numSidesOnEnd;
 	Vec2 transferPoint = end - perpendicularRadius;
 
 	for (int i = 0; i < numSidesOnEnd; i++)
 	{
-		verts.push_back(Vertex_PCU(end, color, Vec2(0, 0)));
-		verts.push_back(Vertex_PCU(transferPoint, color, Vec2(0, 0)));
+		verts[numVerts++] = Vertex_PCU(end, color, Vec2(0, 0));
+		verts[numVerts++] = Vertex_PCU(transferPoint, color, Vec2(0, 0));
 
 		Vec2 endToTransfer = transferPoint - end;
 		endToTransfer.RotateDegrees(degreesPerSide);
 		transferPoint = end + endToTransfer;
 
-		verts.push_back(Vertex_PCU(transferPoint, color, Vec2(0, 0)));
+		verts[numVerts++] = Vertex_PCU(transferPoint, color, Vec2(0, 0));
 	}
 
 	transferPoint = start + perpendicularRadius;
 
 	for (int i = 0; i < numSidesOnEnd; i++)
 	{
-		verts.push_back(Vertex_PCU(start, color, Vec2(0, 0)));
-		verts.push_back(Vertex_PCU(transferPoint, color, Vec2(0, 0)));
+		verts[numVerts++] = Vertex_PCU(start, color, Vec2(0, 0));
+		verts[numVerts++] = Vertex_PCU(transferPoint, color, Vec2(0, 0));
 
 		Vec2 startToTransfer = transferPoint - start;
 		startToTransfer.RotateDegrees(degreesPerSide);
 		transferPoint = start + startToTransfer;
 
-		verts.push_back(Vertex_PCU(transferPoint, color, Vec2(0, 0)));
+		verts[numVerts++] = Vertex_PCU(transferPoint, color, Vec2(0, 0));
 	}
+	return numVerts;
 }
 
-void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& aabb, Rgba8 const& color)
+int AddVertsForAABB2D(Vertex_PCU* verts, AABB2 const& aabb, Rgba8 const& color)
 {
 	Vec2 pointA = aabb.m_mins;
 	Vec2 pointB = Vec2(aabb.m_maxs.x, aabb.m_mins.y);
 	Vec2 pointC = aabb.m_maxs;
 	Vec2 pointD = Vec2(aabb.m_mins.x, aabb.m_maxs.y);
 
-	verts.push_back(Vertex_PCU(pointA, color, Vec2(0, 0)));
-	verts.push_back(Vertex_PCU(pointB, color, Vec2(1, 0)));
-	verts.push_back(Vertex_PCU(pointC, color, Vec2(1, 1)));
+	verts[0] = Vertex_PCU(pointA, color, Vec2(0, 0));
+	verts[1] = Vertex_PCU(pointB, color, Vec2(1, 0));
+	verts[2] = Vertex_PCU(pointC, color, Vec2(1, 1));
 
-	verts.push_back(Vertex_PCU(pointC, color, Vec2(1, 1)));
-	verts.push_back(Vertex_PCU(pointD, color, Vec2(0, 1)));
-	verts.push_back(Vertex_PCU(pointA, color, Vec2(0, 0)));
+	verts[3] = Vertex_PCU(pointC, color, Vec2(1, 1));
+	verts[4] = Vertex_PCU(pointD, color, Vec2(0, 1));
+	verts[5] = Vertex_PCU(pointA, color, Vec2(0, 0));
+	return 6;
 }
 
-void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& aabb, AABB2 const& UVs, Rgba8 const& color)
+int AddVertsForAABB2D(Vertex_PCU* verts, AABB2 const& aabb, AABB2 const& UVs, Rgba8 const& color)
 {
 	Vec2 pointA = aabb.m_mins;
 	Vec2 pointB = Vec2(aabb.m_maxs.x, aabb.m_mins.y);
 	Vec2 pointC = aabb.m_maxs;
 	Vec2 pointD = Vec2(aabb.m_mins.x, aabb.m_maxs.y);
 
-	verts.push_back(Vertex_PCU(pointA, color, UVs.m_mins));
-	verts.push_back(Vertex_PCU(pointB, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y)));
-	verts.push_back(Vertex_PCU(pointC, color, UVs.m_maxs));
+	verts[0] = Vertex_PCU(pointA, color, UVs.m_mins);
+	verts[1] = Vertex_PCU(pointB, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
+	verts[2] = Vertex_PCU(pointC, color, UVs.m_maxs);
 
-	verts.push_back(Vertex_PCU(pointC, color, UVs.m_maxs));
-	verts.push_back(Vertex_PCU(pointD, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y)));
-	verts.push_back(Vertex_PCU(pointA, color, UVs.m_mins));
+	verts[3] = Vertex_PCU(pointC, color, UVs.m_maxs);
+	verts[4] = Vertex_PCU(pointD, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
+	verts[5] = Vertex_PCU(pointA, color, UVs.m_mins);
+	return 6;
 }
 
-void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, float minX, float minY, float maxX, float maxY, Rgba8 const& color)
+int AddVertsForAABB2D(Vertex_PCU* verts, float minX, float minY, float maxX, float maxY, Rgba8 const& color)
 {
 	Vec2 pointA = Vec2(static_cast<float>(minX), static_cast<float>(minY));
 	Vec2 pointB = Vec2(static_cast<float>(maxX), static_cast<float>(minY));
 	Vec2 pointC = Vec2(static_cast<float>(maxX), static_cast<float>(maxY));
 	Vec2 pointD = Vec2(static_cast<float>(minX), static_cast<float>(maxY));
 
-	verts.push_back(Vertex_PCU(pointA, color, Vec2(0, 0)));
-	verts.push_back(Vertex_PCU(pointB, color, Vec2(1, 0)));
-	verts.push_back(Vertex_PCU(pointC, color, Vec2(1, 1)));
+	verts[0] = Vertex_PCU(pointA, color, Vec2(0, 0));
+	verts[1] = Vertex_PCU(pointB, color, Vec2(1, 0));
+	verts[2] = Vertex_PCU(pointC, color, Vec2(1, 1));
 
-	verts.push_back(Vertex_PCU(pointC, color, Vec2(1, 1)));
-	verts.push_back(Vertex_PCU(pointD, color, Vec2(0, 1)));
-	verts.push_back(Vertex_PCU(pointA, color, Vec2(0, 0)));
+	verts[3] = Vertex_PCU(pointC, color, Vec2(1, 1));
+	verts[4] = Vertex_PCU(pointD, color, Vec2(0, 1));
+	verts[5] = Vertex_PCU(pointA, color, Vec2(0, 0));
+	return 6;
 }
 
-void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, float minX, float minY, float maxX, float maxY, AABB2 UVs, Rgba8 const& color)
+int AddVertsForAABB2D(Vertex_PCU* verts, float minX, float minY, float maxX, float maxY, AABB2 UVs, Rgba8 const& color)
 {
 	Vec2 pointA = Vec2(static_cast<float>(minX), static_cast<float>(minY));
 	Vec2 pointB = Vec2(static_cast<float>(maxX), static_cast<float>(minY));
@@ -123,53 +621,58 @@ void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, float minX, float minY, f
 	float minV = UVs.m_mins.y;
 	float maxV = UVs.m_maxs.y;
 
-	verts.push_back(Vertex_PCU(pointA, color, Vec2(minU, minV)));
-	verts.push_back(Vertex_PCU(pointB, color, Vec2(maxU, minV)));
-	verts.push_back(Vertex_PCU(pointC, color, Vec2(maxU, maxV)));
+	verts[0] = Vertex_PCU(pointA, color, Vec2(minU, minV));
+	verts[1] = Vertex_PCU(pointB, color, Vec2(maxU, minV));
+	verts[2] = Vertex_PCU(pointC, color, Vec2(maxU, maxV));
 
-	verts.push_back(Vertex_PCU(pointC, color, Vec2(maxU, maxV)));
-	verts.push_back(Vertex_PCU(pointD, color, Vec2(minU, maxV)));
-	verts.push_back(Vertex_PCU(pointA, color, Vec2(minU, minV)));
+	verts[3] = Vertex_PCU(pointC, color, Vec2(maxU, maxV));
+	verts[4] = Vertex_PCU(pointD, color, Vec2(minU, maxV));
+	verts[5] = Vertex_PCU(pointA, color, Vec2(minU, minV));
+	return 6;
 }
 
-void AddVertsForOBB2D(std::vector<Vertex_PCU>& verts, OBB2 const& obb, Rgba8 const& color)
+int AddVertsForOBB2D(Vertex_PCU* verts, OBB2 const& obb, Rgba8 const& color)
 {
 	Vec2 points[4];
 	obb.GetCornerPoints(points);
 
-	verts.push_back(Vertex_PCU(points[0], color, Vec2(0, 0)));
-	verts.push_back(Vertex_PCU(points[1], color, Vec2(1, 0)));
-	verts.push_back(Vertex_PCU(points[2], color, Vec2(1, 1)));
+	verts[0] = Vertex_PCU(points[0], color, Vec2(0, 0));
+	verts[1] = Vertex_PCU(points[1], color, Vec2(1, 0));
+	verts[2] = Vertex_PCU(points[2], color, Vec2(1, 1));
 
-	verts.push_back(Vertex_PCU(points[0], color, Vec2(0, 0)));
-	verts.push_back(Vertex_PCU(points[2], color, Vec2(1, 1)));
-	verts.push_back(Vertex_PCU(points[3], color, Vec2(0, 1)));
+	verts[3] = Vertex_PCU(points[0], color, Vec2(0, 0));
+	verts[4] = Vertex_PCU(points[2], color, Vec2(1, 1));
+	verts[5] = Vertex_PCU(points[3], color, Vec2(0, 1));
+	return 6;
 }
 
-void AddVertsForDisc2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float radius, Rgba8 const& color)
+int AddVertsForDisc2D(Vertex_PCU* verts, Vec2 const& center, float radius, Rgba8 const& color)
 {
-	int numSides = 60;
+	int numSides = NUM_DISC_SIDES;
 	float degreesPerSide = 360.f / numSides;
 	Vec2 transferPoint = center + Vec2(radius, 0);
+	int numVerts = 0;
 
 	for (int i = 0; i < numSides; i++)
 	{
-		verts.push_back(Vertex_PCU(center, color, Vec2(0, 0)));
-		verts.push_back(Vertex_PCU(transferPoint, color, Vec2(0, 0)));
+		verts[numVerts++] = Vertex_PCU(center, color, Vec2(0, 0));
+		verts[numVerts++] = Vertex_PCU(transferPoint, color, Vec2(0, 0));
 
 		Vec2 centerToTransfer = transferPoint - center;
 		centerToTransfer.RotateDegrees(degreesPerSide);
 		transferPoint = center + centerToTransfer;
 
-		verts.push_back(Vertex_PCU(transferPoint, color, Vec2(0, 0)));
+		verts[numVerts++] = Vertex_PCU(transferPoint, color, Vec2(0, 0));
 	}
+	return numVerts;
 }
 
-void AddVertsForRing2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float radius, float thickness, Rgba8 const& color)
+int AddVertsForRing2D(Vertex_PCU* verts, Vec2 const& center, float radius, float thickness, Rgba8 const& color)
 {
-	int numSides = 60;
+	int numSides = NUM_DISC_SIDES;
 	float degreesPerSide = 360.f / numSides;
 	Vec2 transferPoint = center + Vec2(radius, 0);
+	int numVerts = 0;
 
 	for (int i = 0; i < numSides; i++)
 	{
@@ -178,11 +681,12 @@ void AddVertsForRing2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float
 		centerToTransfer.RotateDegrees(degreesPerSide);
 		transferPoint = center + centerToTransfer;
 
-		AddVertsForLineSegment2D(verts, LineSegment2(initialPoint, transferPoint), thickness, color);
+		numVerts += AddVertsForLineSegment2D(verts + numVerts, LineSegment2(initialPoint, transferPoint), thickness, color);
 	}
+	return numVerts;
 }
 
-void AddVertsForLineSegment2D(std::vector<Vertex_PCU>& verts, LineSegment2 line, float thickness, Rgba8 const& color)
+int AddVertsForLineSegment2D(Vertex_PCU* verts, LineSegment2 const& line, float thickness, Rgba8 const& color)
 {
 	Vec2 thicknessOffsetVectorRight = (line.m_end - line.m_start).GetClamped(thickness / 2);
 	Vec2 thicknessOffsetVectorUp = thicknessOffsetVectorRight.GetRotated90Degrees();
@@ -192,105 +696,112 @@ void AddVertsForLineSegment2D(std::vector<Vertex_PCU>& verts, LineSegment2 line,
 	Vec2 pointC = line.m_end + thicknessOffsetVectorRight + thicknessOffsetVectorUp;
 	Vec2 pointD = line.m_start - thicknessOffsetVectorRight + thicknessOffsetVectorUp;
 
-	verts.push_back(Vertex_PCU(pointA, color, Vec2(0, 0)));
-	verts.push_back(Vertex_PCU(pointB, color, Vec2(0, 0)));
-	verts.push_back(Vertex_PCU(pointC, color, Vec2(0, 0)));
+	verts[0] = Vertex_PCU(pointA, color, Vec2(0, 0));
+	verts[1] = Vertex_PCU(pointB, color, Vec2(0, 0));
+	verts[2] = Vertex_PCU(pointC, color, Vec2(0, 0));
 
-	verts.push_back(Vertex_PCU(pointC, color, Vec2(0, 0)));
-	verts.push_back(Vertex_PCU(pointD, color, Vec2(0, 0)));
-	verts.push_back(Vertex_PCU(pointA, color, Vec2(0, 0)));
+	verts[3] = Vertex_PCU(pointC, color, Vec2(0, 0));
+	verts[4] = Vertex_PCU(pointD, color, Vec2(0, 0));
+	verts[5] = Vertex_PCU(pointA, color, Vec2(0, 0));
+	return 6;
 }
 
-void AddVertsForTriangle2D(std::vector<Vertex_PCU>& verts, Triangle2 triangle, Rgba8 const& color)
+int AddVertsForTriangle2D(Vertex_PCU* verts, Triangle2 const& triangle, Rgba8 const& color)
 {
-	verts.push_back(Vertex_PCU(triangle.m_pointsCounterClockwise[0], color, Vec2(0, 0)));
-	verts.push_back(Vertex_PCU(triangle.m_pointsCounterClockwise[1], color, Vec2(0, 0)));
-	verts.push_back(Vertex_PCU(triangle.m_pointsCounterClockwise[2], color, Vec2(0, 0)));
+	verts[0] = Vertex_PCU(triangle.m_pointsCounterClockwise[0], color, Vec2(0, 0));
+	verts[1] = Vertex_PCU(triangle.m_pointsCounterClockwise[1], color, Vec2(0, 0));
+	verts[2] = Vertex_PCU(triangle.m_pointsCounterClockwise[2], color, Vec2(0, 0));
+	return 3;
 }
 
-void AddVertsForArrow2D(std::vector<Vertex_PCU>& verts, Vec2 tailPos, Vec2 tipPos, float arrowSize, float lineThickness, Rgba8 color)
+int AddVertsForArrow2D(Vertex_PCU* verts, Vec2 tailPos, Vec2 tipPos, float arrowSize, float lineThickness, Rgba8 color)
 {
-	AddVertsForLineSegment2D(verts, LineSegment2(tailPos, tipPos), lineThickness, color);
+	int numVerts = AddVertsForLineSegment2D(verts, LineSegment2(tailPos, tipPos), lineThickness, color);
 	Vec2 line = tipPos - tailPos;
 
 	Vec2 leftWing = tipPos + Vec2::MakeFromPolarDegrees(line.GetOrientationDegrees() + 135.f, arrowSize);
 	Vec2 rightWing = tipPos + Vec2::MakeFromPolarDegrees(line.GetOrientationDegrees() - 135.f, arrowSize);
 
-	AddVertsForLineSegment2D(verts, LineSegment2(tipPos, leftWing), lineThickness, color);
-	AddVertsForLineSegment2D(verts, LineSegment2(tipPos, rightWing), lineThickness, color);
+	numVerts += AddVertsForLineSegment2D(verts + numVerts, LineSegment2(tipPos, leftWing), lineThickness, color);
+	numVerts += AddVertsForLineSegment2D(verts + numVerts, LineSegment2(tipPos, rightWing), lineThickness, color);
+	return numVerts;
 }
 
-void AddVertsForCurve2D(std::vector<Vertex_PCU>& verts, std::vector<Vec2> points, float thickness, Rgba8 const& color)
+int AddVertsForCurve2D(Vertex_PCU* verts, std::vector<Vec2> const& points, float thickness, Rgba8 const& color)
 {
 	int divisions = (int)points.size();
+	int numVerts = 0;
 
 	for (int i = 0; i < divisions - 1; i++)
 	{
 		LineSegment2 line = LineSegment2(points[i], points[i+1]);
-		AddVertsForLineSegment2D(verts, line, thickness, color);
+		numVerts += AddVertsForLineSegment2D(verts + numVerts, line, thickness, color);
 	}
+	return numVerts;
 }
 
-void AddVertsForQuad3D(std::vector<Vertex_PCU>& verts, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Rgba8& color, const AABB2& UVs)
+int AddVertsForQuad3D(Vertex_PCU* verts, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Rgba8& color, const AABB2& UVs)
 {
 	Vec3 pointA = bottomLeft;
 	Vec3 pointB = bottomRight;
 	Vec3 pointC = topRight;
 	Vec3 pointD = topLeft;
 
-	verts.push_back(Vertex_PCU(pointA, color, UVs.m_mins));
-	verts.push_back(Vertex_PCU(pointB, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y)));
-	verts.push_back(Vertex_PCU(pointC, color, UVs.m_maxs));
+	verts[0] = Vertex_PCU(pointA, color, UVs.m_mins);
+	verts[1] = Vertex_PCU(pointB, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
+	verts[2] = Vertex_PCU(pointC, color, UVs.m_maxs);
 
-	verts.push_back(Vertex_PCU(pointA, color, UVs.m_mins));
-	verts.push_back(Vertex_PCU(pointC, color, UVs.m_maxs));
-	verts.push_back(Vertex_PCU(pointD, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y)));
+	verts[3] = Vertex_PCU(pointA, color, UVs.m_mins);
+	verts[4] = Vertex_PCU(pointC, color, UVs.m_maxs);
+	verts[5] = Vertex_PCU(pointD, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
+	return 6;
 }
 
-void AddVertsForQuad3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Rgba8& color, const AABB2& UVs)
+int AddVertsForQuad3D(Vertex_PCU* verts, unsigned int* indexes, unsigned int firstVertexIndex, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Rgba8& color, const AABB2& UVs)
 {
-	verts.push_back(Vertex_PCU(bottomLeft, color, UVs.m_mins));
-	verts.push_back(Vertex_PCU(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y)));
-	verts.push_back(Vertex_PCU(topRight, color, UVs.m_maxs));
-	verts.push_back(Vertex_PCU(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y)));
-
-	int nextIndex = (int)verts.size();
-	indexes.push_back(nextIndex-4);
-	indexes.push_back(nextIndex-3);
-	indexes.push_back(nextIndex-2);
-	indexes.push_back(nextIndex-4);
-	indexes.push_back(nextIndex-2);
-	indexes.push_back(nextIndex-1);
+	verts[0] = Vertex_PCU(bottomLeft, color, UVs.m_mins);
+	verts[1] = Vertex_PCU(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
+	verts[2] = Vertex_PCU(topRight, color, UVs.m_maxs);
+	verts[3] = Vertex_PCU(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
+
+	indexes[0] = firstVertexIndex;
+	indexes[1] = firstVertexIndex + 1;
+	indexes[2] = firstVertexIndex + 2;
+	indexes[3] = firstVertexIndex;
+	indexes[4] = firstVertexIndex + 2;
+	indexes[5] = firstVertexIndex + 3;
+	return 4;
 }
 
-void AddVertsForQuad3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Vec3& normal, const Rgba8& color, const AABB2& UVs)
+int AddVertsForQuad3D(Vertex_PCUTBN* verts, unsigned int* indexes, unsigned int firstVertexIndex, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Vec3& normal, const Rgba8& color, const AABB2& UVs)
 {
-	verts.push_back(Vertex_PCUTBN(bottomLeft, color, UVs.m_mins, Vec3(), Vec3(), normal));
-	verts.push_back(Vertex_PCUTBN(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y), Vec3(), Vec3(), normal));
-	verts.push_back(Vertex_PCUTBN(topRight, color, UVs.m_maxs, Vec3(), Vec3(), normal));
-	verts.push_back(Vertex_PCUTBN(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y), Vec3(), Vec3(), normal));
-
-	int nextIndex = (int)verts.size();
-	indexes.push_back(nextIndex - 4);
-	indexes.push_back(nextIndex - 3);
-	indexes.push_back(nextIndex - 2);
-	indexes.push_back(nextIndex - 4);
-	indexes.push_back(nextIndex - 2);
-	indexes.push_back(nextIndex - 1);
+	verts[0] = Vertex_PCUTBN(bottomLeft, color, UVs.m_mins, Vec3(), Vec3(), normal);
+	verts[1] = Vertex_PCUTBN(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y), Vec3(), Vec3(), normal);
+	verts[2] = Vertex_PCUTBN(topRight, color, UVs.m_maxs, Vec3(), Vec3(), normal);
+	verts[3] = Vertex_PCUTBN(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y), Vec3(), Vec3(), normal);
+
+	indexes[0] = firstVertexIndex;
+	indexes[1] = firstVertexIndex + 1;
+	indexes[2] = firstVertexIndex + 2;
+	indexes[3] = firstVertexIndex;
+	indexes[4] = firstVertexIndex + 2;
+	indexes[5] = firstVertexIndex + 3;
+	return 4;
 }
 
-void AddVertsForQuad3D(std::vector<Vertex_PCUTBN>& verts, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Vec3& normal, const Rgba8& color, const AABB2& UVs)
+int AddVertsForQuad3D(Vertex_PCUTBN* verts, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Vec3& normal, const Rgba8& color, const AABB2& UVs)
 {
-	verts.push_back(Vertex_PCUTBN(bottomLeft, color, UVs.m_mins, Vec3(), Vec3(), normal));
-	verts.push_back(Vertex_PCUTBN(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y), Vec3(), Vec3(), normal));
-	verts.push_back(Vertex_PCUTBN(topRight, color, UVs.m_maxs, Vec3(), Vec3(), normal));
-
-	verts.push_back(Vertex_PCUTBN(topRight, color, UVs.m_maxs, Vec3(), Vec3(), normal));
-	verts.push_back(Vertex_PCUTBN(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y), Vec3(), Vec3(), normal));
-	verts.push_back(Vertex_PCUTBN(bottomLeft, color, UVs.m_mins, Vec3(), Vec3(), normal));
+	verts[0] = Vertex_PCUTBN(bottomLeft, color, UVs.m_mins, Vec3(), Vec3(), normal);
+	verts[1] = Vertex_PCUTBN(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y), Vec3(), Vec3(), normal);
+	verts[2] = Vertex_PCUTBN(topRight, color, UVs.m_maxs, Vec3(), Vec3(), normal);
+
+	verts[3] = Vertex_PCUTBN(topRight, color, UVs.m_maxs, Vec3(), Vec3(), normal);
+	verts[4] = Vertex_PCUTBN(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y), Vec3(), Vec3(), normal);
+	verts[5] = Vertex_PCUTBN(bottomLeft, color, UVs.m_mins, Vec3(), Vec3(), normal);
+	return 6;
 }
 
-void AddVertsForRoundedQuad3D(std::vector<Vertex_PCUTBN>& verts, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Vec3& normal, const Rgba8& color, const AABB2& UVs)
+int AddVertsForRoundedQuad3D(Vertex_PCUTBN* verts, const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Vec3& normal, const Rgba8& color, const AABB2& UVs)
 {
 	Vec3 splitBottom = bottomLeft + ((bottomRight - bottomLeft) * .5f);
 	Vec3 splitTop = topLeft + ((topRight - topLeft) * .5f);
@@ -298,25 +809,26 @@ void AddVertsForRoundedQuad3D(std::vector<Vertex_PCUTBN>& verts, const Vec3& bot
 	Vec3 rightSideNormal = -CrossProduct3D(normal, Vec3(0, 0, 1));
 	float halfUVX = UVs.m_mins.x + ((UVs.m_maxs.x - UVs.m_mins.x) * .5f);
 	//Left Side
-	verts.push_back(Vertex_PCUTBN(bottomLeft, color, UVs.m_mins, Vec3(), Vec3(), leftSideNormal));
-	verts.push_back(Vertex_PCUTBN(splitBottom, color, Vec2(halfUVX, UVs.m_mins.y), Vec3(), Vec3(), normal));
-	verts.push_back(Vertex_PCUTBN(splitTop, color, Vec2(halfUVX, UVs.m_maxs.y), Vec3(), Vec3(), normal));
+	verts[0] = Vertex_PCUTBN(bottomLeft, color, UVs.m_mins, Vec3(), Vec3(), leftSideNormal);
+	verts[1] = Vertex_PCUTBN(splitBottom, color, Vec2(halfUVX, UVs.m_mins.y), Vec3(), Vec3(), normal);
+	verts[2] = Vertex_PCUTBN(splitTop, color, Vec2(halfUVX, UVs.m_maxs.y), Vec3(), Vec3(), normal);
 
-	verts.push_back(Vertex_PCUTBN(splitTop, color, Vec2(halfUVX, UVs.m_maxs.y), Vec3(), Vec3(), normal));
-	verts.push_back(Vertex_PCUTBN(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y), Vec3(), Vec3(), leftSideNormal));
-	verts.push_back(Vertex_PCUTBN(bottomLeft, color, UVs.m_mins, Vec3(), Vec3(), leftSideNormal));
+	verts[3] = Vertex_PCUTBN(splitTop, color, Vec2(halfUVX, UVs.m_maxs.y), Vec3(), Vec3(), normal);
+	verts[4] = Vertex_PCUTBN(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y), Vec3(), Vec3(), leftSideNormal);
+	verts[5] = Vertex_PCUTBN(bottomLeft, color, UVs.m_mins, Vec3(), Vec3(), leftSideNormal);
 
 	//Right Side
-	verts.push_back(Vertex_PCUTBN(splitBottom, color, Vec2(halfUVX, UVs.m_mins.y), Vec3(), Vec3(), normal));
-	verts.push_back(Vertex_PCUTBN(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y), Vec3(), Vec3(), rightSideNormal));
-	verts.push_back(Vertex_PCUTBN(topRight, color, UVs.m_maxs, Vec3(), Vec3(), rightSideNormal));
-
-	verts.push_back(Vertex_PCUTBN(topRight, color, UVs.m_maxs, Vec3(), Vec3(), rightSideNormal));
-	verts.push_back(Vertex_PCUTBN(splitTop, color, Vec2(halfUVX, UVs.m_maxs.y), Vec3(), Vec3(), normal));
-	verts.push_back(Vertex_PCUTBN(splitBottom, color, Vec2(halfUVX, UVs.m_mins.y), Vec3(), Vec3(), normal));
+	verts[6] = Vertex_PCUTBN(splitBottom, color, Vec2(halfUVX, UVs.m_mins.y), Vec3(), Vec3(), normal);
+	verts[7] = Vertex_PCUTBN(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y), Vec3(), Vec3(), rightSideNormal);
+	verts[8] = Vertex_PCUTBN(topRight, color, UVs.m_maxs, Vec3(), Vec3(), rightSideNormal);
+
+	verts[9] = Vertex_PCUTBN(topRight, color, UVs.m_maxs, Vec3(), Vec3(), rightSideNormal);
+	verts[10] = Vertex_PCUTBN(splitTop, color, Vec2(halfUVX, UVs.m_maxs.y), Vec3(), Vec3(), normal);
+	verts[11] = Vertex_PCUTBN(splitBottom, color, Vec2(halfUVX, UVs.m_mins.y), Vec3(), Vec3(), normal);
+	return 12;
 }
 
-void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
+int AddVertsForAABB3D(Vertex_PCU* verts, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
 {
 	float width = bounds.m_maxs.x - bounds.m_mins.x;
 	float length = bounds.m_maxs.z - bounds.m_mins.z;
@@ -330,15 +842,17 @@ void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, cons
 	Vec3 point6 = bounds.m_mins;
 	Vec3 point7 = bounds.m_mins + Vec3(0.f, height, 0.f);
 	Vec3 point8 = bounds.m_maxs + Vec3(0.f, 0.f, -length);
-	AddVertsForQuad3D(verts, point5, point8, point3, point2, color, UVs);
-	AddVertsForQuad3D(verts, point7, point6, point1, point4, color, UVs);
-	AddVertsForQuad3D(verts, point8, point7, point4, point3, color, UVs);
-	AddVertsForQuad3D(verts, point6, point5, point2, point1, color, UVs);
-	AddVertsForQuad3D(verts, point1, point2, point3, point4, color, UVs);
-	AddVertsForQuad3D(verts, point7, point8, point5, point6, color, UVs);
+	int numVerts = 0;
+	numVerts += AddVertsForQuad3D(verts + numVerts, point5, point8, point3, point2, color, UVs);
+	numVerts += AddVertsForQuad3D(verts + numVerts, point7, point6, point1, point4, color, UVs);
+	numVerts += AddVertsForQuad3D(verts + numVerts, point8, point7, point4, point3, color, UVs);
+	numVerts += AddVertsForQuad3D(verts + numVerts, point6, point5, point2, point1, color, UVs);
+	numVerts += AddVertsForQuad3D(verts + numVerts, point1, point2, point3, point4, color, UVs);
+	numVerts += AddVertsForQuad3D(verts + numVerts, point7, point8, point5, point6, color, UVs);
+	return numVerts;
 }
 
-void AddVertsForInverseAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
+int AddVertsForInverseAABB3D(Vertex_PCU* verts, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
 {
 	float width = bounds.m_maxs.x - bounds.m_mins.x;
 	float length = bounds.m_maxs.z - bounds.m_mins.z;
@@ -352,17 +866,19 @@ void AddVertsForInverseAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bound
 	Vec3 point6 = bounds.m_mins;
 	Vec3 point7 = bounds.m_mins + Vec3(0.f, height, 0.f);
 	Vec3 point8 = bounds.m_maxs + Vec3(0.f, 0.f, -length);
+	int numVerts = 0;
 
 	// Reverse winding order (note: flip the order of the 4 corners in each quad)
-	AddVertsForQuad3D(verts, point8, point5, point2, point3, color, UVs); // +X
-	AddVertsForQuad3D(verts, point6, point7, point4, point1, color, UVs); // -X
-	AddVertsForQuad3D(verts, point7, point8, point3, point4, color, UVs); // +Y
-	AddVertsForQuad3D(verts, point5, point6, point1, point2, color, UVs); // -Y
-	AddVertsForQuad3D(verts, point4, point3, point2, point1, color, UVs); // +Z
-	AddVertsForQuad3D(verts, point6, point5, point8, point7, color, UVs); // -Z
+	numVerts += AddVertsForQuad3D(verts + numVerts, point8, point5, point2, point3, color, UVs); // +X
+	numVerts += AddVertsForQuad3D(verts + numVerts, point6, point7, point4, point1, color, UVs); // -X
+	numVerts += AddVertsForQuad3D(verts + numVerts, point7, point8, point3, point4, color, UVs); // +Y
+	numVerts += AddVertsForQuad3D(verts + numVerts, point5, point6, point1, point2, color, UVs); // -Y
+	numVerts += AddVertsForQuad3D(verts + numVerts, point4, point3, point2, point1, color, UVs); // +Z
+	numVerts += AddVertsForQuad3D(verts + numVerts, point6, point5, point8, point7, color, UVs); // -Z
+	return numVerts;
 }
 
-void AddVertsForSkyBoxAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds, const SpriteSheet& sheet, const Rgba8& color)
+int AddVertsForSkyBoxAABB3D(Vertex_PCU* verts, const AABB3& bounds, const SpriteSheet& sheet, const Rgba8& color)
 {
 	float width = bounds.m_maxs.x - bounds.m_mins.x;
 	float length = bounds.m_maxs.z - bounds.m_mins.z;
@@ -383,16 +899,18 @@ void AddVertsForSkyBoxAABB3D(std::vector<Vertex_PCU>& verts, const AABB3& bounds
 	AABB2 uvYN = sheet.GetSpriteUVs(IntVec2(2, 1));
 	AABB2 uvZP = sheet.GetSpriteUVs(IntVec2(1, 0));
 	AABB2 uvZN = sheet.GetSpriteUVs(IntVec2(1, 2));
+	int numVerts = 0;
 	// Reverse winding order (note: flip the order of the 4 corners in each quad)
-	AddVertsForQuad3D(verts, point8, point5, point2, point3, color, uvXP); // +X
-	AddVertsForQuad3D(verts, point6, point7, point4, point1, color, uvXN); // -X
-	AddVertsForQuad3D(verts, point7, point8, point3, point4, color, uvYP); // +Y
-	AddVertsForQuad3D(verts, point5, point6, point1, point2, color, uvYN); // -Y
-	AddVertsForQuad3D(verts, point3, point2, point1, point4, color, uvZP); // +Z
-	AddVertsForQuad3D(verts, point6, point5, point8, point7, color, uvZN); // -Z
+	numVerts += AddVertsForQuad3D(verts + numVerts, point8, point5, point2, point3, color, uvXP); // +X
+	numVerts += AddVertsForQuad3D(verts + numVerts, point6, point7, point4, point1, color, uvXN); // -X
+	numVerts += AddVertsForQuad3D(verts + numVerts, point7, point8, point3, point4, color, uvYP); // +Y
+	numVerts += AddVertsForQuad3D(verts + numVerts, point5, point6, point1, point2, color, uvYN); // -Y
+	numVerts += AddVertsForQuad3D(verts + numVerts, point3, point2, point1, point4, color, uvZP); // +Z
+	numVerts += AddVertsForQuad3D(verts + numVerts, point6, point5, point8, point7, color, uvZN); // -Z
+	return numVerts;
 }
 
-void AddVertsForOBB3D(std::vector<Vertex_PCU>& verts, const OBB3& box, const Rgba8& color, const AABB2& UVs)
+int AddVertsForOBB3D(Vertex_PCU* verts, const OBB3& box, const Rgba8& color, const AABB2& UVs)
 {
 	Vec3 closeBottomLeft	= Vec3(-box.m_halfDims.x, -box.m_halfDims.y, -box.m_halfDims.z);
 	Vec3 closeBottomRight	= Vec3(-box.m_halfDims.x, box.m_halfDims.y, -box.m_halfDims.z);
@@ -415,15 +933,17 @@ void AddVertsForOBB3D(std::vector<Vertex_PCU>& verts, const OBB3& box, const Rgb
 	farTopLeft			= rotationMatrix.TransformPosition3D(farTopLeft);
 	farTopRight			= rotationMatrix.TransformPosition3D(farTopRight);
 
-	AddVertsForQuad3D(verts, farBottomLeft, farBottomRight, farTopRight, farTopLeft, color, UVs); // +X
-	AddVertsForQuad3D(verts, closeBottomRight, farBottomRight, farBottomLeft, closeBottomLeft, color, UVs); //-Z
-	AddVertsForQuad3D(verts, closeTopLeft, farTopLeft, farTopRight, closeTopRight, color, UVs); //+Z
-	AddVertsForQuad3D(verts, closeBottomLeft, farBottomLeft, farTopLeft, closeTopLeft, color, UVs); //-Y
-	AddVertsForQuad3D(verts, farBottomRight, closeBottomRight, closeTopRight, farTopRight, color, UVs); //+Y
-	AddVertsForQuad3D(verts, closeBottomRight, closeBottomLeft, closeTopLeft, closeTopRight, color, UVs); //-X
+	int numVerts = 0;
+	numVerts += AddVertsForQuad3D(verts + numVerts, farBottomLeft, farBottomRight, farTopRight, farTopLeft, color, UVs); // +X
+	numVerts += AddVertsForQuad3D(verts + numVerts, closeBottomRight, farBottomRight, farBottomLeft, closeBottomLeft, color, UVs); //-Z
+	numVerts += AddVertsForQuad3D(verts + numVerts, closeTopLeft, farTopLeft, farTopRight, closeTopRight, color, UVs); //+Z
+	numVerts += AddVertsForQuad3D(verts + numVerts, closeBottomLeft, farBottomLeft, farTopLeft, closeTopLeft, color, UVs); //-Y
+	numVerts += AddVertsForQuad3D(verts + numVerts, farBottomRight, closeBottomRight, closeTopRight, farTopRight, color, UVs); //+Y
+	numVerts += AddVertsForQuad3D(verts + numVerts, closeBottomRight, closeBottomLeft, closeTopLeft, closeTopRight, color, UVs); //-X
+	return numVerts;
 }
 
-void AddVertsForCylinder3D(std::vector<Vertex_PCU>& verts, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
+int AddVertsForCylinder3D(Vertex_PCU* verts, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
 {
 	float UVXRange = UVs.m_maxs.x - UVs.m_mins.x;
 	//Bfloat UVYRange = UVs.m_maxs.y - UVs.m_mins.y;
@@ -442,6 +962,7 @@ void AddVertsForCylinder3D(std::vector<Vertex_PCU>& verts, const Vec3& start, co
 	}
 	Vec3 j = CrossProduct3D(reference, fwdNormal).GetNormalized();
 	Vec3 k = CrossProduct3D(fwdNormal, j);
+	int numVerts = 0;
 
 	for (int i = 0; i < numSlices; i++)
 	{
@@ -461,21 +982,22 @@ void AddVertsForCylinder3D(std::vector<Vertex_PCU>& verts, const Vec3& start, co
 		Vec3 discPointTop2 = end + (j * CosDegrees(yaw2) + k * SinDegrees(yaw2)) * radius;
 
 		// Base
-		verts.push_back(Vertex_PCU(start, color, Vec2(0.5f, 0.5f)));
-		verts.push_back(Vertex_PCU(discPoint2, color, Vec2(uCoordRound2, vCoordRound2)));
-		verts.push_back(Vertex_PCU(discPoint1, color, Vec2(uCoordRound1, vCoordRound1)));
+		verts[numVerts++] = Vertex_PCU(start, color, Vec2(0.5f, 0.5f));
+		verts[numVerts++] = Vertex_PCU(discPoint2, color, Vec2(uCoordRound2, vCoordRound2));
+		verts[numVerts++] = Vertex_PCU(discPoint1, color, Vec2(uCoordRound1, vCoordRound1));
 
 		// Wall
-		AddVertsForQuad3D(verts, discPoint1, discPoint2, discPointTop2, discPointTop1, color, AABB2(yaw1Percent, 0.f, yaw2Percent, 1.f));
+		numVerts += AddVertsForQuad3D(verts + numVerts, discPoint1, discPoint2, discPointTop2, discPointTop1, color, AABB2(yaw1Percent, 0.f, yaw2Percent, 1.f));
 
 		// Cap
-		verts.push_back(Vertex_PCU(end, color, Vec2(0.5f, 0.5f)));
-		verts.push_back(Vertex_PCU(discPointTop1, color, Vec2(uCoordRound1, vCoordRound1)));
-		verts.push_back(Vertex_PCU(discPointTop2, color, Vec2(uCoordRound2, vCoordRound2)));
+		verts[numVerts++] = Vertex_PCU(end, color, Vec2(0.5f, 0.5f));
+		verts[numVerts++] = Vertex_PCU(discPointTop1, color, Vec2(uCoordRound1, vCoordRound1));
+		verts[numVerts++] = Vertex_PCU(discPointTop2, color, Vec2(uCoordRound2, vCoordRound2));
 	}
+	return numVerts;
 }
 
-void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
+int AddVertsForCone3D(Vertex_PCU* verts, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
 {
 	UVs;
 	float degreesPerSide = 360.f / numSlices;
@@ -492,6 +1014,7 @@ void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, const Vec3& start, const
 	}
 	Vec3 j = CrossProduct3D(reference, fwdNormal).GetNormalized();
 	Vec3 k = CrossProduct3D(fwdNormal, j);
+	int numVerts = 0;
 
 	for (int i = 0; i < numSlices; i++)
 	{
@@ -502,33 +1025,36 @@ void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, const Vec3& start, const
 		Vec3 discPoint2 = start + (j * CosDegrees(yaw2) + k * SinDegrees(yaw2)) * radius;
 
 		//Base
-		verts.push_back(Vertex_PCU(start, color, Vec2(0, 0)));
-		verts.push_back(Vertex_PCU(discPoint2, color, Vec2(0, 0)));
-		verts.push_back(Vertex_PCU(discPoint1, color, Vec2(0, 0)));
+		verts[numVerts++] = Vertex_PCU(start, color, Vec2(0, 0));
+		verts[numVerts++] = Vertex_PCU(discPoint2, color, Vec2(0, 0));
+		verts[numVerts++] = Vertex_PCU(discPoint1, color, Vec2(0, 0));
 
 		//Point
-		verts.push_back(Vertex_PCU(end, color, Vec2(0, 0)));
-		verts.push_back(Vertex_PCU(discPoint1, color, Vec2(0, 0)));
-		verts.push_back(Vertex_PCU(discPoint2, color, Vec2(0, 0)));
+		verts[numVerts++] = Vertex_PCU(end, color, Vec2(0, 0));
+		verts[numVerts++] = Vertex_PCU(discPoint1, color, Vec2(0, 0));
+		verts[numVerts++] = Vertex_PCU(discPoint2, color, Vec2(0, 0));
 	}
+	return numVerts;
 }
 
-void AddVertsForRoundArrow3D(std::vector<Vertex_PCU>& verts, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, int numSlices)
+int AddVertsForRoundArrow3D(Vertex_PCU* verts, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, int numSlices)
 {
 	Vec3 fwdVectorHead = (end - start);
 	Vec3 backArrowHeadAdjust = (fwdVectorHead.GetNormalized()) * -radius * 3.0f;
 	Vec3 fwdVectorCylinder = fwdVectorHead + backArrowHeadAdjust;
 
-	AddVertsForCylinder3D(verts, start, start + fwdVectorCylinder, radius, color, AABB2::ZERO_TO_ONE, numSlices);
-	AddVertsForCone3D(verts, start+fwdVectorCylinder, start+fwdVectorHead, radius * 1.5f, color, AABB2::ZERO_TO_ONE, numSlices);
+	int numVerts = AddVertsForCylinder3D(verts, start, start + fwdVectorCylinder, radius, color, AABB2::ZERO_TO_ONE, numSlices);
+	numVerts += AddVertsForCone3D(verts + numVerts, start+fwdVectorCylinder, start+fwdVectorHead, radius * 1.5f, color, AABB2::ZERO_TO_ONE, numSlices);
+	return numVerts;
 }
 
-void AddVertsForSphere(std::vector<Vertex_PCU>& verts, const Vec3& center, float radius, const Rgba8& color, const AABB2& UVs, int numSlices, int numStacks)
+int AddVertsForSphere(Vertex_PCU* verts, const Vec3& center, float radius, const Rgba8& color, const AABB2& UVs, int numSlices, int numStacks)
 {
 	float horizontalAngleStep = 360.f / numSlices;
 	float verticalAngleStep = 180.f / numStacks;
 	float UVXRange = UVs.m_maxs.x - UVs.m_mins.x;
 	float UVYRange = UVs.m_maxs.y - UVs.m_mins.y;
+	int numVerts = 0;
 
 	for (int stack = 0; stack < numStacks; stack++) {
 		float pitch1 = (stack * verticalAngleStep) - 90.f;
@@ -549,25 +1075,26 @@ void AddVertsForSphere(std::vector<Vertex_PCU>& verts, const Vec3& center, float
 
 			if (stack == 0) {
 				// Bottom cap - single triangle
-				verts.push_back(Vertex_PCU(bottomLeft, color, Vec2((yaw1Percent + yaw2Percent )/ 2.f, pitch1Percent)));
-				verts.push_back(Vertex_PCU(topRight, color, Vec2(yaw1Percent, pitch2Percent)));
-				verts.push_back(Vertex_PCU(topLeft, color, Vec2(yaw2Percent,pitch2Percent)));
+				verts[numVerts++] = Vertex_PCU(bottomLeft, color, Vec2((yaw1Percent + yaw2Percent )/ 2.f, pitch1Percent));
+				verts[numVerts++] = Vertex_PCU(topRight, color, Vec2(yaw1Percent, pitch2Percent));
+				verts[numVerts++] = Vertex_PCU(topLeft, color, Vec2(yaw2Percent,pitch2Percent));
 			}
 			else if (stack == numStacks - 1) {
 				// Top cap - single triangle
-				verts.push_back(Vertex_PCU(bottomLeft, color, Vec2(yaw1Percent, pitch1Percent)));
-				verts.push_back(Vertex_PCU(bottomRight, color, Vec2(yaw2Percent, pitch1Percent)));
-				verts.push_back(Vertex_PCU(topLeft, color, Vec2((yaw1Percent + yaw2Percent) / 2.f, pitch2Percent)));
+				verts[numVerts++] = Vertex_PCU(bottomLeft, color, Vec2(yaw1Percent, pitch1Percent));
+				verts[numVerts++] = Vertex_PCU(bottomRight, color, Vec2(yaw2Percent, pitch1Percent));
+				verts[numVerts++] = Vertex_PCU(topLeft, color, Vec2((yaw1Percent + yaw2Percent) / 2.f, pitch2Percent));
 			}
 			else {
 				//Middle stacks - quad
-				AddVertsForQuad3D(verts, bottomLeft, bottomRight, topRight, topLeft, color, AABB2(yaw1Percent,pitch1Percent,yaw2Percent,pitch2Percent));
+				numVerts += AddVertsForQuad3D(verts + numVerts, bottomLeft, bottomRight, topRight, topLeft, color, AABB2(yaw1Percent,pitch1Percent,yaw2Percent,pitch2Percent));
 			}
 		}
 	}
+	return numVerts;
 }
 
-void AddVertsForLitAABB3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
+int AddVertsForAABB3D(Vertex_PCU* verts, unsigned int* indexes, unsigned int firstVertexIndex, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
 {
 	float width = bounds.m_maxs.x - bounds.m_mins.x;
 	float length = bounds.m_maxs.z - bounds.m_mins.z;
@@ -582,15 +1109,314 @@ void AddVertsForLitAABB3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigne
 	Vec3 point7 = bounds.m_mins + Vec3(0.f, height, 0.f);
 	Vec3 point8 = bounds.m_maxs + Vec3(0.f, 0.f, -length);
 
-	AddVertsForQuad3D(verts, indexes, point5, point8, point3, point2, Vec3(1, 0, 0), color, UVs); // +X
-	AddVertsForQuad3D(verts, indexes, point7, point6, point1, point4, Vec3(-1, 0, 0), color, UVs); // -X
-	AddVertsForQuad3D(verts, indexes, point8, point7, point4, point3, Vec3(0, 1, 0), color, UVs); // +Y
-	AddVertsForQuad3D(verts, indexes, point6, point5, point2, point1, Vec3(0, -1, 0), color, UVs); // -Y
-	AddVertsForQuad3D(verts, indexes, point1, point2, point3, point4, Vec3(0, 0, 1), color, UVs); // +Z
-	AddVertsForQuad3D(verts, indexes, point7, point8, point5, point6, Vec3(0, 0, -1), color, UVs); // -Z
+	//Faces can't share corners since each one maps the full UV range, so each face is one shared quad
+	int numVerts = 0;
+	int numIndexes = 0;
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, point5, point8, point3, point2, color, UVs); // +X
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, point7, point6, point1, point4, color, UVs); // -X
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, point8, point7, point4, point3, color, UVs); // +Y
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, point6, point5, point2, point1, color, UVs); // -Y
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, point1, point2, point3, point4, color, UVs); // +Z
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, point7, point8, point5, point6, color, UVs); // -Z
+	return numVerts;
 }
 
-void AddVertsForLitOBB3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const OBB3& box, const Rgba8& color, const AABB2& UVs)
+int AddVertsForOBB3D(Vertex_PCU* verts, unsigned int* indexes, unsigned int firstVertexIndex, const OBB3& box, const Rgba8& color, const AABB2& UVs)
+{
+	Vec3 closeBottomLeft	= Vec3(-box.m_halfDims.x, -box.m_halfDims.y, -box.m_halfDims.z);
+	Vec3 closeBottomRight	= Vec3(-box.m_halfDims.x, box.m_halfDims.y, -box.m_halfDims.z);
+	Vec3 closeTopLeft		= Vec3(-box.m_halfDims.x, -box.m_halfDims.y, box.m_halfDims.z);
+	Vec3 closeTopRight		= Vec3(-box.m_halfDims.x, box.m_halfDims.y, box.m_halfDims.z);
+	Vec3 farBottomLeft		= Vec3(box.m_halfDims.x, -box.m_halfDims.y, -box.m_halfDims.z);
+	Vec3 farBottomRight		= Vec3(box.m_halfDims.x, box.m_halfDims.y, -box.m_halfDims.z);
+	Vec3 farTopLeft			= Vec3(box.m_halfDims.x, -box.m_halfDims.y, box.m_halfDims.z);
+	Vec3 farTopRight		= Vec3(box.m_halfDims.x, box.m_halfDims.y, box.m_halfDims.z);
+
+	Mat44 rotationMatrix = Mat44(box.m_iBasis, box.m_jBasis, box.m_kBasis, box.m_center);
+
+	closeBottomLeft		= rotationMatrix.TransformPosition3D(closeBottomLeft);
+	closeBottomRight	= rotationMatrix.TransformPosition3D(closeBottomRight);
+	closeTopLeft		= rotationMatrix.TransformPosition3D(closeTopLeft);
+	closeTopRight		= rotationMatrix.TransformPosition3D(closeTopRight);
+	farBottomLeft		= rotationMatrix.TransformPosition3D(farBottomLeft);
+	farBottomRight		= rotationMatrix.TransformPosition3D(farBottomRight);
+	farTopLeft			= rotationMatrix.TransformPosition3D(farTopLeft);
+	farTopRight			= rotationMatrix.TransformPosition3D(farTopRight);
+
+	int numVerts = 0;
+	int numIndexes = 0;
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, farBottomLeft, farBottomRight, farTopRight, farTopLeft, color, UVs); // +X
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, closeBottomRight, farBottomRight, farBottomLeft, closeBottomLeft, color, UVs); //-Z
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, closeTopLeft, farTopLeft, farTopRight, closeTopRight, color, UVs); //+Z
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, closeBottomLeft, farBottomLeft, farTopLeft, closeTopLeft, color, UVs); //-Y
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, farBottomRight, closeBottomRight, closeTopRight, farTopRight, color, UVs); //+Y
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, closeBottomRight, closeBottomLeft, closeTopLeft, closeTopRight, color, UVs); //-X
+	return numVerts;
+}
+
+int AddVertsForCylinder3D(Vertex_PCU* verts, unsigned int* indexes, unsigned int firstVertexIndex, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
+{
+	float UVXRange = UVs.m_maxs.x - UVs.m_mins.x;
+
+	float degreesPerSide = 360.f / numSlices;
+	Vec3 fwdNormal = (end - start).GetNormalized();
+
+	Vec3 reference;
+	if (abs(fwdNormal.y) < 0.9f)
+	{
+		reference = Vec3(0, 1, 0);
+	}
+	else
+	{
+		reference = Vec3(0, 0, 1);
+	}
+	Vec3 j = CrossProduct3D(reference, fwdNormal).GetNormalized();
+	Vec3 k = CrossProduct3D(fwdNormal, j);
+
+	//Layout: base center, base ring, wall bottom ring, wall top ring, cap ring, cap center
+	unsigned int baseCenter = firstVertexIndex;
+	unsigned int baseRing = baseCenter + 1;
+	unsigned int wallBottomRing = baseRing + numSlices;
+	unsigned int wallTopRing = wallBottomRing + numSlices + 1;
+	unsigned int capRing = wallTopRing + numSlices + 1;
+	unsigned int capCenter = capRing + numSlices;
+
+	int numVerts = 0;
+	verts[numVerts++] = Vertex_PCU(start, color, Vec2(0.5f, 0.5f));
+	for (int i = 0; i < numSlices; i++)
+	{
+		float yaw = degreesPerSide * i;
+		Vec3 discPoint = start + (j * CosDegrees(yaw) + k * SinDegrees(yaw)) * radius;
+		verts[numVerts++] = Vertex_PCU(discPoint, color, Vec2((CosDegrees(yaw) * .5f) + .5f, (SinDegrees(yaw) * .5f) + .5f));
+	}
+	//The wall's last column sits on the first column's position but carries the far end of the U range
+	for (int i = 0; i <= numSlices; i++)
+	{
+		float yaw = degreesPerSide * (i % numSlices);
+		float yawPercent = UVXRange * ((degreesPerSide * i) / 360.f);
+		Vec3 discPoint = start + (j * CosDegrees(yaw) + k * SinDegrees(yaw)) * radius;
+		verts[numVerts++] = Vertex_PCU(discPoint, color, Vec2(yawPercent, 0.f));
+	}
+	for (int i = 0; i <= numSlices; i++)
+	{
+		float yaw = degreesPerSide * (i % numSlices);
+		float yawPercent = UVXRange * ((degreesPerSide * i) / 360.f);
+		Vec3 discPointTop = end + (j * CosDegrees(yaw) + k * SinDegrees(yaw)) * radius;
+		verts[numVerts++] = Vertex_PCU(discPointTop, color, Vec2(yawPercent, 1.f));
+	}
+	for (int i = 0; i < numSlices; i++)
+	{
+		float yaw = degreesPerSide * i;
+		Vec3 discPointTop = end + (j * CosDegrees(yaw) + k * SinDegrees(yaw)) * radius;
+		verts[numVerts++] = Vertex_PCU(discPointTop, color, Vec2((CosDegrees(yaw) * .5f) + .5f, (SinDegrees(yaw) * .5f) + .5f));
+	}
+	verts[numVerts++] = Vertex_PCU(end, color, Vec2(0.5f, 0.5f));
+
+	int numIndexes = 0;
+	for (int i = 0; i < numSlices; i++)
+	{
+		unsigned int side1 = static_cast<unsigned int>(i);
+		unsigned int side2 = static_cast<unsigned int>((i + 1) % numSlices);
+		unsigned int column1 = static_cast<unsigned int>(i);
+		unsigned int column2 = static_cast<unsigned int>(i + 1);
+
+		// Base
+		indexes[numIndexes++] = baseCenter;
+		indexes[numIndexes++] = baseRing + side2;
+		indexes[numIndexes++] = baseRing + side1;
+
+		// Wall
+		indexes[numIndexes++] = wallBottomRing + column1;
+		indexes[numIndexes++] = wallBottomRing + column2;
+		indexes[numIndexes++] = wallTopRing + column2;
+		indexes[numIndexes++] = wallBottomRing + column1;
+		indexes[numIndexes++] = wallTopRing + column2;
+		indexes[numIndexes++] = wallTopRing + column1;
+
+		// Cap
+		indexes[numIndexes++] = capCenter;
+		indexes[numIndexes++] = capRing + side1;
+		indexes[numIndexes++] = capRing + side2;
+	}
+	return numVerts;
+}
+
+int AddVertsForCone3D(Vertex_PCU* verts, unsigned int* indexes, unsigned int firstVertexIndex, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
+{
+	UVs;
+	float degreesPerSide = 360.f / numSlices;
+	Vec3 fwdNormal = (end - start).GetNormalized();
+
+	Vec3 reference;
+	if (abs(fwdNormal.y) < 0.9f)
+	{
+		reference = Vec3(0, 1, 0);
+	}
+	else
+	{
+		reference = Vec3(0, 0, 1);
+	}
+	Vec3 j = CrossProduct3D(reference, fwdNormal).GetNormalized();
+	Vec3 k = CrossProduct3D(fwdNormal, j);
+
+	//Unlit cone has no UVs to split on, so the base and the sides share one ring
+	unsigned int baseCenter = firstVertexIndex;
+	unsigned int ring = baseCenter + 1;
+	unsigned int point = ring + numSlices;
+
+	int numVerts = 0;
+	verts[numVerts++] = Vertex_PCU(start, color, Vec2(0, 0));
+	for (int i = 0; i < numSlices; i++)
+	{
+		float yaw = degreesPerSide * i;
+		Vec3 discPoint = start + (j * CosDegrees(yaw) + k * SinDegrees(yaw)) * radius;
+		verts[numVerts++] = Vertex_PCU(discPoint, color, Vec2(0, 0));
+	}
+	verts[numVerts++] = Vertex_PCU(end, color, Vec2(0, 0));
+
+	int numIndexes = 0;
+	for (int i = 0; i < numSlices; i++)
+	{
+		unsigned int side1 = static_cast<unsigned int>(i);
+		unsigned int side2 = static_cast<unsigned int>((i + 1) % numSlices);
+
+		//Base
+		indexes[numIndexes++] = baseCenter;
+		indexes[numIndexes++] = ring + side2;
+		indexes[numIndexes++] = ring + side1;
+
+		//Point
+		indexes[numIndexes++] = point;
+		indexes[numIndexes++] = ring + side1;
+		indexes[numIndexes++] = ring + side2;
+	}
+	return numVerts;
+}
+
+int AddVertsForSphere(Vertex_PCU* verts, unsigned int* indexes, unsigned int firstVertexIndex, const Vec3& center, float radius, const Rgba8& color, const AABB2& UVs, int numSlices, int numStacks)
+{
+	GUARANTEE_OR_DIE(numSlices > 0 && numStacks >= 2, "Indexed spheres need at least one slice and two stacks");
+
+	float horizontalAngleStep = 360.f / numSlices;
+	float verticalAngleStep = 180.f / numStacks;
+	float UVXRange = UVs.m_maxs.x - UVs.m_mins.x;
+	float UVYRange = UVs.m_maxs.y - UVs.m_mins.y;
+
+	//Layout: bottom pole (one per slice), rings for stack lines 1..numStacks-1, top pole (one per slice)
+	unsigned int bottomPole = firstVertexIndex;
+	unsigned int firstRing = bottomPole + numSlices;
+	unsigned int ringSize = static_cast<unsigned int>(numSlices + 1);
+	unsigned int topPole = firstRing + ringSize * (numStacks - 1);
+
+	int numVerts = 0;
+	for (int line = 0; line <= numStacks; line++)
+	{
+		float pitch = (line * verticalAngleStep) - 90.f;
+		float pitchPercent = UVYRange * ((pitch + 90.f) / 180.f);
+
+		if (line == 0 || line == numStacks)
+		{
+			for (int slice = 0; slice < numSlices; slice++)
+			{
+				float yaw1Percent = UVXRange * ((slice * horizontalAngleStep) / 360.f);
+				float yaw2Percent = UVXRange * (((slice + 1) * horizontalAngleStep) / 360.f);
+				Vec3 pole = center + Vec3::MakeFromPolarDegrees(slice * horizontalAngleStep, pitch, radius);
+				verts[numVerts++] = Vertex_PCU(pole, color, Vec2((yaw1Percent + yaw2Percent) / 2.f, pitchPercent));
+			}
+		}
+		else
+		{
+			for (int column = 0; column <= numSlices; column++)
+			{
+				float yawPercent = UVXRange * ((column * horizontalAngleStep) / 360.f);
+				Vec3 ringPoint = center + Vec3::MakeFromPolarDegrees((column % numSlices) * horizontalAngleStep, pitch, radius);
+				verts[numVerts++] = Vertex_PCU(ringPoint, color, Vec2(yawPercent, pitchPercent));
+			}
+		}
+	}
+
+	int numIndexes = 0;
+	for (int stack = 0; stack < numStacks; stack++)
+	{
+		unsigned int bottomRing = firstRing + ringSize * (stack - 1);
+		unsigned int topRing = firstRing + ringSize * stack;
+
+		for (int slice = 0; slice < numSlices; slice++)
+		{
+			unsigned int left = static_cast<unsigned int>(slice);
+			unsigned int right = static_cast<unsigned int>(slice + 1);
+
+			if (stack == 0)
+			{
+				// Bottom cap - single triangle
+				indexes[numIndexes++] = bottomPole + left;
+				indexes[numIndexes++] = topRing + right;
+				indexes[numIndexes++] = topRing + left;
+			}
+			else if (stack == numStacks - 1)
+			{
+				// Top cap - single triangle
+				indexes[numIndexes++] = bottomRing + left;
+				indexes[numIndexes++] = bottomRing + right;
+				indexes[numIndexes++] = topPole + left;
+			}
+			else
+			{
+				//Middle stacks - quad
+				indexes[numIndexes++] = bottomRing + left;
+				indexes[numIndexes++] = bottomRing + right;
+				indexes[numIndexes++] = topRing + right;
+				indexes[numIndexes++] = bottomRing + left;
+				indexes[numIndexes++] = topRing + right;
+				indexes[numIndexes++] = topRing + left;
+			}
+		}
+	}
+	return numVerts;
+}
+
+int AddVertsForLitAABB3D(Vertex_PCUTBN* verts, unsigned int* indexes, unsigned int firstVertexIndex, const AABB3& bounds, const Rgba8& color, const AABB2& UVs)
+{
+	float width = bounds.m_maxs.x - bounds.m_mins.x;
+	float length = bounds.m_maxs.z - bounds.m_mins.z;
+	float height = bounds.m_maxs.y - bounds.m_mins.y;
+
+	Vec3 point1 = bounds.m_mins + Vec3(0.f, 0.f, length);
+	Vec3 point2 = bounds.m_maxs + Vec3(0.f, -height, 0.f);
+	Vec3 point3 = bounds.m_maxs;
+	Vec3 point4 = bounds.m_maxs + Vec3(-width, 0.f, 0.f);
+	Vec3 point5 = bounds.m_mins + Vec3(width, 0.f, 0.f);
+	Vec3 point6 = bounds.m_mins;
+	Vec3 point7 = bounds.m_mins + Vec3(0.f, height, 0.f);
+	Vec3 point8 = bounds.m_maxs + Vec3(0.f, 0.f, -length);
+
+	int numVerts = 0;
+	int numIndexes = 0;
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, point5, point8, point3, point2, Vec3(1, 0, 0), color, UVs); // +X
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, point7, point6, point1, point4, Vec3(-1, 0, 0), color, UVs); // -X
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, point8, point7, point4, point3, Vec3(0, 1, 0), color, UVs); // +Y
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, point6, point5, point2, point1, Vec3(0, -1, 0), color, UVs); // -Y
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, point1, point2, point3, point4, Vec3(0, 0, 1), color, UVs); // +Z
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, point7, point8, point5, point6, Vec3(0, 0, -1), color, UVs); // -Z
+	return numVerts;
+}
+
+int AddVertsForLitOBB3D(Vertex_PCUTBN* verts, unsigned int* indexes, unsigned int firstVertexIndex, const OBB3& box, const Rgba8& color, const AABB2& UVs)
 {
 	Vec3 closeBottomLeft = Vec3(-box.m_halfDims.x, -box.m_halfDims.y, -box.m_halfDims.z);
 	Vec3 closeBottomRight = Vec3(-box.m_halfDims.x, box.m_halfDims.y, -box.m_halfDims.z);
@@ -613,15 +1439,23 @@ void AddVertsForLitOBB3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned
 	farTopLeft = rotationMatrix.TransformPosition3D(farTopLeft);
 	farTopRight = rotationMatrix.TransformPosition3D(farTopRight);
 
-	AddVertsForQuad3D(verts, indexes, farBottomLeft, farBottomRight, farTopRight, farTopLeft, box.m_iBasis, color, UVs);
-	AddVertsForQuad3D(verts, indexes, closeBottomRight, farBottomRight, farBottomLeft, closeBottomLeft, -box.m_kBasis, color, UVs);
-	AddVertsForQuad3D(verts, indexes, closeTopLeft, farTopLeft, farTopRight, closeTopRight, box.m_kBasis, color, UVs);
-	AddVertsForQuad3D(verts, indexes, closeBottomLeft, farBottomLeft, farTopLeft, closeTopLeft, -box.m_jBasis, color, UVs);
-	AddVertsForQuad3D(verts, indexes, farBottomRight, closeBottomRight, closeTopRight, farTopRight, box.m_jBasis, color, UVs);
-	AddVertsForQuad3D(verts, indexes, closeBottomRight, closeBottomLeft, closeTopLeft, closeTopRight, -box.m_iBasis, color, UVs);
+	int numVerts = 0;
+	int numIndexes = 0;
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, farBottomLeft, farBottomRight, farTopRight, farTopLeft, box.m_iBasis, color, UVs);
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, closeBottomRight, farBottomRight, farBottomLeft, closeBottomLeft, -box.m_kBasis, color, UVs);
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, closeTopLeft, farTopLeft, farTopRight, closeTopRight, box.m_kBasis, color, UVs);
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, closeBottomLeft, farBottomLeft, farTopLeft, closeTopLeft, -box.m_jBasis, color, UVs);
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, farBottomRight, closeBottomRight, closeTopRight, farTopRight, box.m_jBasis, color, UVs);
+	numIndexes += GetNumIndexesForQuad3D();
+	numVerts += AddVertsForQuad3D(verts + numVerts, indexes + numIndexes, firstVertexIndex + numVerts, closeBottomRight, closeBottomLeft, closeTopLeft, closeTopRight, -box.m_iBasis, color, UVs);
+	return numVerts;
 }
 
-void AddVertsForLitCylinder3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
+int AddVertsForLitCylinder3D(Vertex_PCUTBN* verts, unsigned int* indexes, unsigned int firstVertexIndex, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
 {
 	float UVXRange = UVs.m_maxs.x - UVs.m_mins.x;
 	//Bfloat UVYRange = UVs.m_maxs.y - UVs.m_mins.y;
@@ -640,6 +1474,8 @@ void AddVertsForLitCylinder3D(std::vector<Vertex_PCUTBN>& verts, std::vector<uns
 	}
 	Vec3 j = CrossProduct3D(reference, fwdNormal).GetNormalized();
 	Vec3 k = CrossProduct3D(fwdNormal, j);
+	int numVerts = 0;
+	int numIndexes = 0;
 
 	for (int i = 0; i < numSlices; i++)
 	{
@@ -658,46 +1494,44 @@ void AddVertsForLitCylinder3D(std::vector<Vertex_PCUTBN>& verts, std::vector<uns
 		Vec3 discPointTop1 = end + (j * CosDegrees(yaw1) + k * SinDegrees(yaw1)) * radius;
 		Vec3 discPointTop2 = end + (j * CosDegrees(yaw2) + k * SinDegrees(yaw2)) * radius;
 
-		Vec3 circularNormal = (((discPointTop2 - discPointTop1) / 2.f) - end).GetNormalized();
-
 		// Base
-		verts.push_back(Vertex_PCUTBN(start, color, Vec2(0.5f, 0.5f), Vec3(), Vec3(), -fwdNormal));
-		verts.push_back(Vertex_PCUTBN(discPoint2, color, Vec2(uCoordRound2, vCoordRound2), Vec3(), Vec3(), -fwdNormal));
-		verts.push_back(Vertex_PCUTBN(discPoint1, color, Vec2(uCoordRound1, vCoordRound1), Vec3(), Vec3(), -fwdNormal));
-		int nextIndex = (int)verts.size();
+		verts[numVerts++] = Vertex_PCUTBN(start, color, Vec2(0.5f, 0.5f), Vec3(), Vec3(), -fwdNormal);
+		verts[numVerts++] = Vertex_PCUTBN(discPoint2, color, Vec2(uCoordRound2, vCoordRound2), Vec3(), Vec3(), -fwdNormal);
+		verts[numVerts++] = Vertex_PCUTBN(discPoint1, color, Vec2(uCoordRound1, vCoordRound1), Vec3(), Vec3(), -fwdNormal);
+		unsigned int nextIndex = firstVertexIndex + numVerts;
 
-		indexes.push_back(nextIndex - 3);
-		indexes.push_back(nextIndex - 2);
-		indexes.push_back(nextIndex - 1);
+		indexes[numIndexes++] = nextIndex - 3;
+		indexes[numIndexes++] = nextIndex - 2;
+		indexes[numIndexes++] = nextIndex - 1;
 
 		// Wall
-		Vec3 normal = Vec3();
-		verts.push_back(Vertex_PCUTBN(discPoint1, color, Vec2(yaw1Percent, 0.f), Vec3(), Vec3(), (discPoint1 - start).GetNormalized()));
-		verts.push_back(Vertex_PCUTBN(discPoint2, color, Vec2(yaw2Percent, 0.f), Vec3(), Vec3(), (discPoint2 - start).GetNormalized()));
-		verts.push_back(Vertex_PCUTBN(discPointTop2, color, Vec2(yaw2Percent, 1.f), Vec3(), Vec3(), (discPointTop2 - end).GetNormalized()));
-		verts.push_back(Vertex_PCUTBN(discPointTop1, color, Vec2(yaw1Percent, 1.f), Vec3(), Vec3(), (discPointTop1 - end).GetNormalized()));
-
-		nextIndex = (int)verts.size();
-		indexes.push_back(nextIndex - 4);
-		indexes.push_back(nextIndex - 3);
-		indexes.push_back(nextIndex - 2);
-		indexes.push_back(nextIndex - 4);
-		indexes.push_back(nextIndex - 2);
-		indexes.push_back(nextIndex - 1);
+		verts[numVerts++] = Vertex_PCUTBN(discPoint1, color, Vec2(yaw1Percent, 0.f), Vec3(), Vec3(), (discPoint1 - start).GetNormalized());
+		verts[numVerts++] = Vertex_PCUTBN(discPoint2, color, Vec2(yaw2Percent, 0.f), Vec3(), Vec3(), (discPoint2 - start).GetNormalized());
+		verts[numVerts++] = Vertex_PCUTBN(discPointTop2, color, Vec2(yaw2Percent, 1.f), Vec3(), Vec3(), (discPointTop2 - end).GetNormalized());
+		verts[numVerts++] = Vertex_PCUTBN(discPointTop1, color, Vec2(yaw1Percent, 1.f), Vec3(), Vec3(), (discPointTop1 - end).GetNormalized());
+
+		nextIndex = firstVertexIndex + numVerts;
+		indexes[numIndexes++] = nextIndex - 4;
+		indexes[numIndexes++] = nextIndex - 3;
+		indexes[numIndexes++] = nextIndex - 2;
+		indexes[numIndexes++] = nextIndex - 4;
+		indexes[numIndexes++] = nextIndex - 2;
+		indexes[numIndexes++] = nextIndex - 1;
 
 		// Cap
-		verts.push_back(Vertex_PCUTBN(end, color, Vec2(0.5f, 0.5f), Vec3(), Vec3(), fwdNormal));
-		verts.push_back(Vertex_PCUTBN(discPointTop1, color, Vec2(uCoordRound1, vCoordRound1), Vec3(), Vec3(), fwdNormal));
-		verts.push_back(Vertex_PCUTBN(discPointTop2, color, Vec2(uCoordRound2, vCoordRound2), Vec3(), Vec3(), fwdNormal));
-
-		nextIndex = (int)verts.size();
-		indexes.push_back(nextIndex - 3);
-		indexes.push_back(nextIndex - 2);
-		indexes.push_back(nextIndex - 1);
+		verts[numVerts++] = Vertex_PCUTBN(end, color, Vec2(0.5f, 0.5f), Vec3(), Vec3(), fwdNormal);
+		verts[numVerts++] = Vertex_PCUTBN(discPointTop1, color, Vec2(uCoordRound1, vCoordRound1), Vec3(), Vec3(), fwdNormal);
+		verts[numVerts++] = Vertex_PCUTBN(discPointTop2, color, Vec2(uCoordRound2, vCoordRound2), Vec3(), Vec3(), fwdNormal);
+
+		nextIndex = firstVertexIndex + numVerts;
+		indexes[numIndexes++] = nextIndex - 3;
+		indexes[numIndexes++] = nextIndex - 2;
+		indexes[numIndexes++] = nextIndex - 1;
 	}
+	return numVerts;
 }
 
-void AddVertsForLitCone3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
+int AddVertsForLitCone3D(Vertex_PCUTBN* verts, unsigned int* indexes, unsigned int firstVertexIndex, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, const AABB2& UVs, int numSlices)
 {
 	UVs;
 	float degreesPerSide = 360.f / numSlices;
@@ -714,6 +1548,8 @@ void AddVertsForLitCone3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigne
 	}
 	Vec3 j = CrossProduct3D(reference, fwdNormal).GetNormalized();
 	Vec3 k = CrossProduct3D(fwdNormal, j);
+	int numVerts = 0;
+	int numIndexes = 0;
 
 	for (int i = 0; i < numSlices; i++)
 	{
@@ -726,38 +1562,41 @@ void AddVertsForLitCone3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigne
 		Vec3 discPoint3 = start + (j * CosDegrees((yaw1 + yaw2) * .5f) + k * SinDegrees((yaw1 + yaw2) * .5f)) * radius;
 
 		//Base
-		verts.push_back(Vertex_PCUTBN(start, color, Vec2(0, 0), Vec3(), Vec3(), -fwdNormal));
-		verts.push_back(Vertex_PCUTBN(discPoint2, color, Vec2(0, 0), Vec3(), Vec3(), -fwdNormal));
-		verts.push_back(Vertex_PCUTBN(discPoint1, color, Vec2(0, 0), Vec3(), Vec3(), -fwdNormal));
-		int nextIndex = (int)verts.size();
-		indexes.push_back(nextIndex - 3);
-		indexes.push_back(nextIndex - 2);
-		indexes.push_back(nextIndex - 1);
+		verts[numVerts++] = Vertex_PCUTBN(start, color, Vec2(0, 0), Vec3(), Vec3(), -fwdNormal);
+		verts[numVerts++] = Vertex_PCUTBN(discPoint2, color, Vec2(0, 0), Vec3(), Vec3(), -fwdNormal);
+		verts[numVerts++] = Vertex_PCUTBN(discPoint1, color, Vec2(0, 0), Vec3(), Vec3(), -fwdNormal);
+		unsigned int nextIndex = firstVertexIndex + numVerts;
+		indexes[numIndexes++] = nextIndex - 3;
+		indexes[numIndexes++] = nextIndex - 2;
+		indexes[numIndexes++] = nextIndex - 1;
 
 		//Point
 		Vec3 p3Normal = CrossProduct3D((end - discPoint3), discPoint2 - discPoint1).GetNormalized();
-		verts.push_back(Vertex_PCUTBN(end, color, Vec2(0, 0), Vec3(), Vec3(), -p3Normal));
+		verts[numVerts++] = Vertex_PCUTBN(end, color, Vec2(0, 0), Vec3(), Vec3(), -p3Normal);
 		Vec3 p1Normal = CrossProduct3D((end - discPoint1), discPoint2 - discPoint1).GetNormalized();
 		Vec3 p2Normal = CrossProduct3D((end - discPoint2), discPoint2 - discPoint1).GetNormalized();
-		verts.push_back(Vertex_PCUTBN(discPoint1, color, Vec2(0, 0), Vec3(), Vec3(), -p1Normal));
-		verts.push_back(Vertex_PCUTBN(discPoint2, color, Vec2(0, 0), Vec3(), Vec3(), -p2Normal));
-		nextIndex = (int)verts.size();
-		indexes.push_back(nextIndex - 3);
-		indexes.push_back(nextIndex - 2);
-		indexes.push_back(nextIndex - 1);
+		verts[numVerts++] = Vertex_PCUTBN(discPoint1, color, Vec2(0, 0), Vec3(), Vec3(), -p1Normal);
+		verts[numVerts++] = Vertex_PCUTBN(discPoint2, color, Vec2(0, 0), Vec3(), Vec3(), -p2Normal);
+		nextIndex = firstVertexIndex + numVerts;
+		indexes[numIndexes++] = nextIndex - 3;
+		indexes[numIndexes++] = nextIndex - 2;
+		indexes[numIndexes++] = nextIndex - 1;
 	}
+	return numVerts;
 }
 
 //void AddVertsForLitRoundArrow3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color, int numSlices)
 //{
 //}
 
-void AddVertsForLitSphere(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const Vec3& center, float radius, const Rgba8& color, const AABB2& UVs, int numSlices, int numStacks)
+int AddVertsForLitSphere(Vertex_PCUTBN* verts, unsigned int* indexes, unsigned int firstVertexIndex, const Vec3& center, float radius, const Rgba8& color, const AABB2& UVs, int numSlices, int numStacks)
 {
 	float horizontalAngleStep = 360.f / numSlices;
 	float verticalAngleStep = 180.f / numStacks;
 	float UVXRange = UVs.m_maxs.x - UVs.m_mins.x;
 	float UVYRange = UVs.m_maxs.y - UVs.m_mins.y;
+	int numVerts = 0;
+	int numIndexes = 0;
 
 	for (int stack = 0; stack < numStacks; stack++) {
 		float pitch1 = (stack * verticalAngleStep) - 90.f;
@@ -778,40 +1617,41 @@ void AddVertsForLitSphere(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigne
 
 			if (stack == 0) {
 				// Bottom cap - single triangle
-				verts.push_back(Vertex_PCUTBN(bottomLeft, color, Vec2((yaw1Percent + yaw2Percent) * .5f, pitch1Percent), Vec3(), Vec3(), (bottomLeft - center).GetNormalized()));
-				verts.push_back(Vertex_PCUTBN(topRight, color, Vec2(yaw1Percent, pitch2Percent), Vec3(), Vec3(), (topRight - center).GetNormalized()));
-				verts.push_back(Vertex_PCUTBN(topLeft, color, Vec2(yaw2Percent, pitch2Percent), Vec3(), Vec3(), (topLeft - center).GetNormalized()));
-				int nextIndex = (int)verts.size();
-				indexes.push_back(nextIndex - 3);
-				indexes.push_back(nextIndex - 2);
-				indexes.push_back(nextIndex - 1);
+				verts[numVerts++] = Vertex_PCUTBN(bottomLeft, color, Vec2((yaw1Percent + yaw2Percent) * .5f, pitch1Percent), Vec3(), Vec3(), (bottomLeft - center).GetNormalized());
+				verts[numVerts++] = Vertex_PCUTBN(topRight, color, Vec2(yaw1Percent, pitch2Percent), Vec3(), Vec3(), (topRight - center).GetNormalized());
+				verts[numVerts++] = Vertex_PCUTBN(topLeft, color, Vec2(yaw2Percent, pitch2Percent), Vec3(), Vec3(), (topLeft - center).GetNormalized());
+				unsigned int nextIndex = firstVertexIndex + numVerts;
+				indexes[numIndexes++] = nextIndex - 3;
+				indexes[numIndexes++] = nextIndex - 2;
+				indexes[numIndexes++] = nextIndex - 1;
 			}
 			else if (stack == numStacks - 1) {
 				// Top cap - single triangle
-				verts.push_back(Vertex_PCUTBN(bottomLeft, color, Vec2(yaw1Percent, pitch1Percent), Vec3(), Vec3(), (bottomLeft - center).GetNormalized()));
-				verts.push_back(Vertex_PCUTBN(bottomRight, color, Vec2(yaw2Percent, pitch1Percent), Vec3(), Vec3(), (bottomRight - center).GetNormalized()));
-				verts.push_back(Vertex_PCUTBN(topLeft, color, Vec2((yaw1Percent + yaw2Percent) * .5f, pitch2Percent), Vec3(), Vec3(), (topLeft - center).GetNormalized()));
-				int nextIndex = (int)verts.size();
-				indexes.push_back(nextIndex - 3);
-				indexes.push_back(nextIndex - 2);
-				indexes.push_back(nextIndex - 1);
+				verts[numVerts++] = Vertex_PCUTBN(bottomLeft, color, Vec2(yaw1Percent, pitch1Percent), Vec3(), Vec3(), (bottomLeft - center).GetNormalized());
+				verts[numVerts++] = Vertex_PCUTBN(bottomRight, color, Vec2(yaw2Percent, pitch1Percent), Vec3(), Vec3(), (bottomRight - center).GetNormalized());
+				verts[numVerts++] = Vertex_PCUTBN(topLeft, color, Vec2((yaw1Percent + yaw2Percent) * .5f, pitch2Percent), Vec3(), Vec3(), (topLeft - center).GetNormalized());
+				unsigned int nextIndex = firstVertexIndex + numVerts;
+				indexes[numIndexes++] = nextIndex - 3;
+				indexes[numIndexes++] = nextIndex - 2;
+				indexes[numIndexes++] = nextIndex - 1;
 			}
 			else {
 				//Middle stacks - quad
-				verts.push_back(Vertex_PCUTBN(bottomLeft, color, Vec2(yaw1Percent, pitch1Percent), Vec3(), Vec3(), (bottomLeft - center).GetNormalized()));
-				verts.push_back(Vertex_PCUTBN(bottomRight, color, Vec2(yaw2Percent, pitch1Percent), Vec3(), Vec3(), (bottomRight - center).GetNormalized()));
-				verts.push_back(Vertex_PCUTBN(topRight, color, Vec2(yaw2Percent, pitch2Percent), Vec3(), Vec3(), (topRight - center).GetNormalized()));
-				verts.push_back(Vertex_PCUTBN(topLeft, color, Vec2(yaw1Percent, pitch2Percent), Vec3(), Vec3(), (topLeft - center).GetNormalized()));
-				int nextIndex = (int)verts.size();
-				indexes.push_back(nextIndex - 4);
-				indexes.push_back(nextIndex - 3);
-				indexes.push_back(nextIndex - 2);
-				indexes.push_back(nextIndex - 4);
-				indexes.push_back(nextIndex - 2);
-				indexes.push_back(nextIndex - 1);
+				verts[numVerts++] = Vertex_PCUTBN(bottomLeft, color, Vec2(yaw1Percent, pitch1Percent), Vec3(), Vec3(), (bottomLeft - center).GetNormalized());
+				verts[numVerts++] = Vertex_PCUTBN(bottomRight, color, Vec2(yaw2Percent, pitch1Percent), Vec3(), Vec3(), (bottomRight - center).GetNormalized());
+				verts[numVerts++] = Vertex_PCUTBN(topRight, color, Vec2(yaw2Percent, pitch2Percent), Vec3(), Vec3(), (topRight - center).GetNormalized());
+				verts[numVerts++] = Vertex_PCUTBN(topLeft, color, Vec2(yaw1Percent, pitch2Percent), Vec3(), Vec3(), (topLeft - center).GetNormalized());
+				unsigned int nextIndex = firstVertexIndex + numVerts;
+				indexes[numIndexes++] = nextIndex - 4;
+				indexes[numIndexes++] = nextIndex - 3;
+				indexes[numIndexes++] = nextIndex - 2;
+				indexes[numIndexes++] = nextIndex - 4;
+				indexes[numIndexes++] = nextIndex - 2;
+				indexes[numIndexes++] = nextIndex - 1;
 			}
 		}
 	}
+	return numVerts;
 }
 
 void TransformVertexArray(std::vector<Vertex_PCU>& verts, Vec3 const& translation, float scale, float rotationDegrees)
@@ -826,9 +1666,59 @@ void TransformVertexArray(std::vector<Vertex_PCU>& verts, Vec3 const& translatio
 
 void TransformVertexArray3D(std::vector<Vertex_PCU>& verts, const Mat44& transformation)
 {
-	for (int i = 0; i < (int)verts.size(); i++)
+	TransformVertexArray3D(static_cast<int>(verts.size()), verts.data(), transformation);
+}
+
+void TransformVertexArray3D(int numVerts, Vertex_PCU* verts, const Mat44& transformation)
+{
+	float const* m = transformation.m_values;
+	int vertIndex = 0;
+
+#if defined(ENGINE_SIMD_SSE2)
+	//Each 16 byte load grabs a position plus the color behind it. Four loads transpose into x, y, z and color lanes,
+	//the colors ride along untouched, and transposing back lets every vertex go out in one store.
+	static_assert(offsetof(Vertex_PCU, m_position) == 0 && offsetof(Vertex_PCU, m_color) == 12, "SSE transform expects position then color");
+	__m128 ix = _mm_set1_ps(m[Mat44::Ix]);
+	__m128 iy = _mm_set1_ps(m[Mat44::Iy]);
+	__m128 iz = _mm_set1_ps(m[Mat44::Iz]);
+	__m128 jx = _mm_set1_ps(m[Mat44::Jx]);
+	__m128 jy = _mm_set1_ps(m[Mat44::Jy]);
+	__m128 jz = _mm_set1_ps(m[Mat44::Jz]);
+	__m128 kx = _mm_set1_ps(m[Mat44::Kx]);
+	__m128 ky = _mm_set1_ps(m[Mat44::Ky]);
+	__m128 kz = _mm_set1_ps(m[Mat44::Kz]);
+	__m128 tx = _mm_set1_ps(m[Mat44::Tx]);
+	__m128 ty = _mm_set1_ps(m[Mat44::Ty]);
+	__m128 tz = _mm_set1_ps(m[Mat44::Tz]);
+
+	for (; vertIndex + 4 <= numVerts; vertIndex += 4)
 	{
-		verts[i].m_position = transformation.TransformPosition3D(verts[i].m_position);
+		float* vert0 = reinterpret_cast<float*>(&verts[vertIndex]);
+		float* vert1 = reinterpret_cast<float*>(&verts[vertIndex + 1]);
+		float* vert2 = reinterpret_cast<float*>(&verts[vertIndex + 2]);
+		float* vert3 = reinterpret_cast<float*>(&verts[vertIndex + 3]);
+		__m128 x = _mm_loadu_ps(vert0);
+		__m128 y = _mm_loadu_ps(vert1);
+		__m128 z = _mm_loadu_ps(vert2);
+		__m128 colors = _mm_loadu_ps(vert3);
+		_MM_TRANSPOSE4_PS(x, y, z, colors);
+
+		//Same multiply and add order as Mat44::TransformPosition3D, so every lane rounds exactly like the scalar path
+		__m128 newX = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ix, x), _mm_mul_ps(jx, y)), _mm_mul_ps(kx, z)), tx);
+		__m128 newY = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(iy, x), _mm_mul_ps(jy, y)), _mm_mul_ps(ky, z)), ty);
+		__m128 newZ = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(iz, x), _mm_mul_ps(jz, y)), _mm_mul_ps(kz, z)), tz);
+
+		_MM_TRANSPOSE4_PS(newX, newY, newZ, colors);
+		_mm_storeu_ps(vert0, newX);
+		_mm_storeu_ps(vert1, newY);
+		_mm_storeu_ps(vert2, newZ);
+		_mm_storeu_ps(vert3, colors);
+	}
+#endif
+
+	for (; vertIndex < numVerts; vertIndex++)
+	{
+		verts[vertIndex].m_position = transformation.TransformPosition3D(verts[vertIndex].m_position);
 	}
 }
 
@@ -860,4 +1750,179 @@ AABB2 GetVertexBounds2D(std::vector<Vertex_PCU>& verts)
 	}
 
 	return AABB2(minX,minY,maxX,maxY);
-}
\ No newline at end of file
+}
+
+void TransformVertexArray(VertexStream& stream, Vec3 const& translation, float scale, float rotationDegrees)
+{
+	float cosine = CosDegrees(rotationDegrees);
+	float sine = SinDegrees(rotationDegrees);
+	int numVerts = stream.GetNumVerts();
+	float* positionsX = stream.m_positionsX.data();
+	float* positionsY = stream.m_positionsY.data();
+	float* positionsZ = stream.m_positionsZ.data();
+	int vertIndex = 0;
+
+#if defined(ENGINE_SIMD_SSE2)
+	__m128 cos4 = _mm_set1_ps(cosine);
+	__m128 sin4 = _mm_set1_ps(sine);
+	__m128 scale4 = _mm_set1_ps(scale);
+	__m128 tx = _mm_set1_ps(translation.x);
+	__m128 ty = _mm_set1_ps(translation.y);
+	__m128 tz = _mm_set1_ps(translation.z);
+	for (; vertIndex + 4 <= numVerts; vertIndex += 4)
+	{
+		__m128 x = _mm_mul_ps(_mm_loadu_ps(positionsX + vertIndex), scale4);
+		__m128 y = _mm_mul_ps(_mm_loadu_ps(positionsY + vertIndex), scale4);
+		__m128 z = _mm_mul_ps(_mm_loadu_ps(positionsZ + vertIndex), scale4);
+		_mm_storeu_ps(positionsX + vertIndex, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(cos4, x), _mm_mul_ps(sin4, y)), tx));
+		_mm_storeu_ps(positionsY + vertIndex, _mm_add_ps(_mm_add_ps(_mm_mul_ps(sin4, x), _mm_mul_ps(cos4, y)), ty));
+		_mm_storeu_ps(positionsZ + vertIndex, _mm_add_ps(z, tz));
+	}
+#endif
+
+	for (; vertIndex < numVerts; vertIndex++)
+	{
+		float x = positionsX[vertIndex] * scale;
+		float y = positionsY[vertIndex] * scale;
+		float z = positionsZ[vertIndex] * scale;
+		positionsX[vertIndex] = ((cosine * x) - (sine * y)) + translation.x;
+		positionsY[vertIndex] = ((sine * x) + (cosine * y)) + translation.y;
+		positionsZ[vertIndex] = z + translation.z;
+	}
+
+	if (stream.HasTBN())
+	{
+		for (int tbnIndex = 0; tbnIndex < numVerts; tbnIndex++)
+		{
+			stream.m_tangents[tbnIndex] = stream.m_tangents[tbnIndex].GetRotatedAboutZDegrees(rotationDegrees);
+			stream.m_bitangents[tbnIndex] = stream.m_bitangents[tbnIndex].GetRotatedAboutZDegrees(rotationDegrees);
+			stream.m_normals[tbnIndex] = stream.m_normals[tbnIndex].GetRotatedAboutZDegrees(rotationDegrees);
+		}
+	}
+}
+
+static Vec3 GetNormalizedOrZero(Vec3 const& vector)
+{
+	float lengthSquared = vector.GetLengthSquared();
+	if (lengthSquared == 0.f)
+	{
+		return vector;
+	}
+	return vector / sqrtf(lengthSquared);
+}
+
+void TransformVertexArray3D(VertexStream& stream, const Mat44& transformation)
+{
+	float const* m = transformation.m_values;
+	int numVerts = stream.GetNumVerts();
+	float* positionsX = stream.m_positionsX.data();
+	float* positionsY = stream.m_positionsY.data();
+	float* positionsZ = stream.m_positionsZ.data();
+	int vertIndex = 0;
+
+#if defined(ENGINE_SIMD_SSE2)
+	__m128 ix = _mm_set1_ps(m[Mat44::Ix]);
+	__m128 iy = _mm_set1_ps(m[Mat44::Iy]);
+	__m128 iz = _mm_set1_ps(m[Mat44::Iz]);
+	__m128 jx = _mm_set1_ps(m[Mat44::Jx]);
+	__m128 jy = _mm_set1_ps(m[Mat44::Jy]);
+	__m128 jz = _mm_set1_ps(m[Mat44::Jz]);
+	__m128 kx = _mm_set1_ps(m[Mat44::Kx]);
+	__m128 ky = _mm_set1_ps(m[Mat44::Ky]);
+	__m128 kz = _mm_set1_ps(m[Mat44::Kz]);
+	__m128 tx = _mm_set1_ps(m[Mat44::Tx]);
+	__m128 ty = _mm_set1_ps(m[Mat44::Ty]);
+	__m128 tz = _mm_set1_ps(m[Mat44::Tz]);
+	for (; vertIndex + 4 <= numVerts; vertIndex += 4)
+	{
+		__m128 x = _mm_loadu_ps(positionsX + vertIndex);
+		__m128 y = _mm_loadu_ps(positionsY + vertIndex);
+		__m128 z = _mm_loadu_ps(positionsZ + vertIndex);
+		_mm_storeu_ps(positionsX + vertIndex, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ix, x), _mm_mul_ps(jx, y)), _mm_mul_ps(kx, z)), tx));
+		_mm_storeu_ps(positionsY + vertIndex, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(iy, x), _mm_mul_ps(jy, y)), _mm_mul_ps(ky, z)), ty));
+		_mm_storeu_ps(positionsZ + vertIndex, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(iz, x), _mm_mul_ps(jz, y)), _mm_mul_ps(kz, z)), tz));
+	}
+#endif
+
+	for (; vertIndex < numVerts; vertIndex++)
+	{
+		Vec3 position = transformation.TransformPosition3D(Vec3(positionsX[vertIndex], positionsY[vertIndex], positionsZ[vertIndex]));
+		positionsX[vertIndex] = position.x;
+		positionsY[vertIndex] = position.y;
+		positionsZ[vertIndex] = position.z;
+	}
+
+	if (stream.HasTBN())
+	{
+		//Normals go through the inverse transpose like AddVertsForCachedMesh, so bases must be mutually perpendicular.
+		//Everything is renormalized so scaled transforms still light correctly; zero vectors from PCU input stay zero.
+		Vec3 iBasis = transformation.GetIBasis3D();
+		Vec3 jBasis = transformation.GetJBasis3D();
+		Vec3 kBasis = transformation.GetKBasis3D();
+		Vec3 iNormalBasis = iBasis / iBasis.GetLengthSquared();
+		Vec3 jNormalBasis = jBasis / jBasis.GetLengthSquared();
+		Vec3 kNormalBasis = kBasis / kBasis.GetLengthSquared();
+		for (int tbnIndex = 0; tbnIndex < numVerts; tbnIndex++)
+		{
+			Vec3 const& normal = stream.m_normals[tbnIndex];
+			stream.m_tangents[tbnIndex] = GetNormalizedOrZero(transformation.TransformVectorQuantity3D(stream.m_tangents[tbnIndex]));
+			stream.m_bitangents[tbnIndex] = GetNormalizedOrZero(transformation.TransformVectorQuantity3D(stream.m_bitangents[tbnIndex]));
+			stream.m_normals[tbnIndex] = GetNormalizedOrZero(iNormalBasis * normal.x + jNormalBasis * normal.y + kNormalBasis * normal.z);
+		}
+	}
+}
+
+AABB2 GetVertexBounds2D(VertexStream const& stream)
+{
+	//Starts from the origin like the Vertex_PCU version so both forms report the same box
+	float minX = 0.f;
+	float minY = 0.f;
+	float maxX = 0.f;
+	float maxY = 0.f;
+	int numVerts = stream.GetNumVerts();
+	float const* positionsX = stream.m_positionsX.data();
+	float const* positionsY = stream.m_positionsY.data();
+	int vertIndex = 0;
+
+#if defined(ENGINE_SIMD_SSE2)
+	__m128 minX4 = _mm_setzero_ps();
+	__m128 minY4 = _mm_setzero_ps();
+	__m128 maxX4 = _mm_setzero_ps();
+	__m128 maxY4 = _mm_setzero_ps();
+	for (; vertIndex + 4 <= numVerts; vertIndex += 4)
+	{
+		__m128 x = _mm_loadu_ps(positionsX + vertIndex);
+		__m128 y = _mm_loadu_ps(positionsY + vertIndex);
+		minX4 = _mm_min_ps(minX4, x);
+		minY4 = _mm_min_ps(minY4, y);
+		maxX4 = _mm_max_ps(maxX4, x);
+		maxY4 = _mm_max_ps(maxY4, y);
+	}
+	minX = GetLowestLane(minX4);
+	minY = GetLowestLane(minY4);
+	maxX = GetHighestLane(maxX4);
+	maxY = GetHighestLane(maxY4);
+#endif
+
+	for (; vertIndex < numVerts; vertIndex++)
+	{
+		if (positionsX[vertIndex] < minX)
+		{
+			minX = positionsX[vertIndex];
+		}
+		if (positionsY[vertIndex] < minY)
+		{
+			minY = positionsY[vertIndex];
+		}
+		if (positionsX[vertIndex] > maxX)
+		{
+			maxX = positionsX[vertIndex];
+		}
+		if (positionsY[vertIndex] > maxY)
+		{
+			maxY = positionsY[vertIndex];
+		}
+	}
+
+	return AABB2(minX, minY, maxX, maxY);
+}
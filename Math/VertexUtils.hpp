@@ -17,6 +17,7 @@ struct Triangle2;
 struct Mat44;
 struct OBB3;
 class SpriteSheet;
+class VertexStream;
 
 //2D
 void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Capsule2 const& capsule, Rgba8 const& color);
@@ -57,6 +58,13 @@ void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, const Vec3& start, const
 void AddVertsForRoundArrow3D(std::vector<Vertex_PCU>& verts, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, int numSlices = 32);
 void AddVertsForSphere(std::vector<Vertex_PCU>& verts, const Vec3& center, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32, int numStacks = 16);
 
+//Unlit Indexed - neighbouring triangles share vertexes wherever position and UVs agree
+void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForOBB3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const OBB3& box, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForCylinder3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32);
+void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32);
+void AddVertsForSphere(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, const Vec3& center, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32, int numStacks = 16);
+
 void AddVertsForLitAABB3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
 void AddVertsForLitOBB3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const OBB3& box, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
 void AddVertsForLitCylinder3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32);
@@ -64,6 +72,111 @@ void AddVertsForLitCone3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigne
 //void AddVertsForLitRoundArrow3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, int numSlices = 32);
 void AddVertsForLitSphere(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, const Vec3& center, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32, int numStacks = 16);
 
+//Vertex and index counts
+//Each count is exactly what the matching AddVertsFor* call appends, so a frame's geometry can be sized once up front.
+int GetNumVertsForCapsule2D();
+int GetNumVertsForAABB2D();
+int GetNumVertsForOBB2D();
+int GetNumVertsForDisc2D();
+int GetNumVertsForRing2D();
+int GetNumVertsForLineSegment2D();
+int GetNumVertsForTriangle2D();
+int GetNumVertsForArrow2D();
+int GetNumVertsForCurve2D(int numPoints);
+int GetNumVertsForQuad3D();
+int GetNumVertsForIndexedQuad3D();
+int GetNumIndexesForQuad3D();
+int GetNumVertsForRoundedQuad3D();
+int GetNumVertsForAABB3D(); //Also InverseAABB3D and SkyBoxAABB3D
+int GetNumVertsForOBB3D();
+int GetNumVertsForCylinder3D(int numSlices = 32);
+int GetNumVertsForCone3D(int numSlices = 32);
+int GetNumVertsForRoundArrow3D(int numSlices = 32);
+int GetNumVertsForSphere(int numSlices = 32, int numStacks = 16);
+int GetNumVertsForIndexedAABB3D();
+int GetNumIndexesForAABB3D();
+int GetNumVertsForIndexedOBB3D();
+int GetNumIndexesForOBB3D();
+int GetNumVertsForIndexedCylinder3D(int numSlices = 32);
+int GetNumIndexesForCylinder3D(int numSlices = 32);
+int GetNumVertsForIndexedCone3D(int numSlices = 32);
+int GetNumIndexesForCone3D(int numSlices = 32);
+int GetNumVertsForIndexedSphere(int numSlices = 32, int numStacks = 16); //Dies unless numSlices > 0 and numStacks >= 2
+int GetNumIndexesForSphere(int numSlices = 32, int numStacks = 16);
+int GetNumVertsForLitAABB3D();
+int GetNumIndexesForLitAABB3D();
+int GetNumVertsForLitOBB3D();
+int GetNumIndexesForLitOBB3D();
+int GetNumVertsForLitCylinder3D(int numSlices = 32);
+int GetNumIndexesForLitCylinder3D(int numSlices = 32);
+int GetNumVertsForLitCone3D(int numSlices = 32);
+int GetNumIndexesForLitCone3D(int numSlices = 32);
+int GetNumVertsForLitSphere(int numSlices = 32, int numStacks = 16);
+int GetNumIndexesForLitSphere(int numSlices = 32, int numStacks = 16);
+
+//Pre-sized output
+//These write into caller-owned memory that already holds GetNumVertsFor*() vertexes (and GetNumIndexesFor*() indexes)
+//and return the number of vertexes written. Indexed versions offset every index by firstVertexIndex, the slot verts[0]
+//occupies in the final vertex buffer.
+int AddVertsForCapsule2D(Vertex_PCU* verts, Capsule2 const& capsule, Rgba8 const& color);
+int AddVertsForAABB2D(Vertex_PCU* verts, AABB2 const& aabb, Rgba8 const& color);
+int AddVertsForAABB2D(Vertex_PCU* verts, AABB2 const& aabb, AABB2 const& UVs, Rgba8 const& color);
+int AddVertsForAABB2D(Vertex_PCU* verts, float minX, float minY, float maxX, float maxY, Rgba8 const& color);
+int AddVertsForAABB2D(Vertex_PCU* verts, float minX, float minY, float maxX, float maxY, AABB2 UVs, Rgba8 const& color);
+int AddVertsForOBB2D(Vertex_PCU* verts, OBB2 const& obb, Rgba8 const& color);
+int AddVertsForDisc2D(Vertex_PCU* verts, Vec2 const& center, float radius, Rgba8 const& color);
+int AddVertsForRing2D(Vertex_PCU* verts, Vec2 const& center, float radius, float thickness, Rgba8 const& color);
+int AddVertsForLineSegment2D(Vertex_PCU* verts, LineSegment2 const& line, float thickness, Rgba8 const& color);
+int AddVertsForTriangle2D(Vertex_PCU* verts, Triangle2 const& triangle, Rgba8 const& color);
+int AddVertsForArrow2D(Vertex_PCU* verts, Vec2 tailPos, Vec2 tipPos, float arrowSize, float lineThickness, Rgba8 color);
+int AddVertsForCurve2D(Vertex_PCU* verts, std::vector<Vec2> const& points, float thickness, Rgba8 const& color);
+
+int AddVertsForQuad3D(Vertex_PCU* verts,
+	const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft,
+	const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+int AddVertsForQuad3D(Vertex_PCU* verts, unsigned int* indexes, unsigned int firstVertexIndex,
+	const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft,
+	const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+int AddVertsForQuad3D(Vertex_PCUTBN* verts, unsigned int* indexes, unsigned int firstVertexIndex,
+	const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Vec3& normal,
+	const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+int AddVertsForQuad3D(Vertex_PCUTBN* verts,
+	const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Vec3& normal,
+	const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+int AddVertsForRoundedQuad3D(Vertex_PCUTBN* verts,
+	const Vec3& bottomLeft, const Vec3& bottomRight, const Vec3& topRight, const Vec3& topLeft, const Vec3& normal,
+	const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+int AddVertsForAABB3D(Vertex_PCU* verts, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+int AddVertsForInverseAABB3D(Vertex_PCU* verts, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+int AddVertsForSkyBoxAABB3D(Vertex_PCU* verts, const AABB3& bounds, const SpriteSheet& sheet, const Rgba8& color = Rgba8::WHITE);
+int AddVertsForOBB3D(Vertex_PCU* verts, const OBB3& box, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+int AddVertsForCylinder3D(Vertex_PCU* verts, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32);
+int AddVertsForCone3D(Vertex_PCU* verts, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32);
+int AddVertsForRoundArrow3D(Vertex_PCU* verts, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, int numSlices = 32);
+int AddVertsForSphere(Vertex_PCU* verts, const Vec3& center, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32, int numStacks = 16);
+
+int AddVertsForAABB3D(Vertex_PCU* verts, unsigned int* indexes, unsigned int firstVertexIndex, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+int AddVertsForOBB3D(Vertex_PCU* verts, unsigned int* indexes, unsigned int firstVertexIndex, const OBB3& box, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+int AddVertsForCylinder3D(Vertex_PCU* verts, unsigned int* indexes, unsigned int firstVertexIndex, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32);
+int AddVertsForCone3D(Vertex_PCU* verts, unsigned int* indexes, unsigned int firstVertexIndex, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32);
+int AddVertsForSphere(Vertex_PCU* verts, unsigned int* indexes, unsigned int firstVertexIndex, const Vec3& center, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32, int numStacks = 16);
+
+int AddVertsForLitAABB3D(Vertex_PCUTBN* verts, unsigned int* indexes, unsigned int firstVertexIndex, const AABB3& bounds, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+int AddVertsForLitOBB3D(Vertex_PCUTBN* verts, unsigned int* indexes, unsigned int firstVertexIndex, const OBB3& box, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE);
+int AddVertsForLitCylinder3D(Vertex_PCUTBN* verts, unsigned int* indexes, unsigned int firstVertexIndex, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32);
+int AddVertsForLitCone3D(Vertex_PCUTBN* verts, unsigned int* indexes, unsigned int firstVertexIndex, const Vec3& start, const Vec3& end, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32);
+int AddVertsForLitSphere(Vertex_PCUTBN* verts, unsigned int* indexes, unsigned int firstVertexIndex, const Vec3& center, float radius, const Rgba8& color = Rgba8::WHITE, const AABB2& UVs = AABB2::ZERO_TO_ONE, int numSlices = 32, int numStacks = 16);
+
 void TransformVertexArray(std::vector<Vertex_PCU>& verts, Vec3 const& translation, float scale, float rotationDegrees);
 void TransformVertexArray3D(std::vector<Vertex_PCU>& verts, const Mat44& transformation);
-AABB2 GetVertexBounds2D(std::vector<Vertex_PCU>& verts);
\ No newline at end of file
+//Transforms four vertexes at a time with SSE where available. Bit-for-bit identical to Mat44::TransformPosition3D on every vertex
+//as long as the compiler isn't contracting the scalar multiply-adds into FMAs (MSVC only does that under /fp:contract).
+void TransformVertexArray3D(int numVerts, Vertex_PCU* verts, const Mat44& transformation);
+AABB2 GetVertexBounds2D(std::vector<Vertex_PCU>& verts);
+
+//Structure-of-arrays versions of the bulk passes. TransformVertexArray3D and GetVertexBounds2D match the Vertex_PCU versions exactly;
+//TransformVertexArray rotates by one cos/sin per call, so it matches within a few ULP like TransformVertexArrayXY3D.
+//Lit streams also carry their tangent, bitangent and normal through the rotation.
+void TransformVertexArray(VertexStream& stream, Vec3 const& translation, float scale, float rotationDegrees);
+void TransformVertexArray3D(VertexStream& stream, const Mat44& transformation);
+AABB2 GetVertexBounds2D(VertexStream const& stream);
\ No newline at end of file
@@ -92,6 +92,47 @@ float4 PixelMain(v2p_t input) : SV_Target0
 }
 )";
 
+//Handed from an async load's decode stage on a worker to its finalize stage on the main thread. The handle keeps the
+//cache entry loading until then, even if every caller drops theirs.
+template<typename HandleType>
+struct PendingImageLoad
+{
+	std::string	m_filePath;
+	Image*		m_image = nullptr; //Null if the file was missing or did not decode
+	HandleType	m_handle;
+};
+
+struct PendingShaderLoad
+{
+	std::string					m_shaderName;
+	std::vector<unsigned char>	m_vertexShaderByteCode;
+	std::vector<unsigned char>	m_pixelShaderByteCode;
+	bool						m_didCompile = false;
+	ShaderHandle				m_handle;
+};
+
+static Image* DecodeImageFile(std::string const& imageFilePath)
+{
+	MappedFile imageFile(imageFilePath);
+	if (!imageFile.IsOpen())
+	{
+		return nullptr;
+	}
+	Image* image = new Image(imageFile);
+	if (image->GetDimensions().x <= 0)
+	{
+		delete image;
+		return nullptr;
+	}
+	return image;
+}
+
+//What a texture is charged against its cache's budget: RGBA8 texels, one mip
+static size_t GetTextureMemoryBytes(Texture const& texture)
+{
+	return 4 * static_cast<size_t>(texture.GetDimensions().x) * static_cast<size_t>(texture.GetDimensions().y);
+}
+
 Renderer::Renderer()
 {
 	m_renderConfig = RenderConfig();
@@ -128,6 +169,15 @@ void Renderer::Startup()
 	InitializeDeviceContext();//Create Swap chain and device, also set device context
 	InitializeRenderTargetView();//Get Back buffer and Create Render target view
 
+	//Create resource caches
+	m_textureCache = new ResourceCache<Texture*>(m_renderConfig.m_textureCacheConfig, [](Texture* texture) { delete texture; });
+	m_fontCache = new ResourceCache<BitmapFont*>(m_renderConfig.m_fontCacheConfig, [this](BitmapFont* font)
+	{
+		delete font;
+		m_fontTextures.erase(font); //Lets the texture be evicted once nothing else holds it
+	});
+	m_shaderCache = new ResourceCache<Shader*>(m_renderConfig.m_shaderCacheConfig, [](Shader* shader) { delete shader; });
+
 	//Create and Bind Shader from source
 	m_defaultShader = CreateDefaultShader();
 	BindShader(CreateOrGetShader("Default"));
@@ -143,12 +193,18 @@ void Renderer::Startup()
 	InitializeSamplerStates();//Create Sampler States. Default to POINT_CLAMP
 	InitializeRasterizerStates();//Create and Set Rasterizer State
 	InitializeDepthModes();//Create and Set Depth Modes
+
+	m_assetPipeline = new AssetPipeline(m_renderConfig.m_assetPipelineConfig);
+	m_assetPipeline->Startup();
 }
 
 void Renderer::BeginFrame()
 {
 	//Set render target
 	m_deviceContext->OMSetRenderTargets(1, &m_renderTargetView, m_depthStencilDSV);
+
+	//Create the D3D objects for assets that finished decoding, within the frame's budget
+	m_assetPipeline->BeginFrame();
 }
 
 void Renderer::EndFrame()
@@ -167,24 +223,18 @@ void Renderer::EndFrame()
 
 void Renderer::Shutdown()
 {
-	//Release Loaded Shaders
-	for (int i = 0; i < static_cast<int>(m_loadedShaders.size()); i++)
-	{
-		if (m_loadedShaders[i] != nullptr)
-		{
-			delete m_loadedShaders[i];
-		}
-	}
-	m_loadedShaders.clear();
-
-	//for (int i = 0; i < static_cast<int>(m_loadedFonts.size()); i++)
-	//{
-	//	if (m_loadedFonts[i] != nullptr)
-	//	{
-	//		delete m_loadedFonts[i];
-	//	}
-	//}
-	m_loadedFonts.clear();
+	//Finish async loads so nothing is created after the lists below are released
+	m_assetPipeline->Shutdown();
+	delete m_assetPipeline;
+	m_assetPipeline = nullptr;
+
+	//Release cached resources, fonts first since they hold their textures
+	delete m_fontCache;
+	m_fontCache = nullptr;
+	delete m_shaderCache;
+	m_shaderCache = nullptr;
+	delete m_textureCache;
+	m_textureCache = nullptr;
 
 	//Release Loaded Textures
 	for (int i = 0; i < static_cast<int>(m_loadedTextures.size()); i++)
@@ -389,23 +439,22 @@ Texture* Renderer::CreateOrGetTextureFromFile(char const* imageFilePath)
 	return newTexture;
 }
 
+//Returns the cached texture if the file is already loaded, finishing a pending async load of it first
 Texture* Renderer::CreateTextureFromFile(char const* imageFilePath)
 {
-	//IntVec2 dimensions = IntVec2(0, 0); // This will be filled in for us to indicate image width & height
-	//int bytesPerTexel = 0;					// ...and how many color components the image had (e.g. 3=RGB=24bit, 4=RGBA=32bit)
-
-	//// Load (and decompress) the image RGB(A) bytes from a file on disk into a memory buffer (array of bytes)
-	//stbi_set_flip_vertically_on_load(1); // We prefer uvTexCoords has origin (0,0) at BOTTOM LEFT
-	//unsigned char* texelData = stbi_load(imageFilePath, &dimensions.x, &dimensions.y, &bytesPerTexel, 0);
-
-	//// Check if the load was successful
-	//GUARANTEE_OR_DIE(texelData, Stringf("Failed to load image \"%s\"", imageFilePath));
-
-	Texture* newTexture = CreateTextureFromImage(*CreateImageFromFile(imageFilePath));
-
-	//// Free the raw image texel data now that we've sent a copy of it down to the GPU to be stored in video memory
-	//stbi_image_free(texelData);
+	if (m_textureCache->IsLoading(imageFilePath))
+	{
+		FinishPendingAssetLoads();
+	}
+	Texture* existingTexture = GetTextureFromFileName(imageFilePath);
+	if (existingTexture)
+	{
+		return existingTexture;
+	}
 
+	Texture* newTexture = CreateTextureObject(Image(imageFilePath));
+	TextureHandle newTextureHandle = m_textureCache->Add(imageFilePath, newTexture, GetTextureMemoryBytes(*newTexture));
+	m_textureCache->Pin(newTexture);
 	return newTexture;
 }
 
@@ -424,6 +473,13 @@ Texture* Renderer::CreateTextureFromData(char const* name, IntVec2 dimensions, i
 }
 
 Texture* Renderer::CreateTextureFromImage(const Image& image)
+{
+	Texture* newTexture = CreateTextureObject(image);
+	m_loadedTextures.push_back(newTexture);
+	return newTexture;
+}
+
+Texture* Renderer::CreateTextureObject(const Image& image)
 {
 	Texture* newTexture = new Texture();
 	newTexture->m_dimensions = image.GetDimensions();
@@ -455,21 +511,17 @@ Texture* Renderer::CreateTextureFromImage(const Image& image)
 	{
 		ERROR_AND_DIE(Stringf("CreateShaderresourceView failed for image: \"%s\".", image.GetImageFilePath().c_str()));
 	}
-
-	m_loadedTextures.push_back(newTexture);
 	return newTexture;
 }
 
 Texture* Renderer::GetTextureFromFileName(char const* imageFilePath)
 {
-	for (int i = 0; i < m_loadedTextures.size(); i++)
+	Texture* texture = nullptr;
+	if (m_textureCache->Find(imageFilePath, texture))
 	{
-		if (m_loadedTextures[i]->m_name == imageFilePath)
-		{
-			return m_loadedTextures[i];
-		}
+		m_textureCache->Pin(texture); //The caller keeps the raw pointer
 	}
-	return nullptr;
+	return texture;
 }
 
 void Renderer::BindTexture(Texture* texture)
@@ -498,24 +550,154 @@ BitmapFont* Renderer::CreateOrGetBitmapFont(const char* bitmapFontFilePathWithNo
 
 BitmapFont* Renderer::GetBitmapFontForFileName(const char* bitmapFontFilePathWithNoExtension)
 {
-	for (int i = 0; i < m_loadedFonts.size(); i++)
+	BitmapFont* font = nullptr;
+	if (m_fontCache->Find(bitmapFontFilePathWithNoExtension, font))
 	{
-		if (m_loadedFonts[i]->m_fontFilePathNameWithNoExtension == bitmapFontFilePathWithNoExtension)
-		{
-			return m_loadedFonts[i];
-		}
+		m_fontCache->Pin(font); //The caller keeps the raw pointer
 	}
-	return nullptr;
+	return font;
 }
 
+//Returns the cached font if the file is already loaded, finishing a pending async load of it first
 BitmapFont* Renderer::CreateBitmapFontFromFile(const char* bitmapFontFilePathWithNoExtension)
 {
-	Texture* fontTexture = CreateTextureFromFile(bitmapFontFilePathWithNoExtension);
+	if (m_fontCache->IsLoading(bitmapFontFilePathWithNoExtension) || m_textureCache->IsLoading(bitmapFontFilePathWithNoExtension))
+	{
+		FinishPendingAssetLoads();
+	}
+	BitmapFont* existingFont = GetBitmapFontForFileName(bitmapFontFilePathWithNoExtension);
+	if (existingFont)
+	{
+		return existingFont;
+	}
+
+	BitmapFont* newFont = CreateBitmapFontObject(bitmapFontFilePathWithNoExtension, nullptr);
+	BitmapFontHandle newFontHandle = m_fontCache->Add(bitmapFontFilePathWithNoExtension, newFont, sizeof(BitmapFont));
+	m_fontCache->Pin(newFont);
+	return newFont;
+}
+
+BitmapFont* Renderer::CreateBitmapFontObject(char const* bitmapFontFilePathWithNoExtension, Image const* decodedImage)
+{
+	Texture* fontTexture = nullptr;
+	TextureHandle fontTextureHandle = m_textureCache->Acquire(bitmapFontFilePathWithNoExtension);
+	if (fontTextureHandle.IsReady())
+	{
+		fontTexture = fontTextureHandle.Get();
+	}
+	else
+	{
+		fontTexture = decodedImage ? CreateTextureObject(*decodedImage) : CreateTextureObject(Image(bitmapFontFilePathWithNoExtension));
+		if (fontTextureHandle.IsValid())
+		{
+			//The file is still loading as a plain texture; this font keeps a copy of its own
+			fontTextureHandle.Release();
+			m_loadedTextures.push_back(fontTexture);
+		}
+		else
+		{
+			fontTextureHandle = m_textureCache->Add(bitmapFontFilePathWithNoExtension, fontTexture, GetTextureMemoryBytes(*fontTexture));
+		}
+	}
+
 	BitmapFont* newFont = new BitmapFont(bitmapFontFilePathWithNoExtension, *fontTexture);
-	m_loadedFonts.push_back(newFont);
+	m_fontTextures[newFont] = fontTextureHandle;
 	return newFont;
 }
 
+TextureHandle Renderer::CreateOrGetTextureFromFileAsync(char const* imageFilePath, Texture* placeholder)
+{
+	TextureHandle textureHandle = m_textureCache->Acquire(imageFilePath);
+	if (textureHandle.IsValid())
+	{
+		return textureHandle;
+	}
+	textureHandle = m_textureCache->AddLoading(imageFilePath, placeholder);
+
+	PendingImageLoad<TextureHandle>* pendingLoad = new PendingImageLoad<TextureHandle>();
+	pendingLoad->m_filePath = imageFilePath;
+	pendingLoad->m_handle = textureHandle;
+	m_assetPipeline->QueueLoad(
+		[pendingLoad]()
+		{
+			pendingLoad->m_image = DecodeImageFile(pendingLoad->m_filePath);
+		},
+		[this, pendingLoad]()
+		{
+			if (pendingLoad->m_image)
+			{
+				Texture* newTexture = CreateTextureObject(*pendingLoad->m_image);
+				m_textureCache->FinishLoad(pendingLoad->m_handle, newTexture, GetTextureMemoryBytes(*newTexture));
+			}
+			else
+			{
+				m_textureCache->FinishLoad(pendingLoad->m_handle, nullptr, 0, true);
+			}
+			delete pendingLoad->m_image;
+			delete pendingLoad;
+		});
+	return textureHandle;
+}
+
+BitmapFontHandle Renderer::CreateOrGetBitmapFontAsync(char const* bitmapFontFilePathWithNoExtension, BitmapFont* placeholder)
+{
+	BitmapFontHandle fontHandle = m_fontCache->Acquire(bitmapFontFilePathWithNoExtension);
+	if (fontHandle.IsValid())
+	{
+		return fontHandle;
+	}
+	fontHandle = m_fontCache->AddLoading(bitmapFontFilePathWithNoExtension, placeholder);
+
+	PendingImageLoad<BitmapFontHandle>* pendingLoad = new PendingImageLoad<BitmapFontHandle>();
+	pendingLoad->m_filePath = bitmapFontFilePathWithNoExtension;
+	pendingLoad->m_handle = fontHandle;
+	m_assetPipeline->QueueLoad(
+		[pendingLoad]()
+		{
+			pendingLoad->m_image = DecodeImageFile(pendingLoad->m_filePath);
+		},
+		[this, pendingLoad]()
+		{
+			if (pendingLoad->m_image)
+			{
+				BitmapFont* newFont = CreateBitmapFontObject(pendingLoad->m_filePath.c_str(), pendingLoad->m_image);
+				m_fontCache->FinishLoad(pendingLoad->m_handle, newFont, sizeof(BitmapFont));
+			}
+			else
+			{
+				m_fontCache->FinishLoad(pendingLoad->m_handle, nullptr, 0, true);
+			}
+			delete pendingLoad->m_image;
+			delete pendingLoad;
+		});
+	return fontHandle;
+}
+
+void Renderer::FinishPendingAssetLoads()
+{
+	m_assetPipeline->FinishAllLoads();
+}
+
+int Renderer::GetNumPendingAssetLoads() const
+{
+	return m_assetPipeline ? m_assetPipeline->GetNumPendingLoads() : 0;
+}
+
+void Renderer::ReleaseTexture(Texture* texture)
+{
+	m_textureCache->Unpin(texture);
+}
+
+void Renderer::ReleaseBitmapFont(BitmapFont* font)
+{
+	m_fontCache->Unpin(font);
+}
+
+void Renderer::ReleaseShader(Shader* shader)
+{
+	m_shaderCache->Unpin(shader);
+}
+
 void Renderer::SetBlendMode(BlendMode blendMode)
 {
 	if (blendMode == BlendMode::ALPHA		||
@@ -622,17 +804,63 @@ void Renderer::SetDepthMode(DepthMode depthMode)
 
 Shader* Renderer::CreateOrGetShader(char const* shaderName, VertexType vType)
 {
-	vType;
-	for (int shaderIndex = 0; shaderIndex < static_cast<int>(m_loadedShaders.size()); shaderIndex++)
+	//Checked here as well so a pending shader is not read and compiled a second time
+	if (m_shaderCache->IsLoading(shaderName))
 	{
-		if (m_loadedShaders[shaderIndex] != nullptr && m_loadedShaders[shaderIndex]->GetName() == shaderName)
-		{
-			return m_loadedShaders[shaderIndex];
-		}
+		FinishPendingAssetLoads();
+	}
+	Shader* existingShader = nullptr;
+	if (m_shaderCache->Find(shaderName, existingShader))
+	{
+		m_shaderCache->Pin(existingShader); //The caller keeps the raw pointer
+		return existingShader;
 	}
 	return CreateShader(shaderName, vType);
 }
 
+//Reads and compiles the HLSL on a worker; only the D3D shader objects are created on the main thread
+ShaderHandle Renderer::CreateOrGetShaderAsync(char const* shaderName, VertexType vType, Shader* placeholder)
+{
+	ShaderHandle shaderHandle = m_shaderCache->Acquire(shaderName);
+	if (shaderHandle.IsValid())
+	{
+		return shaderHandle;
+	}
+	shaderHandle = m_shaderCache->AddLoading(shaderName, placeholder);
+
+	PendingShaderLoad* pendingLoad = new PendingShaderLoad();
+	pendingLoad->m_shaderName = shaderName;
+	pendingLoad->m_handle = shaderHandle;
+	m_assetPipeline->QueueLoad(
+		[this, pendingLoad]()
+		{
+			std::vector<uint8_t> shaderSource;
+			if (TryFileReadToBuffer(shaderSource, "Data/Shaders/" + pendingLoad->m_shaderName + ".hlsl") < 0)
+			{
+				return;
+			}
+			shaderSource.push_back('\0');
+			char const* sourceText = reinterpret_cast<char const*>(shaderSource.data());
+			char const* name = pendingLoad->m_shaderName.c_str();
+			pendingLoad->m_didCompile = CompileShaderToByteCode(pendingLoad->m_vertexShaderByteCode, name, sourceText, "VertexMain", "vs_5_0")
+				&& CompileShaderToByteCode(pendingLoad->m_pixelShaderByteCode, name, sourceText, "PixelMain", "ps_5_0");
+		},
+		[this, pendingLoad, vType]()
+		{
+			if (pendingLoad->m_didCompile)
+			{
+				Shader* newShader = CreateShaderObject(pendingLoad->m_shaderName.c_str(), pendingLoad->m_vertexShaderByteCode, pendingLoad->m_pixelShaderByteCode, vType);
+				m_shaderCache->FinishLoad(pendingLoad->m_handle, newShader, pendingLoad->m_vertexShaderByteCode.size() + pendingLoad->m_pixelShaderByteCode.size());
+			}
+			else
+			{
+				m_shaderCache->FinishLoad(pendingLoad->m_handle, nullptr, 0, true);
+			}
+			delete pendingLoad;
+		});
+	return shaderHandle;
+}
+
 Shader* Renderer::CreateDefaultShader()
 {
 	return CreateShader("Default", DefaultShaderByteCode, VertexType::PCU);
@@ -649,18 +877,47 @@ Shader* Renderer::CreateShader(char const* shaderName, VertexType vType)
 
 Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource, VertexType vType)
 {
-	vType;
 	std::vector<uint8_t> vertexShaderByteCode;
 	std::vector<uint8_t> pixelShaderByteCode;
+	if (!CompileShaderToByteCode(vertexShaderByteCode, shaderName, shaderSource, "VertexMain", "vs_5_0"))
+	{
+		ERROR_AND_DIE("Could not compile Vertex Shader");
+	}
+	if (!CompileShaderToByteCode(pixelShaderByteCode, shaderName, shaderSource, "PixelMain", "ps_5_0"))
+	{
+		ERROR_AND_DIE("Could not compile Pixel Shader");
+	}
+	return CreateShaderFromByteCode(shaderName, vertexShaderByteCode, pixelShaderByteCode, vType);
+}
+
+//Returns the cached shader if one with this name already exists, finishing a pending async load of it first
+Shader* Renderer::CreateShaderFromByteCode(char const* shaderName, std::vector<unsigned char> const& vertexShaderByteCode, std::vector<unsigned char> const& pixelShaderByteCode, VertexType vType)
+{
+	if (m_shaderCache->IsLoading(shaderName))
+	{
+		FinishPendingAssetLoads();
+	}
+	Shader* existingShader = nullptr;
+	if (m_shaderCache->Find(shaderName, existingShader))
+	{
+		m_shaderCache->Pin(existingShader);
+		return existingShader;
+	}
+
+	Shader* newShader = CreateShaderObject(shaderName, vertexShaderByteCode, pixelShaderByteCode, vType);
+	ShaderHandle newShaderHandle = m_shaderCache->Add(shaderName, newShader, vertexShaderByteCode.size() + pixelShaderByteCode.size());
+	m_shaderCache->Pin(newShader);
+	return newShader;
+}
+
+Shader* Renderer::CreateShaderObject(char const* shaderName, std::vector<unsigned char> const& vertexShaderByteCode, std::vector<unsigned char> const& pixelShaderByteCode, VertexType vType)
+{
+	vType;
 	ID3D11VertexShader* vertexShader = nullptr;
 	ID3D11PixelShader* pixelShader = nullptr;
 	ID3D11InputLayout* inputLayoutForVertex = nullptr;
 	HRESULT hr;
 	//Create vertex shader
-	if (!CompileShaderToByteCode(vertexShaderByteCode, shaderName, shaderSource, "VertexMain", "vs_5_0"))
-	{
-		ERROR_AND_DIE("Could not compile Vertex Shader");
-	}
 	hr = m_device->CreateVertexShader(
 		vertexShaderByteCode.data(),
 		vertexShaderByteCode.size(),
@@ -671,10 +928,6 @@ Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource,
 		ERROR_AND_DIE(Stringf("Could not create vertex shader."));
 	}
 	//Create pixel shader
-	if (!CompileShaderToByteCode(pixelShaderByteCode, shaderName, shaderSource, "PixelMain", "ps_5_0"))
-	{
-		ERROR_AND_DIE("Could not compile Pixel Shader");
-	}
 	hr = m_device->CreatePixelShader(
 		pixelShaderByteCode.data(),
 		pixelShaderByteCode.size(),
@@ -713,7 +966,6 @@ Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource,
 	makeShader->m_pixelShader = pixelShader;
 	makeShader->m_inputLayout = inputLayoutForVertex;
 
-	m_loadedShaders.push_back(makeShader);
 	return makeShader;
 }
 
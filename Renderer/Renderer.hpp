@@ -5,7 +5,11 @@
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Window/Window.hpp"
 #include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/AssetPipeline.hpp"
+#include "Engine/Core/ResourceCache.hpp"
 #include "Game/EngineBuildPreferences.hpp"
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 class Texture;
@@ -111,8 +115,16 @@ enum class VertexType
 struct RenderConfig
 {
 	Window* m_window;
+	AssetPipelineConfig m_assetPipelineConfig;
+	ResourceCacheConfig m_textureCacheConfig;
+	ResourceCacheConfig m_fontCacheConfig; //Fonts count only their own size; their textures count against the texture budget
+	ResourceCacheConfig m_shaderCacheConfig;
 };
 
+typedef ResourceHandle<Texture*> TextureHandle; //A null placeholder binds as the default white texture
+typedef ResourceHandle<BitmapFont*> BitmapFontHandle;
+typedef ResourceHandle<Shader*> ShaderHandle; //A null placeholder binds as the default shader
+
 class Renderer
 {
 public:
@@ -153,6 +165,24 @@ public:
 	BitmapFont* GetBitmapFontForFileName(const char* bitmapFontFilePathWithNoExtension);
 	BitmapFont* CreateBitmapFontFromFile(const char* bitmapFontFilePathWithNoExtension);
 
+	//Async loading: the handle comes back at once, decoding runs on g_theJobSystem and the D3D objects are created in a
+	//time-budgeted batch in BeginFrame. Asking for a pending asset through any synchronous create or CreateOrGet method finishes every pending load first.
+	TextureHandle		CreateOrGetTextureFromFileAsync(char const* imageFilePath, Texture* placeholder = nullptr);
+	BitmapFontHandle	CreateOrGetBitmapFontAsync(char const* bitmapFontFilePathWithNoExtension, BitmapFont* placeholder = nullptr);
+	ShaderHandle		CreateOrGetShaderAsync(char const* shaderName, VertexType vType = VertexType::PCU, Shader* placeholder = nullptr);
+	void				FinishPendingAssetLoads(); //Blocks until every async load has finished, e.g. at the end of a level load
+	int					GetNumPendingAssetLoads() const;
+
+	//Resource caches: textures, fonts and shaders loaded by file or name are cached by key, and stay loaded while a handle
+	//refers to them. Each synchronous call pins its resource once for the raw pointer it returns, and each Release here undoes
+	//one pin; unpinned, unreferenced resources are evicted least recently used first when their cache is over its budget.
+	void	ReleaseTexture(Texture* texture);
+	void	ReleaseBitmapFont(BitmapFont* font);
+	void	ReleaseShader(Shader* shader);
+	ResourceCache<Texture*>&	GetTextureCache() { return *m_textureCache; }
+	ResourceCache<BitmapFont*>&	GetFontCache() { return *m_fontCache; }
+	ResourceCache<Shader*>&		GetShaderCache() { return *m_shaderCache; }
+
 	//Blend Methods
 	void SetBlendMode(BlendMode blendMode);
 
@@ -173,6 +203,7 @@ public:
 	Shader* CreateDefaultShader();
 	Shader* CreateShader(char const* shaderName, VertexType vType = VertexType::PCU);
 	Shader* CreateShader(char const* shaderName, char const* shaderSource, VertexType vType = VertexType::PCU);
+	Shader* CreateShaderFromByteCode(char const* shaderName, std::vector<unsigned char> const& vertexShaderByteCode, std::vector<unsigned char> const& pixelShaderByteCode, VertexType vType = VertexType::PCU);
 	bool CompileShaderToByteCode(std::vector<unsigned char>& outByteCode, char const* name, char const* source, char const* entryPoint, char const* target);
 	void BindShader(Shader* shader);
 
@@ -196,10 +227,19 @@ private:
 	void InitializeRasterizerStates();
 	void InitializeDepthModes();
 
+	//Create objects without registering them anywhere
+	Texture* CreateTextureObject(const Image& image);
+	Shader* CreateShaderObject(char const* shaderName, std::vector<unsigned char> const& vertexShaderByteCode, std::vector<unsigned char> const& pixelShaderByteCode, VertexType vType);
+	BitmapFont* CreateBitmapFontObject(char const* bitmapFontFilePathWithNoExtension, Image const* decodedImage); //Decodes the image if it is null
+
 	RenderConfig m_renderConfig;
-	std::vector<Texture*> m_loadedTextures;
-	std::vector<BitmapFont*> m_loadedFonts;
-	std::vector<Shader*> m_loadedShaders;
+	std::vector<Texture*> m_loadedTextures; //Textures not loaded from a file, e.g. the default texture
+	ResourceCache<Texture*>* m_textureCache = nullptr;
+	ResourceCache<BitmapFont*>* m_fontCache = nullptr;
+	ResourceCache<Shader*>* m_shaderCache = nullptr;
+	std::unordered_map<BitmapFont*, TextureHandle> m_fontTextures; //Keeps each cached font's texture cached
+
+	AssetPipeline* m_assetPipeline = nullptr;
 
 	const Texture* m_defaultTexture = nullptr;
 	Shader* m_currentShader = nullptr;
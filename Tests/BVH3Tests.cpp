@@ -0,0 +1,241 @@
+#include "Engine/Tests/TestUtils.hpp"
+#include "Engine/Math/BVH3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include <algorithm>
+#include <vector>
+
+//Checks BVH3 closest-hit raycasts, any-hit raycasts and sphere and box overlap queries against brute force loops over the same
+//primitives, on random mixed scenes, both after Build and after moving every primitive and calling Refit. Then times the raycasts.
+//Off-tree: g++ -std=c++17 -O2 -pthread -I. Engine/Tests/BVH3Tests.cpp
+//	Engine/Math/*.cpp Engine/Core/Rgba8.cpp Engine/Core/StringUtils.cpp Engine/Core/ErrorWarningAssert.cpp
+//	Engine/Core/Vertex_PCU.cpp Engine/Core/VertexStream.cpp Engine/Renderer/SpriteSheet.cpp Engine/Renderer/SpriteDefinition.cpp -o BVH3Tests
+
+static int const NUM_PRIMITIVES = 3000;
+
+static Vec3 RollPointInWorld(RandomNumberGenerator& rng)
+{
+	return Vec3(rng.RollRandomFloatInRange(-200.f, 200.f), rng.RollRandomFloatInRange(-200.f, 200.f), rng.RollRandomFloatInRange(-50.f, 50.f));
+}
+
+//Each shape kind in turn, so every leaf type and mixed leaves are covered
+static void AddOrSetRandomPrimitive(BVH3& bvh, int primitiveIndex, bool isSet, RandomNumberGenerator& rng)
+{
+	Vec3 center = RollPointInWorld(rng);
+	Vec3 halfDims = Vec3(rng.RollRandomFloatInRange(0.5f, 4.f), rng.RollRandomFloatInRange(0.5f, 4.f), rng.RollRandomFloatInRange(0.5f, 4.f));
+	switch (primitiveIndex % 4)
+	{
+	case 0:
+		isSet ? bvh.SetSphere(primitiveIndex, center, halfDims.x) : (void)bvh.AddSphere(center, halfDims.x);
+		break;
+	case 1:
+		isSet ? bvh.SetAABB(primitiveIndex, AABB3(center - halfDims, center + halfDims)) : (void)bvh.AddAABB(AABB3(center - halfDims, center + halfDims));
+		break;
+	case 2:
+	{
+		Vec3 iBasis = Vec3(rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-1.f, 1.f)).GetNormalized();
+		Vec3 jBasis = CrossProduct3D(Vec3(0.f, 0.f, 1.f), iBasis).GetNormalized();
+		Vec3 kBasis = CrossProduct3D(iBasis, jBasis);
+		OBB3 box = OBB3(center, iBasis, jBasis, kBasis, halfDims);
+		isSet ? bvh.SetOBB(primitiveIndex, box) : (void)bvh.AddOBB(box);
+		break;
+	}
+	default:
+	{
+		FloatRange minMaxZ = FloatRange(center.z - halfDims.z, center.z + halfDims.z);
+		isSet ? bvh.SetZCylinder(primitiveIndex, center, halfDims.x, minMaxZ) : (void)bvh.AddZCylinder(center, halfDims.x, minMaxZ);
+		break;
+	}
+	}
+}
+
+static RaycastResult3D RaycastVsPrimitiveBrute(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, BVHPrimitive3D const& primitive)
+{
+	switch (primitive.m_shape)
+	{
+	case BVHShape3D::SPHERE:	return RaycastVsSphere3D(startPos, fwdNormal, maxDist, primitive.m_center, primitive.m_radius);
+	case BVHShape3D::AABB:		return RaycastVsAABB3D(startPos, fwdNormal, maxDist, primitive.m_box);
+	case BVHShape3D::OBB:		return RaycastVsOBB3D(startPos, fwdNormal, maxDist, primitive.m_orientedBox);
+	default:					return RaycastVsCylinderZ3D(startPos, fwdNormal, maxDist, primitive.m_center, primitive.m_minMaxZ, primitive.m_radius);
+	}
+}
+
+//Nearest hit over every primitive, lowest index on ties, the same order BVH3 reports. Like BVH3, impacts the sphere and
+//cylinder functions report behind the start are skipped.
+static int RaycastClosestBrute(BVH3 const& bvh, Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, RaycastResult3D& out_result)
+{
+	int nearestIndex = -1;
+	for (int primitiveIndex = 0; primitiveIndex < bvh.GetNumPrimitives(); primitiveIndex++)
+	{
+		RaycastResult3D result = RaycastVsPrimitiveBrute(startPos, fwdNormal, maxDist, bvh.GetPrimitive(primitiveIndex));
+		if (result.m_didImpact && result.m_impactDist >= 0.f && (nearestIndex < 0 || result.m_impactDist < out_result.m_impactDist))
+		{
+			out_result = result;
+			nearestIndex = primitiveIndex;
+		}
+	}
+	return nearestIndex;
+}
+
+static bool DoesSphereOverlapPrimitiveBrute(Vec3 const& center, float radius, BVHPrimitive3D const& primitive)
+{
+	switch (primitive.m_shape)
+	{
+	case BVHShape3D::SPHERE:	return DoSpheresOverlap3D(center, radius, primitive.m_center, primitive.m_radius);
+	case BVHShape3D::AABB:		return DoesSphereAABBOverlap3D(center, radius, primitive.m_box);
+	case BVHShape3D::OBB:		return DoesSphereOBBOverlap3D(center, radius, primitive.m_orientedBox);
+	default:					return DoesSphereZCylinderOverlap3D(center, radius, primitive.m_center, primitive.m_radius, primitive.m_minMaxZ);
+	}
+}
+
+static bool DoesAABBOverlapPrimitiveBrute(AABB3 const& box, BVHPrimitive3D const& primitive)
+{
+	switch (primitive.m_shape)
+	{
+	case BVHShape3D::SPHERE:	return DoesSphereAABBOverlap3D(primitive.m_center, primitive.m_radius, box);
+	case BVHShape3D::AABB:		return DoAABBsOverlap3D(box, primitive.m_box);
+	case BVHShape3D::OBB:		return DoesAABBOBBOverlap3D(box, primitive.m_orientedBox);
+	default:					return DoesAABBZCylinderOverlap3D(box, primitive.m_center, primitive.m_radius, primitive.m_minMaxZ);
+	}
+}
+
+static void CheckQueriesAgainstBruteForce(BVH3 const& bvh, RandomNumberGenerator& rng, char const* stage)
+{
+	int numHits = 0;
+	int numRayMismatches = 0;
+	for (int rayIndex = 0; rayIndex < 3000; rayIndex++)
+	{
+		Vec3 startPos = RollPointInWorld(rng) * 1.1f;
+		Vec3 fwdNormal = Vec3(rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-0.3f, 0.3f)).GetNormalized();
+		if (rayIndex % 97 == 0)
+		{
+			fwdNormal = Vec3(1.f, 0.f, 0.f); //Axis-aligned rays hit the zero-direction slab case in the node tests
+		}
+		float maxDist = rng.RollRandomFloatInRange(20.f, 300.f);
+
+		RaycastResult3D bruteResult;
+		int bruteIndex = RaycastClosestBrute(bvh, startPos, fwdNormal, maxDist, bruteResult);
+		int bvhIndex = -2;
+		RaycastResult3D bvhResult = bvh.RaycastClosest(startPos, fwdNormal, maxDist, &bvhIndex);
+		bool isSame = bvhIndex == bruteIndex && bvhResult.m_didImpact == (bruteIndex >= 0) && (bruteIndex < 0 || bvhResult.m_impactDist == bruteResult.m_impactDist);
+		numRayMismatches += isSame ? 0 : 1;
+		numHits += bruteIndex >= 0 ? 1 : 0;
+		TEST_CHECK(isSame, "RaycastClosest differs from the brute force nearest hit");
+		TEST_CHECK(bvh.RaycastAny(startPos, fwdNormal, maxDist) == (bruteIndex >= 0), "RaycastAny differs from the brute force nearest hit");
+	}
+
+	int numQueryMismatches = 0;
+	for (int queryIndex = 0; queryIndex < 500; queryIndex++)
+	{
+		Vec3 center = RollPointInWorld(rng);
+		float radius = rng.RollRandomFloatInRange(1.f, 20.f);
+		AABB3 box = AABB3(center - Vec3(radius, radius, radius * 0.5f), center + Vec3(radius, radius, radius * 0.5f));
+		std::vector<int> bvhSphereIndexes;
+		std::vector<int> bvhBoxIndexes;
+		bvh.QuerySphere(center, radius, bvhSphereIndexes);
+		bvh.QueryAABB(box, bvhBoxIndexes);
+		std::sort(bvhSphereIndexes.begin(), bvhSphereIndexes.end());
+		std::sort(bvhBoxIndexes.begin(), bvhBoxIndexes.end());
+
+		std::vector<int> bruteSphereIndexes;
+		std::vector<int> bruteBoxIndexes;
+		for (int primitiveIndex = 0; primitiveIndex < bvh.GetNumPrimitives(); primitiveIndex++)
+		{
+			if (DoesSphereOverlapPrimitiveBrute(center, radius, bvh.GetPrimitive(primitiveIndex)))
+			{
+				bruteSphereIndexes.push_back(primitiveIndex);
+			}
+			if (DoesAABBOverlapPrimitiveBrute(box, bvh.GetPrimitive(primitiveIndex)))
+			{
+				bruteBoxIndexes.push_back(primitiveIndex);
+			}
+		}
+		bool isSame = bvhSphereIndexes == bruteSphereIndexes && bvhBoxIndexes == bruteBoxIndexes;
+		numQueryMismatches += isSame ? 0 : 1;
+		TEST_CHECK(bvhSphereIndexes == bruteSphereIndexes, "QuerySphere differs from the brute force overlap set");
+		TEST_CHECK(bvhBoxIndexes == bruteBoxIndexes, "QueryAABB differs from the brute force overlap set");
+	}
+	printf("%s: 3000 rays (%d hits), %d ray mismatches; 500 sphere and box queries, %d mismatches\n", stage, numHits, numRayMismatches, numQueryMismatches);
+}
+
+//Moves every primitive a few units, as a frame of object movement would, keeping its shape
+static void NudgeAllPrimitives(BVH3& bvh, RandomNumberGenerator& rng)
+{
+	for (int primitiveIndex = 0; primitiveIndex < bvh.GetNumPrimitives(); primitiveIndex++)
+	{
+		BVHPrimitive3D primitive = bvh.GetPrimitive(primitiveIndex);
+		Vec3 offset = Vec3(rng.RollRandomFloatInRange(-3.f, 3.f), rng.RollRandomFloatInRange(-3.f, 3.f), rng.RollRandomFloatInRange(-1.f, 1.f));
+		switch (primitive.m_shape)
+		{
+		case BVHShape3D::SPHERE:
+			bvh.SetSphere(primitiveIndex, primitive.m_center + offset, primitive.m_radius);
+			break;
+		case BVHShape3D::AABB:
+			bvh.SetAABB(primitiveIndex, AABB3(primitive.m_box.m_mins + offset, primitive.m_box.m_maxs + offset));
+			break;
+		case BVHShape3D::OBB:
+			primitive.m_orientedBox.m_center += offset;
+			bvh.SetOBB(primitiveIndex, primitive.m_orientedBox);
+			break;
+		default:
+			bvh.SetZCylinder(primitiveIndex, primitive.m_center + offset, primitive.m_radius, FloatRange(primitive.m_minMaxZ.m_min + offset.z, primitive.m_minMaxZ.m_max + offset.z));
+			break;
+		}
+	}
+}
+
+int main()
+{
+	RandomNumberGenerator rng;
+	BVH3 bvh;
+	for (int primitiveIndex = 0; primitiveIndex < NUM_PRIMITIVES; primitiveIndex++)
+	{
+		AddOrSetRandomPrimitive(bvh, primitiveIndex, false, rng);
+	}
+	bvh.Build();
+	printf("%d primitives, %d nodes\n", bvh.GetNumPrimitives(), bvh.GetNumNodes());
+	CheckQueriesAgainstBruteForce(bvh, rng, "After Build");
+
+	//Small moves keep the tree shape; a full reshuffle makes the refit bounds large and overlapping, which must still be correct
+	NudgeAllPrimitives(bvh, rng);
+	bvh.Refit();
+	CheckQueriesAgainstBruteForce(bvh, rng, "After a small move and Refit");
+	for (int primitiveIndex = 0; primitiveIndex < NUM_PRIMITIVES; primitiveIndex++)
+	{
+		AddOrSetRandomPrimitive(bvh, primitiveIndex, true, rng);
+	}
+	bvh.Refit();
+	CheckQueriesAgainstBruteForce(bvh, rng, "After a full reshuffle and Refit");
+	bvh.Build();
+	CheckQueriesAgainstBruteForce(bvh, rng, "After rebuilding");
+
+	//Benchmark: closest-hit raycasts through the tree against the brute force loop
+	std::vector<Vec3> startPositions;
+	std::vector<Vec3> fwdNormals;
+	for (int rayIndex = 0; rayIndex < 2000; rayIndex++)
+	{
+		startPositions.push_back(RollPointInWorld(rng));
+		fwdNormals.push_back(Vec3(rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-0.3f, 0.3f)).GetNormalized());
+	}
+	float checksum = 0.f;
+	double bruteMs = TimeBestOfMs(3, [&]()
+	{
+		for (int rayIndex = 0; rayIndex < static_cast<int>(startPositions.size()); rayIndex++)
+		{
+			RaycastResult3D result;
+			checksum += (float)RaycastClosestBrute(bvh, startPositions[rayIndex], fwdNormals[rayIndex], 150.f, result);
+		}
+	});
+	double bvhMs = TimeBestOfMs(3, [&]()
+	{
+		for (int rayIndex = 0; rayIndex < static_cast<int>(startPositions.size()); rayIndex++)
+		{
+			int hitIndex = -1;
+			bvh.RaycastClosest(startPositions[rayIndex], fwdNormals[rayIndex], 150.f, &hitIndex);
+			checksum += (float)hitIndex;
+		}
+	});
+	printf("2000 closest-hit rays of length 150 (checksum %g)\n", checksum);
+	ReportBenchmark("BVH3::RaycastClosest", bruteMs, bvhMs);
+	return ReportTestResults("BVH3Tests");
+}
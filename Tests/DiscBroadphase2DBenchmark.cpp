@@ -0,0 +1,193 @@
+#include "Engine/Tests/TestUtils.hpp"
+#include "Engine/Math/DiscBroadphase2D.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+//Scaling of DiscBroadphase2D against the O(n^2) loop games used to write, at constant disc density.
+//Each frame moves every disc then runs one resolve pass. Also checks the overlapping pairs against brute force.
+//Off-tree: g++ -std=c++17 -O2 -pthread -I. Engine/Tests/DiscBroadphase2DBenchmark.cpp
+//	Engine/Math/*.cpp Engine/Core/Rgba8.cpp Engine/Core/StringUtils.cpp Engine/Core/ErrorWarningAssert.cpp
+//	Engine/Core/Vertex_PCU.cpp Engine/Core/VertexStream.cpp Engine/Renderer/SpriteSheet.cpp Engine/Renderer/SpriteDefinition.cpp -o DiscBroadphase2DBenchmark
+
+struct BenchDisc
+{
+	Vec2 m_center;
+	Vec2 m_velocity;
+	float m_radius = 0.5f;
+};
+
+static std::vector<BenchDisc> MakeDiscs(int numDiscs, float worldSize, RandomNumberGenerator& rng)
+{
+	std::vector<BenchDisc> discs(numDiscs);
+	for (BenchDisc& disc : discs)
+	{
+		disc.m_center = Vec2(rng.RollRandomFloatInRange(0.f, worldSize), rng.RollRandomFloatInRange(0.f, worldSize));
+		disc.m_velocity = Vec2(rng.RollRandomFloatInRange(-0.1f, 0.1f), rng.RollRandomFloatInRange(-0.1f, 0.1f));
+		disc.m_radius = rng.RollRandomFloatInRange(0.3f, 0.7f);
+	}
+	return discs;
+}
+
+static Vec2 GetWrappedMove(Vec2 const& center, Vec2 const& velocity, float worldSize)
+{
+	Vec2 newCenter = center + velocity;
+	newCenter.x = newCenter.x < 0.f ? newCenter.x + worldSize : (newCenter.x > worldSize ? newCenter.x - worldSize : newCenter.x);
+	newCenter.y = newCenter.y < 0.f ? newCenter.y + worldSize : (newCenter.y > worldSize ? newCenter.y - worldSize : newCenter.y);
+	return newCenter;
+}
+
+static void BruteForceResolve(std::vector<BenchDisc>& discs)
+{
+	for (int discA = 0; discA < static_cast<int>(discs.size()); discA++)
+	{
+		for (int discB = discA + 1; discB < static_cast<int>(discs.size()); discB++)
+		{
+			PushDiscsOutOfEachOther2D(discs[discA].m_center, discs[discA].m_radius, discs[discB].m_center, discs[discB].m_radius);
+		}
+	}
+}
+
+static void CheckPairsAgainstBruteForce(RandomNumberGenerator& rng)
+{
+	float worldSize = 40.f;
+	std::vector<BenchDisc> discs = MakeDiscs(1000, worldSize, rng);
+	DiscBroadphase2D broadphase;
+	std::vector<int> discIDs;
+	for (BenchDisc const& disc : discs)
+	{
+		discIDs.push_back(broadphase.AddDisc(disc.m_center, disc.m_radius));
+	}
+
+	std::vector<DiscPair2D> pairs;
+	for (int frame = 0; frame < 20; frame++)
+	{
+		for (int discIndex = 0; discIndex < static_cast<int>(discs.size()); discIndex++)
+		{
+			discs[discIndex].m_center = GetWrappedMove(discs[discIndex].m_center, discs[discIndex].m_velocity * 10.f, worldSize);
+			broadphase.MoveDisc(discIDs[discIndex], discs[discIndex].m_center);
+		}
+
+		pairs.clear();
+		broadphase.GetOverlappingPairs(pairs);
+		std::vector<long long> foundPairs;
+		for (DiscPair2D const& pair : pairs)
+		{
+			long long low = std::min(pair.m_discA, pair.m_discB);
+			long long high = std::max(pair.m_discA, pair.m_discB);
+			foundPairs.push_back(low * 100000 + high);
+		}
+		std::sort(foundPairs.begin(), foundPairs.end());
+
+		std::vector<long long> expectedPairs;
+		for (int discA = 0; discA < static_cast<int>(discs.size()); discA++)
+		{
+			for (int discB = discA + 1; discB < static_cast<int>(discs.size()); discB++)
+			{
+				if (DoDiscsOverlap2D(discs[discA].m_center, discs[discA].m_radius, discs[discB].m_center, discs[discB].m_radius))
+				{
+					long long low = std::min(discIDs[discA], discIDs[discB]);
+					long long high = std::max(discIDs[discA], discIDs[discB]);
+					expectedPairs.push_back(low * 100000 + high);
+				}
+			}
+		}
+		std::sort(expectedPairs.begin(), expectedPairs.end());
+		TEST_CHECK(foundPairs == expectedPairs, "GetOverlappingPairs differs from the brute force pair set");
+	}
+}
+
+//Discs that wander over a large world must not leave the cells they passed through behind
+static void CheckCellsFollowDiscs(RandomNumberGenerator& rng)
+{
+	DiscBroadphase2D broadphase;
+	std::vector<int> discIDs;
+	for (int discIndex = 0; discIndex < 200; discIndex++)
+	{
+		discIDs.push_back(broadphase.AddDisc(Vec2(rng.RollRandomFloatInRange(0.f, 20.f), rng.RollRandomFloatInRange(0.f, 20.f)), 0.5f));
+	}
+	int boxID = broadphase.AddStaticBox(AABB2(0.f, 0.f, 10.f, 10.f));
+	int maxOccupiedCells = 0;
+	for (int frame = 0; frame < 500; frame++)
+	{
+		for (int discID : discIDs)
+		{
+			broadphase.MoveDisc(discID, broadphase.GetDiscCenter(discID) + Vec2(rng.RollRandomFloatInRange(-1.f, 3.f), rng.RollRandomFloatInRange(-1.f, 3.f)));
+		}
+		maxOccupiedCells = std::max(maxOccupiedCells, broadphase.GetNumOccupiedCells());
+	}
+	TEST_CHECK(maxOccupiedCells <= 200 * 4 + 36, "Occupied cells grew past what the discs and box cover");
+
+	broadphase.RemoveStaticBox(boxID);
+	for (int discID : discIDs)
+	{
+		broadphase.RemoveDisc(discID);
+	}
+	TEST_CHECK(broadphase.GetNumOccupiedCells() == 0, "Cells outlived every disc and box in them");
+}
+
+int main()
+{
+	RandomNumberGenerator rng;
+	CheckPairsAgainstBruteForce(rng);
+	CheckCellsFollowDiscs(rng);
+
+	int const numFrames = 10;
+	int const discCounts[] = { 1000, 5000, 10000, 40000 };
+	printf("%8s %18s %22s\n", "discs", "grid ms/frame", "brute force ms/frame");
+	for (int numDiscs : discCounts)
+	{
+		//About one disc per 4 square units at every size
+		float worldSize = 2.f * sqrtf((float)numDiscs);
+		std::vector<BenchDisc> discs = MakeDiscs(numDiscs, worldSize, rng);
+
+		DiscBroadphase2D broadphase;
+		std::vector<int> discIDs;
+		for (BenchDisc const& disc : discs)
+		{
+			discIDs.push_back(broadphase.AddDisc(disc.m_center, disc.m_radius));
+		}
+		double gridMs = TimeBestOfMs(3, [&]()
+		{
+			for (int frame = 0; frame < numFrames; frame++)
+			{
+				for (int discIndex = 0; discIndex < numDiscs; discIndex++)
+				{
+					int discID = discIDs[discIndex];
+					broadphase.MoveDisc(discID, GetWrappedMove(broadphase.GetDiscCenter(discID), discs[discIndex].m_velocity, worldSize));
+				}
+				broadphase.ResolveCollisions(1);
+			}
+		}) / numFrames;
+
+		//The quadratic loop is skipped where it would take minutes
+		double bruteMs = 0.0;
+		if (numDiscs <= 10000)
+		{
+			std::vector<BenchDisc> bruteDiscs = discs;
+			bruteMs = TimeBestOfMs(1, [&]()
+			{
+				for (int frame = 0; frame < 2; frame++)
+				{
+					for (BenchDisc& disc : bruteDiscs)
+					{
+						disc.m_center = GetWrappedMove(disc.m_center, disc.m_velocity, worldSize);
+					}
+					BruteForceResolve(bruteDiscs);
+				}
+			}) / 2.0;
+		}
+
+		if (bruteMs > 0.0)
+		{
+			printf("%8d %18.3f %22.3f\n", numDiscs, gridMs, bruteMs);
+		}
+		else
+		{
+			printf("%8d %18.3f %22s\n", numDiscs, gridMs, "-");
+		}
+	}
+	return ReportTestResults("DiscBroadphase2DBenchmark");
+}
@@ -0,0 +1,133 @@
+#include "Engine/Tests/TestUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//Fire cost of the hashed EventSystem against the std::map<std::string, SubscriptionList> dispatch it replaced, plus EventID checks.
+//Off-tree: g++ -std=c++17 -O2 -pthread -I. Engine/Tests/EventSystemBenchmark.cpp
+//	Engine/Math/*.cpp Engine/Core/Rgba8.cpp Engine/Core/StringUtils.cpp Engine/Core/ErrorWarningAssert.cpp
+//	Engine/Core/Vertex_PCU.cpp Engine/Core/VertexStream.cpp Engine/Renderer/SpriteSheet.cpp Engine/Renderer/SpriteDefinition.cpp
+//	Engine/Core/EngineCommon.cpp Engine/Core/EventSystem.cpp Engine/Core/EventID.cpp Engine/Core/JobSystem.cpp
+//	Engine/Core/NamedStrings.cpp Engine/Core/XmlUtils.cpp Engine/Core/Clock.cpp Engine/Core/Time.cpp Engine/ThirdParty/TinyXML2/tinyxml2.cpp -o EventSystemBenchmark
+
+static_assert(EventID("KeyPressed").m_hash == HashEventName("KeyPressed", 10), "Literal EventIDs must hash at compile time");
+static_assert(std::is_constructible<EventID, char const (&)[11]>::value, "Literals must convert to EventID");
+static_assert(!std::is_constructible<EventID, char (&)[11]>::value, "Mutable buffers must not convert to EventID");
+
+//The old dispatch, kept here as the baseline: a string keyed map lookup on every fire
+class LegacyEventSystem
+{
+public:
+	void SubscribeEventCallbackFunction(std::string const& eventName, EventCallbackFunction* functionPtr)
+	{
+		m_subscriptionListsByEventName[eventName].push_back(functionPtr);
+	}
+
+	void FireEvent(std::string const& eventName, EventArgs& args)
+	{
+		std::map<std::string, std::vector<EventCallbackFunction*>>::iterator found = m_subscriptionListsByEventName.find(eventName);
+		if (found == m_subscriptionListsByEventName.end())
+		{
+			return;
+		}
+		for (EventCallbackFunction* functionPtr : found->second)
+		{
+			if (functionPtr(args))
+			{
+				break;
+			}
+		}
+	}
+
+protected:
+	std::map<std::string, std::vector<EventCallbackFunction*>> m_subscriptionListsByEventName;
+};
+
+static int s_numCallbacks = 0;
+
+static bool CountCallback(EventArgs& args)
+{
+	(void)args;
+	s_numCallbacks++;
+	return false;
+}
+
+static void CheckEventIDs(EventSystem& eventSystem)
+{
+	//A name that came from a buffer must survive the buffer once subscribed
+	char nameBuffer[32] = "buffered_event";
+	eventSystem.SubscribeEventCallbackFunction(std::string(nameBuffer), CountCallback);
+	nameBuffer[0] = 'X';
+	EventID storedID = EventID(std::string("buffered_event"));
+	TEST_CHECK(std::string(storedID.GetName()) == "buffered_event", "Interned event name changed with the buffer it came from");
+	TEST_CHECK(EventID("buffered_event") == storedID, "Literal and string EventIDs of the same name differ");
+
+	s_numCallbacks = 0;
+	eventSystem.FireEvent("buffered_event");
+	TEST_CHECK(s_numCallbacks == 1, "Literal fire missed a std::string subscription");
+
+	//A removal made before the table grows must stay removed after it
+	EventSystemConfig smallConfig;
+	smallConfig.m_initialEventCapacity = 2;
+	EventSystem smallSystem(smallConfig);
+	smallSystem.Startup();
+	smallSystem.SubscribeEventCallbackFunction("grow_a", CountCallback);
+	int subscriptionID = smallSystem.AddSubscription(EventID("grow_b"), EventCallback(CountCallback));
+	smallSystem.RemoveSubscription(EventID("grow_b"), subscriptionID);
+	for (int eventIndex = 0; eventIndex < 16; eventIndex++)
+	{
+		smallSystem.SubscribeEventCallbackFunction(std::string("grow_extra_") + std::to_string(eventIndex), CountCallback);
+	}
+	s_numCallbacks = 0;
+	smallSystem.FireEvent("grow_b");
+	TEST_CHECK(s_numCallbacks == 0, "Removed subscription fired after the table grew");
+	smallSystem.Shutdown();
+}
+
+int main()
+{
+	//The engine's own instance from EngineCommon, so the global FireEvent helpers reach it too
+	EventSystem& eventSystem = *g_theEventSystem;
+	eventSystem.Startup();
+	CheckEventIDs(eventSystem);
+
+	LegacyEventSystem legacySystem;
+	std::vector<std::string> eventNames;
+	for (int eventIndex = 0; eventIndex < 20; eventIndex++)
+	{
+		eventNames.push_back(std::string("bench_event_") + std::to_string(eventIndex));
+	}
+	eventNames.push_back("KeyPressed");
+	eventNames.push_back("debug_toggle");
+	for (std::string const& eventName : eventNames)
+	{
+		for (int subscriberIndex = 0; subscriberIndex < 2; subscriberIndex++)
+		{
+			legacySystem.SubscribeEventCallbackFunction(eventName, CountCallback);
+			eventSystem.SubscribeEventCallbackFunction(eventName, CountCallback);
+		}
+	}
+
+	int const numFires = 2000000;
+	EventArgs args;
+	std::string variableName = "bench_event_7";
+
+	double legacyLiteralMs = TimeBestOfMs(3, [&]() { for (int fireIndex = 0; fireIndex < numFires; fireIndex++) legacySystem.FireEvent("KeyPressed", args); });
+	double hashedLiteralMs = TimeBestOfMs(3, [&]() { for (int fireIndex = 0; fireIndex < numFires; fireIndex++) eventSystem.FireEvent("KeyPressed", args); });
+	double legacyStringMs = TimeBestOfMs(3, [&]() { for (int fireIndex = 0; fireIndex < numFires; fireIndex++) legacySystem.FireEvent(variableName, args); });
+	double hashedStringMs = TimeBestOfMs(3, [&]() { for (int fireIndex = 0; fireIndex < numFires; fireIndex++) eventSystem.FireEvent(variableName, args); });
+	static constexpr EventID s_debugToggleID = EventID("debug_toggle");
+	double legacyIDMs = TimeBestOfMs(3, [&]() { for (int fireIndex = 0; fireIndex < numFires; fireIndex++) legacySystem.FireEvent("debug_toggle", args); });
+	double hashedIDMs = TimeBestOfMs(3, [&]() { for (int fireIndex = 0; fireIndex < numFires; fireIndex++) eventSystem.FireEvent(s_debugToggleID, args); });
+
+	printf("%d fires per case, %d events with 2 subscribers each (%d callbacks run)\n", numFires, static_cast<int>(eventNames.size()), s_numCallbacks);
+	ReportBenchmark("Literal \"KeyPressed\"", legacyLiteralMs, hashedLiteralMs);
+	ReportBenchmark("std::string variable", legacyStringMs, hashedStringMs);
+	ReportBenchmark("constexpr EventID \"debug_toggle\"", legacyIDMs, hashedIDMs);
+
+	eventSystem.Shutdown();
+	return ReportTestResults("EventSystemBenchmark");
+}
@@ -0,0 +1,91 @@
+#include "Engine/Tests/TestUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+//Scaling of JobSystem across thread counts: ParallelFor over a compute-bound range against a plain loop, and kick plus wait
+//overhead per empty job. Results are checked against the serial loop at every thread count.
+//Off-tree: g++ -std=c++17 -O2 -pthread -I. Engine/Tests/JobSystemBenchmark.cpp
+//	Engine/Math/*.cpp Engine/Core/Rgba8.cpp Engine/Core/StringUtils.cpp Engine/Core/ErrorWarningAssert.cpp
+//	Engine/Core/Vertex_PCU.cpp Engine/Core/VertexStream.cpp Engine/Renderer/SpriteSheet.cpp Engine/Renderer/SpriteDefinition.cpp
+//	Engine/Core/EngineCommon.cpp Engine/Core/EventSystem.cpp Engine/Core/EventID.cpp Engine/Core/JobSystem.cpp
+//	Engine/Core/NamedStrings.cpp Engine/Core/XmlUtils.cpp Engine/Core/Clock.cpp Engine/Core/Time.cpp Engine/ThirdParty/TinyXML2/tinyxml2.cpp -o JobSystemBenchmark
+
+static float GetWorkForIndex(int index)
+{
+	float value = static_cast<float>(index);
+	for (int step = 0; step < 32; step++)
+	{
+		value = sqrtf(value * 1.0001f + static_cast<float>(step));
+	}
+	return value;
+}
+
+int main()
+{
+	int const numItems = 1000000;
+	int const numEmptyJobs = 100000;
+	std::vector<float> serialResults(numItems);
+	std::vector<float> parallelResults(numItems);
+
+	double serialMs = TimeBestOfMs(3, [&]()
+	{
+		for (int index = 0; index < numItems; index++)
+		{
+			serialResults[index] = GetWorkForIndex(index);
+		}
+	});
+
+	int numHardwareThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+	int maxThreads = std::max(numHardwareThreads, 4);
+	printf("%d hardware threads; ParallelFor over %d items, serial loop %.3f ms\n", numHardwareThreads, numItems, serialMs);
+	printf("%8s %16s %10s %22s\n", "threads", "ParallelFor ms", "speedup", "kick + wait ns/job");
+	for (int numThreads = 1; numThreads <= maxThreads; numThreads++)
+	{
+		JobSystemConfig config;
+		config.m_numWorkerThreads = numThreads - 1;
+		JobSystem jobSystem(config);
+		jobSystem.Startup();
+		g_theJobSystem = &jobSystem;
+
+		std::fill(parallelResults.begin(), parallelResults.end(), 0.f);
+		double parallelMs = TimeBestOfMs(3, [&]()
+		{
+			jobSystem.ParallelFor(0, numItems, [&](int index) { parallelResults[index] = GetWorkForIndex(index); });
+		});
+		TEST_CHECK(parallelResults == serialResults, "ParallelFor results differ from the serial loop");
+
+		std::atomic<int> numJobsRun = 0;
+		double kickMs = TimeBestOfMs(3, [&]()
+		{
+			JobCounter counter;
+			for (int jobIndex = 0; jobIndex < numEmptyJobs; jobIndex++)
+			{
+				jobSystem.KickJob([&numJobsRun]() { numJobsRun.fetch_add(1, std::memory_order_relaxed); }, &counter);
+			}
+			jobSystem.WaitForCounter(counter);
+		});
+		TEST_CHECK(numJobsRun.load() == numEmptyJobs * 3, "Not every kicked job ran");
+
+		//A dependent job must see everything its dependency counter covered
+		JobCounter firstCounter;
+		JobCounter secondCounter;
+		std::atomic<int> numFirstJobsDone = 0;
+		int numFirstJobsSeen = -1;
+		for (int jobIndex = 0; jobIndex < 64; jobIndex++)
+		{
+			jobSystem.KickJob([&numFirstJobsDone]() { numFirstJobsDone.fetch_add(1); }, &firstCounter);
+		}
+		jobSystem.KickJob([&]() { numFirstJobsSeen = numFirstJobsDone.load(); }, &secondCounter, &firstCounter);
+		jobSystem.WaitForCounter(secondCounter);
+		TEST_CHECK(numFirstJobsSeen == 64, "Dependent job ran before its dependency finished");
+
+		g_theJobSystem = nullptr;
+		jobSystem.Shutdown();
+		printf("%8d %16.3f %9.2fx %22.1f\n", numThreads, parallelMs, serialMs / parallelMs, kickMs * 1000000.0 / numEmptyJobs);
+	}
+	printf("Thread counts beyond the hardware threads only measure oversubscription\n");
+	return ReportTestResults("JobSystemBenchmark");
+}
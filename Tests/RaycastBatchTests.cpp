@@ -0,0 +1,213 @@
+#include "Engine/Tests/TestUtils.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/OBB3.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <vector>
+
+//Checks the batched SIMD ray vs box kernels against the single-shape scalar functions, then times both.
+//Off-tree: g++ -std=c++17 -O2 -pthread -I. Engine/Tests/RaycastBatchTests.cpp
+//	Engine/Math/*.cpp Engine/Core/Rgba8.cpp Engine/Core/StringUtils.cpp Engine/Core/ErrorWarningAssert.cpp
+//	Engine/Core/Vertex_PCU.cpp Engine/Core/VertexStream.cpp Engine/Renderer/SpriteSheet.cpp Engine/Renderer/SpriteDefinition.cpp -o RaycastBatchTests
+
+struct ScalarNearestHit
+{
+	RaycastResult3D m_result;
+	int m_index = -1;
+};
+
+//The loop the batch functions replace: every shape through the scalar test, nearest hit wins, earlier shape on ties
+template<typename Shape, typename RaycastFunction>
+ScalarNearestHit RaycastNearestScalar(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, std::vector<Shape> const& shapes, RaycastFunction const& raycast)
+{
+	ScalarNearestHit nearest;
+	nearest.m_result.m_impactDist = maxDist;
+	for (int shapeIndex = 0; shapeIndex < static_cast<int>(shapes.size()); shapeIndex++)
+	{
+		RaycastResult3D result = raycast(startPos, fwdNormal, maxDist, shapes[shapeIndex]);
+		if (result.m_didImpact && (nearest.m_index < 0 || result.m_impactDist < nearest.m_result.m_impactDist))
+		{
+			nearest.m_result = result;
+			nearest.m_index = shapeIndex;
+		}
+	}
+	return nearest;
+}
+
+//Starts on integer and half-integer grid points, so many lie exactly on box faces, heading along axes and face diagonals.
+//Every direction has at least one zero component, so the parallel slab case (0 / 0 on a face) is hit constantly.
+static void AddGridRays(RaycastBatch3D& rays)
+{
+	std::vector<Vec3> directions;
+	for (int x = -1; x <= 1; x++)
+	{
+		for (int y = -1; y <= 1; y++)
+		{
+			for (int z = -1; z <= 1; z++)
+			{
+				int numZeros = (x == 0) + (y == 0) + (z == 0);
+				if (numZeros == 1 || numZeros == 2)
+				{
+					directions.push_back(Vec3((float)x, (float)y, (float)z).GetNormalized());
+				}
+			}
+		}
+	}
+
+	for (int x = -6; x <= 6; x++)
+	{
+		for (int y = -6; y <= 6; y++)
+		{
+			for (int z = -6; z <= 6; z++)
+			{
+				Vec3 startPos = Vec3((float)x, (float)y, (float)z) * 0.5f;
+				for (int dirIndex = 0; dirIndex < static_cast<int>(directions.size()); dirIndex++)
+				{
+					rays.AddRay(startPos, directions[dirIndex], 8.f);
+				}
+			}
+		}
+	}
+}
+
+//Unit boxes on the grid plus a few flat ones, nine in total so both the four-wide loop and the scalar tail run
+static void AddGridBoxes(std::vector<AABB3>& aabbs, std::vector<OBB3>& obbs)
+{
+	aabbs.push_back(AABB3(0.f, 0.f, 0.f, 1.f, 1.f, 1.f));
+	aabbs.push_back(AABB3(-2.f, -1.f, 0.f, -1.f, 0.f, 1.f));
+	aabbs.push_back(AABB3(1.f, -2.f, -1.f, 2.f, 0.f, 1.f));
+	aabbs.push_back(AABB3(-1.f, 1.f, -2.f, 1.f, 2.f, -1.f));
+	aabbs.push_back(AABB3(-3.f, -3.f, -3.f, 3.f, -2.f, 3.f));
+	aabbs.push_back(AABB3(0.f, 0.f, 2.f, 0.f, 1.f, 3.f));
+	aabbs.push_back(AABB3(-2.f, 2.f, 1.f, 2.f, 2.f, 2.f));
+	aabbs.push_back(AABB3(2.f, 2.f, -2.f, 3.f, 3.f, -1.f));
+	aabbs.push_back(AABB3(-0.5f, -0.5f, -0.5f, 0.5f, 0.5f, 0.5f));
+
+	for (int boxIndex = 0; boxIndex < static_cast<int>(aabbs.size()); boxIndex++)
+	{
+		AABB3 const& box = aabbs[boxIndex];
+		Vec3 center = (box.m_mins + box.m_maxs) * 0.5f;
+		Vec3 halfDims = (box.m_maxs - box.m_mins) * 0.5f;
+		if (boxIndex % 2 == 0)
+		{
+			obbs.push_back(OBB3(center, Vec3(1.f, 0.f, 0.f), Vec3(0.f, 1.f, 0.f), Vec3(0.f, 0.f, 1.f), halfDims));
+		}
+		else
+		{
+			//Same box turned a quarter about Z, so the faces still sit on the grid
+			obbs.push_back(OBB3(center, Vec3(0.f, 1.f, 0.f), Vec3(-1.f, 0.f, 0.f), Vec3(0.f, 0.f, 1.f), Vec3(halfDims.y, halfDims.x, halfDims.z)));
+		}
+	}
+}
+
+static bool AreSameHit(RaycastResult3D const& batched, int batchedIndex, ScalarNearestHit const& scalar)
+{
+	if (batchedIndex != scalar.m_index || batched.m_didImpact != scalar.m_result.m_didImpact)
+	{
+		return false;
+	}
+	return !batched.m_didImpact || batched.m_impactDist == scalar.m_result.m_impactDist;
+}
+
+int main()
+{
+	RaycastBatch3D rays;
+	AddGridRays(rays);
+	std::vector<AABB3> aabbs;
+	std::vector<OBB3> obbs;
+	AddGridBoxes(aabbs, obbs);
+
+	AABB3Batch3D aabbBatch;
+	OBB3Batch3D obbBatch;
+	for (int boxIndex = 0; boxIndex < static_cast<int>(aabbs.size()); boxIndex++)
+	{
+		aabbBatch.AddBox(aabbs[boxIndex]);
+		obbBatch.AddBox(obbs[boxIndex]);
+	}
+
+	std::vector<RaycastResult3D> results;
+	std::vector<int> hitIndexes;
+	int numRays = rays.GetNumRays();
+	int numAABBMismatches = 0;
+	int numOBBMismatches = 0;
+
+	RaycastVsAABBs3D(rays, aabbBatch, results, &hitIndexes);
+	for (int rayIndex = 0; rayIndex < numRays; rayIndex++)
+	{
+		Vec3 startPos = Vec3(rays.m_startX[rayIndex], rays.m_startY[rayIndex], rays.m_startZ[rayIndex]);
+		Vec3 fwdNormal = Vec3(rays.m_fwdX[rayIndex], rays.m_fwdY[rayIndex], rays.m_fwdZ[rayIndex]);
+		ScalarNearestHit scalar = RaycastNearestScalar(startPos, fwdNormal, rays.m_maxDist[rayIndex], aabbs, RaycastVsAABB3D);
+		bool isSame = AreSameHit(results[rayIndex], hitIndexes[rayIndex], scalar);
+		numAABBMismatches += isSame ? 0 : 1;
+		TEST_CHECK(isSame, "RaycastVsAABBs3D differs from the scalar RaycastVsAABB3D loop");
+	}
+
+	RaycastVsOBBs3D(rays, obbBatch, results, &hitIndexes);
+	for (int rayIndex = 0; rayIndex < numRays; rayIndex++)
+	{
+		Vec3 startPos = Vec3(rays.m_startX[rayIndex], rays.m_startY[rayIndex], rays.m_startZ[rayIndex]);
+		Vec3 fwdNormal = Vec3(rays.m_fwdX[rayIndex], rays.m_fwdY[rayIndex], rays.m_fwdZ[rayIndex]);
+		ScalarNearestHit scalar = RaycastNearestScalar(startPos, fwdNormal, rays.m_maxDist[rayIndex], obbs, RaycastVsOBB3D);
+		bool isSame = AreSameHit(results[rayIndex], hitIndexes[rayIndex], scalar);
+		numOBBMismatches += isSame ? 0 : 1;
+		TEST_CHECK(isSame, "RaycastVsOBBs3D differs from the scalar RaycastVsOBB3D loop");
+	}
+	printf("%d grid rays: %d AABB mismatches, %d OBB mismatches\n", numRays, numAABBMismatches, numOBBMismatches);
+
+	//Benchmark: the same rays against a larger field of boxes
+	std::vector<AABB3> benchAABBs;
+	std::vector<OBB3> benchOBBs;
+	for (int copyIndex = 0; copyIndex < 8; copyIndex++)
+	{
+		Vec3 offset = Vec3(7.f * (float)copyIndex, 0.f, 0.f);
+		for (int boxIndex = 0; boxIndex < static_cast<int>(aabbs.size()); boxIndex++)
+		{
+			benchAABBs.push_back(AABB3(aabbs[boxIndex].m_mins + offset, aabbs[boxIndex].m_maxs + offset));
+			OBB3 box = obbs[boxIndex];
+			box.m_center += offset;
+			benchOBBs.push_back(box);
+		}
+	}
+	AABB3Batch3D benchAABBBatch;
+	OBB3Batch3D benchOBBBatch;
+	for (int boxIndex = 0; boxIndex < static_cast<int>(benchAABBs.size()); boxIndex++)
+	{
+		benchAABBBatch.AddBox(benchAABBs[boxIndex]);
+		benchOBBBatch.AddBox(benchOBBs[boxIndex]);
+	}
+
+	float checksum = 0.f;
+	double scalarAABBMs = TimeBestOfMs(5, [&]()
+	{
+		for (int rayIndex = 0; rayIndex < numRays; rayIndex++)
+		{
+			Vec3 startPos = Vec3(rays.m_startX[rayIndex], rays.m_startY[rayIndex], rays.m_startZ[rayIndex]);
+			Vec3 fwdNormal = Vec3(rays.m_fwdX[rayIndex], rays.m_fwdY[rayIndex], rays.m_fwdZ[rayIndex]);
+			checksum += RaycastNearestScalar(startPos, fwdNormal, rays.m_maxDist[rayIndex], benchAABBs, RaycastVsAABB3D).m_result.m_impactDist;
+		}
+	});
+	double batchedAABBMs = TimeBestOfMs(5, [&]()
+	{
+		RaycastVsAABBs3D(rays, benchAABBBatch, results);
+		checksum += results[0].m_impactDist;
+	});
+	double scalarOBBMs = TimeBestOfMs(5, [&]()
+	{
+		for (int rayIndex = 0; rayIndex < numRays; rayIndex++)
+		{
+			Vec3 startPos = Vec3(rays.m_startX[rayIndex], rays.m_startY[rayIndex], rays.m_startZ[rayIndex]);
+			Vec3 fwdNormal = Vec3(rays.m_fwdX[rayIndex], rays.m_fwdY[rayIndex], rays.m_fwdZ[rayIndex]);
+			checksum += RaycastNearestScalar(startPos, fwdNormal, rays.m_maxDist[rayIndex], benchOBBs, RaycastVsOBB3D).m_result.m_impactDist;
+		}
+	});
+	double batchedOBBMs = TimeBestOfMs(5, [&]()
+	{
+		RaycastVsOBBs3D(rays, benchOBBBatch, results);
+		checksum += results[0].m_impactDist;
+	});
+
+	printf("%d rays vs %d boxes (checksum %g)\n", numRays, static_cast<int>(benchAABBs.size()), checksum);
+	ReportBenchmark("RaycastVsAABBs3D", scalarAABBMs, batchedAABBMs);
+	ReportBenchmark("RaycastVsOBBs3D", scalarOBBMs, batchedOBBMs);
+	return ReportTestResults("RaycastBatchTests");
+}
@@ -0,0 +1,118 @@
+#include "Engine/Tests/TestUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/FloatRange.hpp"
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+//Text parsing through the string_view tokenizer and from_chars parsers, against the allocating split plus atof/atoi they replaced.
+//Both versions parse the same generated inputs and their outputs are compared.
+//Off-tree: g++ -std=c++17 -O2 -pthread -I. Engine/Tests/StringParsingBenchmark.cpp
+//	Engine/Math/*.cpp Engine/Core/Rgba8.cpp Engine/Core/StringUtils.cpp Engine/Core/ErrorWarningAssert.cpp
+//	Engine/Core/Vertex_PCU.cpp Engine/Core/VertexStream.cpp Engine/Renderer/SpriteSheet.cpp Engine/Renderer/SpriteDefinition.cpp -o StringParsingBenchmark
+
+//The old SplitStringOnDelimiter, kept here as the baseline
+static Strings LegacySplitStringOnDelimiter(std::string const& originalString, char delimiterToSplitOn)
+{
+	Strings resultList;
+	std::string current = "";
+	for (int stringIndex = 0; stringIndex < static_cast<int>(originalString.size()); stringIndex++)
+	{
+		if (originalString[stringIndex] == delimiterToSplitOn)
+		{
+			resultList.push_back(std::string(current));
+			current = "";
+		}
+		else
+		{
+			current += originalString[stringIndex];
+		}
+	}
+	resultList.push_back(current);
+	return resultList;
+}
+
+static Vec3 LegacyParseVec3(char const* text)
+{
+	Strings variables = LegacySplitStringOnDelimiter(text, ',');
+	return Vec3(static_cast<float>(atof(variables[0].c_str())), static_cast<float>(atof(variables[1].c_str())), static_cast<float>(atof(variables[2].c_str())));
+}
+
+static Rgba8 LegacyParseRgba8(char const* text)
+{
+	Strings variables = LegacySplitStringOnDelimiter(text, ',');
+	unsigned char alpha = variables.size() == 4 ? static_cast<unsigned char>(atoi(variables[3].c_str())) : 255;
+	return Rgba8(static_cast<unsigned char>(atoi(variables[0].c_str())), static_cast<unsigned char>(atoi(variables[1].c_str())), static_cast<unsigned char>(atoi(variables[2].c_str())), alpha);
+}
+
+static FloatRange LegacyParseFloatRange(char const* text)
+{
+	Strings variables = LegacySplitStringOnDelimiter(text, '~');
+	return FloatRange(static_cast<float>(atof(variables[0].c_str())), static_cast<float>(atof(variables[1].c_str())));
+}
+
+int main()
+{
+	int const numInputs = 200000;
+	std::vector<std::string> vec3Texts;
+	std::vector<std::string> rgbaTexts;
+	std::vector<std::string> rangeTexts;
+	for (int inputIndex = 0; inputIndex < numInputs; inputIndex++)
+	{
+		vec3Texts.push_back(Stringf("%.3f,%d, %.2f", (float)inputIndex * 0.125f, -inputIndex, (float)(inputIndex % 977) / 7.f));
+		rgbaTexts.push_back(inputIndex % 2 == 0 ? Stringf("%d,%d,%d", inputIndex % 256, (inputIndex / 3) % 256, 17) : Stringf("%d, %d, %d, %d", 255, inputIndex % 200, 3, inputIndex % 256));
+		rangeTexts.push_back(Stringf("%.1f~%.4f", (float)(inputIndex % 50), (float)inputIndex * 0.01f));
+	}
+
+	for (int inputIndex = 0; inputIndex < numInputs; inputIndex++)
+	{
+		Vec3 parsedVec3;
+		parsedVec3.SetFromText(vec3Texts[inputIndex]);
+		Vec3 legacyVec3 = LegacyParseVec3(vec3Texts[inputIndex].c_str());
+		TEST_CHECK(parsedVec3.x == legacyVec3.x && parsedVec3.y == legacyVec3.y && parsedVec3.z == legacyVec3.z, "Vec3::SetFromText differs from atof");
+
+		Rgba8 parsedColor;
+		parsedColor.SetFromText(rgbaTexts[inputIndex]);
+		Rgba8 legacyColor = LegacyParseRgba8(rgbaTexts[inputIndex].c_str());
+		TEST_CHECK(parsedColor.r == legacyColor.r && parsedColor.g == legacyColor.g && parsedColor.b == legacyColor.b && parsedColor.a == legacyColor.a, "Rgba8::SetFromText differs from atoi");
+
+		FloatRange parsedRange;
+		parsedRange.SetFromText(rangeTexts[inputIndex]);
+		FloatRange legacyRange = LegacyParseFloatRange(rangeTexts[inputIndex].c_str());
+		TEST_CHECK(parsedRange.m_min == legacyRange.m_min && parsedRange.m_max == legacyRange.m_max, "FloatRange::SetFromText differs from atof");
+
+		TEST_CHECK(SplitStringOnDelimiter(vec3Texts[inputIndex], ',') == LegacySplitStringOnDelimiter(vec3Texts[inputIndex], ','), "SplitStringOnDelimiter tokens differ");
+	}
+
+	float checksum = 0.f;
+	double legacyVec3Ms = TimeBestOfMs(3, [&]() { for (std::string const& text : vec3Texts) checksum += LegacyParseVec3(text.c_str()).x; });
+	double vec3Ms = TimeBestOfMs(3, [&]() { Vec3 parsed; for (std::string const& text : vec3Texts) { parsed.SetFromText(text); checksum += parsed.x; } });
+	double legacyRgbaMs = TimeBestOfMs(3, [&]() { for (std::string const& text : rgbaTexts) checksum += LegacyParseRgba8(text.c_str()).g; });
+	double rgbaMs = TimeBestOfMs(3, [&]() { Rgba8 parsed; for (std::string const& text : rgbaTexts) { parsed.SetFromText(text); checksum += parsed.g; } });
+	double legacyRangeMs = TimeBestOfMs(3, [&]() { for (std::string const& text : rangeTexts) checksum += LegacyParseFloatRange(text.c_str()).m_max; });
+	double rangeMs = TimeBestOfMs(3, [&]() { FloatRange parsed; for (std::string const& text : rangeTexts) { parsed.SetFromText(text); checksum += parsed.m_max; } });
+	double legacySplitMs = TimeBestOfMs(3, [&]() { for (std::string const& text : vec3Texts) checksum += (float)LegacySplitStringOnDelimiter(text, ',').size(); });
+	double splitMs = TimeBestOfMs(3, [&]() { for (std::string const& text : vec3Texts) checksum += (float)SplitStringOnDelimiter(text, ',').size(); });
+	double tokenizerMs = TimeBestOfMs(3, [&]()
+	{
+		for (std::string const& text : vec3Texts)
+		{
+			StringTokenizer tokens(text, ',');
+			std::string_view token;
+			while (tokens.GetNextToken(token))
+			{
+				checksum += (float)token.size();
+			}
+		}
+	});
+
+	printf("%d inputs per case (checksum %g)\n", numInputs, checksum);
+	ReportBenchmark("Vec3::SetFromText", legacyVec3Ms, vec3Ms);
+	ReportBenchmark("Rgba8::SetFromText", legacyRgbaMs, rgbaMs);
+	ReportBenchmark("FloatRange::SetFromText", legacyRangeMs, rangeMs);
+	ReportBenchmark("SplitStringOnDelimiter", legacySplitMs, splitMs);
+	ReportBenchmark("StringTokenizer (no allocation)", legacySplitMs, tokenizerMs);
+	return ReportTestResults("StringParsingBenchmark");
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+
+//Shared helpers for the standalone test and benchmark programs in this folder.
+//Each .cpp here is its own console program with a main(); they are not part of Engine.vcxproj.
+//Build one by adding it to a console project that links Engine.lib, or off-tree from the folder that holds Engine/ with the
+//g++ command in its header, which lists every Engine .cpp it links. That needs a Windows g++ such as MinGW-w64, since
+//ErrorWarningAssert.cpp and Time.cpp call Win32.
+//Every program returns 0 when all checks pass and prints its timings, so the numbers in commit messages can be reproduced.
+
+//The game normally defines g_rng; FloatRange.cpp refers to it, so every test program defines it here
+class RandomNumberGenerator;
+RandomNumberGenerator* g_rng = nullptr;
+
+static int s_numTestChecks = 0;
+static int s_numTestFailures = 0;
+
+#define TEST_CHECK(condition, message)																\
+	do																								\
+	{																								\
+		s_numTestChecks++;																			\
+		if (!(condition))																			\
+		{																							\
+			s_numTestFailures++;																	\
+			if (s_numTestFailures <= 20)															\
+			{																						\
+				printf("FAILED %s(%d): %s\n", __FILE__, __LINE__, message);							\
+			}																						\
+		}																							\
+	} while (0)
+
+inline int ReportTestResults(char const* testName)
+{
+	printf("%s: %d checks, %d failures\n", testName, s_numTestChecks, s_numTestFailures);
+	return s_numTestFailures == 0 ? 0 : 1;
+}
+
+//Best of several runs, in milliseconds, so one descheduled run does not skew the result
+template<typename Function>
+double TimeBestOfMs(int numRuns, Function const& function)
+{
+	double bestMs = 0.0;
+	for (int runIndex = 0; runIndex < numRuns; runIndex++)
+	{
+		std::chrono::high_resolution_clock::time_point startTime = std::chrono::high_resolution_clock::now();
+		function();
+		std::chrono::high_resolution_clock::time_point endTime = std::chrono::high_resolution_clock::now();
+		double elapsedMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+		if (runIndex == 0 || elapsedMs < bestMs)
+		{
+			bestMs = elapsedMs;
+		}
+	}
+	return bestMs;
+}
+
+inline void ReportBenchmark(char const* label, double baselineMs, double optimizedMs)
+{
+	printf("%-40s baseline %9.3f ms   optimized %9.3f ms   speedup %5.2fx\n", label, baselineMs, optimizedMs, optimizedMs > 0.0 ? baselineMs / optimizedMs : 0.0);
+}
@@ -0,0 +1,108 @@
+#include "Engine/Tests/TestUtils.hpp"
+#include "Engine/Core/TileHeatMap.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+//GenerateDistanceFieldParallel on g_theJobSystem against the serial bucket queue version, with and without entry costs,
+//across thread counts. Every parallel field is compared tile for tile with the serial one.
+//Off-tree: g++ -std=c++17 -O2 -pthread -I. Engine/Tests/TileHeatMapBenchmark.cpp Engine/Core/TileHeatMap.cpp
+//	Engine/Math/*.cpp Engine/Core/Rgba8.cpp Engine/Core/StringUtils.cpp Engine/Core/ErrorWarningAssert.cpp
+//	Engine/Core/Vertex_PCU.cpp Engine/Core/VertexStream.cpp Engine/Renderer/SpriteSheet.cpp Engine/Renderer/SpriteDefinition.cpp
+//	Engine/Core/EngineCommon.cpp Engine/Core/EventSystem.cpp Engine/Core/EventID.cpp Engine/Core/JobSystem.cpp
+//	Engine/Core/NamedStrings.cpp Engine/Core/XmlUtils.cpp Engine/Core/Clock.cpp Engine/Core/Time.cpp Engine/ThirdParty/TinyXML2/tinyxml2.cpp -o TileHeatMapBenchmark
+
+static int const MAP_SIZE = 1024;
+
+//Open ground with scattered walls, so the wavefronts stay wide
+static std::vector<bool> MakeSolidTiles(RandomNumberGenerator& rng, IntVec2 const& dimensions)
+{
+	std::vector<bool> solidTiles(dimensions.x * dimensions.y, false);
+	for (int wallIndex = 0; wallIndex < dimensions.x * dimensions.y / 200; wallIndex++)
+	{
+		int startX = rng.RollRandomIntLessThan(dimensions.x);
+		int startY = rng.RollRandomIntLessThan(dimensions.y);
+		bool isHorizontal = rng.RollRandomIntLessThan(2) == 0;
+		int length = rng.RollRandomIntInRange(2, 20);
+		for (int step = 0; step < length; step++)
+		{
+			int tileX = isHorizontal ? startX + step : startX;
+			int tileY = isHorizontal ? startY : startY + step;
+			if (tileX < dimensions.x && tileY < dimensions.y)
+			{
+				solidTiles[tileY * dimensions.x + tileX] = true;
+			}
+		}
+	}
+	return solidTiles;
+}
+
+static bool AreFieldsEqual(TileHeatMap const& fieldA, TileHeatMap const& fieldB)
+{
+	for (int tileIndex = 0; tileIndex < fieldA.GetSize(); tileIndex++)
+	{
+		if (fieldA.GetTileHeatValue(tileIndex) != fieldB.GetTileHeatValue(tileIndex))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+int main()
+{
+	RandomNumberGenerator rng;
+	IntVec2 dimensions(MAP_SIZE, MAP_SIZE);
+	std::vector<bool> solidTiles = MakeSolidTiles(rng, dimensions);
+	std::vector<IntVec2> seedTiles;
+	for (int seedIndex = 0; seedIndex < 4; seedIndex++)
+	{
+		seedTiles.push_back(IntVec2(rng.RollRandomIntLessThan(MAP_SIZE), rng.RollRandomIntLessThan(MAP_SIZE)));
+	}
+	//Roads, grass and swamp; most tiles cost 1 so the buckets still hold wide wavefronts
+	std::vector<unsigned char> tileEntryCosts(MAP_SIZE * MAP_SIZE, 1);
+	for (unsigned char& cost : tileEntryCosts)
+	{
+		int roll = rng.RollRandomIntLessThan(10);
+		cost = roll < 7 ? 1 : (roll < 9 ? 3 : 8);
+	}
+
+	TileHeatMap serialField(dimensions);
+	TileHeatMap serialCostField(dimensions);
+	TileHeatMap parallelField(dimensions);
+	double serialMs = TimeBestOfMs(3, [&]() { serialField.GenerateDistanceField(solidTiles, seedTiles); });
+	double serialCostMs = TimeBestOfMs(3, [&]() { serialCostField.GenerateDistanceField(solidTiles, seedTiles, 999999.f, &tileEntryCosts); });
+
+	//No job system falls back to the serial version
+	parallelField.GenerateDistanceFieldParallel(solidTiles, seedTiles, 999999.f, &tileEntryCosts);
+	TEST_CHECK(AreFieldsEqual(parallelField, serialCostField), "Fallback without a job system differs from the serial version");
+
+	int numHardwareThreads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+	int maxThreads = std::max(numHardwareThreads, 4);
+	printf("%d hardware threads, %dx%d map; serial %.3f ms uniform, %.3f ms with entry costs\n", numHardwareThreads, MAP_SIZE, MAP_SIZE, serialMs, serialCostMs);
+	printf("%8s %14s %10s %14s %10s\n", "threads", "uniform ms", "speedup", "costs ms", "speedup");
+	for (int numThreads = 2; numThreads <= maxThreads; numThreads++)
+	{
+		JobSystemConfig config;
+		config.m_numWorkerThreads = numThreads - 1;
+		JobSystem jobSystem(config);
+		jobSystem.Startup();
+		g_theJobSystem = &jobSystem;
+
+		parallelField.SetAllValues(-1.f);
+		double parallelMs = TimeBestOfMs(3, [&]() { parallelField.GenerateDistanceFieldParallel(solidTiles, seedTiles); });
+		TEST_CHECK(AreFieldsEqual(parallelField, serialField), "Uniform cost parallel field differs from the serial version");
+
+		parallelField.SetAllValues(-1.f);
+		double parallelCostMs = TimeBestOfMs(3, [&]() { parallelField.GenerateDistanceFieldParallel(solidTiles, seedTiles, 999999.f, &tileEntryCosts); });
+		TEST_CHECK(AreFieldsEqual(parallelField, serialCostField), "Entry cost parallel field differs from the serial version");
+
+		g_theJobSystem = nullptr;
+		jobSystem.Shutdown();
+		printf("%8d %14.3f %9.2fx %14.3f %9.2fx\n", numThreads, parallelMs, serialMs / parallelMs, parallelCostMs, serialCostMs / parallelCostMs);
+	}
+	printf("Thread counts beyond the hardware threads only measure oversubscription\n");
+	return ReportTestResults("TileHeatMapBenchmark");
+}
@@ -0,0 +1,185 @@
+#include "Engine/Tests/TestUtils.hpp"
+#include "Engine/Core/TilePathfinder.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <vector>
+
+//Re-path cost of TilePathfinder A* and JPS on a 512x512 map, against the per-query allocating A* games used to write.
+//Path costs from all three are checked against each other on every query.
+//Off-tree: g++ -std=c++17 -O2 -pthread -I. Engine/Tests/TilePathfinderBenchmark.cpp Engine/Core/TilePathfinder.cpp Engine/Core/TileHeatMap.cpp
+//	Engine/Math/*.cpp Engine/Core/Rgba8.cpp Engine/Core/StringUtils.cpp Engine/Core/ErrorWarningAssert.cpp
+//	Engine/Core/Vertex_PCU.cpp Engine/Core/VertexStream.cpp Engine/Renderer/SpriteSheet.cpp Engine/Renderer/SpriteDefinition.cpp
+//	Engine/Core/EngineCommon.cpp Engine/Core/EventSystem.cpp Engine/Core/EventID.cpp Engine/Core/JobSystem.cpp
+//	Engine/Core/NamedStrings.cpp Engine/Core/XmlUtils.cpp Engine/Core/Clock.cpp Engine/Core/Time.cpp Engine/ThirdParty/TinyXML2/tinyxml2.cpp -o TilePathfinderBenchmark
+
+static int const MAP_SIZE = 512;
+
+//Scattered wall segments with gaps, about a fifth of the map solid
+static std::vector<bool> MakeWallMap(RandomNumberGenerator& rng)
+{
+	std::vector<bool> solidTiles(MAP_SIZE * MAP_SIZE, false);
+	for (int wallIndex = 0; wallIndex < 4000; wallIndex++)
+	{
+		int startX = rng.RollRandomIntLessThan(MAP_SIZE);
+		int startY = rng.RollRandomIntLessThan(MAP_SIZE);
+		bool isHorizontal = rng.RollRandomIntLessThan(2) == 0;
+		int length = rng.RollRandomIntInRange(4, 40);
+		for (int step = 0; step < length; step++)
+		{
+			int tileX = isHorizontal ? startX + step : startX;
+			int tileY = isHorizontal ? startY : startY + step;
+			if (tileX < MAP_SIZE && tileY < MAP_SIZE)
+			{
+				solidTiles[tileY * MAP_SIZE + tileX] = true;
+			}
+		}
+	}
+	return solidTiles;
+}
+
+//Textbook A* with a std::priority_queue and fresh arrays every query, same movement rules and costs as TilePathfinder
+static float FindPathCostNaive(std::vector<bool> const& solidTiles, IntVec2 const& start, IntVec2 const& goal)
+{
+	auto isOpen = [&](int tileX, int tileY)
+	{
+		return tileX >= 0 && tileY >= 0 && tileX < MAP_SIZE && tileY < MAP_SIZE && !solidTiles[tileY * MAP_SIZE + tileX];
+	};
+	auto getOctile = [&](int tileX, int tileY)
+	{
+		int deltaX = abs(goal.x - tileX);
+		int deltaY = abs(goal.y - tileY);
+		return (float)std::max(deltaX, deltaY) + 0.41421356f * (float)std::min(deltaX, deltaY);
+	};
+
+	std::vector<float> gCosts(MAP_SIZE * MAP_SIZE, 1e30f);
+	std::vector<bool> isClosed(MAP_SIZE * MAP_SIZE, false);
+	typedef std::pair<float, int> OpenEntry;
+	std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> openList;
+	gCosts[start.y * MAP_SIZE + start.x] = 0.f;
+	openList.push(OpenEntry(getOctile(start.x, start.y), start.y * MAP_SIZE + start.x));
+	while (!openList.empty())
+	{
+		int tileIndex = openList.top().second;
+		openList.pop();
+		if (isClosed[tileIndex])
+		{
+			continue;
+		}
+		isClosed[tileIndex] = true;
+		int tileX = tileIndex % MAP_SIZE;
+		int tileY = tileIndex / MAP_SIZE;
+		if (tileX == goal.x && tileY == goal.y)
+		{
+			return gCosts[tileIndex];
+		}
+		for (int stepY = -1; stepY <= 1; stepY++)
+		{
+			for (int stepX = -1; stepX <= 1; stepX++)
+			{
+				if ((stepX == 0 && stepY == 0) || !isOpen(tileX + stepX, tileY + stepY))
+				{
+					continue;
+				}
+				bool isDiagonal = stepX != 0 && stepY != 0;
+				if (isDiagonal && (!isOpen(tileX + stepX, tileY) || !isOpen(tileX, tileY + stepY)))
+				{
+					continue;
+				}
+				int neighborIndex = (tileY + stepY) * MAP_SIZE + tileX + stepX;
+				float gCost = gCosts[tileIndex] + (isDiagonal ? 1.41421356f : 1.f);
+				if (gCost < gCosts[neighborIndex])
+				{
+					gCosts[neighborIndex] = gCost;
+					openList.push(OpenEntry(gCost + getOctile(tileX + stepX, tileY + stepY), neighborIndex));
+				}
+			}
+		}
+	}
+	return -1.f;
+}
+
+static IntVec2 RollOpenTile(std::vector<bool> const& solidTiles, RandomNumberGenerator& rng, IntVec2 const& near, int maxOffset)
+{
+	for (;;)
+	{
+		IntVec2 tile = IntVec2(near.x + rng.RollRandomIntInRange(-maxOffset, maxOffset), near.y + rng.RollRandomIntInRange(-maxOffset, maxOffset));
+		if (tile.x >= 0 && tile.y >= 0 && tile.x < MAP_SIZE && tile.y < MAP_SIZE && !solidTiles[tile.y * MAP_SIZE + tile.x])
+		{
+			return tile;
+		}
+	}
+}
+
+static void RunQueries(char const* label, std::vector<bool> const& solidTiles, TilePathfinder& pathfinder, std::vector<IntVec2> const& starts, std::vector<IntVec2> const& goals)
+{
+	int numQueries = static_cast<int>(starts.size());
+	std::vector<IntVec2> path;
+	for (int queryIndex = 0; queryIndex < numQueries; queryIndex++)
+	{
+		float naiveCost = FindPathCostNaive(solidTiles, starts[queryIndex], goals[queryIndex]);
+		bool didFindAStar = pathfinder.FindPathAStar(starts[queryIndex], goals[queryIndex], path);
+		float aStarCost = didFindAStar ? pathfinder.GetLastPathCost() : -1.f;
+		bool didFindJPS = pathfinder.FindPathJPS(starts[queryIndex], goals[queryIndex], path);
+		float jpsCost = didFindJPS ? pathfinder.GetLastPathCost() : -1.f;
+		TEST_CHECK(fabsf(naiveCost - aStarCost) < 0.01f, "FindPathAStar path cost differs from the reference A*");
+		TEST_CHECK(fabsf(naiveCost - jpsCost) < 0.01f, "FindPathJPS path cost differs from the reference A*");
+	}
+
+	double naiveMs = TimeBestOfMs(3, [&]()
+	{
+		for (int queryIndex = 0; queryIndex < numQueries; queryIndex++)
+		{
+			FindPathCostNaive(solidTiles, starts[queryIndex], goals[queryIndex]);
+		}
+	});
+	double aStarMs = TimeBestOfMs(3, [&]()
+	{
+		for (int queryIndex = 0; queryIndex < numQueries; queryIndex++)
+		{
+			pathfinder.FindPathAStar(starts[queryIndex], goals[queryIndex], path);
+		}
+	});
+	double jpsMs = TimeBestOfMs(3, [&]()
+	{
+		for (int queryIndex = 0; queryIndex < numQueries; queryIndex++)
+		{
+			pathfinder.FindPathJPS(starts[queryIndex], goals[queryIndex], path);
+		}
+	});
+
+	printf("%s, %d queries\n", label, numQueries);
+	ReportBenchmark("  FindPathAStar", naiveMs, aStarMs);
+	ReportBenchmark("  FindPathJPS", naiveMs, jpsMs);
+}
+
+int main()
+{
+	RandomNumberGenerator rng;
+	std::vector<bool> solidTiles = MakeWallMap(rng);
+	TilePathfinder pathfinder(IntVec2(MAP_SIZE, MAP_SIZE));
+	pathfinder.SetSolidTiles(solidTiles);
+
+	//Agents re-pathing to goals near them, the per-frame case
+	std::vector<IntVec2> starts;
+	std::vector<IntVec2> goals;
+	for (int agentIndex = 0; agentIndex < 300; agentIndex++)
+	{
+		starts.push_back(RollOpenTile(solidTiles, rng, IntVec2(MAP_SIZE / 2, MAP_SIZE / 2), MAP_SIZE / 2));
+		goals.push_back(RollOpenTile(solidTiles, rng, starts.back(), 64));
+	}
+	RunQueries("Local re-paths (goal within 64 tiles)", solidTiles, pathfinder, starts, goals);
+
+	starts.clear();
+	goals.clear();
+	for (int agentIndex = 0; agentIndex < 50; agentIndex++)
+	{
+		starts.push_back(RollOpenTile(solidTiles, rng, IntVec2(MAP_SIZE / 2, MAP_SIZE / 2), MAP_SIZE / 2));
+		goals.push_back(RollOpenTile(solidTiles, rng, IntVec2(MAP_SIZE / 2, MAP_SIZE / 2), MAP_SIZE / 2));
+	}
+	RunQueries("Cross-map paths", solidTiles, pathfinder, starts, goals);
+
+	return ReportTestResults("TilePathfinderBenchmark");
+}